@@ -205,8 +205,9 @@ set(URHO3D_NETFX netstandard2.1 CACHE STRING "TargetFramework value for .NET lib
 set_property(CACHE URHO3D_NETFX PROPERTY STRINGS netstandard2.1)
 set(URHO3D_NETFX_RUNTIME_VERSION OFF CACHE STRING "Version of runtime to use.")
 option                (URHO3D_DEBUG_ASSERT       "Enable Urho3D assert macros"                           ${URHO3D_ENABLE_ALL}                                    )
+option                (URHO3D_EVENT_NAMES        "Register event names for profiler and event loggers"   ON                                                      )
 cmake_dependent_option(URHO3D_FILEWATCHER        "Watch filesystem for resource changes"                 ${URHO3D_ENABLE_ALL} "URHO3D_THREADING;NOT UWP"      OFF)
-option                (URHO3D_HASH_DEBUG         "Enable StringHash name debugging"                      ${URHO3D_ENABLE_ALL}                                    )
+option                (URHO3D_HASH_DEBUG         "Enable StringHash reverse lookup registry"             ${URHO3D_ENABLE_ALL}                                    )
 option                (URHO3D_MONOLITHIC_HEADER  "Create Urho3DAll.h which includes all engine headers." OFF                                                     )
 cmake_dependent_option(URHO3D_MINIDUMPS          "Enable writing minidumps on crash"                     ${URHO3D_ENABLE_ALL} "MSVC;NOT UWP"                  OFF)
 cmake_dependent_option(URHO3D_PLUGINS            "Enable plugins"                                        ${URHO3D_ENABLE_ALL} "NOT EMSCRIPTEN;NOT UWP"               OFF)
@@ -253,6 +254,7 @@ elseif (URHO3D_TOOLS OR URHO3D_EDITOR)
     set (URHO3D_FILEWATCHER ON)
     set (URHO3D_LOGGING ON)
     set (URHO3D_HASH_DEBUG ON)
+    set (URHO3D_EVENT_NAMES ON)
 endif ()
 
 if (EMSCRIPTEN)
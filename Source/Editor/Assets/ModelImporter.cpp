@@ -88,6 +88,14 @@ template <class T> ea::optional<float> GetTrackStep(const T& track)
     return track.keyFrames_[numFrames - 1].time_ - track.keyFrames_[numFrames - 2].time_;
 }
 
+ea::optional<float> GetTrackStep(const AnimationTrack& track)
+{
+    const unsigned numFrames = track.GetNumKeyFrames();
+    if (numFrames <= 1)
+        return ea::nullopt;
+    return track.GetKeyFrameValue(numFrames - 1).time_ - track.GetKeyFrameValue(numFrames - 2).time_;
+}
+
 ea::optional<float> GetFrameStep(const Animation& animation)
 {
     ea::optional<float> frameStep;
@@ -364,6 +372,7 @@ void ModelImporter::ResetRootMotion(Animation& animation, const ResetRootMotionI
     if (!rootTrack)
         return;
 
+    rootTrack->Decompress();
     const AnimationKeyFrame& firstFrame = rootTrack->keyFrames_.front();
     const AnimationKeyFrame& lastFrame = rootTrack->keyFrames_.back();
     if (firstFrame.time_ == lastFrame.time_)
@@ -0,0 +1,151 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "AllocationCounter.h"
+
+#include <cstdlib>
+#include <new>
+
+#ifdef _MSC_VER
+#include <malloc.h>
+#endif
+
+namespace Benchmarks
+{
+
+namespace
+{
+
+thread_local unsigned numActiveCounters{};
+thread_local unsigned numAllocations{};
+
+void* AllocateAligned(std::size_t size, std::size_t alignment)
+{
+    if (numActiveCounters != 0)
+        ++numAllocations;
+
+    // Size of aligned_alloc should be a multiple of alignment
+    size = (size + alignment - 1) / alignment * alignment;
+#ifdef _MSC_VER
+    void* ptr = _aligned_malloc(size ? size : alignment, alignment);
+#else
+    void* ptr = std::aligned_alloc(alignment, size ? size : alignment);
+#endif
+    if (ptr)
+        return ptr;
+    throw std::bad_alloc{};
+}
+
+void FreeAligned(void* ptr)
+{
+#ifdef _MSC_VER
+    _aligned_free(ptr);
+#else
+    std::free(ptr);
+#endif
+}
+
+}
+
+AllocationCounter::AllocationCounter()
+    : numAllocationsBefore_(numAllocations)
+{
+    ++numActiveCounters;
+}
+
+AllocationCounter::~AllocationCounter()
+{
+    --numActiveCounters;
+}
+
+unsigned AllocationCounter::GetNumAllocations() const
+{
+    return numAllocations - numAllocationsBefore_;
+}
+
+} // namespace Benchmarks
+
+void* operator new(std::size_t size)
+{
+    if (Benchmarks::numActiveCounters != 0)
+        ++Benchmarks::numAllocations;
+
+    if (void* ptr = std::malloc(size ? size : 1))
+        return ptr;
+    throw std::bad_alloc{};
+}
+
+void* operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t size) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t size) noexcept
+{
+    std::free(ptr);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+    return Benchmarks::AllocateAligned(size, static_cast<std::size_t>(alignment));
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment)
+{
+    return Benchmarks::AllocateAligned(size, static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void* ptr, std::align_val_t alignment) noexcept
+{
+    Benchmarks::FreeAligned(ptr);
+}
+
+void operator delete[](void* ptr, std::align_val_t alignment) noexcept
+{
+    Benchmarks::FreeAligned(ptr);
+}
+
+void operator delete(void* ptr, std::size_t size, std::align_val_t alignment) noexcept
+{
+    Benchmarks::FreeAligned(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t size, std::align_val_t alignment) noexcept
+{
+    Benchmarks::FreeAligned(ptr);
+}
@@ -0,0 +1,154 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../../CommonUtils.h"
+#include "AllocationCounter.h"
+
+#include <Urho3D/Core/Context.h>
+#include <Urho3D/Core/Object.h>
+#include <Urho3D/Core/PoolAllocator.h>
+
+namespace
+{
+
+/// VariantMap before nodes were pooled.
+using LegacyVariantMap = ea::unordered_map<StringHash, Variant>;
+
+URHO3D_EVENT(E_ALLOCATIONEVENT, AllocationEvent)
+{
+    URHO3D_PARAM(P_NODE, Node);
+    URHO3D_PARAM(P_POSITION, Position);
+    URHO3D_PARAM(P_NAME, Name);
+    URHO3D_PARAM(P_VALUE, Value);
+}
+
+class AllocationEventReceiver : public Object
+{
+    URHO3D_OBJECT(AllocationEventReceiver, Object);
+
+public:
+    explicit AllocationEventReceiver(Context* context)
+        : Object(context)
+    {
+        SubscribeToEvent(E_ALLOCATIONEVENT, &AllocationEventReceiver::HandleEvent);
+    }
+
+    int sum_{};
+
+private:
+    void HandleEvent(VariantMap& eventData) { sum_ += eventData[AllocationEvent::P_VALUE].GetInt(); }
+};
+
+template <class T> unsigned CountAllocations(unsigned numIterations, const T& callback)
+{
+    const Benchmarks::AllocationCounter counter;
+    for (unsigned i = 0; i < numIterations; ++i)
+        callback();
+    return counter.GetNumAllocations();
+}
+
+/// Return whether heap allocations made inside of the engine are counted.
+bool AreEngineAllocationsVisible()
+{
+    const unsigned size = PoolAllocator::MaxPooledSize + 1;
+    const auto allocateInEngine = [&] { PoolAllocator::Deallocate(PoolAllocator::Allocate(size), size); };
+    return CountAllocations(1, allocateInEngine) != 0;
+}
+
+/// Clear and fill the map like event data is filled before SendEvent.
+template <class T> void FillEventData(T& eventData, Object* sender)
+{
+    using namespace AllocationEvent;
+    eventData.clear();
+    eventData[P_NODE] = sender;
+    eventData[P_POSITION] = Vector3::ONE;
+    eventData[P_NAME] = "Name";
+    eventData[P_VALUE] = 1;
+}
+
+} // namespace
+
+TEST_CASE("Allocations per event data fill")
+{
+    if (!AreEngineAllocationsVisible())
+        FAIL("Allocations of the engine are not visible to AllocationCounter");
+
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto sender = MakeShared<AllocationEventReceiver>(context);
+
+    LegacyVariantMap legacyMap;
+    VariantMap pooledMap;
+    const auto fillLegacyMap = [&] { FillEventData(legacyMap, sender); };
+    const auto fillPooledMap = [&] { FillEventData(pooledMap, sender); };
+
+    // Warm up pools and bucket arrays
+    fillLegacyMap();
+    fillPooledMap();
+
+    const unsigned numIterations = 1000;
+    const unsigned numLegacyAllocations = CountAllocations(numIterations, fillLegacyMap);
+    const unsigned numPooledAllocations = CountAllocations(numIterations, fillPooledMap);
+    WARN("Allocations per " << numIterations << " fills: ea::unordered_map " << numLegacyAllocations
+                            << ", VariantMap " << numPooledAllocations);
+    CHECK(numLegacyAllocations != 0);
+    CHECK(numPooledAllocations == 0);
+
+    BENCHMARK("Fill ea::unordered_map")
+    {
+        fillLegacyMap();
+    };
+
+    BENCHMARK("Fill VariantMap")
+    {
+        fillPooledMap();
+    };
+}
+
+TEST_CASE("Allocations per Object::SendEvent")
+{
+    if (!AreEngineAllocationsVisible())
+        FAIL("Allocations of the engine are not visible to AllocationCounter");
+
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto receiver = MakeShared<AllocationEventReceiver>(context);
+
+    const auto sendEvent = [&]
+    {
+        VariantMap& eventData = receiver->GetEventDataMap();
+        FillEventData(eventData, receiver);
+        receiver->SendEvent(E_ALLOCATIONEVENT, eventData);
+    };
+
+    // Warm up pools and event data maps
+    sendEvent();
+
+    const unsigned numIterations = 1000;
+    const unsigned numSendEventAllocations = CountAllocations(numIterations, sendEvent);
+    WARN("Allocations per " << numIterations << " SendEvent calls: " << numSendEventAllocations);
+    CHECK(numSendEventAllocations == 0);
+
+    BENCHMARK("Send event")
+    {
+        sendEvent();
+    };
+}
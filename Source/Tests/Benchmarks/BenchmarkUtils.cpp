@@ -0,0 +1,131 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "BenchmarkUtils.h"
+
+#include <catch2/catch_amalgamated.hpp>
+
+namespace Benchmarks
+{
+
+namespace
+{
+
+/// Listener that collects benchmark results without affecting console output.
+class BenchmarkResultCollector : public Catch::EventListenerBase
+{
+public:
+    using Catch::EventListenerBase::EventListenerBase;
+
+    void sectionStarting(const Catch::SectionInfo& sectionInfo) override
+    {
+        // Root section is named after the test case, so it is included in the benchmark name as well.
+        sections_.push_back(sectionInfo.name.c_str());
+    }
+
+    void sectionEnded(const Catch::SectionStats&) override
+    {
+        sections_.pop_back();
+    }
+
+    void benchmarkEnded(const Catch::BenchmarkStats<>& stats) override
+    {
+        ea::string name;
+        for (const ea::string& section : sections_)
+            name += section + "/";
+        name += stats.info.name.c_str();
+
+        BenchmarkResult result;
+        result.name_ = name;
+        result.mean_ = stats.mean.point.count();
+        result.standardDeviation_ = stats.standardDeviation.point.count();
+        result.samples_ = stats.samples.size();
+        GetBenchmarkResults().push_back(result);
+    }
+
+private:
+    ea::vector<ea::string> sections_;
+};
+
+} // namespace
+
+CATCH_REGISTER_LISTENER(BenchmarkResultCollector)
+
+ea::vector<BenchmarkResult>& GetBenchmarkResults()
+{
+    static ea::vector<BenchmarkResult> results;
+    return results;
+}
+
+JSONValue BenchmarkResultsToJSON(const ea::vector<BenchmarkResult>& results)
+{
+    JSONArray benchmarks;
+    for (const BenchmarkResult& result : results)
+    {
+        JSONValue benchmark;
+        benchmark.Set("name", result.name_);
+        benchmark.Set("mean", result.mean_);
+        benchmark.Set("standardDeviation", result.standardDeviation_);
+        benchmark.Set("samples", result.samples_);
+        benchmarks.push_back(benchmark);
+    }
+
+    JSONValue root;
+    root.Set("unit", "ns");
+    root.Set("benchmarks", benchmarks);
+    return root;
+}
+
+ea::vector<BenchmarkResult> BenchmarkResultsFromJSON(const JSONValue& value)
+{
+    ea::vector<BenchmarkResult> results;
+    for (const JSONValue& benchmark : value.Get("benchmarks").GetArray())
+    {
+        BenchmarkResult result;
+        result.name_ = benchmark.Get("name").GetString();
+        result.mean_ = benchmark.Get("mean").GetDouble();
+        result.standardDeviation_ = benchmark.Get("standardDeviation").GetDouble();
+        result.samples_ = benchmark.Get("samples").GetUInt();
+        if (!result.name_.empty())
+            results.push_back(result);
+    }
+    return results;
+}
+
+ea::vector<BenchmarkComparison> CompareBenchmarkResults(
+    const ea::vector<BenchmarkResult>& baseline, const ea::vector<BenchmarkResult>& current)
+{
+    ea::vector<BenchmarkComparison> comparisons;
+    for (const BenchmarkResult& result : current)
+    {
+        const auto iter = ea::find_if(baseline.begin(), baseline.end(),
+            [&](const BenchmarkResult& baselineResult) { return baselineResult.name_ == result.name_; });
+        if (iter == baseline.end())
+            continue;
+
+        comparisons.push_back(BenchmarkComparison{result.name_, iter->mean_, result.mean_});
+    }
+    return comparisons;
+}
+
+} // namespace Benchmarks
@@ -0,0 +1,73 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#pragma once
+
+#include <Urho3D/Container/Str.h>
+#include <Urho3D/Resource/JSONValue.h>
+
+#include <EASTL/vector.h>
+
+using namespace Urho3D;
+
+namespace Benchmarks
+{
+
+/// Result of single benchmark.
+struct BenchmarkResult
+{
+    /// Unique benchmark name in format "<test case>/<benchmark>".
+    ea::string name_;
+    /// Mean duration of single iteration in nanoseconds.
+    double mean_{};
+    /// Standard deviation of single iteration in nanoseconds.
+    double standardDeviation_{};
+    /// Number of collected samples.
+    unsigned samples_{};
+};
+
+/// Difference between current and baseline result.
+struct BenchmarkComparison
+{
+    ea::string name_;
+    double baselineMean_{};
+    double currentMean_{};
+
+    /// Return relative change of mean duration, positive if slower than baseline.
+    double GetRelativeChange() const { return baselineMean_ > 0.0 ? currentMean_ / baselineMean_ - 1.0 : 0.0; }
+};
+
+/// Return results collected in this run.
+ea::vector<BenchmarkResult>& GetBenchmarkResults();
+
+/// Convert results to/from JSON value.
+/// @{
+JSONValue BenchmarkResultsToJSON(const ea::vector<BenchmarkResult>& results);
+ea::vector<BenchmarkResult> BenchmarkResultsFromJSON(const JSONValue& value);
+/// @}
+
+/// Compare current results with baseline. Benchmarks missing in baseline are ignored.
+ea::vector<BenchmarkComparison> CompareBenchmarkResults(
+    const ea::vector<BenchmarkResult>& baseline, const ea::vector<BenchmarkResult>& current);
+
+} // namespace Benchmarks
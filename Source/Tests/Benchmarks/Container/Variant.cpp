@@ -0,0 +1,127 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../../CommonUtils.h"
+
+#include <Urho3D/Core/Variant.h>
+
+TEST_CASE("Variant construction and copy")
+{
+    const ea::string longString = "Urho3D/Models/Characters/Mutant/Mutant_Idle0.ani";
+    const VariantVector variantVector{Variant{1}, Variant{Vector3::ONE}, Variant{"Text"}};
+    const ResourceRefList resourceRefList{StringHash{"Material"}, {"Materials/A.xml", "Materials/B.xml"}};
+
+    BENCHMARK("Construct int")
+    {
+        return Variant{10};
+    };
+
+    BENCHMARK("Construct Vector3")
+    {
+        return Variant{Vector3::ONE};
+    };
+
+    BENCHMARK("Construct Matrix3x4")
+    {
+        return Variant{Matrix3x4::IDENTITY};
+    };
+
+    BENCHMARK("Construct long string")
+    {
+        return Variant{longString};
+    };
+
+    BENCHMARK("Construct VariantVector")
+    {
+        return Variant{variantVector};
+    };
+
+    BENCHMARK("Construct ResourceRefList")
+    {
+        return Variant{resourceRefList};
+    };
+
+    const Variant vector3Value{Vector3::ONE};
+    const Variant stringValue{longString};
+    const Variant variantVectorValue{variantVector};
+
+    BENCHMARK("Copy Vector3")
+    {
+        return Variant{vector3Value};
+    };
+
+    BENCHMARK("Copy long string")
+    {
+        return Variant{stringValue};
+    };
+
+    BENCHMARK("Copy VariantVector")
+    {
+        return Variant{variantVectorValue};
+    };
+
+    BENCHMARK_ADVANCED("Assign over existing value")(Catch::Benchmark::Chronometer meter)
+    {
+        ea::vector<Variant> values(meter.runs(), Variant{10});
+        meter.measure([&](int i) { values[i] = vector3Value; });
+    };
+}
+
+TEST_CASE("VariantMap lookups")
+{
+    VariantMap map;
+    ea::vector<StringHash> keys;
+    for (unsigned i = 0; i < 16; ++i)
+    {
+        const StringHash key{Format("Parameter{}", i)};
+        map[key] = static_cast<int>(i);
+        keys.push_back(key);
+    }
+    const StringHash missingKey{"MissingParameter"};
+
+    BENCHMARK("Find existing key")
+    {
+        int sum = 0;
+        for (const StringHash key : keys)
+            sum += map.find(key)->second.GetInt();
+        return sum;
+    };
+
+    BENCHMARK("Find missing key")
+    {
+        return map.find(missingKey) != map.end();
+    };
+
+    BENCHMARK("Insert 16 keys")
+    {
+        VariantMap newMap;
+        for (const StringHash key : keys)
+            newMap[key] = 1;
+        return newMap;
+    };
+
+    BENCHMARK("Copy map of 16 keys")
+    {
+        return VariantMap{map};
+    };
+}
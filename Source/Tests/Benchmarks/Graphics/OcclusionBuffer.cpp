@@ -0,0 +1,117 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "../../CommonUtils.h"
+
+#include <Urho3D/Graphics/Camera.h>
+#include <Urho3D/Graphics/OcclusionBuffer.h>
+#include <Urho3D/Math/RandomEngine.h>
+#include <Urho3D/Scene/Scene.h>
+
+namespace
+{
+
+/// Create vertices of random boxes in front of the camera, 12 triangles per box.
+ea::vector<Vector3> CreateOccluderTriangles(unsigned numBoxes)
+{
+    static const unsigned boxIndices[] = {
+        0, 1, 3, 0, 3, 2, 4, 6, 7, 4, 7, 5, 0, 4, 5, 0, 5, 1,
+        2, 3, 7, 2, 7, 6, 0, 2, 6, 0, 6, 4, 1, 5, 7, 1, 7, 3,
+    };
+
+    RandomEngine random{0u};
+    ea::vector<Vector3> vertices;
+    for (unsigned i = 0; i < numBoxes; ++i)
+    {
+        const Vector3 center = random.GetVector3({-40.0f, -20.0f, 10.0f}, {40.0f, 20.0f, 90.0f});
+        const Vector3 halfSize = random.GetVector3(Vector3::ONE * 0.5f, Vector3::ONE * 4.0f);
+        Vector3 corners[8];
+        for (unsigned j = 0; j < 8; ++j)
+        {
+            corners[j] = center + Vector3(j & 1 ? halfSize.x_ : -halfSize.x_, j & 2 ? halfSize.y_ : -halfSize.y_,
+                j & 4 ? halfSize.z_ : -halfSize.z_);
+        }
+        for (unsigned index : boxIndices)
+            vertices.push_back(corners[index]);
+    }
+    return vertices;
+}
+
+void BenchmarkOcclusionBuffer(Context* context, unsigned numTriangles, bool threaded)
+{
+    auto scene = MakeShared<Scene>(context);
+    auto camera = scene->CreateChild("Camera")->CreateComponent<Camera>();
+    camera->SetAspectRatio(1.6f);
+    camera->SetFarClip(100.0f);
+
+    const ea::vector<Vector3> vertices = CreateOccluderTriangles(numTriangles / 12);
+
+    auto buffer = MakeShared<OcclusionBuffer>(context);
+    buffer->SetSize(256, 160, threaded);
+    buffer->SetView(camera);
+    buffer->SetMaxTriangles(numTriangles);
+    buffer->SetCullMode(CULL_NONE);
+
+    BENCHMARK("Draw occluders")
+    {
+        buffer->Clear();
+        buffer->AddTriangles(Matrix3x4::IDENTITY, vertices.data(), sizeof(Vector3), 0, vertices.size());
+        buffer->DrawTriangles();
+        buffer->BuildDepthHierarchy();
+        return buffer->GetNumTriangles();
+    };
+
+    RandomEngine random{1u};
+    ea::vector<BoundingBox> boxes;
+    for (unsigned i = 0; i < 10000; ++i)
+    {
+        const Vector3 center = random.GetVector3({-40.0f, -20.0f, 10.0f}, {40.0f, 20.0f, 90.0f});
+        boxes.emplace_back(center - Vector3::ONE, center + Vector3::ONE);
+    }
+
+    BENCHMARK("Test 10000 boxes")
+    {
+        unsigned numVisible = 0;
+        for (const BoundingBox& box : boxes)
+            numVisible += buffer->IsVisible(box) ? 1 : 0;
+        return numVisible;
+    };
+}
+
+} // namespace
+
+TEST_CASE("Occlusion buffer rasterization")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+
+    for (unsigned numTriangles : {5000, 50000})
+    {
+        DYNAMIC_SECTION("Single thread, triangles: " << numTriangles)
+        {
+            BenchmarkOcclusionBuffer(context, numTriangles, false);
+        }
+        DYNAMIC_SECTION("Threaded, triangles: " << numTriangles)
+        {
+            BenchmarkOcclusionBuffer(context, numTriangles, true);
+        }
+    }
+}
@@ -0,0 +1,155 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../../CommonUtils.h"
+
+#include <Urho3D/Core/WorkQueue.h>
+#include <Urho3D/Math/RandomEngine.h>
+#include <Urho3D/RenderPipeline/PipelineBatchSorter.h>
+
+#include <EASTL/sort.h>
+
+namespace
+{
+
+void BenchmarkBatchSorting(unsigned numBatches, float changedShare)
+{
+    RandomEngine random{0u};
+
+    ea::vector<PipelineBatch> batches(numBatches);
+    ea::vector<PipelineBatchByState> sortedBatches(numBatches);
+    for (unsigned i = 0; i < numBatches; ++i)
+    {
+        batches[i].drawableIndex_ = i;
+        sortedBatches[i].pipelineBatch_ = &batches[i];
+        sortedBatches[i].primaryKey_ = random.GetUInt(0, 1000) * 0x10000000000ull;
+        sortedBatches[i].secondaryKey_ = random.GetUInt();
+    }
+
+    // Emulate batches collected in different order every frame, some of them changed
+    const unsigned numChangedBatches = static_cast<unsigned>(numBatches * changedShare);
+    ea::vector<PipelineBatchByState> frameBatches = sortedBatches;
+    random.Shuffle(frameBatches.begin(), frameBatches.end());
+    for (unsigned i = 0; i < numChangedBatches; ++i)
+        frameBatches[i].secondaryKey_ = random.GetUInt();
+
+    ea::vector<PipelineBatchByState> buffer;
+
+    // Each iteration sorts two frames: one without changes and one with changes
+    BENCHMARK("Full sort")
+    {
+        buffer = sortedBatches;
+        ea::sort(buffer.begin(), buffer.end());
+        buffer = frameBatches;
+        ea::sort(buffer.begin(), buffer.end());
+        return buffer.size();
+    };
+
+    PipelineBatchSorter sorter;
+    buffer = sortedBatches;
+    sorter.Sort(buffer);
+
+    BENCHMARK("Incremental sort")
+    {
+        buffer = sortedBatches;
+        sorter.Sort(buffer);
+        buffer = frameBatches;
+        sorter.Sort(buffer);
+        return sorter.GetNumReusedBatches();
+    };
+}
+
+void BenchmarkRadixSort(WorkQueue* workQueue, unsigned numBatches)
+{
+    RandomEngine random{0u};
+
+    ea::vector<PipelineBatchByState> byStateBatches(numBatches);
+    ea::vector<PipelineBatchBackToFront> backToFrontBatches(numBatches);
+    for (unsigned i = 0; i < numBatches; ++i)
+    {
+        byStateBatches[i].primaryKey_ = (static_cast<unsigned long long>(random.GetUInt(0, 2000)) << 40)
+            | (static_cast<unsigned long long>(random.GetUInt(0, 500)) << 24);
+        byStateBatches[i].secondaryKey_ = static_cast<unsigned long long>(random.GetUInt(0, 1000)) << 40;
+        backToFrontBatches[i].renderOrder_ = 128;
+        backToFrontBatches[i].distance_ = random.GetFloat(0.0f, 1000.0f);
+    }
+
+    PipelineBatchRadixSort radixSort;
+    ea::vector<PipelineBatchByState> byStateBuffer;
+    ea::vector<PipelineBatchBackToFront> backToFrontBuffer;
+
+    BENCHMARK("Comparison sort by state")
+    {
+        byStateBuffer = byStateBatches;
+        ea::sort(byStateBuffer.begin(), byStateBuffer.end());
+        return byStateBuffer.size();
+    };
+
+    BENCHMARK("Radix sort by state")
+    {
+        byStateBuffer = byStateBatches;
+        radixSort.RadixSort(byStateBuffer, workQueue);
+        return byStateBuffer.size();
+    };
+
+    BENCHMARK("Comparison sort back to front")
+    {
+        backToFrontBuffer = backToFrontBatches;
+        ea::sort(backToFrontBuffer.begin(), backToFrontBuffer.end());
+        return backToFrontBuffer.size();
+    };
+
+    BENCHMARK("Radix sort back to front")
+    {
+        backToFrontBuffer = backToFrontBatches;
+        radixSort.RadixSort(backToFrontBuffer, workQueue);
+        return backToFrontBuffer.size();
+    };
+}
+
+} // namespace
+
+TEST_CASE("Pipeline batch radix sort")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto workQueue = context->GetSubsystem<WorkQueue>();
+
+    for (unsigned numBatches : {10000, 100000})
+    {
+        DYNAMIC_SECTION("Batches: " << numBatches)
+        {
+            BenchmarkRadixSort(workQueue, numBatches);
+        }
+    }
+}
+
+TEST_CASE("Pipeline batch sorting")
+{
+    for (unsigned numBatches : {10000, 100000})
+    {
+        DYNAMIC_SECTION("Batches: " << numBatches << ", 5% changed")
+        {
+            BenchmarkBatchSorting(numBatches, 0.05f);
+        }
+    }
+}
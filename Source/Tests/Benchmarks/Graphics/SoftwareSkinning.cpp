@@ -0,0 +1,91 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+
+#include "../../CommonUtils.h"
+#include "../../ModelUtils.h"
+
+#include <Urho3D/Graphics/Model.h>
+#include <Urho3D/Graphics/SoftwareModelAnimator.h>
+#include <Urho3D/Math/BatchMath.h>
+
+namespace
+{
+
+const unsigned numBones = 32;
+const unsigned numQuads = 16384;
+
+const char* GetInstructionSetName(BatchMathInstructionSet instructionSet)
+{
+    switch (instructionSet)
+    {
+    case BatchMathInstructionSet::AVX2: return "AVX2";
+    case BatchMathInstructionSet::NEON: return "NEON";
+    default: return "Generic";
+    }
+}
+
+} // namespace
+
+TEST_CASE("Software skinning of 65536 vertices")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+
+    const SharedPtr<Model> model = Tests::CreateSkinnedMorphedGrid_Model(context, numBones, numQuads)->ExportModel();
+
+    ea::vector<ModelMorph> morphs = model->GetMorphs();
+    morphs[0].weight_ = 0.5f;
+
+    ea::vector<Matrix3x4> skinMatrices;
+    for (unsigned i = 0; i < numBones; ++i)
+        skinMatrices.emplace_back(Vector3::RIGHT * (i * 0.1f), Quaternion{i * 5.0f, Vector3::FORWARD}, 1.0f);
+
+    auto animator = MakeShared<SoftwareModelAnimator>(context);
+    animator->Initialize(model, true, SoftwareModelAnimator::MaxBones);
+
+    const BatchMathInstructionSet defaultInstructionSet = GetBatchMathInstructionSet();
+    for (const BatchMathInstructionSet instructionSet :
+        {BatchMathInstructionSet::Generic, BatchMathInstructionSet::AVX2, BatchMathInstructionSet::NEON})
+    {
+        if (!IsBatchMathInstructionSetSupported(instructionSet))
+            continue;
+
+        SetBatchMathInstructionSet(instructionSet);
+        const ea::string suffix = Format(" ({})", GetInstructionSetName(instructionSet));
+
+        BENCHMARK(("Reset, morph and skin in separate passes" + suffix).c_str())
+        {
+            animator->ResetAnimation();
+            animator->ApplyMorphs(morphs);
+            animator->ApplySkinning(skinMatrices);
+            return animator->GetVertexBuffers()[0]->GetShadowData()[0];
+        };
+
+        BENCHMARK(("Reset, morph and skin in one pass" + suffix).c_str())
+        {
+            animator->Update(morphs, skinMatrices);
+            return animator->GetVertexBuffers()[0]->GetShadowData()[0];
+        };
+    }
+    SetBatchMathInstructionSet(defaultInstructionSet);
+}
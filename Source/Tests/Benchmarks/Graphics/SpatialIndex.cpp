@@ -0,0 +1,141 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "../../CommonUtils.h"
+
+#include <Urho3D/Graphics/Camera.h>
+#include <Urho3D/Graphics/Model.h>
+#include <Urho3D/Graphics/Octree.h>
+#include <Urho3D/Graphics/StaticModel.h>
+#include <Urho3D/Math/RandomEngine.h>
+#include <Urho3D/Scene/Scene.h>
+
+namespace
+{
+
+/// Share of drawables that move every frame.
+const float movingShare = 0.1f;
+
+/// Measure queries and updates of given spatial index over scene with randomly scattered drawables.
+void BenchmarkSpatialIndex(Context* context, unsigned numDrawables, OctreeSpatialIndex spatialIndex)
+{
+    auto model = MakeShared<Model>(context);
+    model->SetBoundingBox(BoundingBox(-Vector3::ONE, Vector3::ONE));
+
+    const float areaSize = Sqrt(static_cast<float>(numDrawables)) * 4.0f;
+    RandomEngine random{0u};
+
+    auto scene = MakeShared<Scene>(context);
+    auto octree = scene->CreateComponent<Octree>();
+    octree->SetSize(BoundingBox(Vector3::ZERO, Vector3(areaSize, 20.0f, areaSize)), 8);
+    octree->SetSpatialIndex(spatialIndex);
+
+    ea::vector<Node*> movingNodes;
+    const unsigned numMovingNodes = static_cast<unsigned>(numDrawables * movingShare);
+    for (unsigned i = 0; i < numDrawables; ++i)
+    {
+        Node* node = scene->CreateChild();
+        node->SetPosition(random.GetVector3({0.0f, 0.0f, 0.0f}, {areaSize, 20.0f, areaSize}));
+        node->SetScale(random.GetFloat(0.5f, 2.0f));
+        node->CreateComponent<StaticModel>()->SetModel(model);
+        if (i < numMovingNodes)
+            movingNodes.push_back(node);
+    }
+
+    auto cameraNode = scene->CreateChild();
+    cameraNode->SetPosition({areaSize * 0.5f, 30.0f, 0.0f});
+    cameraNode->LookAt({areaSize * 0.5f, 0.0f, areaSize * 0.5f});
+    auto camera = cameraNode->CreateComponent<Camera>();
+    camera->SetFarClip(areaSize * 0.5f);
+
+    FrameInfo frameInfo;
+    frameInfo.scene_ = scene;
+    octree->Update(frameInfo);
+
+    ea::vector<Drawable*> result;
+    BENCHMARK("Frustum query")
+    {
+        FrustumOctreeQuery query(result, camera->GetFrustum());
+        octree->GetDrawables(query);
+        return result.size();
+    };
+
+    BENCHMARK("Batched frustum query")
+    {
+        octree->GetDrawablesInFrustum(result, camera->GetFrustum());
+        return result.size();
+    };
+
+    const Vector3 boxCenter{areaSize * 0.5f, 10.0f, areaSize * 0.5f};
+    BENCHMARK("Small box query")
+    {
+        BoxOctreeQuery query(result, BoundingBox(boxCenter - Vector3::ONE * 10.0f, boxCenter + Vector3::ONE * 10.0f));
+        octree->GetDrawables(query);
+        return result.size();
+    };
+
+    const Ray ray{Vector3{0.0f, 10.0f, 0.0f}, Vector3{1.0f, 0.0f, 1.0f}.Normalized()};
+    BENCHMARK("Raycast")
+    {
+        RayOctreeQuery query(ray, RAY_AABB);
+        octree->Raycast(query);
+        return query.result_.size();
+    };
+
+    BENCHMARK("RaycastSingle")
+    {
+        RayOctreeQuery query(ray, RAY_AABB);
+        octree->RaycastSingle(query);
+        return query.result_.size();
+    };
+
+    BENCHMARK_ADVANCED("Update with moving drawables")(Catch::Benchmark::Chronometer meter)
+    {
+        meter.measure([&](int i)
+        {
+            ++frameInfo.frameNumber_;
+            const Vector3 offset = Vector3::RIGHT * (i % 2 == 0 ? 0.5f : -0.5f);
+            for (Node* node : movingNodes)
+                node->Translate(offset);
+            octree->Update(frameInfo);
+        });
+    };
+}
+
+} // namespace
+
+TEST_CASE("Octree spatial index queries")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+
+    for (unsigned numDrawables : {10000, 100000})
+    {
+        DYNAMIC_SECTION("Octants, drawables: " << numDrawables)
+        {
+            BenchmarkSpatialIndex(context, numDrawables, OctreeSpatialIndex::Octants);
+        }
+        DYNAMIC_SECTION("BVH, drawables: " << numDrawables)
+        {
+            BenchmarkSpatialIndex(context, numDrawables, OctreeSpatialIndex::BVH);
+        }
+    }
+}
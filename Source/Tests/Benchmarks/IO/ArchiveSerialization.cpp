@@ -0,0 +1,138 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../../CommonUtils.h"
+
+#include <Urho3D/IO/ArchiveSerialization.h>
+#include <Urho3D/IO/BinaryArchive.h>
+#include <Urho3D/IO/MemoryBuffer.h>
+#include <Urho3D/IO/VectorBuffer.h>
+#include <Urho3D/Scene/Node.h>
+#include <Urho3D/Scene/Scene.h>
+
+namespace
+{
+
+struct BenchmarkAggregate
+{
+    ea::string name_;
+    ea::vector<Vector3> positions_;
+    ea::vector<Quaternion> rotations_;
+    VariantMap variables_;
+
+    void SerializeInBlock(Archive& archive)
+    {
+        SerializeValue(archive, "name", name_);
+        SerializeValue(archive, "positions", positions_);
+        SerializeValue(archive, "rotations", rotations_);
+        SerializeValue(archive, "variables", variables_);
+    }
+};
+
+BenchmarkAggregate CreateTestAggregate()
+{
+    BenchmarkAggregate result;
+    result.name_ = "Aggregate";
+    for (unsigned i = 0; i < 256; ++i)
+    {
+        result.positions_.push_back(Vector3::ONE * static_cast<float>(i));
+        result.rotations_.push_back(Quaternion{static_cast<float>(i), Vector3::UP});
+    }
+    for (unsigned i = 0; i < 16; ++i)
+        result.variables_[StringHash{i}] = static_cast<int>(i);
+    return result;
+}
+
+} // namespace
+
+TEST_CASE("BinaryArchive serialization")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+
+    auto sourceObject = CreateTestAggregate();
+    VectorBuffer sourceBuffer;
+    {
+        BinaryOutputArchive archive{context, sourceBuffer};
+        SerializeValue(archive, "aggregate", sourceObject);
+    }
+
+    BENCHMARK("Save aggregate")
+    {
+        VectorBuffer buffer;
+        BinaryOutputArchive archive{context, buffer};
+        SerializeValue(archive, "aggregate", sourceObject);
+        return buffer.GetSize();
+    };
+
+    BENCHMARK("Load aggregate")
+    {
+        BenchmarkAggregate object;
+        MemoryBuffer buffer{sourceBuffer.GetBuffer()};
+        BinaryInputArchive archive{context, buffer};
+        SerializeValue(archive, "aggregate", object);
+        return object.positions_.size();
+    };
+
+    auto scene = MakeShared<Scene>(context);
+    Node* rootNode = scene->CreateChild("Root");
+    for (unsigned i = 0; i < 100; ++i)
+    {
+        Node* child = rootNode->CreateChild(Format("Child{}", i));
+        child->SetPosition(Vector3::ONE * static_cast<float>(i));
+        child->SetVar("Index", static_cast<int>(i));
+    }
+
+    VectorBuffer nodeBuffer;
+    {
+        BinaryOutputArchive archive{context, nodeBuffer};
+        ArchiveBlock block = archive.OpenUnorderedBlock("node");
+        rootNode->SerializeInBlock(archive);
+    }
+
+    BENCHMARK("Save node hierarchy")
+    {
+        VectorBuffer buffer;
+        BinaryOutputArchive archive{context, buffer};
+        ArchiveBlock block = archive.OpenUnorderedBlock("node");
+        rootNode->SerializeInBlock(archive);
+        return buffer.GetSize();
+    };
+
+    BENCHMARK_ADVANCED("Load node hierarchy")(Catch::Benchmark::Chronometer meter)
+    {
+        ea::vector<Node*> nodes;
+        for (int i = 0; i < meter.runs(); ++i)
+            nodes.push_back(scene->CreateChild("Copy"));
+
+        meter.measure([&](int i)
+        {
+            MemoryBuffer buffer{nodeBuffer.GetBuffer()};
+            BinaryInputArchive archive{context, buffer};
+            ArchiveBlock block = archive.OpenUnorderedBlock("node");
+            nodes[i]->SerializeInBlock(archive);
+        });
+
+        for (Node* node : nodes)
+            node->Remove();
+    };
+}
@@ -0,0 +1,107 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../../CommonUtils.h"
+
+#include <Urho3D/IO/MemoryBuffer.h>
+#include <Urho3D/IO/VectorBuffer.h>
+
+namespace
+{
+
+const unsigned numElements = 1024;
+
+void WriteTestData(Serializer& dest)
+{
+    for (unsigned i = 0; i < numElements; ++i)
+    {
+        dest.WriteUInt(i);
+        dest.WriteFloat(static_cast<float>(i));
+        dest.WriteVector3(Vector3::ONE * static_cast<float>(i));
+        dest.WriteQuaternion(Quaternion::IDENTITY);
+        dest.WriteStringHash(StringHash{i});
+        dest.WriteVLE(i);
+    }
+}
+
+float ReadTestData(Deserializer& source)
+{
+    float sum = 0.0f;
+    for (unsigned i = 0; i < numElements; ++i)
+    {
+        sum += static_cast<float>(source.ReadUInt());
+        sum += source.ReadFloat();
+        sum += source.ReadVector3().x_;
+        sum += source.ReadQuaternion().w_;
+        sum += static_cast<float>(source.ReadStringHash().Value());
+        sum += static_cast<float>(source.ReadVLE());
+    }
+    return sum;
+}
+
+} // namespace
+
+TEST_CASE("VectorBuffer and MemoryBuffer read/write")
+{
+    VectorBuffer sourceBuffer;
+    WriteTestData(sourceBuffer);
+
+    BENCHMARK("Write to new VectorBuffer")
+    {
+        VectorBuffer buffer;
+        WriteTestData(buffer);
+        return buffer.GetSize();
+    };
+
+    BENCHMARK_ADVANCED("Write to reused VectorBuffer")(Catch::Benchmark::Chronometer meter)
+    {
+        VectorBuffer buffer;
+        WriteTestData(buffer);
+        meter.measure([&]
+        {
+            buffer.Clear();
+            WriteTestData(buffer);
+            return buffer.GetSize();
+        });
+    };
+
+    BENCHMARK("Read from MemoryBuffer")
+    {
+        MemoryBuffer buffer{sourceBuffer.GetBuffer()};
+        return ReadTestData(buffer);
+    };
+
+    BENCHMARK("Read from VectorBuffer")
+    {
+        sourceBuffer.Seek(0);
+        return ReadTestData(sourceBuffer);
+    };
+
+    BENCHMARK("Write strings")
+    {
+        VectorBuffer buffer;
+        for (unsigned i = 0; i < numElements; ++i)
+            buffer.WriteString("Urho3D/Models/Characters/Mutant/Mutant_Idle0.ani");
+        return buffer.GetSize();
+    };
+}
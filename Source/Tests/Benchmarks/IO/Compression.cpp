@@ -0,0 +1,59 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../../CommonUtils.h"
+
+#include <Urho3D/IO/Compression.h>
+#include <Urho3D/Math/RandomEngine.h>
+
+TEST_CASE("LZ4 compression")
+{
+    const unsigned dataSize = 256 * 1024;
+
+    // Mix of repeated patterns and noise, similar to serialized scene data.
+    RandomEngine random{0u};
+    ByteVector sourceData(dataSize);
+    for (unsigned i = 0; i < dataSize; ++i)
+        sourceData[i] = (i / 64) % 4 == 0 ? static_cast<unsigned char>(random.GetUInt(0, 255)) : static_cast<unsigned char>(i % 17);
+
+    ByteVector compressedData(EstimateCompressBound(dataSize));
+    const unsigned compressedSize = CompressData(compressedData.data(), sourceData.data(), dataSize);
+    REQUIRE(compressedSize > 0);
+    compressedData.resize(compressedSize);
+
+    ByteVector decompressedData(dataSize);
+    REQUIRE(DecompressData(decompressedData.data(), compressedData.data(), dataSize) == compressedSize);
+    REQUIRE(decompressedData == sourceData);
+
+    ByteVector buffer(EstimateCompressBound(dataSize));
+
+    BENCHMARK("Compress 256 KiB")
+    {
+        return CompressData(buffer.data(), sourceData.data(), dataSize);
+    };
+
+    BENCHMARK("Decompress 256 KiB")
+    {
+        return DecompressData(buffer.data(), compressedData.data(), dataSize);
+    };
+}
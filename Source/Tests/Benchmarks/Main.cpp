@@ -0,0 +1,132 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include <catch2/catch_amalgamated.hpp>
+// Don't write benchmarks here!
+
+#include "../CommonUtils.h"
+#include "BenchmarkUtils.h"
+
+#include <Urho3D/IO/File.h>
+#include <Urho3D/Resource/JSONFile.h>
+
+#include <iostream>
+
+namespace
+{
+
+bool SaveResults(Context* context, const ea::string& fileName, const ea::vector<Benchmarks::BenchmarkResult>& results)
+{
+    auto jsonFile = MakeShared<JSONFile>(context);
+    jsonFile->GetRoot() = Benchmarks::BenchmarkResultsToJSON(results);
+
+    File file(context, fileName, FILE_WRITE);
+    return file.IsOpen() && jsonFile->Save(file);
+}
+
+bool LoadResults(Context* context, const ea::string& fileName, ea::vector<Benchmarks::BenchmarkResult>& results)
+{
+    File file(context, fileName, FILE_READ);
+    if (!file.IsOpen())
+        return false;
+
+    auto jsonFile = MakeShared<JSONFile>(context);
+    if (!jsonFile->Load(file))
+        return false;
+
+    results = Benchmarks::BenchmarkResultsFromJSON(jsonFile->GetRoot());
+    return true;
+}
+
+/// Print comparison with baseline and return number of regressions above threshold.
+unsigned ReportComparison(const ea::vector<Benchmarks::BenchmarkComparison>& comparisons, double maxRegression)
+{
+    unsigned numRegressions = 0;
+    for (const Benchmarks::BenchmarkComparison& comparison : comparisons)
+    {
+        const double change = comparison.GetRelativeChange() * 100.0;
+        const bool isRegression = change > maxRegression;
+        if (isRegression)
+            ++numRegressions;
+
+        std::cout << (isRegression ? "REGRESSION " : "           ") << comparison.name_.c_str() << ": "
+                  << comparison.baselineMean_ << " ns -> " << comparison.currentMean_ << " ns (" << (change >= 0.0 ? "+" : "")
+                  << change << "%)" << std::endl;
+    }
+    return numRegressions;
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    std::string jsonOutput;
+    std::string baseline;
+    double maxRegression = 10.0;
+
+    Catch::Session session;
+
+    using namespace Catch::Clara;
+    auto cli = session.cli()
+        | Opt(jsonOutput, "file")["--json-output"]("write benchmark results to JSON file")
+        | Opt(baseline, "file")["--baseline"]("compare benchmark results with JSON file written by --json-output")
+        | Opt(maxRegression, "percent")["--max-regression"]("max allowed slowdown relative to baseline, 10% by default");
+    session.cli(cli);
+
+    if (const int result = session.applyCommandLine(argc, argv))
+        return result;
+
+    int result = session.run();
+    Tests::ResetContext();
+
+    if (jsonOutput.empty() && baseline.empty())
+        return result;
+
+    // Test context is destroyed at this point, create a new one for file IO.
+    auto context = MakeShared<Context>();
+    const ea::vector<Benchmarks::BenchmarkResult>& results = Benchmarks::GetBenchmarkResults();
+
+    if (!jsonOutput.empty() && !SaveResults(context, jsonOutput.c_str(), results))
+    {
+        std::cerr << "Failed to write benchmark results to " << jsonOutput << std::endl;
+        result = EXIT_FAILURE;
+    }
+
+    if (!baseline.empty())
+    {
+        ea::vector<Benchmarks::BenchmarkResult> baselineResults;
+        if (!LoadResults(context, baseline.c_str(), baselineResults))
+        {
+            std::cerr << "Failed to read benchmark baseline from " << baseline << std::endl;
+            result = EXIT_FAILURE;
+        }
+        else
+        {
+            const auto comparisons = Benchmarks::CompareBenchmarkResults(baselineResults, results);
+            if (ReportComparison(comparisons, maxRegression) > 0)
+                result = EXIT_FAILURE;
+        }
+    }
+
+    return result;
+}
@@ -0,0 +1,110 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../../CommonUtils.h"
+
+#include <Urho3D/Math/BatchMath.h>
+#include <Urho3D/Math/RandomEngine.h>
+
+namespace
+{
+
+const unsigned numElements = 4096;
+
+const char* GetInstructionSetName(BatchMathInstructionSet instructionSet)
+{
+    switch (instructionSet)
+    {
+    case BatchMathInstructionSet::AVX2: return "AVX2";
+    case BatchMathInstructionSet::NEON: return "NEON";
+    default: return "Generic";
+    }
+}
+
+} // namespace
+
+TEST_CASE("Batch math operations")
+{
+    RandomEngine random{0u};
+
+    ea::vector<Matrix3x4> transforms;
+    ea::vector<Vector3> points;
+    ea::vector<BoundingBox> boxes;
+    for (unsigned i = 0; i < numElements; ++i)
+    {
+        transforms.emplace_back(random.GetVector3(-Vector3::ONE * 10.0f, Vector3::ONE * 10.0f),
+            random.GetQuaternion(), random.GetVector3(Vector3::ONE * 0.5f, Vector3::ONE * 2.0f));
+        points.push_back(random.GetVector3(-Vector3::ONE * 10.0f, Vector3::ONE * 10.0f));
+        const Vector3 center = random.GetVector3(-Vector3::ONE * 100.0f, Vector3::ONE * 100.0f);
+        boxes.emplace_back(center - Vector3::ONE, center + Vector3::ONE);
+    }
+
+    Frustum frustum;
+    frustum.Define(60.0f, 1.5f, 1.0f, 0.1f, 100.0f);
+
+    ea::vector<Vector3> resultPoints(numElements);
+    ea::vector<Matrix3x4> resultTransforms(numElements);
+    ea::vector<BoundingBox> resultBoxes(numElements);
+    ea::vector<bool> resultVisible(numElements);
+
+    const BatchMathInstructionSet defaultInstructionSet = GetBatchMathInstructionSet();
+    for (const BatchMathInstructionSet instructionSet :
+        {BatchMathInstructionSet::Generic, BatchMathInstructionSet::AVX2, BatchMathInstructionSet::NEON})
+    {
+        if (!IsBatchMathInstructionSetSupported(instructionSet))
+            continue;
+
+        SetBatchMathInstructionSet(instructionSet);
+        const ea::string suffix = Format(" ({})", GetInstructionSetName(instructionSet));
+
+        BENCHMARK(("Transform 4096 points" + suffix).c_str())
+        {
+            TransformPoints(transforms[0], points.data(), resultPoints.data(), numElements);
+            return resultPoints.back();
+        };
+
+        BENCHMARK(("Multiply 4096 matrices" + suffix).c_str())
+        {
+            MultiplyMatrices(transforms.data(), transforms.data(), resultTransforms.data(), numElements);
+            return resultTransforms.back();
+        };
+
+        BENCHMARK(("Transform 4096 bounding boxes" + suffix).c_str())
+        {
+            TransformBoundingBoxes(transforms.data(), boxes.data(), resultBoxes.data(), numElements);
+            return resultBoxes.back();
+        };
+
+        BENCHMARK(("Merge 4096 bounding boxes" + suffix).c_str())
+        {
+            return MergeBoundingBoxes(boxes.data(), numElements);
+        };
+
+        BENCHMARK(("Test 4096 bounding boxes in frustum" + suffix).c_str())
+        {
+            TestBoundingBoxesInFrustum(frustum, boxes.data(), resultVisible.data(), numElements);
+            return resultVisible.back();
+        };
+    }
+    SetBatchMathInstructionSet(defaultInstructionSet);
+}
@@ -0,0 +1,79 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../../CommonUtils.h"
+
+#include <Urho3D/Container/InternedString.h>
+#include <Urho3D/Math/StringHash.h>
+
+TEST_CASE("StringHash calculation")
+{
+    const ea::string shortString = "Position";
+    const ea::string longString = "Urho3D/Models/Characters/Mutant/Mutant_Idle0.ani";
+
+    BENCHMARK("Short string")
+    {
+        return StringHash{shortString};
+    };
+
+    BENCHMARK("Long string")
+    {
+        return StringHash{longString};
+    };
+
+    BENCHMARK("C string literal")
+    {
+        return StringHash{"Position"};
+    };
+
+    BENCHMARK("Raw data")
+    {
+        return StringHash::Calculate(longString.data(), longString.size());
+    };
+
+    BENCHMARK("Compile-time literal")
+    {
+        return "Position"_sh;
+    };
+}
+
+TEST_CASE("InternedString operations")
+{
+    const ea::string longString = "Urho3D/Models/Characters/Mutant/Mutant_Idle0.ani";
+    const InternedString internedString{longString};
+
+    BENCHMARK("Intern existing string")
+    {
+        return InternedString{longString};
+    };
+
+    BENCHMARK("Compare interned strings")
+    {
+        return InternedString{longString} == internedString;
+    };
+
+    BENCHMARK("Copy ea::string")
+    {
+        return ea::string{longString};
+    };
+}
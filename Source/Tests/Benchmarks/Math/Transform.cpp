@@ -0,0 +1,139 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../../CommonUtils.h"
+
+#include <Urho3D/Math/Matrix3x4.h>
+#include <Urho3D/Math/Quaternion.h>
+#include <Urho3D/Math/RandomEngine.h>
+
+namespace
+{
+
+const unsigned numTransforms = 1024;
+
+ea::vector<Matrix3x4> CreateRandomTransforms(RandomEngine& random)
+{
+    ea::vector<Matrix3x4> result;
+    for (unsigned i = 0; i < numTransforms; ++i)
+        result.emplace_back(random.GetVector3({-10.0f, -10.0f, -10.0f}, {10.0f, 10.0f, 10.0f}),
+            random.GetQuaternion(), random.GetVector3(Vector3::ONE * 0.5f, Vector3::ONE * 2.0f));
+    return result;
+}
+
+} // namespace
+
+TEST_CASE("Matrix3x4 operations")
+{
+    RandomEngine random{0u};
+    const auto transforms = CreateRandomTransforms(random);
+    const auto points = [&]
+    {
+        ea::vector<Vector3> result;
+        for (unsigned i = 0; i < numTransforms; ++i)
+            result.push_back(random.GetVector3({-10.0f, -10.0f, -10.0f}, {10.0f, 10.0f, 10.0f}));
+        return result;
+    }();
+
+    BENCHMARK("Multiply 1024 matrices")
+    {
+        Matrix3x4 result = Matrix3x4::IDENTITY;
+        for (const Matrix3x4& transform : transforms)
+            result = transform * result;
+        return result;
+    };
+
+    BENCHMARK("Transform 1024 points")
+    {
+        Vector3 result = Vector3::ZERO;
+        for (unsigned i = 0; i < numTransforms; ++i)
+            result += transforms[i] * points[i];
+        return result;
+    };
+
+    BENCHMARK("Inverse 1024 matrices")
+    {
+        Matrix3x4 result = Matrix3x4::ZERO;
+        for (const Matrix3x4& transform : transforms)
+            result = result + transform.Inverse();
+        return result;
+    };
+
+    BENCHMARK("Decompose 1024 matrices")
+    {
+        Vector3 translation;
+        Quaternion rotation;
+        Vector3 scale;
+        Vector3 result = Vector3::ZERO;
+        for (const Matrix3x4& transform : transforms)
+        {
+            transform.Decompose(translation, rotation, scale);
+            result += translation + scale;
+        }
+        return result;
+    };
+}
+
+TEST_CASE("Quaternion operations")
+{
+    RandomEngine random{0u};
+    const auto rotations = [&]
+    {
+        ea::vector<Quaternion> result;
+        for (unsigned i = 0; i < numTransforms; ++i)
+            result.push_back(random.GetQuaternion());
+        return result;
+    }();
+
+    BENCHMARK("Multiply 1024 quaternions")
+    {
+        Quaternion result = Quaternion::IDENTITY;
+        for (const Quaternion& rotation : rotations)
+            result = (rotation * result).Normalized();
+        return result;
+    };
+
+    BENCHMARK("Rotate 1024 vectors")
+    {
+        Vector3 result = Vector3::ONE;
+        for (const Quaternion& rotation : rotations)
+            result = rotation * result;
+        return result;
+    };
+
+    BENCHMARK("Slerp 1024 quaternions")
+    {
+        Quaternion result = Quaternion::IDENTITY;
+        for (const Quaternion& rotation : rotations)
+            result = result.Slerp(rotation, 0.25f);
+        return result;
+    };
+
+    BENCHMARK("Convert 1024 quaternions to matrices")
+    {
+        Matrix3 result = Matrix3::ZERO;
+        for (const Quaternion& rotation : rotations)
+            result = result + rotation.RotationMatrix();
+        return result;
+    };
+}
@@ -0,0 +1,255 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../../CommonUtils.h"
+#include "../../ModelUtils.h"
+
+#include <Urho3D/Core/CoreEvents.h>
+#include <Urho3D/Core/Timer.h>
+#include <Urho3D/Graphics/AnimatedModel.h>
+#include <Urho3D/Graphics/AnimationController.h>
+#include <Urho3D/Graphics/Model.h>
+#include <Urho3D/Graphics/Octree.h>
+#include <Urho3D/Graphics/StaticModel.h>
+#include <Urho3D/Math/RandomEngine.h>
+#include <Urho3D/Resource/ResourceCache.h>
+#include <Urho3D/Scene/LogicComponent.h>
+#include <Urho3D/Scene/LogicComponentScheduler.h>
+#include <Urho3D/Scene/Scene.h>
+#include <Urho3D/Scene/SceneEvents.h>
+#if URHO3D_PHYSICS
+    #include <Urho3D/Physics/CollisionShape.h>
+    #include <Urho3D/Physics/PhysicsWorld.h>
+    #include <Urho3D/Physics/RigidBody.h>
+#endif
+
+namespace
+{
+
+/// Simple game logic that moves node around the origin.
+class BenchmarkLogicComponent : public LogicComponent
+{
+    URHO3D_OBJECT(BenchmarkLogicComponent, LogicComponent);
+
+public:
+    explicit BenchmarkLogicComponent(Context* context)
+        : LogicComponent(context)
+    {
+        SetUpdateEventMask(USE_UPDATE | USE_POSTUPDATE);
+    }
+
+    void Update(float timeStep) override
+    {
+        time_ += timeStep;
+        node_->SetPosition(origin_ + Vector3{Cos(time_ * 90.0f), 0.0f, Sin(time_ * 90.0f)});
+    }
+
+    void PostUpdate(float timeStep) override { node_->Rotate(Quaternion{timeStep * 45.0f, Vector3::UP}); }
+
+    Vector3 origin_;
+    float time_{};
+};
+
+/// Share of each node kind in the benchmark scene, remaining nodes are empty.
+struct SceneComposition
+{
+    float staticModels_{0.4f};
+    float animatedModels_{0.1f};
+    float rigidBodies_{0.2f};
+    float logicComponents_{0.2f};
+};
+
+/// Number of nodes grouped under one parent node.
+const unsigned nodesPerGroup = 1000;
+const float timeStep = 1.0f / 60.0f;
+
+SharedPtr<Model> CreateBenchmarkSkinnedModel(Context* context)
+{
+    return Tests::CreateSkinnedQuad_Model(context)->ExportModel();
+}
+
+SharedPtr<Animation> CreateBenchmarkAnimation(Context* context)
+{
+    return Tests::CreateLoopedRotationAnimation(context, "", "Quad 1", Vector3::UP, 2.0f);
+}
+
+/// Create scene with given number of nodes scattered over square area.
+SharedPtr<Scene> CreateBenchmarkScene(Context* context, unsigned numNodes, const SceneComposition& composition)
+{
+    auto cache = context->GetSubsystem<ResourceCache>();
+    auto staticModel = cache->GetResource<Model>("Models/Box.mdl");
+    auto skinnedModel = Tests::GetOrCreateResource<Model>(
+        context, "@/Benchmarks/SceneUpdate/SkinnedModel.mdl", CreateBenchmarkSkinnedModel);
+    auto animation = Tests::GetOrCreateResource<Animation>(
+        context, "@/Benchmarks/SceneUpdate/Rotation.ani", CreateBenchmarkAnimation);
+
+    auto scene = MakeShared<Scene>(context);
+    scene->CreateComponent<Octree>();
+#if URHO3D_PHYSICS
+    scene->CreateComponent<PhysicsWorld>();
+#endif
+
+    const unsigned numStaticModels = static_cast<unsigned>(numNodes * composition.staticModels_);
+    const unsigned numAnimatedModels = static_cast<unsigned>(numNodes * composition.animatedModels_);
+    const unsigned numRigidBodies = static_cast<unsigned>(numNodes * composition.rigidBodies_);
+    const unsigned numLogicComponents = static_cast<unsigned>(numNodes * composition.logicComponents_);
+
+    const float areaSize = Sqrt(static_cast<float>(numNodes)) * 2.0f;
+    RandomEngine random{0u};
+
+    Node* group = nullptr;
+    for (unsigned i = 0; i < numNodes; ++i)
+    {
+        if (i % nodesPerGroup == 0)
+            group = scene->CreateChild("Group");
+
+        const Vector3 position = random.GetVector3({0.0f, 0.0f, 0.0f}, {areaSize, 10.0f, areaSize});
+        Node* node = group->CreateChild("Node");
+        node->SetPosition(position);
+
+        unsigned index = i;
+        if (index < numStaticModels)
+        {
+            node->CreateComponent<StaticModel>()->SetModel(staticModel);
+            continue;
+        }
+
+        index -= numStaticModels;
+        if (index < numAnimatedModels)
+        {
+            node->CreateComponent<AnimatedModel>()->SetModel(skinnedModel);
+            auto animationController = node->CreateComponent<AnimationController>();
+            animationController->PlayNew(AnimationParameters{animation}.Looped().Time(random.GetFloat(0.0f, 2.0f)));
+            continue;
+        }
+
+        index -= numAnimatedModels;
+        if (index < numRigidBodies)
+        {
+            node->CreateComponent<StaticModel>()->SetModel(staticModel);
+#if URHO3D_PHYSICS
+            node->CreateComponent<CollisionShape>()->SetBox(Vector3::ONE);
+            auto rigidBody = node->CreateComponent<RigidBody>();
+            rigidBody->SetMass(1.0f);
+            rigidBody->SetUseGravity(false);
+            rigidBody->SetLinearVelocity(random.GetDirectionVector3());
+#endif
+            continue;
+        }
+
+        index -= numRigidBodies;
+        if (index < numLogicComponents)
+        {
+            node->CreateComponent<StaticModel>()->SetModel(staticModel);
+            node->CreateComponent<BenchmarkLogicComponent>()->origin_ = position;
+            continue;
+        }
+    }
+
+    return scene;
+}
+
+/// Measure duration of each stage of the frame separately.
+void BenchmarkSceneUpdate(Context* context, unsigned numNodes)
+{
+    auto scene = CreateBenchmarkScene(context, numNodes, SceneComposition{});
+    auto octree = scene->GetComponent<Octree>();
+
+    // Let everything initialize and get inserted into the octree
+    Tests::RunFrame(context, timeStep);
+
+    ea::vector<AnimationController*> animationControllers;
+    scene->GetComponents<AnimationController>(animationControllers, true);
+
+    FrameInfo frameInfo;
+    frameInfo.scene_ = scene;
+    frameInfo.timeStep_ = timeStep;
+
+    BENCHMARK("Whole frame")
+    {
+        Tests::RunFrame(context, timeStep);
+    };
+
+    BENCHMARK("Scene::Update")
+    {
+        scene->Update(timeStep);
+        // Consume queued drawable updates so they don't pile up between samples
+        octree->Update(frameInfo);
+    };
+
+    LogicComponentScheduler* scheduler = scene->GetLogicComponentScheduler();
+    BENCHMARK("LogicComponent updates")
+    {
+        scheduler->Update(LogicUpdatePhase::Update, timeStep);
+    };
+
+    BENCHMARK("AnimationController updates")
+    {
+        for (AnimationController* animationController : animationControllers)
+            animationController->Update(timeStep);
+    };
+
+#if URHO3D_PHYSICS
+    auto physicsWorld = scene->GetComponent<PhysicsWorld>();
+    BENCHMARK("PhysicsWorld::Update")
+    {
+        physicsWorld->Update(timeStep);
+    };
+#endif
+
+    BENCHMARK_ADVANCED("Octree::Update")(Catch::Benchmark::Chronometer meter)
+    {
+        // Move everything so every drawable needs reinsertion
+        meter.measure([&](int i)
+        {
+            ++frameInfo.frameNumber_;
+            for (Node* group : scene->GetChildren())
+                group->Translate(Vector3::RIGHT * (i % 2 == 0 ? 0.01f : -0.01f));
+            octree->Update(frameInfo);
+        });
+    };
+}
+
+} // namespace
+
+TEST_CASE("Headless scene update")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    const auto guard = Tests::MakeScopedReflection<BenchmarkLogicComponent>(context);
+
+    for (unsigned numNodes : {1000, 10000, 100000})
+    {
+        DYNAMIC_SECTION("Nodes: " << numNodes)
+        {
+            BenchmarkSceneUpdate(context, numNodes);
+        }
+    }
+}
+
+TEST_CASE("Headless scene update with 1M nodes", "[.][large]")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    const auto guard = Tests::MakeScopedReflection<BenchmarkLogicComponent>(context);
+
+    BenchmarkSceneUpdate(context, 1000000);
+}
@@ -0,0 +1,91 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../../CommonUtils.h"
+
+#include <Urho3D/Scene/Scene.h>
+
+namespace
+{
+
+/// Create scene with 1000 root nodes, each with 10 children and 10 grandchildren per child.
+ea::vector<Node*> CreateHierarchy(Scene* scene)
+{
+    ea::vector<Node*> rootNodes;
+    for (unsigned i = 0; i < 1000; ++i)
+    {
+        Node* node = scene->CreateChild();
+        node->SetPosition({static_cast<float>(i), 0.0f, 0.0f});
+        rootNodes.push_back(node);
+
+        for (unsigned j = 0; j < 10; ++j)
+        {
+            Node* child = node->CreateChild();
+            child->SetPosition({0.0f, static_cast<float>(j), 0.0f});
+            for (unsigned k = 0; k < 10; ++k)
+                child->CreateChild()->SetPosition({0.0f, 0.0f, static_cast<float>(k)});
+        }
+    }
+    return rootNodes;
+}
+
+}
+
+TEST_CASE("Node world transform update")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto scene = MakeShared<Scene>(context);
+    const ea::vector<Node*> rootNodes = CreateHierarchy(scene);
+
+    ea::vector<Node*> allNodes;
+    scene->GetChildren(allNodes, true);
+
+    const auto moveRootNodes = [&](int i)
+    {
+        const Vector3 offset = Vector3::UP * (i % 2 == 0 ? 0.01f : -0.01f);
+        for (Node* node : rootNodes)
+            node->Translate(offset);
+    };
+
+    BENCHMARK_ADVANCED("Update on demand")(Catch::Benchmark::Chronometer meter)
+    {
+        meter.measure([&](int i)
+        {
+            moveRootNodes(i);
+            for (Node* node : allNodes)
+                node->GetWorldTransform();
+        });
+    };
+
+    scene->SetTransformStoreEnabled(true);
+    scene->UpdateTransforms();
+
+    BENCHMARK_ADVANCED("Update via transform store")(Catch::Benchmark::Chronometer meter)
+    {
+        meter.measure([&](int i)
+        {
+            moveRootNodes(i);
+            scene->UpdateTransforms();
+        });
+    };
+}
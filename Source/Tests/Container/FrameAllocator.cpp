@@ -0,0 +1,119 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../CommonUtils.h"
+
+#include <Urho3D/Container/LinearArena.h>
+#include <Urho3D/Core/FrameAllocator.h>
+
+#include <EASTL/numeric_limits.h>
+
+#include <new>
+
+TEST_CASE("LinearArena allocates aligned memory and merges blocks on reset")
+{
+    LinearArena allocator(1024);
+
+    const auto ptr1 = reinterpret_cast<uintptr_t>(allocator.Allocate(3, 1));
+    const auto ptr2 = reinterpret_cast<uintptr_t>(allocator.Allocate(8, 64));
+    REQUIRE(ptr2 % 64 == 0);
+    REQUIRE(ptr2 > ptr1);
+    REQUIRE(allocator.GetAllocatedSize() == 11);
+    REQUIRE(allocator.GetNumBlocks() == 1);
+
+    // Big allocation gets its own block
+    allocator.Allocate(4000);
+    REQUIRE(allocator.GetNumBlocks() == 2);
+
+    allocator.Reset();
+    REQUIRE(allocator.GetAllocatedSize() == 0);
+    REQUIRE(allocator.GetNumBlocks() == 1);
+
+    const unsigned capacity = allocator.GetCapacity();
+    REQUIRE(capacity >= 1024 + 4000);
+
+    // Same workload fits into merged block
+    allocator.Allocate(3, 1);
+    allocator.Allocate(8, 64);
+    allocator.Allocate(4000);
+    REQUIRE(allocator.GetNumBlocks() == 1);
+    REQUIRE(allocator.GetCapacity() == capacity);
+}
+
+TEST_CASE("FrameAllocator is usable with EASTL containers")
+{
+    FrameAllocator::BeginFrame();
+
+    {
+        FrameVector<unsigned> vector;
+        for (unsigned i = 0; i < 1000; ++i)
+            vector.push_back(i);
+
+        FrameHashMap<unsigned, unsigned> map;
+        for (unsigned i = 0; i < 1000; ++i)
+            map.emplace(i, i * 2);
+
+        for (unsigned i = 0; i < 1000; ++i)
+        {
+            REQUIRE(vector[i] == i);
+            REQUIRE(map[i] == i * 2);
+        }
+    }
+
+    // Memory is reused in the next frame, containers of the previous frame should be destroyed by now
+    FrameAllocator::BeginFrame();
+
+    {
+        FrameVector<unsigned> vector(1000, 1u);
+        REQUIRE(vector.size() == 1000);
+        REQUIRE(vector.back() == 1u);
+    }
+}
+
+TEST_CASE("LinearArena rejects allocations that overflow")
+{
+    LinearArena allocator(1024);
+    REQUIRE_THROWS_AS(allocator.Allocate(ea::numeric_limits<unsigned>::max() - 8, 16), std::bad_alloc);
+    REQUIRE(allocator.GetNumBlocks() == 1);
+}
+
+TEST_CASE("FrameAllocator keeps memory of containers that outlive the frame")
+{
+    FrameAllocator::BeginFrame();
+
+    FrameVector<unsigned> persistentVector;
+    for (unsigned i = 0; i < 1000; ++i)
+        persistentVector.push_back(i);
+
+    for (unsigned frame = 0; frame < 3; ++frame)
+    {
+        FrameAllocator::BeginFrame();
+
+        // New allocations should not overwrite memory that is still in use
+        FrameVector<unsigned> vector(1000, 0xffffffffu);
+        for (unsigned i = 0; i < 1000; ++i)
+            REQUIRE(persistentVector[i] == i);
+    }
+
+    REQUIRE_THROWS_AS(FrameAllocator::Allocate(ea::numeric_limits<unsigned>::max()), std::bad_alloc);
+}
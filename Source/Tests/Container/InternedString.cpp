@@ -0,0 +1,82 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../CommonUtils.h"
+
+#include <Urho3D/Container/InternedString.h>
+
+#include <EASTL/vector.h>
+
+#include <thread>
+
+TEST_CASE("InternedString shares storage of equal strings")
+{
+    const InternedString first{"Models/Box.mdl"};
+    const InternedString second{ea::string{"Models/Box.mdl"}};
+    const InternedString third{"Models/Sphere.mdl"};
+
+    CHECK(first == second);
+    CHECK(first.c_str() == second.c_str());
+    CHECK(first != third);
+
+    CHECK(first == "Models/Box.mdl");
+    CHECK(first.length() == 14);
+    CHECK(first.GetHash() == StringHash{"Models/Box.mdl"});
+    CHECK(first.ToString() == "Models/Box.mdl");
+
+    const unsigned numStrings = InternedString::GetNumStrings();
+    const InternedString fourth{"Models/Sphere.mdl"};
+    CHECK(fourth == third);
+    CHECK(InternedString::GetNumStrings() == numStrings);
+}
+
+TEST_CASE("InternedString is empty by default")
+{
+    const InternedString empty;
+    CHECK(empty.empty());
+    CHECK(empty == InternedString{""});
+    CHECK(empty.GetHash() == StringHash::Empty);
+    CHECK(ea::string_view{empty.c_str()}.empty());
+}
+
+TEST_CASE("InternedString can be used from multiple threads")
+{
+    const unsigned numThreads = 4;
+    const unsigned numStrings = 1000;
+
+    ea::vector<ea::vector<InternedString>> results(numThreads);
+    ea::vector<std::thread> threads;
+    for (unsigned threadIndex = 0; threadIndex < numThreads; ++threadIndex)
+    {
+        threads.emplace_back([&, threadIndex]
+        {
+            for (unsigned i = 0; i < numStrings; ++i)
+                results[threadIndex].emplace_back(Format("Threaded/{}", i));
+        });
+    }
+    for (std::thread& thread : threads)
+        thread.join();
+
+    for (unsigned threadIndex = 1; threadIndex < numThreads; ++threadIndex)
+        CHECK(results[threadIndex] == results[0]);
+}
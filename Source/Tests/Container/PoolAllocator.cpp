@@ -0,0 +1,117 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../CommonUtils.h"
+
+#include <Urho3D/Core/PoolAllocator.h>
+#include <Urho3D/Core/Variant.h>
+
+#include <EASTL/algorithm.h>
+#include <EASTL/vector.h>
+
+#include <thread>
+
+TEST_CASE("PoolAllocator reuses freed blocks")
+{
+    void* ptr1 = PoolAllocator::Allocate(40);
+    void* ptr2 = PoolAllocator::Allocate(48);
+    REQUIRE(reinterpret_cast<uintptr_t>(ptr1) % PoolAllocator::Granularity == 0);
+    REQUIRE(reinterpret_cast<uintptr_t>(ptr2) % PoolAllocator::Granularity == 0);
+    REQUIRE(ptr1 != ptr2);
+
+    // Blocks of the same size class are reused
+    PoolAllocator::Deallocate(ptr1, 40);
+    REQUIRE(PoolAllocator::Allocate(33) == ptr1);
+
+    // Big blocks are allocated on the heap
+    void* bigPtr = PoolAllocator::Allocate(PoolAllocator::MaxPooledSize + 1);
+    PoolAllocator::Deallocate(bigPtr, PoolAllocator::MaxPooledSize + 1);
+
+    PoolAllocator::Deallocate(ptr1, 33);
+    PoolAllocator::Deallocate(ptr2, 48);
+}
+
+TEST_CASE("PoolAllocator blocks can be freed on another thread")
+{
+    ea::vector<void*> blocks;
+    for (unsigned i = 0; i < 1000; ++i)
+        blocks.push_back(PoolAllocator::Allocate(64));
+
+    std::thread thread([&]
+    {
+        for (void* block : blocks)
+            PoolAllocator::Deallocate(block, 64);
+        for (void*& block : blocks)
+            block = PoolAllocator::Allocate(64);
+    });
+    thread.join();
+
+    for (void* block : blocks)
+        PoolAllocator::Deallocate(block, 64);
+}
+
+TEST_CASE("PoolAllocator returns blocks freed on another thread to the owner thread")
+{
+    // Use new thread so the pool is empty
+    unsigned numReusedBlocks = 0;
+    std::thread ownerThread([&]
+    {
+        ea::vector<void*> blocks;
+        for (unsigned i = 0; i < 1000; ++i)
+            blocks.push_back(PoolAllocator::Allocate(64));
+        const ea::vector<void*> originalBlocks = blocks;
+
+        std::thread([&] { for (void* block : blocks) PoolAllocator::Deallocate(block, 64); }).join();
+
+        for (void*& block : blocks)
+        {
+            block = PoolAllocator::Allocate(64);
+            if (ea::find(originalBlocks.begin(), originalBlocks.end(), block) != originalBlocks.end())
+                ++numReusedBlocks;
+        }
+
+        for (void* block : blocks)
+            PoolAllocator::Deallocate(block, 64);
+    });
+    ownerThread.join();
+
+    CHECK(numReusedBlocks == 1000);
+}
+
+TEST_CASE("VariantMap with pooled nodes behaves as regular map")
+{
+    VariantMap map;
+    map["A"] = 1;
+    map["B"] = ea::string{"Value"};
+    map.clear();
+
+    map["A"] = 2;
+    CHECK(map.size() == 1);
+    CHECK(map["A"].GetInt() == 2);
+
+    VariantMap copy = map;
+    CHECK(copy == map);
+
+    const Variant variant = ea::move(copy);
+    CHECK(variant.GetVariantMap() == map);
+}
@@ -74,3 +74,28 @@ TEST_CASE("Variant is move-assigned")
         REQUIRE(value.GetCustomPtr<TestLargeObject>()->c_ == "12345678901234567890");
     }
 }
+
+TEST_CASE("Variant takes ownership of moved values")
+{
+    ea::string string{"12345678901234567890"};
+    const char* stringData = string.data();
+    Variant stringValue{ea::move(string)};
+    REQUIRE(stringValue.GetString().data() == stringData);
+
+    VariantVector vector{Variant{1}, Variant{2}};
+    const Variant* vectorData = vector.data();
+    Variant vectorValue;
+    vectorValue = ea::move(vector);
+    REQUIRE(vectorValue.GetVariantVector().data() == vectorData);
+
+    VariantMap map;
+    map["Key"] = 1;
+    const Variant* mapValue = &map["Key"];
+    Variant mapVariant{ea::move(map)};
+    REQUIRE(&mapVariant.GetVariantMap().find("Key")->second == mapValue);
+
+    StringVector strings{"12345678901234567890"};
+    const ea::string* stringsData = strings.data();
+    Variant stringsValue{ea::move(strings)};
+    REQUIRE(stringsValue.GetStringVector().data() == stringsData);
+}
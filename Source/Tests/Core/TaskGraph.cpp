@@ -0,0 +1,112 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../CommonUtils.h"
+
+#include <Urho3D/Core/TaskGraph.h>
+
+#include <atomic>
+
+TEST_CASE("TaskGraph executes tasks after their dependencies")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto workQueue = context->GetSubsystem<WorkQueue>();
+
+    static constexpr unsigned numElements = 10000;
+    ea::vector<unsigned> values(numElements);
+    std::atomic<unsigned> sum{};
+    std::atomic<bool> mismatch{};
+    unsigned total{};
+
+    TaskGraph taskGraph(workQueue);
+    const auto fillTask = taskGraph.AddParallelTask(numElements,
+        [&](unsigned beginIndex, unsigned endIndex)
+    {
+        for (unsigned i = beginIndex; i < endIndex; ++i)
+            values[i] = i;
+    });
+    const auto sumTask = taskGraph.AddForEachTask(values,
+        [&](unsigned index, unsigned value)
+    {
+        if (index != value)
+            mismatch = true;
+        sum.fetch_add(value, std::memory_order_relaxed);
+    }, {fillTask});
+    taskGraph.AddTask([&] { total = sum.load(std::memory_order_relaxed); }, {sumTask});
+
+    const unsigned expectedTotal = numElements * (numElements - 1) / 2;
+
+    taskGraph.Execute();
+    REQUIRE_FALSE(mismatch);
+    REQUIRE(total == expectedTotal);
+
+    // Graph can be executed again
+    sum = 0;
+    total = 0;
+    taskGraph.Execute();
+    REQUIRE(total == expectedTotal);
+}
+
+TEST_CASE("TaskGraph executes independent chains of tasks")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto workQueue = context->GetSubsystem<WorkQueue>();
+
+    static constexpr unsigned numChains = 8;
+    static constexpr unsigned chainLength = 16;
+    ea::vector<unsigned> counters(numChains);
+    ea::vector<unsigned char> failed(numChains);
+
+    TaskGraph taskGraph(workQueue);
+    ea::vector<TaskGraph::TaskId> lastTasks;
+    for (unsigned chainIndex = 0; chainIndex < numChains; ++chainIndex)
+    {
+        TaskGraph::TaskId previousTask{};
+        for (unsigned step = 0; step < chainLength; ++step)
+        {
+            auto task = [&counters, &failed, chainIndex, step]
+            {
+                if (counters[chainIndex] != step)
+                    failed[chainIndex] = true;
+                ++counters[chainIndex];
+            };
+            previousTask = step == 0 ? taskGraph.AddTask(task) : taskGraph.AddTask(task, {previousTask});
+        }
+        lastTasks.push_back(previousTask);
+    }
+
+    unsigned numFinished = 0;
+    const auto finalTask = taskGraph.AddTask([&]
+    {
+        for (unsigned chainIndex = 0; chainIndex < numChains; ++chainIndex)
+            numFinished += counters[chainIndex] == chainLength;
+    });
+    for (TaskGraph::TaskId task : lastTasks)
+        taskGraph.AddDependency(finalTask, task);
+
+    taskGraph.Execute();
+
+    REQUIRE(numFinished == numChains);
+    for (unsigned chainIndex = 0; chainIndex < numChains; ++chainIndex)
+        REQUIRE_FALSE(failed[chainIndex]);
+}
@@ -0,0 +1,222 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../CommonUtils.h"
+
+#include <Urho3D/Core/Context.h>
+#include <Urho3D/Core/Object.h>
+
+namespace
+{
+
+URHO3D_EVENT(E_TESTTYPEDEVENT, TestTypedEvent)
+{
+    URHO3D_PARAM(P_VALUE, Value);
+}
+
+struct TestTypedEventData
+{
+    int value_{};
+
+    void ToVariantMap(VariantMap& eventData) const { eventData[TestTypedEvent::P_VALUE] = value_; }
+    static TestTypedEventData FromVariantMap(const VariantMap& eventData)
+    {
+        const auto iter = eventData.find(TestTypedEvent::P_VALUE);
+        return {iter != eventData.end() ? iter->second.GetInt() : 0};
+    }
+};
+
+class TestTypedEventObject : public Object
+{
+    URHO3D_OBJECT(TestTypedEventObject, Object);
+
+public:
+    explicit TestTypedEventObject(Context* context)
+        : Object(context)
+    {
+    }
+};
+
+} // namespace
+
+TEST_CASE("Typed events are delivered to specific and non-specific subscribers")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto sender = MakeShared<TestTypedEventObject>(context);
+    auto otherSender = MakeShared<TestTypedEventObject>(context);
+    auto receiver = MakeShared<TestTypedEventObject>(context);
+
+    ea::vector<ea::string> log;
+    receiver->SubscribeToTypedEvent<TestTypedEventData>(sender, E_TESTTYPEDEVENT,
+        [&](const TestTypedEventData& eventData) { log.push_back(Format("specific {}", eventData.value_)); });
+
+    auto anyReceiver = MakeShared<TestTypedEventObject>(context);
+    anyReceiver->SubscribeToTypedEvent<TestTypedEventData>(E_TESTTYPEDEVENT,
+        [&](const TestTypedEventData& eventData) { log.push_back(Format("any {}", eventData.value_)); });
+
+    sender->SendTypedEvent(E_TESTTYPEDEVENT, TestTypedEventData{1});
+    otherSender->SendTypedEvent(E_TESTTYPEDEVENT, TestTypedEventData{2});
+    REQUIRE(log == ea::vector<ea::string>{"specific 1", "any 1", "any 2"});
+
+    // Receiver subscribed both ways gets the event only once
+    log.clear();
+    receiver->SubscribeToTypedEvent<TestTypedEventData>(E_TESTTYPEDEVENT,
+        [&](const TestTypedEventData& eventData) { log.push_back(Format("receiver any {}", eventData.value_)); });
+    sender->SendTypedEvent(E_TESTTYPEDEVENT, TestTypedEventData{3});
+    REQUIRE(log == ea::vector<ea::string>{"specific 3", "any 3"});
+
+    log.clear();
+    receiver->UnsubscribeFromTypedEvent(sender, E_TESTTYPEDEVENT);
+    receiver->UnsubscribeFromTypedEvent(nullptr, E_TESTTYPEDEVENT);
+    anyReceiver = nullptr;
+    sender->SendTypedEvent(E_TESTTYPEDEVENT, TestTypedEventData{4});
+    REQUIRE(log.empty());
+}
+
+TEST_CASE("Typed and regular subscribers share subscription order")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto sender = MakeShared<TestTypedEventObject>(context);
+    auto typedReceiver = MakeShared<TestTypedEventObject>(context);
+    auto regularReceiver = MakeShared<TestTypedEventObject>(context);
+    auto otherTypedReceiver = MakeShared<TestTypedEventObject>(context);
+
+    ea::vector<ea::string> log;
+    typedReceiver->SubscribeToTypedEvent<TestTypedEventData>(sender, E_TESTTYPEDEVENT,
+        [&](const TestTypedEventData& eventData) { log.push_back(Format("typed {}", eventData.value_)); });
+    regularReceiver->SubscribeToEvent(sender, E_TESTTYPEDEVENT,
+        [&](VariantMap& eventData) { log.push_back(Format("regular {}", eventData[TestTypedEvent::P_VALUE].GetInt())); });
+    otherTypedReceiver->SubscribeToTypedEvent<TestTypedEventData>(E_TESTTYPEDEVENT,
+        [&](const TestTypedEventData& eventData) { log.push_back(Format("other typed {}", eventData.value_)); });
+
+    sender->SendTypedEvent(E_TESTTYPEDEVENT, TestTypedEventData{5});
+    REQUIRE(log == ea::vector<ea::string>{"typed 5", "regular 5", "other typed 5"});
+
+    // Events sent via SendEvent are received by typed subscribers
+    log.clear();
+    sender->SendEvent(E_TESTTYPEDEVENT, ea::make_pair(TestTypedEvent::P_VALUE, 6));
+    REQUIRE(log == ea::vector<ea::string>{"typed 6", "regular 6", "other typed 6"});
+
+    // Regular unsubscribe functions remove typed subscriptions too
+    log.clear();
+    typedReceiver->UnsubscribeFromEvent(sender, E_TESTTYPEDEVENT);
+    otherTypedReceiver->UnsubscribeFromAllEvents();
+    sender->SendTypedEvent(E_TESTTYPEDEVENT, TestTypedEventData{7});
+    REQUIRE(log == ea::vector<ea::string>{"regular 7"});
+}
+
+TEST_CASE("Typed event subscriptions are safe to change during send")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto sender = MakeShared<TestTypedEventObject>(context);
+
+    ea::vector<SharedPtr<TestTypedEventObject>> receivers;
+    for (unsigned i = 0; i < 4; ++i)
+        receivers.push_back(MakeShared<TestTypedEventObject>(context));
+
+    ea::vector<unsigned> log;
+    const auto subscribe = [&](unsigned index)
+    {
+        receivers[index]->SubscribeToTypedEvent<TestTypedEventData>(sender, E_TESTTYPEDEVENT,
+            [&log, index](const TestTypedEventData&) { log.push_back(index); });
+    };
+
+    // Receiver 0 unsubscribes receiver 1, destroys receiver 2 and subscribes receiver 3
+    receivers[0]->SubscribeToTypedEvent<TestTypedEventData>(sender, E_TESTTYPEDEVENT,
+        [&](const TestTypedEventData&)
+    {
+        log.push_back(0);
+        receivers[1]->UnsubscribeFromTypedEvent(sender, E_TESTTYPEDEVENT);
+        receivers[2] = nullptr;
+        subscribe(3);
+    });
+    subscribe(1);
+    subscribe(2);
+
+    sender->SendTypedEvent(E_TESTTYPEDEVENT, TestTypedEventData{});
+    REQUIRE(log == ea::vector<unsigned>{0});
+
+    log.clear();
+    receivers[0]->UnsubscribeFromTypedEvent(sender, E_TESTTYPEDEVENT);
+    sender->SendTypedEvent(E_TESTTYPEDEVENT, TestTypedEventData{});
+    REQUIRE(log == ea::vector<unsigned>{3});
+
+    // Sender destroyed during send stops the dispatch
+    log.clear();
+    TestTypedEventObject* senderPtr = sender;
+    receivers[0]->SubscribeToTypedEvent<TestTypedEventData>(senderPtr, E_TESTTYPEDEVENT,
+        [&](const TestTypedEventData&)
+    {
+        log.push_back(0);
+        sender = nullptr;
+    });
+    senderPtr->SendTypedEvent(E_TESTTYPEDEVENT, TestTypedEventData{});
+    REQUIRE(log == ea::vector<unsigned>{3, 0});
+}
+
+TEST_CASE("Replaced event handlers are invoked")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto sender = MakeShared<TestTypedEventObject>(context);
+    auto firstReceiver = MakeShared<TestTypedEventObject>(context);
+    auto secondReceiver = MakeShared<TestTypedEventObject>(context);
+
+    ea::vector<ea::string> log;
+    const auto subscribe = [&](Object* receiver, const ea::string& name)
+    {
+        receiver->SubscribeToTypedEvent<TestTypedEventData>(E_TESTTYPEDEVENT,
+            [&log, name](const TestTypedEventData&) { log.push_back(name); });
+    };
+
+    subscribe(firstReceiver, "first");
+    subscribe(secondReceiver, "second");
+    sender->SendTypedEvent(E_TESTTYPEDEVENT, TestTypedEventData{});
+    REQUIRE(log == ea::vector<ea::string>{"first", "second"});
+
+    // Replace handler between sends
+    log.clear();
+    subscribe(secondReceiver, "second replaced");
+    sender->SendTypedEvent(E_TESTTYPEDEVENT, TestTypedEventData{});
+    REQUIRE(log == ea::vector<ea::string>{"first", "second replaced"});
+
+    // Replace handler during send
+    log.clear();
+    firstReceiver->SubscribeToEvent(E_TESTTYPEDEVENT,
+        [&]()
+    {
+        log.push_back("first");
+        subscribe(secondReceiver, "second replaced during send");
+    });
+    sender->SendTypedEvent(E_TESTTYPEDEVENT, TestTypedEventData{});
+    REQUIRE(log == ea::vector<ea::string>{"first", "second replaced during send"});
+}
+
+TEST_CASE("Event and parameter hashes are calculated from names")
+{
+    CHECK(E_TESTTYPEDEVENT == "TestTypedEvent"_sh);
+    CHECK(TestTypedEvent::P_VALUE == "Value"_sh);
+#ifdef URHO3D_EVENT_NAMES
+    CHECK(GetEventNameRegister().GetString(E_TESTTYPEDEVENT) == "TestTypedEvent");
+    CHECK(GetEventParamRegister().GetString(TestTypedEvent::P_VALUE) == "Value");
+#endif
+}
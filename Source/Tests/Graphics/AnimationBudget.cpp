@@ -0,0 +1,61 @@
+// Copyright (c) 2023-2023 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#include "../CommonUtils.h"
+
+#include <Urho3D/Core/CoreEvents.h>
+#include <Urho3D/Graphics/AnimationBudgetManager.h>
+
+TEST_CASE("AnimationBudgetManager staggers reduced-rate updates across frames")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto budget = MakeShared<AnimationBudgetManager>(context);
+
+    AnimationBudgetSettings settings;
+    settings.enabled_ = true;
+    settings.buckets_ = {{10.0f, 1}, {M_LARGE_VALUE, 4}};
+    settings.offscreenUpdateInterval_ = 0;
+    budget->SetSettings(settings);
+
+    CHECK(budget->GetBucketIndex(5.0f) == 0);
+    CHECK(budget->GetBucketIndex(10.0f) == 0);
+    CHECK(budget->GetBucketIndex(50.0f) == 1);
+    CHECK(budget->GetBucketIndex(M_INFINITY) == 1);
+
+    // Near models are updated every frame, distant models are updated once per 4 frames with different phases
+    const unsigned numModels = 8;
+    for (unsigned frameNumber = 1; frameNumber <= 4; ++frameNumber)
+    {
+        budget->SendEvent(E_BEGINFRAME);
+
+        unsigned numNearUpdates = 0;
+        unsigned numFarUpdates = 0;
+        for (unsigned phase = 0; phase < numModels; ++phase)
+        {
+            if (budget->ScheduleUpdate(1.0f, frameNumber, phase))
+                ++numNearUpdates;
+            if (budget->ScheduleUpdate(100.0f, frameNumber, phase))
+                ++numFarUpdates;
+            CHECK_FALSE(budget->ScheduleOffscreenUpdate(frameNumber, phase));
+        }
+
+        CHECK(numNearUpdates == numModels);
+        CHECK(numFarUpdates == numModels / 4);
+    }
+
+    // Statistics are collected for the last finished frame
+    budget->SendEvent(E_BEGINFRAME);
+    const AnimationBudgetStats& stats = budget->GetStats();
+    CHECK(stats.numModels_[0] == numModels);
+    CHECK(stats.numUpdates_[0] == numModels);
+    CHECK(stats.numModels_[1] == numModels);
+    CHECK(stats.numUpdates_[1] == numModels / 4);
+    CHECK(stats.numOffscreenModels_ == numModels);
+    CHECK(stats.numOffscreenUpdates_ == 0);
+    CHECK(stats.GetNumModels() == numModels * 3);
+    CHECK(stats.GetNumSkippedUpdates() == numModels * 3 - numModels - numModels / 4);
+
+    budget->SendEvent(E_BEGINFRAME);
+    CHECK(budget->GetStats().GetNumModels() == 0);
+}
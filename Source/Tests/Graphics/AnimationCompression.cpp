@@ -0,0 +1,186 @@
+// Copyright (c) 2023-2023 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#include "../CommonUtils.h"
+
+#include <Urho3D/Graphics/Animation.h>
+#include <Urho3D/IO/VectorBuffer.h>
+
+namespace
+{
+
+SharedPtr<Animation> CreateTestAnimation(Context* context)
+{
+    const unsigned numKeyFrames = 61;
+    const float length = 2.0f;
+
+    auto animation = MakeShared<Animation>(context);
+    animation->SetLength(length);
+
+    // Linear movement and constant scale
+    AnimationTrack* linearTrack = animation->CreateTrack("Linear");
+    linearTrack->channelMask_ = CHANNEL_POSITION | CHANNEL_ROTATION | CHANNEL_SCALE;
+
+    // Complex movement and rotation
+    AnimationTrack* curveTrack = animation->CreateTrack("Curve");
+    curveTrack->channelMask_ = CHANNEL_POSITION | CHANNEL_ROTATION;
+
+    for (unsigned i = 0; i < numKeyFrames; ++i)
+    {
+        const float time = length * i / (numKeyFrames - 1);
+        const float angle = time * 180.0f;
+
+        linearTrack->AddKeyFrame(AnimationKeyFrame{
+            time, Vector3{time, 2.0f * time, -time}, Quaternion::IDENTITY, Vector3::ONE * 2.0f});
+
+        curveTrack->AddKeyFrame(AnimationKeyFrame{time, Vector3{Sin(angle), Cos(angle), time * time},
+            Quaternion{angle, Vector3::UP} * Quaternion{Sin(angle) * 30.0f, Vector3::RIGHT}});
+    }
+    return animation;
+}
+
+void CheckAnimationsEqual(const Animation& lhs, const Animation& rhs, float time, float error)
+{
+    for (const auto& [nameHash, lhsTrack] : lhs.GetTracks())
+    {
+        const AnimationTrack* rhsTrack = const_cast<Animation&>(rhs).GetTrack(nameHash);
+        REQUIRE(rhsTrack);
+
+        unsigned lhsFrame = 0;
+        unsigned rhsFrame = 0;
+        Transform lhsValue;
+        Transform rhsValue;
+        lhsTrack.Sample(time, lhs.GetLength(), false, lhsFrame, lhsValue);
+        rhsTrack->Sample(time, rhs.GetLength(), false, rhsFrame, rhsValue);
+
+        CHECK(lhsValue.position_.Equals(rhsValue.position_, error));
+        CHECK(lhsValue.rotation_.Equivalent(rhsValue.rotation_, error));
+        CHECK(lhsValue.scale_.Equals(rhsValue.scale_, error));
+    }
+}
+
+}
+
+TEST_CASE("Animation is compressed within error bounds")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+
+    const auto originalAnimation = CreateTestAnimation(context);
+    const auto animation = CreateTestAnimation(context);
+
+    AnimationCompressionSettings settings;
+    settings.positionError_ = 0.001f;
+    settings.rotationError_ = 0.001f;
+    settings.scaleError_ = 0.001f;
+
+    const AnimationCompressionReport report = animation->Compress(settings);
+    CHECK(report.numTracks_ == 2);
+    CHECK(report.numKeyFrames_ == 2 * 61);
+    CHECK(report.numConstantChannels_ == 2);
+    CHECK(report.compressedSize_ < report.uncompressedSize_);
+    CHECK(report.maxPositionError_ <= settings.positionError_ + M_LARGE_EPSILON);
+    CHECK(report.maxRotationError_ <= settings.rotationError_ + M_LARGE_EPSILON);
+    CHECK(report.maxScaleError_ <= settings.scaleError_ + M_LARGE_EPSILON);
+
+    // Linear track needs only the first and the last keyframes
+    const AnimationTrack* linearTrack = animation->GetTrack(StringHash{"Linear"});
+    REQUIRE(linearTrack->IsCompressed());
+    CHECK(linearTrack->keyFrames_.empty());
+    CHECK(linearTrack->GetNumKeyFrames() == 2);
+    CHECK(animation->GetTrack(StringHash{"Curve"})->GetNumKeyFrames() > 2);
+    CHECK(animation->GetTrack(StringHash{"Curve"})->GetNumKeyFrames() <= 61);
+
+    for (float time = 0.0f; time <= 2.0f; time += 0.0125f)
+        CheckAnimationsEqual(*originalAnimation, *animation, time, 0.005f);
+
+    // Compressed animation survives serialization
+    VectorBuffer buffer;
+    REQUIRE(animation->Save(buffer));
+    buffer.Seek(0);
+
+    auto loadedAnimation = MakeShared<Animation>(context);
+    REQUIRE(loadedAnimation->Load(buffer));
+    REQUIRE(loadedAnimation->GetTrack(StringHash{"Linear"})->IsCompressed());
+    REQUIRE(loadedAnimation->GetTrack(StringHash{"Curve"})->IsCompressed());
+    const unsigned uncompressedMemoryUse =
+        sizeof(Animation) + 2 * sizeof(AnimationTrack) + 2 * 61 * sizeof(AnimationKeyFrame);
+    CHECK(loadedAnimation->GetMemoryUse() < uncompressedMemoryUse);
+
+    for (float time = 0.0f; time <= 2.0f; time += 0.0125f)
+        CheckAnimationsEqual(*animation, *loadedAnimation, time, M_EPSILON);
+
+    // Decompressed animation is editable
+    loadedAnimation->Decompress();
+    const AnimationTrack* decompressedTrack = loadedAnimation->GetTrack(StringHash{"Linear"});
+    REQUIRE_FALSE(decompressedTrack->IsCompressed());
+    REQUIRE(decompressedTrack->keyFrames_.size() == 2);
+    CHECK(decompressedTrack->keyFrames_[1].time_ == 2.0f);
+    CHECK(decompressedTrack->keyFrames_[1].position_.Equals(Vector3{2.0f, 4.0f, -2.0f}, 0.001f));
+}
+
+TEST_CASE("Animation compression accounts for quantization error of large tracks")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+
+    const unsigned numKeyFrames = 101;
+    const float length = 10.0f;
+
+    auto animation = MakeShared<Animation>(context);
+    animation->SetLength(length);
+
+    // 16-bit quantization step of 100 meter track exceeds default position error
+    AnimationTrack* track = animation->CreateTrack("Large");
+    track->channelMask_ = CHANNEL_POSITION;
+    for (unsigned i = 0; i < numKeyFrames; ++i)
+    {
+        const float time = length * i / (numKeyFrames - 1);
+        track->AddKeyFrame(AnimationKeyFrame{time, Vector3{time * 10.0f, Sin(time * 90.0f), 0.0f}});
+    }
+
+    const AnimationCompressionSettings settings;
+    const AnimationCompressionReport report = animation->Compress(settings);
+    CHECK(report.maxPositionError_ <= settings.positionError_ + M_LARGE_EPSILON);
+}
+
+TEST_CASE("Compressed animation track is decompressed on edit")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+
+    const auto animation = CreateTestAnimation(context);
+    animation->Compress(AnimationCompressionSettings{});
+
+    AnimationTrack* track = animation->GetTrack(StringHash{"Linear"});
+    REQUIRE(track->IsCompressed());
+
+    track->AddKeyFrame(AnimationKeyFrame{3.0f, Vector3{3.0f, 6.0f, -3.0f}});
+    REQUIRE_FALSE(track->IsCompressed());
+    REQUIRE(track->GetNumKeyFrames() == 3);
+    CHECK(track->keyFrames_[1].position_.Equals(Vector3{2.0f, 4.0f, -2.0f}, 0.001f));
+
+    unsigned frameIndex = 0;
+    Transform value;
+    track->Sample(3.0f, 3.0f, false, frameIndex, value);
+    CHECK(value.position_.Equals(Vector3{3.0f, 6.0f, -3.0f}, M_EPSILON));
+}
+
+TEST_CASE("Keyframe index is found in compressed animation track")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+
+    const auto animation = CreateTestAnimation(context);
+    animation->Compress(AnimationCompressionSettings{});
+
+    const AnimationTrack* track = animation->GetTrack(StringHash{"Curve"});
+    REQUIRE(track->IsCompressed());
+    REQUIRE(track->keyFrames_.empty());
+
+    const unsigned numKeyFrames = track->GetNumKeyFrames();
+    REQUIRE(numKeyFrames > 2);
+    for (unsigned i = 0; i < numKeyFrames; ++i)
+    {
+        unsigned index = 0;
+        REQUIRE(track->GetKeyFrameIndex(track->GetKeyFrameValue(i).time_, index));
+        CHECK(index == i);
+    }
+}
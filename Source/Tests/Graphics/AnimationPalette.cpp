@@ -0,0 +1,114 @@
+// Copyright (c) 2023-2023 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#include "../CommonUtils.h"
+#include "../ModelUtils.h"
+
+#include <Urho3D/Graphics/AnimationPalette.h>
+#include <Urho3D/Graphics/Material.h>
+#include <Urho3D/Graphics/Model.h>
+#include <Urho3D/Graphics/PaletteAnimatedModel.h>
+#include <Urho3D/Resource/ResourceCache.h>
+#include <Urho3D/Scene/Scene.h>
+
+TEST_CASE("AnimationPalette bakes skinning matrices of animation clips")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+
+    const SharedPtr<Model> model = Tests::CreateSkinnedQuad_Model(context)->ExportModel();
+    const ea::vector<SharedPtr<Animation>> animations{
+        Tests::CreateLoopedTranslationAnimation(context, "Move", "Quad 2", Vector3::UP, Vector3::RIGHT, 2.0f),
+        Tests::CreateLoopedRotationAnimation(context, "Rotate", "Quad 1", Vector3::UP, 1.0f),
+    };
+
+    auto palette = MakeShared<AnimationPalette>(context);
+    REQUIRE(palette->Bake(model, animations, 10.0f));
+
+    // Both ends of each clip are baked
+    REQUIRE(palette->GetNumClips() == 2);
+    CHECK(palette->GetNumBones() == 3);
+    CHECK(palette->GetClip(0).firstFrame_ == 0);
+    CHECK(palette->GetClip(0).numFrames_ == 21);
+    CHECK(palette->GetClip(1).firstFrame_ == 21);
+    CHECK(palette->GetClip(1).numFrames_ == 11);
+    CHECK(palette->GetNumFrames() == 32);
+    CHECK(palette->GetClipIndex("Rotate") == 1);
+    CHECK(palette->GetClipIndex("Missing") == M_MAX_UNSIGNED);
+
+    // Skinning matrices are relative to bind pose
+    CHECK(palette->GetSkinMatrix(0, 2).Equals(Matrix3x4::IDENTITY, M_LARGE_EPSILON));
+    CHECK(palette->GetSkinMatrix(5, 2).Translation().Equals(Vector3::LEFT, M_LARGE_EPSILON));
+    CHECK(palette->GetSkinMatrix(15, 2).Translation().Equals(Vector3::RIGHT, M_LARGE_EPSILON));
+    CHECK(palette->GetSkinMatrix(5, 1).Equals(Matrix3x4::IDENTITY, M_LARGE_EPSILON));
+    CHECK(palette->GetBoundingBox().min_.x_ <= -1.5f + M_LARGE_EPSILON);
+    CHECK(palette->GetBoundingBox().max_.x_ >= 1.5f - M_LARGE_EPSILON);
+
+    // Instance data contains two nearest frames and blend factor between them
+    CHECK(palette->GetInstanceData(0, 0.55f, true).Equals(Vector4{5.0f, 6.0f, 0.5f, 0.0f}, M_LARGE_EPSILON));
+    CHECK(palette->GetInstanceData(0, 2.55f, true).Equals(Vector4{5.0f, 6.0f, 0.5f, 0.0f}, M_LARGE_EPSILON));
+    CHECK(palette->GetInstanceData(0, -1.45f, true).Equals(Vector4{5.0f, 6.0f, 0.5f, 0.0f}, M_LARGE_EPSILON));
+    CHECK(palette->GetInstanceData(0, 3.0f, false).Equals(Vector4{19.0f, 20.0f, 1.0f, 0.0f}, M_LARGE_EPSILON));
+    CHECK(palette->GetInstanceData(0, -1.0f, false).Equals(Vector4{0.0f, 1.0f, 0.0f, 0.0f}, M_LARGE_EPSILON));
+    CHECK(palette->GetInstanceData(1, 0.25f, true).Equals(Vector4{23.0f, 24.0f, 0.5f, 0.0f}, M_LARGE_EPSILON));
+    CHECK(palette->GetInstanceData(2, 0.0f, true) == Vector4::ZERO);
+
+    // Model without skeleton cannot be baked
+    auto staticModel = MakeShared<Model>(context);
+    CHECK_FALSE(palette->Bake(staticModel, animations, 10.0f));
+}
+
+TEST_CASE("PaletteAnimatedModel shares palette and materials between instances")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto cache = context->GetSubsystem<ResourceCache>();
+
+    const SharedPtr<Model> model = Tests::CreateSkinnedQuad_Model(context)->ExportModel();
+    model->SetName("Tests/PaletteAnimatedModel.mdl");
+    const ea::vector<SharedPtr<Animation>> animations{
+        Tests::CreateLoopedTranslationAnimation(context, "Tests/Move.ani", "Quad 2", Vector3::UP, Vector3::RIGHT, 2.0f),
+    };
+    auto material = MakeShared<Material>(context);
+
+    auto scene = MakeShared<Scene>(context);
+    auto palettedModel1 = scene->CreateChild()->CreateComponent<PaletteAnimatedModel>();
+    palettedModel1->SetModel(model);
+    palettedModel1->SetMaterial(material);
+    palettedModel1->SetAnimations(animations);
+
+    auto palettedModel2 = scene->CreateChild()->CreateComponent<PaletteAnimatedModel>();
+    palettedModel2->SetModel(model);
+    palettedModel2->SetAnimations(animations);
+    palettedModel2->SetMaterial(material);
+
+    // Palette and palette materials are shared, source material is still reported to the user
+    AnimationPalette* palette = palettedModel1->GetPalette();
+    REQUIRE(palette);
+    CHECK(palettedModel2->GetPalette() == palette);
+    CHECK(AnimationPalette::GetOrCreate(model, animations, PaletteAnimatedModel::DefaultFrameRate) == palette);
+
+    CHECK(palettedModel1->GetMaterial(0) == material);
+    CHECK(palettedModel2->GetMaterial(0) == material);
+
+    Material* paletteMaterial = palettedModel1->GetBatches()[0].material_;
+    REQUIRE(paletteMaterial);
+    CHECK(paletteMaterial != material);
+    CHECK(paletteMaterial == palettedModel2->GetBatches()[0].material_);
+    CHECK(paletteMaterial->GetVertexShaderDefines().contains(AnimationPalette::ShaderDefine));
+    CHECK(palettedModel1->GetBatches()[0].instancingData_ != nullptr);
+
+    // Playback time follows scene time
+    palettedModel1->Play("Tests/Move.ani");
+    palettedModel2->SetSpeed(2.0f);
+    scene->SetElapsedTime(0.25f);
+    CHECK(Equals(palettedModel1->GetTime(), 0.25f));
+    CHECK(Equals(palettedModel2->GetTime(), 0.5f));
+
+    // Without animations the model is rendered with source material
+    palettedModel2->SetAnimations({});
+    CHECK(palettedModel2->GetPalette() == nullptr);
+    CHECK(palettedModel2->GetBatches()[0].material_ == material);
+    CHECK(palettedModel2->GetBatches()[0].instancingData_ == nullptr);
+
+    cache->ReleaseResource<AnimationPalette>(palette->GetName(), true);
+}
@@ -0,0 +1,75 @@
+// Copyright (c) 2023-2023 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#include "../CommonUtils.h"
+
+#include <Urho3D/Graphics/AnimationPose.h>
+#include <Urho3D/Graphics/AnimationTrack.h>
+
+TEST_CASE("AnimationPose blends samples with interpolation and additively")
+{
+    AnimationPose pose;
+    pose.Resize(3);
+    for (unsigned i = 0; i < 3; ++i)
+        pose.ResetBone(i, Vector3::ONE * static_cast<float>(i), Quaternion::IDENTITY, Vector3::ONE);
+
+    // The first layer overwrites bones regardless of weight
+    AnimationPoseSamples samples;
+    samples.positions_.Add(0, Vector3{10.0f, 0.0f, 0.0f}, 1.0f, Vector3::ZERO);
+    samples.rotations_.Add(1, Quaternion{90.0f, Vector3::UP}, 1.0f, Quaternion::IDENTITY);
+    pose.BlendLerp(samples, 0.5f);
+
+    CHECK(pose.GetBone(0).position_.Equals(Vector3{10.0f, 0.0f, 0.0f}));
+    CHECK(pose.GetBone(1).rotation_.Equivalent(Quaternion{90.0f, Vector3::UP}));
+    CHECK(pose.GetBone(2).position_.Equals(Vector3::ONE * 2.0f));
+
+    // The second layer is interpolated with track weight applied
+    samples.Clear();
+    samples.positions_.Add(0, Vector3{20.0f, 0.0f, 0.0f}, 0.5f, Vector3::ZERO);
+    samples.rotations_.Add(1, Quaternion::IDENTITY, 1.0f, Quaternion::IDENTITY);
+    pose.BlendLerp(samples, 0.5f);
+
+    CHECK(pose.GetBone(0).position_.Equals(Vector3{12.5f, 0.0f, 0.0f}));
+    CHECK(pose.GetBone(1).rotation_.Equivalent(Quaternion{45.0f, Vector3::UP}));
+
+    // Additive layer is applied only to animated channels
+    samples.Clear();
+    samples.positions_.Add(0, Vector3{3.0f, 1.0f, 0.0f}, 1.0f, Vector3{1.0f, 1.0f, 0.0f});
+    samples.positions_.Add(2, Vector3{3.0f, 1.0f, 0.0f}, 1.0f, Vector3{1.0f, 1.0f, 0.0f});
+    samples.rotations_.Add(1, Quaternion{30.0f, Vector3::UP}, 1.0f, Quaternion::IDENTITY);
+    pose.BlendAdditive(samples, 0.5f);
+
+    CHECK(pose.GetBone(0).position_.Equals(Vector3{13.5f, 0.0f, 0.0f}));
+    CHECK(pose.GetBone(1).rotation_.Equivalent(Quaternion{60.0f, Vector3::UP}));
+    CHECK(pose.GetBone(2).position_.Equals(Vector3::ONE * 2.0f));
+}
+
+TEST_CASE("Keyframe index is found from any hint")
+{
+    AnimationTrack track;
+    track.channelMask_ = CHANNEL_POSITION;
+    for (unsigned i = 0; i < 10; ++i)
+        track.AddKeyFrame(AnimationKeyFrame{static_cast<float>(i), Vector3::ONE * static_cast<float>(i)});
+
+    for (unsigned hint = 0; hint < 12; ++hint)
+    {
+        for (float time : {-1.0f, 0.0f, 0.5f, 1.0f, 2.5f, 7.0f, 8.99f, 9.0f, 12.0f})
+        {
+            unsigned index = hint;
+            REQUIRE(track.GetKeyFrameIndex(time, index));
+            const unsigned expectedIndex = static_cast<unsigned>(Clamp(FloorToInt(time), 0, 9));
+            CHECK(index == expectedIndex);
+        }
+    }
+
+    // Continuous playback
+    unsigned frameIndex = 0;
+    for (float time = 0.0f; time < 9.0f; time += 0.25f)
+    {
+        Transform value;
+        track.Sample(time, 9.0f, false, frameIndex, value);
+        CHECK(frameIndex == static_cast<unsigned>(FloorToInt(time)));
+        CHECK(value.position_.Equals(Vector3::ONE * time, M_LARGE_EPSILON));
+    }
+}
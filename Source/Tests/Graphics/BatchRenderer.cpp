@@ -0,0 +1,375 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../CommonUtils.h"
+
+#include <Urho3D/Graphics/Geometry.h>
+#include <Urho3D/Graphics/IndexBuffer.h>
+#include <Urho3D/Graphics/VertexBuffer.h>
+#include <Urho3D/RenderAPI/DrawCommandQueue.h>
+#include <Urho3D/RenderPipeline/BatchRenderer.h>
+
+namespace Urho3D
+{
+
+/// Records and inspects draw commands of DrawCommandQueue without render device, pipeline states and shaders.
+class DrawCommandQueueTester
+{
+public:
+    explicit DrawCommandQueueTester(DrawCommandQueue& queue)
+        : queue_(queue)
+    {
+    }
+
+    void AddConstantBuffer(ShaderParameterGroup group, ea::span<const unsigned char> data)
+    {
+        queue_.AddRawConstantBuffer(group, data);
+    }
+    void AddShaderResource(RawTexture* texture) { queue_.AddRawShaderResource(texture); }
+    void Draw(unsigned indexStart, unsigned indexCount) { queue_.DrawRaw(indexStart, indexCount); }
+
+    ea::span<const DrawCommandDescription> GetDrawCommands() const { return queue_.GetDrawCommands(); }
+    const IntRect& GetScissorRect(unsigned index) const { return queue_.GetScissorRect(index); }
+    RawTexture* GetShaderResourceTexture(unsigned index) const { return queue_.GetShaderResourceTexture(index); }
+    const unsigned char* GetConstantBufferData(const ConstantBufferCollectionRef& ref) const
+    {
+        return queue_.GetConstantBufferData(ref);
+    }
+
+private:
+    DrawCommandQueue& queue_;
+};
+
+}
+
+namespace
+{
+
+SharedPtr<Geometry> CreateIndexedGeometry(Context* context, unsigned indexCount)
+{
+    auto vb = MakeShared<VertexBuffer>(context);
+    vb->SetShadowed(true);
+    vb->SetSize(0, 0);
+    auto ib = MakeShared<IndexBuffer>(context);
+    ib->SetShadowed(true);
+    ib->SetSize(indexCount, false);
+
+    auto geometry = MakeShared<Geometry>(context);
+    REQUIRE(geometry->SetVertexBuffer(0, vb));
+    geometry->SetIndexBuffer(ib);
+    REQUIRE(geometry->SetDrawRange(PrimitiveType::LINE_LIST, 0, indexCount));
+    return geometry;
+}
+
+/// Pipeline states are only compared during splitting and are never dereferenced.
+PipelineState* GetFakePipelineState(unsigned index)
+{
+    static unsigned char storage[1024];
+    return reinterpret_cast<PipelineState*>(&storage[index]);
+}
+
+/// Textures are only stored by the queue and are never dereferenced.
+RawTexture* GetFakeTexture(unsigned index)
+{
+    static unsigned char storage[1024];
+    return reinterpret_cast<RawTexture*>(&storage[index]);
+}
+
+/// Blocks are big enough so each of them is stored in separate buffer.
+ea::vector<unsigned char> CreateConstantBufferData(unsigned char value)
+{
+    return ea::vector<unsigned char>(10000, value);
+}
+
+/// Record commands of one recording chunk. Like batch renderer, chunk sets constant buffers and resources
+/// before the first draw. First chunk uses scissor rect and stencil reference of parent queue.
+void RecordChunk(DrawCommandQueue& queue, unsigned chunkIndex)
+{
+    DrawCommandQueueTester tester{queue};
+    const auto value = static_cast<unsigned char>(chunkIndex * 16);
+
+    if (chunkIndex != 0)
+    {
+        queue.SetScissorRect(IntRect(chunkIndex, chunkIndex, 100, 100));
+        queue.SetStencilRef(chunkIndex);
+    }
+    tester.AddConstantBuffer(SP_CAMERA, ea::vector<unsigned char>(64, value));
+
+    for (unsigned i = 0; i < 5; ++i)
+    {
+        // Small blocks share buffers, big blocks are stored in separate ones
+        const unsigned size = i % 4 == 3 ? 10000 : 16 * (i + 1);
+        tester.AddConstantBuffer(SP_OBJECT, ea::vector<unsigned char>(size, static_cast<unsigned char>(value + i + 1)));
+        if (i % 2 == 0)
+        {
+            for (unsigned j = 0; j <= i % 3; ++j)
+                tester.AddShaderResource(GetFakeTexture(chunkIndex * 10 + i + j));
+            queue.CommitShaderResources();
+        }
+        if (i == 2)
+            queue.SetScissorRect(IntRect(0, 0, 50 + chunkIndex, 50));
+        tester.Draw(chunkIndex * 100 + i * 3, 3);
+    }
+}
+
+void CompareDrawCommands(const DrawCommandQueueTester& expected, const DrawCommandQueueTester& actual)
+{
+    const auto expectedCommands = expected.GetDrawCommands();
+    const auto actualCommands = actual.GetDrawCommands();
+    REQUIRE(actualCommands.size() == expectedCommands.size());
+
+    for (unsigned i = 0; i < expectedCommands.size(); ++i)
+    {
+        const DrawCommandDescription& expectedCommand = expectedCommands[i];
+        const DrawCommandDescription& actualCommand = actualCommands[i];
+
+        CHECK(actualCommand.indexStart_ == expectedCommand.indexStart_);
+        CHECK(actualCommand.indexCount_ == expectedCommand.indexCount_);
+        CHECK(actualCommand.stencilRef_ == expectedCommand.stencilRef_);
+        CHECK(actual.GetScissorRect(actualCommand.scissorRect_) == expected.GetScissorRect(expectedCommand.scissorRect_));
+
+        for (unsigned group = 0; group < MAX_SHADER_PARAMETER_GROUPS; ++group)
+        {
+            const ConstantBufferCollectionRef& expectedRef = expectedCommand.constantBuffers_[group];
+            const ConstantBufferCollectionRef& actualRef = actualCommand.constantBuffers_[group];
+            REQUIRE(actualRef.size_ == expectedRef.size_);
+            if (expectedRef.size_ == 0)
+                continue;
+
+            const unsigned char* expectedData = expected.GetConstantBufferData(expectedRef);
+            const unsigned char* actualData = actual.GetConstantBufferData(actualRef);
+            CHECK(ea::equal(expectedData, expectedData + expectedRef.size_, actualData));
+        }
+
+        const ShaderResourceRange& expectedRange = expectedCommand.shaderResources_;
+        const ShaderResourceRange& actualRange = actualCommand.shaderResources_;
+        REQUIRE(actualRange.second - actualRange.first == expectedRange.second - expectedRange.first);
+        for (unsigned j = 0; j < expectedRange.second - expectedRange.first; ++j)
+        {
+            CHECK(actual.GetShaderResourceTexture(actualRange.first + j)
+                == expected.GetShaderResourceTexture(expectedRange.first + j));
+        }
+    }
+}
+
+bool IsConstantBufferFilled(const DrawCommandQueueTester& queue, const ConstantBufferCollectionRef& ref, unsigned char value)
+{
+    if (ref.size_ == 0)
+        return false;
+
+    const unsigned char* data = queue.GetConstantBufferData(ref);
+    return ea::all_of(data, data + ref.size_, [&](unsigned char x) { return x == value; });
+}
+
+}
+
+TEST_CASE("Batches are split into recording chunks at pipeline state changes")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto geometry = CreateIndexedGeometry(context, 2);
+    auto emptyGeometry = CreateIndexedGeometry(context, 0);
+
+    // Pipeline state changes every 50 batches, every 7th batch has empty geometry and unique state
+    const unsigned numBatches = 2000;
+    ea::vector<PipelineBatch> batches(numBatches);
+    ea::vector<PipelineBatchByState> sortedBatches(numBatches);
+    for (unsigned i = 0; i < numBatches; ++i)
+    {
+        const bool isEmpty = i % 7 == 6;
+        batches[i].sourceBatchIndex_ = M_MAX_UNSIGNED;
+        batches[i].geometry_ = isEmpty ? emptyGeometry : geometry;
+        batches[i].geometryType_ = GEOM_STATIC;
+        batches[i].pipelineState_ = GetFakePipelineState(isEmpty ? 1000 - i % 10 : i / 50);
+        sortedBatches[i].pipelineBatch_ = &batches[i];
+    }
+
+    for (bool instancing : {false, true})
+    {
+        PipelineBatchGroup<PipelineBatchByState> batchGroup{sortedBatches};
+        batchGroup.startInstance_ = 10;
+        if (instancing)
+            batchGroup.flags_ |= BatchRenderFlag::EnableInstancingForStaticGeometry;
+
+        ea::vector<BatchRecordingChunk> chunks;
+        BatchRenderer::SplitIntoRecordingChunks(chunks, batchGroup, 256, 4);
+        REQUIRE(chunks.size() == 4);
+
+        unsigned nextBatch = 0;
+        unsigned nextInstance = batchGroup.startInstance_;
+        for (const BatchRecordingChunk& chunk : chunks)
+        {
+            REQUIRE(chunk.beginBatch_ == nextBatch);
+            REQUIRE(chunk.startInstance_ == nextInstance);
+            REQUIRE(chunk.endBatch_ > chunk.beginBatch_);
+
+            // Chunk shall start with new pipeline state, ignoring skipped batches
+            if (chunk.beginBatch_ != 0)
+            {
+                unsigned previousBatch = chunk.beginBatch_ - 1;
+                while (batches[previousBatch].geometry_ == emptyGeometry)
+                    --previousBatch;
+                CHECK(batches[chunk.beginBatch_].pipelineState_ != batches[previousBatch].pipelineState_);
+            }
+
+            unsigned numInstances = 0;
+            for (unsigned i = chunk.beginBatch_; i < chunk.endBatch_; ++i)
+            {
+                if (instancing && batches[i].geometry_ != emptyGeometry)
+                    ++numInstances;
+            }
+            CHECK(chunk.numInstances_ == numInstances);
+
+            nextBatch = chunk.endBatch_;
+            nextInstance += chunk.numInstances_;
+        }
+        REQUIRE(nextBatch == numBatches);
+    }
+
+    // Batches with the same pipeline state are never split
+    for (PipelineBatch& batch : batches)
+        batch.pipelineState_ = GetFakePipelineState(0);
+
+    ea::vector<BatchRecordingChunk> chunks;
+    BatchRenderer::SplitIntoRecordingChunks(chunks, PipelineBatchGroup<PipelineBatchByState>{sortedBatches}, 256, 4);
+    REQUIRE(chunks.size() == 1);
+    CHECK(chunks[0].beginBatch_ == 0);
+    CHECK(chunks[0].endBatch_ == numBatches);
+}
+
+TEST_CASE("Draw commands recorded in another queue are remapped on append")
+{
+    const IntRect parentRect{0, 0, 10, 10};
+    const IntRect childRect{5, 5, 20, 20};
+
+    DrawCommandQueue parentQueue{nullptr};
+    DrawCommandQueueTester parent{parentQueue};
+    parentQueue.Reset();
+    parentQueue.SetScissorRect(parentRect);
+    parentQueue.SetStencilRef(3);
+    parent.AddConstantBuffer(SP_OBJECT, CreateConstantBufferData(1));
+    parent.AddShaderResource(GetFakeTexture(0));
+    parentQueue.CommitShaderResources();
+    parent.Draw(0, 3);
+
+    // Child queue inherits scissor rect and stencil reference, but not constant buffers and resources
+    DrawCommandQueue childQueue{nullptr};
+    DrawCommandQueueTester child{childQueue};
+    childQueue.ResetFrom(parentQueue);
+    child.Draw(10, 3);
+
+    child.AddConstantBuffer(SP_OBJECT, CreateConstantBufferData(2));
+    child.AddConstantBuffer(SP_CAMERA, CreateConstantBufferData(3));
+    child.AddShaderResource(GetFakeTexture(1));
+    child.AddShaderResource(GetFakeTexture(2));
+    childQueue.CommitShaderResources();
+    childQueue.SetScissorRect(childRect);
+    childQueue.SetStencilRef(5);
+    child.Draw(20, 3);
+
+    // Parent queue continues recording with the state of child queue
+    parentQueue.AppendCommands(childQueue);
+    parent.Draw(30, 3);
+
+    const auto drawCommands = parent.GetDrawCommands();
+    REQUIRE(drawCommands.size() == 4);
+
+    const DrawCommandDescription& parentCommand = drawCommands[0];
+    CHECK(parentCommand.indexStart_ == 0);
+    CHECK(parent.GetScissorRect(parentCommand.scissorRect_) == parentRect);
+    CHECK(parentCommand.stencilRef_ == 3);
+    CHECK(IsConstantBufferFilled(parent, parentCommand.constantBuffers_[SP_OBJECT], 1));
+    REQUIRE(parentCommand.shaderResources_ == ShaderResourceRange{0, 1});
+    CHECK(parent.GetShaderResourceTexture(0) == GetFakeTexture(0));
+
+    const DrawCommandDescription& inheritedCommand = drawCommands[1];
+    CHECK(inheritedCommand.indexStart_ == 10);
+    CHECK(parent.GetScissorRect(inheritedCommand.scissorRect_) == parentRect);
+    CHECK(inheritedCommand.stencilRef_ == 3);
+    CHECK(inheritedCommand.constantBuffers_[SP_OBJECT].size_ == 0);
+    CHECK(inheritedCommand.shaderResources_.first == inheritedCommand.shaderResources_.second);
+
+    for (unsigned i : {2, 3})
+    {
+        const DrawCommandDescription& childCommand = drawCommands[i];
+        CHECK(childCommand.indexStart_ == i * 10);
+        CHECK(parent.GetScissorRect(childCommand.scissorRect_) == childRect);
+        CHECK(childCommand.stencilRef_ == 5);
+        CHECK(IsConstantBufferFilled(parent, childCommand.constantBuffers_[SP_OBJECT], 2));
+        CHECK(IsConstantBufferFilled(parent, childCommand.constantBuffers_[SP_CAMERA], 3));
+        REQUIRE(childCommand.shaderResources_ == ShaderResourceRange{1, 3});
+        CHECK(parent.GetShaderResourceTexture(1) == GetFakeTexture(1));
+        CHECK(parent.GetShaderResourceTexture(2) == GetFakeTexture(2));
+    }
+
+    // Constant buffers of child queue are adopted after the buffer used by parent queue
+    CHECK(drawCommands[3].constantBuffers_[SP_OBJECT].index_ > parentCommand.constantBuffers_[SP_OBJECT].index_);
+}
+
+TEST_CASE("Draw commands recorded in chunks are the same as recorded in one queue")
+{
+    const unsigned numChunks = 4;
+
+    const auto recordPrologue = [](DrawCommandQueue& queue)
+    {
+        DrawCommandQueueTester tester{queue};
+        queue.Reset();
+        queue.SetScissorRect(IntRect(1, 2, 3, 4));
+        queue.SetStencilRef(7);
+        tester.AddConstantBuffer(SP_OBJECT, ea::vector<unsigned char>(32, 200));
+        tester.AddShaderResource(GetFakeTexture(500));
+        queue.CommitShaderResources();
+        tester.Draw(1000, 3);
+    };
+
+    // Draw after merge uses the state of the last chunk
+    const auto recordEpilogue = [](DrawCommandQueue& queue)
+    {
+        DrawCommandQueueTester tester{queue};
+        tester.Draw(2000, 3);
+        tester.AddConstantBuffer(SP_OBJECT, ea::vector<unsigned char>(32, 201));
+        tester.Draw(2003, 3);
+    };
+
+    DrawCommandQueue singleQueue{nullptr};
+    recordPrologue(singleQueue);
+    for (unsigned i = 0; i < numChunks; ++i)
+        RecordChunk(singleQueue, i);
+    recordEpilogue(singleQueue);
+
+    DrawCommandQueue mergedQueue{nullptr};
+    recordPrologue(mergedQueue);
+    ea::vector<SharedPtr<DrawCommandQueue>> chunkQueues;
+    for (unsigned i = 0; i < numChunks; ++i)
+    {
+        auto chunkQueue = MakeShared<DrawCommandQueue>(nullptr);
+        chunkQueue->ResetFrom(mergedQueue);
+        chunkQueues.push_back(chunkQueue);
+    }
+    for (unsigned i = 0; i < numChunks; ++i)
+        RecordChunk(*chunkQueues[i], i);
+    for (DrawCommandQueue* chunkQueue : chunkQueues)
+        mergedQueue.AppendCommands(*chunkQueue);
+    recordEpilogue(mergedQueue);
+
+    CompareDrawCommands(DrawCommandQueueTester{singleQueue}, DrawCommandQueueTester{mergedQueue});
+}
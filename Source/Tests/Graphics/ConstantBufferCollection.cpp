@@ -0,0 +1,85 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../CommonUtils.h"
+
+#include <Urho3D/RenderAPI/ConstantBufferCollection.h>
+
+namespace
+{
+
+ConstantBufferCollectionRef AddTestBlock(ConstantBufferCollection& collection, unsigned size, unsigned char value)
+{
+    const auto refAndData = collection.AddBlock(size);
+    memset(refAndData.second, value, size);
+    return refAndData.first;
+}
+
+const unsigned char* GetBlockData(const ConstantBufferCollection& collection, const ConstantBufferCollectionRef& ref)
+{
+    return static_cast<const unsigned char*>(collection.GetBufferData(ref.index_)) + ref.offset_;
+}
+
+}
+
+TEST_CASE("ConstantBufferCollection adopts buffers of another collection")
+{
+    const unsigned blockSize = 4096;
+
+    ConstantBufferCollection collection;
+    collection.ClearAndInitialize(256);
+    const ConstantBufferCollectionRef ownRef = AddTestBlock(collection, 64, 1);
+
+    ConstantBufferCollection otherCollection;
+    otherCollection.ClearAndInitialize(256);
+    ea::vector<ConstantBufferCollectionRef> otherRefs;
+    for (unsigned i = 0; i < 6; ++i)
+        otherRefs.push_back(AddTestBlock(otherCollection, blockSize, static_cast<unsigned char>(10 + i)));
+    REQUIRE(otherCollection.GetNumBuffers() == 2);
+
+    const unsigned firstIndex = collection.AdoptBuffers(otherCollection);
+    REQUIRE(firstIndex == 1);
+    REQUIRE(collection.GetNumBuffers() == 3);
+
+    // Own and adopted data is preserved
+    REQUIRE(GetBlockData(collection, ownRef)[0] == 1);
+    for (unsigned i = 0; i < otherRefs.size(); ++i)
+    {
+        const ConstantBufferCollectionRef ref{otherRefs[i].index_ + firstIndex, otherRefs[i].offset_, otherRefs[i].size_};
+        const unsigned char* data = GetBlockData(collection, ref);
+        REQUIRE(data[0] == 10 + i);
+        REQUIRE(data[blockSize - 1] == 10 + i);
+    }
+
+    // New blocks are added after adopted ones
+    const ConstantBufferCollectionRef nextRef = AddTestBlock(collection, 64, 2);
+    REQUIRE(nextRef.index_ == 2);
+    REQUIRE(nextRef.offset_ == 2 * blockSize);
+
+    // Other collection is reusable
+    otherCollection.ClearAndInitialize(256);
+    REQUIRE(otherCollection.GetNumBuffers() == 1);
+    REQUIRE(otherCollection.GetBufferSize(0) == 0);
+    const ConstantBufferCollectionRef otherRef = AddTestBlock(otherCollection, blockSize, 3);
+    REQUIRE(GetBlockData(otherCollection, otherRef)[blockSize - 1] == 3);
+}
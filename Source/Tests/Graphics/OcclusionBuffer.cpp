@@ -0,0 +1,258 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "../CommonUtils.h"
+
+#include <Urho3D/Graphics/Camera.h>
+#include <Urho3D/Graphics/Model.h>
+#include <Urho3D/Graphics/OcclusionBuffer.h>
+#include <Urho3D/Graphics/Octree.h>
+#include <Urho3D/Graphics/StaticModel.h>
+#include <Urho3D/RenderPipeline/TemporalOcclusion.h>
+#include <Urho3D/Resource/ResourceCache.h>
+#include <Urho3D/Scene/Scene.h>
+
+namespace
+{
+
+/// Create two triangles forming a quad parallel to XY plane.
+ea::vector<Vector3> CreateQuad(const Vector2& min, const Vector2& max, float z)
+{
+    return {
+        {min.x_, min.y_, z}, {max.x_, min.y_, z}, {max.x_, max.y_, z},
+        {min.x_, min.y_, z}, {max.x_, max.y_, z}, {min.x_, max.y_, z},
+    };
+}
+
+SharedPtr<OcclusionBuffer> CreateOcclusionBuffer(Context* context, Camera* camera, bool threaded)
+{
+    auto buffer = MakeShared<OcclusionBuffer>(context);
+    REQUIRE(buffer->SetSize(64, 64, threaded));
+    buffer->SetView(camera);
+    buffer->SetCullMode(CULL_NONE);
+    buffer->Clear();
+    return buffer;
+}
+
+}
+
+TEST_CASE("OcclusionBuffer rasterizes occluders and culls boxes behind them")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto scene = MakeShared<Scene>(context);
+    auto camera = scene->CreateChild("Camera")->CreateComponent<Camera>();
+    camera->SetFov(60.0f);
+    camera->SetAspectRatio(1.0f);
+    camera->SetNearClip(0.1f);
+    camera->SetFarClip(100.0f);
+
+    // Left half of the screen is covered by the quad at distance 10
+    const ea::vector<Vector3> quad = CreateQuad({-20.0f, -20.0f}, {0.0f, 20.0f}, 10.0f);
+
+    for (bool threaded : {false, true})
+    {
+        auto buffer = CreateOcclusionBuffer(context, camera, threaded);
+        buffer->AddTriangles(Matrix3x4::IDENTITY, quad.data(), sizeof(Vector3), 0, quad.size());
+        buffer->DrawTriangles();
+        buffer->BuildDepthHierarchy();
+
+        REQUIRE(buffer->GetNumTriangles() == 2);
+
+        const int clearValue = static_cast<int>(OCCLUSION_Z_SCALE);
+        const int* data = buffer->GetBuffer();
+        REQUIRE(data[32 * 64 + 4] < clearValue);
+        REQUIRE(data[32 * 64 + 60] == clearValue);
+
+        // Box behind the quad is hidden, box in front or on the other side is visible
+        REQUIRE_FALSE(buffer->IsVisible(BoundingBox(Vector3(-3.0f, -1.0f, 20.0f), Vector3(-2.0f, 1.0f, 21.0f))));
+        REQUIRE(buffer->IsVisible(BoundingBox(Vector3(-3.0f, -1.0f, 5.0f), Vector3(-2.0f, 1.0f, 6.0f))));
+        REQUIRE(buffer->IsVisible(BoundingBox(Vector3(2.0f, -1.0f, 20.0f), Vector3(3.0f, 1.0f, 21.0f))));
+        REQUIRE(buffer->IsVisible(BoundingBox(Vector3(-1.0f, -1.0f, 20.0f), Vector3(1.0f, 1.0f, 21.0f))));
+    }
+}
+
+TEST_CASE("OcclusionBuffer produces same depth with and without threading")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto scene = MakeShared<Scene>(context);
+    auto camera = scene->CreateChild("Camera")->CreateComponent<Camera>();
+    camera->SetAspectRatio(1.0f);
+
+    ea::vector<Vector3> vertices;
+    for (unsigned i = 0; i < 20; ++i)
+    {
+        const float offset = static_cast<float>(i) - 10.0f;
+        const ea::vector<Vector3> quad = CreateQuad({offset, offset * 0.5f}, {offset + 3.0f, offset * 0.5f + 4.0f},
+            10.0f + static_cast<float>(i % 7));
+        vertices.insert(vertices.end(), quad.begin(), quad.end());
+    }
+
+    auto singleThreaded = CreateOcclusionBuffer(context, camera, false);
+    auto multiThreaded = CreateOcclusionBuffer(context, camera, true);
+    for (OcclusionBuffer* buffer : {singleThreaded.Get(), multiThreaded.Get()})
+    {
+        buffer->AddTriangles(Matrix3x4::IDENTITY, vertices.data(), sizeof(Vector3), 0, vertices.size());
+        buffer->DrawTriangles();
+    }
+
+    const int* expected = singleThreaded->GetBuffer();
+    const int* actual = multiThreaded->GetBuffer();
+    REQUIRE(ea::equal(expected, expected + 64 * 64, actual));
+}
+
+TEST_CASE("OcclusionBuffer rejects triangles only behind fully covered tiles")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto scene = MakeShared<Scene>(context);
+    auto camera = scene->CreateChild("Camera")->CreateComponent<Camera>();
+    camera->SetAspectRatio(1.0f);
+
+    // Near quad covers the left half of the screen, far quad covers the whole screen
+    ea::vector<Vector3> vertices = CreateQuad({-20.0f, -20.0f}, {0.0f, 20.0f}, 10.0f);
+    const ea::vector<Vector3> farQuad = CreateQuad({-100.0f, -100.0f}, {100.0f, 100.0f}, 50.0f);
+    vertices.insert(vertices.end(), farQuad.begin(), farQuad.end());
+
+    auto buffer = CreateOcclusionBuffer(context, camera, false);
+    buffer->AddTriangles(Matrix3x4::IDENTITY, vertices.data(), sizeof(Vector3), 0, vertices.size());
+    buffer->DrawTriangles();
+
+    // Far quad is hidden where the near quad is drawn and is visible everywhere else
+    const int clearValue = static_cast<int>(OCCLUSION_Z_SCALE);
+    const int* data = buffer->GetBuffer();
+    const int nearDepth = data[32 * 64 + 4];
+    const int farDepth = data[32 * 64 + 60];
+    CHECK(nearDepth < farDepth);
+    CHECK(farDepth < clearValue);
+    for (int y = 0; y < 64; ++y)
+    {
+        CHECK(data[y * 64] == nearDepth);
+        CHECK(data[y * 64 + 63] == farDepth);
+    }
+}
+
+TEST_CASE("OcclusionBuffer reprojects depth history conservatively")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto scene = MakeShared<Scene>(context);
+    Node* cameraNode = scene->CreateChild("Camera");
+    auto camera = cameraNode->CreateComponent<Camera>();
+    camera->SetAspectRatio(1.0f);
+
+    const ea::vector<Vector3> quad = CreateQuad({-20.0f, -20.0f}, {0.0f, 20.0f}, 10.0f);
+
+    auto buffer = CreateOcclusionBuffer(context, camera, false);
+    REQUIRE_FALSE(buffer->ReprojectDepthHistory());
+    buffer->AddTriangles(Matrix3x4::IDENTITY, quad.data(), sizeof(Vector3), 0, quad.size());
+    buffer->DrawTriangles();
+    buffer->StoreDepthHistory();
+    REQUIRE(buffer->HasDepthHistory());
+
+    // Move camera and compare reprojected depth with depth rendered from scratch
+    cameraNode->SetPosition({0.5f, 0.2f, 1.0f});
+    cameraNode->SetRotation(Quaternion(3.0f, Vector3::UP));
+
+    auto reference = CreateOcclusionBuffer(context, camera, false);
+    reference->AddTriangles(Matrix3x4::IDENTITY, quad.data(), sizeof(Vector3), 0, quad.size());
+    reference->DrawTriangles();
+
+    buffer->SetView(camera);
+    buffer->Clear();
+    REQUIRE(buffer->ReprojectDepthHistory());
+    buffer->BuildDepthHierarchy();
+
+    const int* expected = reference->GetBuffer();
+    const int* actual = buffer->GetBuffer();
+    unsigned numCovered = 0;
+    for (unsigned i = 0; i < 64 * 64; ++i)
+    {
+        // Reprojected depth may have holes but never be in front of actual geometry
+        CHECK(actual[i] >= expected[i] - OCCLUSION_FIXED_BIAS);
+        if (actual[i] < static_cast<int>(OCCLUSION_Z_SCALE))
+            ++numCovered;
+    }
+    REQUIRE(numCovered > 64 * 64 / 4);
+
+    REQUIRE_FALSE(buffer->IsVisible(BoundingBox(Vector3(-4.0f, -1.0f, 20.0f), Vector3(-3.0f, 1.0f, 21.0f))));
+    REQUIRE(buffer->IsVisible(BoundingBox(Vector3(4.0f, -1.0f, 20.0f), Vector3(5.0f, 1.0f, 21.0f))));
+
+    buffer->ResetDepthHistory();
+    REQUIRE_FALSE(buffer->HasDepthHistory());
+}
+
+TEST_CASE("TemporalOcclusion forgets depth history of disabled occluders")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto cache = context->GetSubsystem<ResourceCache>();
+    auto scene = MakeShared<Scene>(context);
+    scene->CreateComponent<Octree>();
+    auto camera = scene->CreateChild("Camera")->CreateComponent<Camera>();
+    camera->SetAspectRatio(1.0f);
+
+    // Wall in front of the camera covers the whole screen
+    Node* wallNode = scene->CreateChild("Wall");
+    wallNode->SetPosition({0.0f, 0.0f, 10.0f});
+    wallNode->SetScale({100.0f, 100.0f, 1.0f});
+    auto wall = wallNode->CreateComponent<StaticModel>();
+    wall->SetModel(cache->GetResource<Model>("Models/Box.mdl"));
+    wall->SetOccluder(true);
+
+    const BoundingBox occludee{Vector3(-1.0f, -1.0f, 20.0f), Vector3(1.0f, 1.0f, 21.0f)};
+
+    auto buffer = CreateOcclusionBuffer(context, camera, false);
+    TemporalOcclusion temporalOcclusion;
+    const auto drawFrame = [&]()
+    {
+        ea::vector<SortedOccluder> occluders;
+        if (wall->IsEnabledEffective() && wall->IsOccluder())
+            occluders.push_back(SortedOccluder{0.0f, wall});
+
+        buffer->Clear();
+        temporalOcclusion.DrawOccluders(buffer, occluders);
+        buffer->BuildDepthHierarchy();
+    };
+
+    for (bool disableComponent : {true, false})
+    {
+        // Occluder is stored in history after it stays static for one frame
+        drawFrame();
+        drawFrame();
+        REQUIRE(temporalOcclusion.IsInDepthHistory(wall));
+        drawFrame();
+        REQUIRE(temporalOcclusion.IsInDepthHistory(wall));
+        REQUIRE_FALSE(buffer->IsVisible(occludee));
+
+        if (disableComponent)
+            wall->SetEnabled(false);
+        else
+            wall->SetOccluder(false);
+
+        // Occludee is visible immediately, reprojected depth of the former occluder is not used
+        drawFrame();
+        REQUIRE(buffer->IsVisible(occludee));
+        REQUIRE_FALSE(temporalOcclusion.IsInDepthHistory(wall));
+
+        wall->SetEnabled(true);
+        wall->SetOccluder(true);
+        temporalOcclusion.Reset();
+        buffer->ResetDepthHistory();
+    }
+}
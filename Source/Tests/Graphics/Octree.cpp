@@ -0,0 +1,186 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "../CommonUtils.h"
+
+#include <Urho3D/Graphics/Camera.h>
+#include <Urho3D/Graphics/Model.h>
+#include <Urho3D/Graphics/Octree.h>
+#include <Urho3D/Graphics/StaticModel.h>
+#include <Urho3D/Math/Random.h>
+#include <Urho3D/Scene/Scene.h>
+
+#include <EASTL/sort.h>
+
+namespace
+{
+
+ea::vector<Drawable*> SortedDrawables(ea::vector<Drawable*> drawables)
+{
+    ea::sort(drawables.begin(), drawables.end());
+    return drawables;
+}
+
+ea::vector<Drawable*> SortedDrawables(const ea::vector<RayQueryResult>& results)
+{
+    ea::vector<Drawable*> drawables;
+    for (const RayQueryResult& result : results)
+        drawables.push_back(result.drawable_);
+    return SortedDrawables(drawables);
+}
+
+/// Run a set of queries and return their results.
+ea::vector<ea::vector<Drawable*>> QueryDrawables(Octree* octree, Camera* camera)
+{
+    ea::vector<ea::vector<Drawable*>> results;
+    ea::vector<Drawable*> drawables;
+
+    BoxOctreeQuery boxQuery(drawables, BoundingBox(Vector3(-20.0f, -5.0f, -20.0f), Vector3(10.0f, 5.0f, 30.0f)));
+    octree->GetDrawables(boxQuery);
+    results.push_back(SortedDrawables(drawables));
+
+    SphereOctreeQuery sphereQuery(drawables, Sphere(Vector3(15.0f, 0.0f, -10.0f), 25.0f));
+    octree->GetDrawables(sphereQuery);
+    results.push_back(SortedDrawables(drawables));
+
+    FrustumOctreeQuery frustumQuery(drawables, camera->GetFrustum());
+    octree->GetDrawables(frustumQuery);
+    results.push_back(SortedDrawables(drawables));
+
+    RayOctreeQuery rayQuery(Ray(Vector3(-60.0f, 0.5f, 0.5f), Vector3::RIGHT), RAY_AABB);
+    octree->Raycast(rayQuery);
+    results.push_back(SortedDrawables(rayQuery.result_));
+
+    octree->RaycastSingle(rayQuery);
+    results.push_back(SortedDrawables(rayQuery.result_));
+
+    return results;
+}
+
+}
+
+TEST_CASE("Octree BVH spatial index returns same query results as octants")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto scene = MakeShared<Scene>(context);
+    auto octree = scene->CreateComponent<Octree>();
+
+    auto model = MakeShared<Model>(context);
+    model->SetBoundingBox(BoundingBox(-Vector3::ONE, Vector3::ONE));
+
+    auto cameraNode = scene->CreateChild("Camera");
+    cameraNode->SetPosition({0.0f, 10.0f, -60.0f});
+    cameraNode->LookAt(Vector3::ZERO);
+    auto camera = cameraNode->CreateComponent<Camera>();
+    camera->SetFarClip(80.0f);
+
+    SetRandomSeed(1);
+    ea::vector<Node*> nodes;
+    for (unsigned i = 0; i < 1000; ++i)
+    {
+        Node* node = scene->CreateChild();
+        node->SetPosition(Vector3(Random(-50.0f, 50.0f), Random(-10.0f, 10.0f), Random(-50.0f, 50.0f)));
+        node->SetScale(Random(0.2f, 4.0f));
+        auto staticModel = node->CreateComponent<StaticModel>();
+        staticModel->SetModel(model);
+        nodes.push_back(node);
+    }
+
+    FrameInfo frameInfo;
+    octree->Update(frameInfo);
+
+    const auto octantResults = QueryDrawables(octree, camera);
+    REQUIRE(!octantResults[0].empty());
+    REQUIRE(!octantResults[3].empty());
+    REQUIRE(octantResults[4].size() == 1);
+
+    octree->SetSpatialIndex(OctreeSpatialIndex::BVH);
+    REQUIRE(octree->GetBVH().GetNumDrawables() == octree->GetAllDrawables().size());
+    REQUIRE(octree->GetBVH().GetNumPendingDrawables() == 0);
+    REQUIRE(QueryDrawables(octree, camera) == octantResults);
+
+    // Move, remove and add drawables
+    for (unsigned i = 0; i < 100; ++i)
+        nodes[i]->Translate(Vector3(Random(-20.0f, 20.0f), 0.0f, Random(-20.0f, 20.0f)));
+    for (unsigned i = 100; i < 150; ++i)
+        nodes[i]->Remove();
+    for (unsigned i = 0; i < 20; ++i)
+    {
+        Node* node = scene->CreateChild();
+        node->SetPosition(Vector3(Random(-50.0f, 50.0f), Random(-10.0f, 10.0f), Random(-50.0f, 50.0f)));
+        auto staticModel = node->CreateComponent<StaticModel>();
+        staticModel->SetModel(model);
+    }
+    REQUIRE(octree->GetBVH().GetNumPendingDrawables() == 20);
+
+    octree->Update(frameInfo);
+    const auto bvhResults = QueryDrawables(octree, camera);
+    REQUIRE(octree->GetBVH().GetNumDrawables() == octree->GetAllDrawables().size());
+
+    octree->SetSpatialIndex(OctreeSpatialIndex::Octants);
+    REQUIRE(octree->GetBVH().GetNumDrawables() == 0);
+    REQUIRE(QueryDrawables(octree, camera) == bvhResults);
+}
+
+TEST_CASE("Batched frustum culling returns same drawables as FrustumOctreeQuery")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto scene = MakeShared<Scene>(context);
+    auto octree = scene->CreateComponent<Octree>();
+
+    auto model = MakeShared<Model>(context);
+    model->SetBoundingBox(BoundingBox(-Vector3::ONE, Vector3::ONE));
+
+    auto cameraNode = scene->CreateChild("Camera");
+    cameraNode->SetPosition({0.0f, 10.0f, -60.0f});
+    cameraNode->LookAt(Vector3::ZERO);
+    auto camera = cameraNode->CreateComponent<Camera>();
+    camera->SetFarClip(80.0f);
+
+    SetRandomSeed(2);
+    for (unsigned i = 0; i < 5000; ++i)
+    {
+        Node* node = scene->CreateChild();
+        node->SetPosition(Vector3(Random(-100.0f, 100.0f), Random(-10.0f, 10.0f), Random(-100.0f, 100.0f)));
+        node->SetScale(Random(0.2f, 4.0f));
+        auto staticModel = node->CreateComponent<StaticModel>();
+        staticModel->SetModel(model);
+        staticModel->SetViewMask(i % 3 == 0 ? 0x2 : 0x1);
+    }
+
+    FrameInfo frameInfo;
+    octree->Update(frameInfo);
+
+    for (OctreeSpatialIndex spatialIndex : {OctreeSpatialIndex::Octants, OctreeSpatialIndex::BVH})
+    {
+        octree->SetSpatialIndex(spatialIndex);
+
+        ea::vector<Drawable*> expected;
+        FrustumOctreeQuery query(expected, camera->GetFrustum(), DRAWABLE_GEOMETRY, 0x1);
+        octree->GetDrawables(query);
+        REQUIRE(!expected.empty());
+
+        ea::vector<Drawable*> actual;
+        octree->GetDrawablesInFrustum(actual, camera->GetFrustum(), DRAWABLE_GEOMETRY, 0x1);
+        REQUIRE(SortedDrawables(actual) == SortedDrawables(expected));
+    }
+}
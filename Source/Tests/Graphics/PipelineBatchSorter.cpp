@@ -0,0 +1,171 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../CommonUtils.h"
+
+#include <Urho3D/Core/WorkQueue.h>
+#include <Urho3D/Math/RandomEngine.h>
+#include <Urho3D/RenderPipeline/PipelineBatchSorter.h>
+
+namespace
+{
+
+/// Create batches for drawables with several source batches each.
+ea::vector<PipelineBatch> CreateBatches(unsigned numDrawables, unsigned numSourceBatches)
+{
+    ea::vector<PipelineBatch> batches;
+    for (unsigned drawableIndex = 0; drawableIndex < numDrawables; ++drawableIndex)
+    {
+        for (unsigned sourceBatchIndex = 0; sourceBatchIndex < numSourceBatches; ++sourceBatchIndex)
+        {
+            PipelineBatch& batch = batches.emplace_back();
+            batch.drawableIndex_ = drawableIndex;
+            batch.sourceBatchIndex_ = sourceBatchIndex;
+        }
+    }
+    return batches;
+}
+
+/// Fill sort keys for batches in random order.
+ea::vector<PipelineBatchByState> FillSortKeys(RandomEngine& random,
+    const ea::vector<PipelineBatch>& batches, const ea::vector<unsigned long long>& keys)
+{
+    ea::vector<PipelineBatchByState> sortedBatches;
+    for (unsigned i = 0; i < batches.size(); ++i)
+    {
+        PipelineBatchByState& sortedBatch = sortedBatches.emplace_back();
+        sortedBatch.pipelineBatch_ = &batches[i];
+        sortedBatch.primaryKey_ = keys[i];
+        sortedBatch.secondaryKey_ = keys[i] % 3;
+    }
+    random.Shuffle(sortedBatches.begin(), sortedBatches.end());
+    return sortedBatches;
+}
+
+bool IsSorted(const ea::vector<PipelineBatchByState>& batches)
+{
+    for (unsigned i = 1; i < batches.size(); ++i)
+    {
+        if (batches[i] < batches[i - 1])
+            return false;
+    }
+    return true;
+}
+
+}
+
+TEST_CASE("PipelineBatchSorter reuses order of unchanged batches")
+{
+    RandomEngine random{0u};
+    PipelineBatchSorter sorter;
+
+    const ea::vector<PipelineBatch> batches = CreateBatches(200, 3);
+    ea::vector<unsigned long long> keys;
+    for (unsigned i = 0; i < batches.size(); ++i)
+        keys.push_back(random.GetUInt(0, 50));
+
+    // First sort is done from scratch
+    ea::vector<PipelineBatchByState> sortedBatches = FillSortKeys(random, batches, keys);
+    sorter.Sort(sortedBatches);
+    CHECK(IsSorted(sortedBatches));
+    CHECK(sorter.GetNumReusedBatches() == 0);
+
+    // Unchanged batches are reused
+    sortedBatches = FillSortKeys(random, batches, keys);
+    sorter.Sort(sortedBatches);
+    CHECK(IsSorted(sortedBatches));
+    CHECK(sorter.GetNumReusedBatches() == batches.size());
+
+    // Changed batches are sorted and merged with reused ones
+    for (unsigned i = 0; i < batches.size(); i += 10)
+        keys[i] += 7;
+    sortedBatches = FillSortKeys(random, batches, keys);
+    sorter.Sort(sortedBatches);
+    CHECK(IsSorted(sortedBatches));
+    CHECK(sorter.GetNumReusedBatches() == batches.size() - batches.size() / 10);
+
+    // Removed and added batches are handled too
+    const ea::vector<PipelineBatch> otherBatches = CreateBatches(220, 3);
+    keys.resize(otherBatches.size(), 25);
+    sortedBatches = FillSortKeys(random, otherBatches, keys);
+    sortedBatches.erase(sortedBatches.begin(), sortedBatches.begin() + 30);
+    sorter.Sort(sortedBatches);
+    CHECK(IsSorted(sortedBatches));
+    CHECK(sorter.GetNumReusedBatches() > 0);
+    CHECK(sorter.GetNumReusedBatches() <= batches.size());
+
+    ea::vector<const PipelineBatch*> resultBatches;
+    for (const PipelineBatchByState& sortedBatch : sortedBatches)
+        resultBatches.push_back(sortedBatch.pipelineBatch_);
+    ea::sort(resultBatches.begin(), resultBatches.end());
+    CHECK(ea::unique(resultBatches.begin(), resultBatches.end()) == resultBatches.end());
+}
+
+TEST_CASE("PipelineBatchRadixSort sorts batches in the same order as comparison sort")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto workQueue = context->GetSubsystem<WorkQueue>();
+    RandomEngine random{0u};
+
+    PipelineBatchRadixSort radixSort;
+    for (unsigned numBatches : {1, 100, 10000, 50000})
+    {
+        ea::vector<PipelineBatchByState> byStateBatches(numBatches);
+        ea::vector<PipelineBatchBackToFront> backToFrontBatches(numBatches);
+        for (unsigned i = 0; i < numBatches; ++i)
+        {
+            PipelineBatchByState& byStateBatch = byStateBatches[i];
+            byStateBatch.primaryKey_ = static_cast<unsigned long long>(random.GetUInt(0, 4)) << 56;
+            byStateBatch.primaryKey_ |= static_cast<unsigned long long>(random.GetUInt(0, 200)) << 32;
+            byStateBatch.primaryKey_ |= random.GetUInt(0, 5000);
+            byStateBatch.secondaryKey_ = static_cast<unsigned long long>(random.GetUInt()) << 24;
+
+            PipelineBatchBackToFront& backToFrontBatch = backToFrontBatches[i];
+            backToFrontBatch.renderOrder_ = static_cast<unsigned char>(random.GetUInt(120, 130));
+            backToFrontBatch.distance_ = random.GetFloat(-10.0f, 100.0f);
+        }
+
+        for (WorkQueue* queue : {static_cast<WorkQueue*>(nullptr), workQueue})
+        {
+            auto expectedByState = byStateBatches;
+            auto actualByState = byStateBatches;
+            ea::sort(expectedByState.begin(), expectedByState.end());
+            radixSort.RadixSort(actualByState, queue);
+            for (unsigned i = 0; i < numBatches; ++i)
+            {
+                REQUIRE(actualByState[i].primaryKey_ == expectedByState[i].primaryKey_);
+                REQUIRE(actualByState[i].secondaryKey_ == expectedByState[i].secondaryKey_);
+            }
+
+            auto expectedBackToFront = backToFrontBatches;
+            auto actualBackToFront = backToFrontBatches;
+            ea::sort(expectedBackToFront.begin(), expectedBackToFront.end());
+            radixSort.RadixSort(actualBackToFront, queue);
+            for (unsigned i = 0; i < numBatches; ++i)
+            {
+                REQUIRE(actualBackToFront[i].renderOrder_ == expectedBackToFront[i].renderOrder_);
+                REQUIRE(actualBackToFront[i].distance_ == expectedBackToFront[i].distance_);
+            }
+        }
+    }
+}
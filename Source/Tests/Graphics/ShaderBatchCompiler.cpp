@@ -0,0 +1,82 @@
+// Copyright (c) 2023-2023 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#include "../CommonUtils.h"
+
+#include <Urho3D/Graphics/ShaderBatchCompiler.h>
+
+TEST_CASE("ShaderBatchCompiler compiles identical variations once")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+
+    ShaderVariationCompileDesc desc;
+    desc.shaderName_ = "Test";
+    desc.sourceCode_ = "void main() {}\n";
+    desc.renderBackend_ = RenderBackend::OpenGL;
+    desc.translationPolicy_ = ShaderTranslationPolicy::Verbatim;
+
+    auto compiler = MakeShared<ShaderBatchCompiler>(context);
+
+    desc.type_ = VS;
+    desc.defines_ = "A B";
+    const unsigned vertexShader = compiler->AddVariation(desc);
+    desc.shaderName_ = "AnotherTest";
+    const unsigned sameVertexShader = compiler->AddVariation(desc);
+
+    desc.defines_ = "A";
+    const unsigned otherVertexShader = compiler->AddVariation(desc);
+
+    desc.type_ = PS;
+    const unsigned pixelShader = compiler->AddVariation(desc);
+
+    REQUIRE(compiler->GetNumVariations() == 4);
+    REQUIRE(compiler->GetNumUniqueVariations() == 3);
+    CHECK(compiler->GetDesc(sameVertexShader).shaderName_ == "Test");
+
+    compiler->Compile();
+    for (unsigned index : {vertexShader, sameVertexShader, otherVertexShader, pixelShader})
+    {
+        REQUIRE(compiler->IsCompiled(index));
+        REQUIRE_FALSE(compiler->GetBytecode(index).bytecode_.empty());
+    }
+    CHECK(&compiler->GetBytecode(vertexShader) == &compiler->GetBytecode(sameVertexShader));
+    CHECK(compiler->GetBytecode(pixelShader).type_ == PS);
+
+    compiler->Clear();
+    REQUIRE(compiler->GetNumVariations() == 0);
+    REQUIRE(compiler->GetNumUniqueVariations() == 0);
+}
+
+#ifdef URHO3D_SHADER_TRANSLATOR
+TEST_CASE("ShaderBatchCompiler translates variations in parallel")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+
+    ShaderVariationCompileDesc desc;
+    desc.shaderName_ = "Test";
+    desc.sourceCode_ = "void main() {}\n";
+    desc.renderBackend_ = RenderBackend::OpenGL;
+    desc.translationPolicy_ = ShaderTranslationPolicy::Translate;
+
+    // Enough unique variations to keep all worker threads busy with glslang and SPIRV-Cross
+    auto compiler = MakeShared<ShaderBatchCompiler>(context);
+    const unsigned numVariations = 32;
+    for (unsigned i = 0; i < numVariations; ++i)
+    {
+        desc.type_ = i % 2 == 0 ? VS : PS;
+        desc.defines_ = Format("VARIATION{}", i);
+        compiler->AddVariation(desc);
+    }
+    REQUIRE(compiler->GetNumUniqueVariations() == numVariations);
+
+    compiler->Compile();
+    for (unsigned index = 0; index < numVariations; ++index)
+    {
+        REQUIRE(compiler->IsCompiled(index));
+        CHECK(compiler->GetBytecode(index).type_ == compiler->GetDesc(index).type_);
+        CHECK_FALSE(compiler->GetBytecode(index).bytecode_.empty());
+        CHECK(compiler->GetTranslatedSource(index).contains("main"));
+    }
+}
+#endif
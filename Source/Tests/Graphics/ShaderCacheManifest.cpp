@@ -0,0 +1,77 @@
+// Copyright (c) 2023-2023 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#include "../CommonUtils.h"
+
+#include <Urho3D/Core/ProcessUtils.h>
+#include <Urho3D/Graphics/ShaderCacheManifest.h>
+#include <Urho3D/IO/FileSystem.h>
+
+TEST_CASE("ShaderCacheManifest records unique variations and survives save and load")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto fs = context->GetSubsystem<FileSystem>();
+    const TemporaryDir tempDir{context, Format("{}{}/", fs->GetTemporaryDir(), GenerateUUID())};
+    const FileIdentifier cacheDir{"file", tempDir.GetPath()};
+
+    auto manifest = MakeShared<ShaderCacheManifest>(context);
+    manifest->AddVariation("Shaders/GLSL/v2/M_LitPipeline.glsl", VS, "DIRLIGHT PERPIXEL");
+    manifest->AddVariation("Shaders/GLSL/v2/M_LitPipeline.glsl", PS, "DIRLIGHT PERPIXEL");
+    manifest->AddVariation("Shaders/GLSL/v2/M_LitPipeline.glsl", VS, "DIRLIGHT PERPIXEL");
+    REQUIRE(manifest->GetEntries().size() == 2);
+    REQUIRE(manifest->Save(cacheDir, RenderBackend::Vulkan));
+
+    auto loadedManifest = MakeShared<ShaderCacheManifest>(context);
+    loadedManifest->AddVariation("Shaders/GLSL/v2/M_LitPipeline.glsl", PS, "DIRLIGHT PERPIXEL");
+    REQUIRE(loadedManifest->Load(cacheDir, RenderBackend::Vulkan));
+    REQUIRE(loadedManifest->GetEntries().size() == 2);
+    CHECK(loadedManifest->GetEntries()[0] == manifest->GetEntries()[1]);
+    CHECK(loadedManifest->GetEntries()[1] == manifest->GetEntries()[0]);
+
+    // Manifest of another backend is ignored
+    auto otherBackendManifest = MakeShared<ShaderCacheManifest>(context);
+    REQUIRE_FALSE(otherBackendManifest->Load(cacheDir, RenderBackend::D3D11));
+    REQUIRE(otherBackendManifest->GetEntries().empty());
+
+    ShaderBytecode bytecode;
+    REQUIRE_FALSE(loadedManifest->TakePrewarmedBytecode("Unknown.bytecode", 0, bytecode));
+    REQUIRE(loadedManifest->GetNumPendingPrewarmTasks() == 0);
+}
+
+TEST_CASE("ShaderCacheManifest forgets variations that are not used for many runs")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto fs = context->GetSubsystem<FileSystem>();
+    const TemporaryDir tempDir{context, Format("{}{}/", fs->GetTemporaryDir(), GenerateUUID())};
+    const FileIdentifier cacheDir{"file", tempDir.GetPath()};
+
+    const ea::string shaderName = "Shaders/GLSL/v2/M_LitPipeline.glsl";
+    const ShaderCacheManifestEntry usedEntry{shaderName, VS, "DIRLIGHT"};
+    const ShaderCacheManifestEntry unusedEntry{shaderName, VS, "POINTLIGHT"};
+
+    auto manifest = MakeShared<ShaderCacheManifest>(context);
+    manifest->AddVariation(usedEntry.shaderName_, usedEntry.type_, usedEntry.defines_);
+    manifest->AddVariation(unusedEntry.shaderName_, unusedEntry.type_, unusedEntry.defines_);
+    REQUIRE(manifest->Save(cacheDir, RenderBackend::Vulkan));
+
+    // Each run uses only one variation
+    for (unsigned run = 1; run <= ShaderCacheManifest::MaxUnusedRuns; ++run)
+    {
+        auto runManifest = MakeShared<ShaderCacheManifest>(context);
+        runManifest->AddVariation(usedEntry.shaderName_, usedEntry.type_, usedEntry.defines_);
+        REQUIRE(runManifest->Load(cacheDir, RenderBackend::Vulkan));
+        REQUIRE(runManifest->GetEntries().size() == 2);
+        CHECK(runManifest->GetEntries()[0] == usedEntry);
+        CHECK(runManifest->GetEntries()[0].numUnusedRuns_ == 0);
+        CHECK(runManifest->GetEntries()[1] == unusedEntry);
+        CHECK(runManifest->GetEntries()[1].numUnusedRuns_ == run);
+        REQUIRE(runManifest->Save(cacheDir, RenderBackend::Vulkan));
+    }
+
+    auto finalManifest = MakeShared<ShaderCacheManifest>(context);
+    REQUIRE(finalManifest->Load(cacheDir, RenderBackend::Vulkan));
+    REQUIRE(finalManifest->GetEntries().size() == 1);
+    CHECK(finalManifest->GetEntries()[0] == usedEntry);
+    CHECK(finalManifest->GetEntries()[0].numUnusedRuns_ == 1);
+}
@@ -0,0 +1,95 @@
+// Copyright (c) 2023-2023 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#include "../CommonUtils.h"
+#include "../ModelUtils.h"
+
+#include <Urho3D/Graphics/AnimatedModel.h>
+#include <Urho3D/Graphics/Graphics.h>
+#include <Urho3D/Graphics/Model.h>
+#include <Urho3D/Graphics/SoftwareModelAnimator.h>
+#include <Urho3D/Graphics/VertexBuffer.h>
+#include <Urho3D/Scene/Scene.h>
+
+TEST_CASE("SoftwareModelAnimator applies morphs and skinning to vertex ranges in one pass")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+
+    const unsigned numBones = 8;
+    const SharedPtr<Model> model = Tests::CreateSkinnedMorphedGrid_Model(context, numBones, 1000)->ExportModel();
+
+    ea::vector<ModelMorph> morphs = model->GetMorphs();
+    REQUIRE(morphs.size() == 1);
+    morphs[0].weight_ = 0.75f;
+
+    // Bones are rotated around Z axis, so Z coordinate is changed only by the morph
+    ea::vector<Matrix3x4> skinMatrices;
+    for (unsigned i = 0; i < numBones; ++i)
+        skinMatrices.emplace_back(Vector3::RIGHT * (i * 0.1f), Quaternion{i * 10.0f, Vector3::FORWARD}, 1.0f);
+
+    auto expectedAnimator = MakeShared<SoftwareModelAnimator>(context);
+    expectedAnimator->Initialize(model, true, SoftwareModelAnimator::MaxBones);
+    expectedAnimator->ResetAnimation();
+    expectedAnimator->ApplyMorphs(morphs);
+    expectedAnimator->ApplySkinning(skinMatrices);
+
+    auto actualAnimator = MakeShared<SoftwareModelAnimator>(context);
+    actualAnimator->Initialize(model, true, SoftwareModelAnimator::MaxBones);
+    actualAnimator->Update(morphs, skinMatrices);
+
+    VertexBuffer* expectedBuffer = expectedAnimator->GetVertexBuffers()[0];
+    VertexBuffer* actualBuffer = actualAnimator->GetVertexBuffers()[0];
+    REQUIRE(expectedBuffer);
+    REQUIRE(actualBuffer);
+    REQUIRE(actualBuffer->GetVertexCount() > SoftwareModelAnimator::VerticesPerTask);
+
+    const ea::vector<Vector4> expectedData = expectedBuffer->GetUnpackedData();
+    const ea::vector<Vector4> actualData = actualBuffer->GetUnpackedData();
+    REQUIRE(actualData.size() == expectedData.size());
+    for (unsigned i = 0; i < actualData.size(); ++i)
+        CHECK(actualData[i].Equals(expectedData[i], M_LARGE_EPSILON));
+
+    // Only even vertices are morphed
+    const unsigned numElements = actualBuffer->GetElements().size();
+    for (unsigned i = 0; i < actualBuffer->GetVertexCount(); ++i)
+    {
+        const float z = actualData[i * numElements].z_;
+        if (i % 2 == 0)
+            CHECK(z < -0.3f);
+        else
+            CHECK(Equals(z, 0.0f));
+    }
+}
+
+TEST_CASE("AnimatedModel applies morphs without Graphics")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    REQUIRE(!context->GetSubsystem<Graphics>());
+
+    const SharedPtr<Model> model = Tests::CreateSkinnedMorphedGrid_Model(context, 4, 10)->ExportModel();
+
+    auto scene = MakeShared<Scene>(context);
+    auto animatedModel = scene->CreateChild("Model")->CreateComponent<AnimatedModel>();
+    animatedModel->SetModel(model);
+    animatedModel->SetMorphWeight(0u, 1.0f);
+
+    FrameInfo frameInfo;
+    animatedModel->UpdateGeometry(frameInfo);
+
+    const auto& vertexBuffers = animatedModel->GetMorphVertexBuffers();
+    REQUIRE(vertexBuffers.size() == 1);
+    REQUIRE(vertexBuffers[0]);
+
+    // Only even vertices are morphed
+    const ea::vector<Vector4> data = vertexBuffers[0]->GetUnpackedData();
+    const unsigned numElements = vertexBuffers[0]->GetElements().size();
+    for (unsigned i = 0; i < vertexBuffers[0]->GetVertexCount(); ++i)
+    {
+        const float z = data[i * numElements].z_;
+        if (i % 2 == 0)
+            CHECK(Equals(z, -0.5f));
+        else
+            CHECK(Equals(z, 0.0f));
+    }
+}
@@ -0,0 +1,242 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../CommonUtils.h"
+
+#include <Urho3D/Math/BatchMath.h>
+#include <Urho3D/Math/RandomEngine.h>
+
+namespace
+{
+
+const unsigned numElements = 37;
+const float epsilon = 0.0001f;
+
+const ea::vector<BatchMathInstructionSet> instructionSets = {
+    BatchMathInstructionSet::AVX2,
+    BatchMathInstructionSet::NEON,
+};
+
+Matrix3x4 GetRandomTransform(RandomEngine& random)
+{
+    return Matrix3x4{random.GetVector3(-Vector3::ONE * 10.0f, Vector3::ONE * 10.0f), random.GetQuaternion(),
+        random.GetVector3(Vector3::ONE * 0.5f, Vector3::ONE * 2.0f)};
+}
+
+BoundingBox GetRandomBoundingBox(RandomEngine& random)
+{
+    const Vector3 center = random.GetVector3(-Vector3::ONE * 50.0f, Vector3::ONE * 50.0f);
+    const Vector3 halfSize = random.GetVector3(Vector3::ONE * 0.1f, Vector3::ONE * 5.0f);
+    return BoundingBox{center - halfSize, center + halfSize};
+}
+
+/// Instruction set override for the duration of the scope.
+class ScopedInstructionSet
+{
+public:
+    explicit ScopedInstructionSet(BatchMathInstructionSet instructionSet)
+        : previous_(GetBatchMathInstructionSet())
+    {
+        SetBatchMathInstructionSet(instructionSet);
+    }
+    ~ScopedInstructionSet() { SetBatchMathInstructionSet(previous_); }
+
+private:
+    BatchMathInstructionSet previous_{};
+};
+
+}
+
+TEST_CASE("Batch math functions match generic implementation")
+{
+    RandomEngine random{0u};
+
+    ea::vector<Matrix3x4> transforms;
+    ea::vector<Matrix3x4> otherTransforms;
+    ea::vector<Vector3> points;
+    ea::vector<BoundingBox> boxes;
+    for (unsigned i = 0; i < numElements; ++i)
+    {
+        transforms.push_back(GetRandomTransform(random));
+        otherTransforms.push_back(GetRandomTransform(random));
+        points.push_back(random.GetVector3(-Vector3::ONE * 10.0f, Vector3::ONE * 10.0f));
+        boxes.push_back(GetRandomBoundingBox(random));
+    }
+
+    Frustum frustum;
+    frustum.Define(60.0f, 1.5f, 1.0f, 0.1f, 60.0f, Matrix3x4{Vector3::BACK * 10.0f, Quaternion::IDENTITY, 1.0f});
+
+    ea::vector<Vector3> expectedPoints(numElements);
+    ea::vector<Matrix3x4> expectedTransforms(numElements);
+    ea::vector<BoundingBox> expectedBoxes(numElements);
+    bool expectedVisible[numElements]{};
+    BoundingBox expectedMerged;
+    {
+        ScopedInstructionSet guard{BatchMathInstructionSet::Generic};
+        REQUIRE(GetBatchMathInstructionSet() == BatchMathInstructionSet::Generic);
+
+        TransformPoints(transforms[0], points.data(), expectedPoints.data(), numElements);
+        MultiplyMatrices(transforms.data(), otherTransforms.data(), expectedTransforms.data(), numElements);
+        TransformBoundingBoxes(transforms.data(), boxes.data(), expectedBoxes.data(), numElements);
+        TestBoundingBoxesInFrustum(frustum, boxes.data(), expectedVisible, numElements);
+        expectedMerged = MergeBoundingBoxes(boxes.data(), numElements);
+    }
+
+    // Generic implementation may use SSE, it should match Frustum exactly
+    for (unsigned i = 0; i < numElements; ++i)
+        CHECK(expectedVisible[i] == (frustum.IsInsideFast(boxes[i]) != OUTSIDE));
+
+    // Test data should contain both visible and invisible boxes
+    const auto numVisible = ea::count(ea::begin(expectedVisible), ea::end(expectedVisible), true);
+    REQUIRE(numVisible > 0);
+    REQUIRE(numVisible < numElements);
+
+    for (const BatchMathInstructionSet instructionSet : instructionSets)
+    {
+        if (!IsBatchMathInstructionSetSupported(instructionSet))
+            continue;
+
+        ScopedInstructionSet guard{instructionSet};
+        REQUIRE(GetBatchMathInstructionSet() == instructionSet);
+
+        ea::vector<Vector3> actualPoints(numElements);
+        TransformPoints(transforms[0], points.data(), actualPoints.data(), numElements);
+        for (unsigned i = 0; i < numElements; ++i)
+            CHECK(actualPoints[i].Equals(expectedPoints[i], epsilon));
+
+        ea::vector<Matrix3x4> actualTransforms(numElements);
+        MultiplyMatrices(transforms.data(), otherTransforms.data(), actualTransforms.data(), numElements);
+        for (unsigned i = 0; i < numElements; ++i)
+            CHECK(actualTransforms[i].Equals(expectedTransforms[i], epsilon));
+
+        ea::vector<BoundingBox> actualBoxes(numElements);
+        TransformBoundingBoxes(transforms.data(), boxes.data(), actualBoxes.data(), numElements);
+        for (unsigned i = 0; i < numElements; ++i)
+        {
+            CHECK(actualBoxes[i].min_.Equals(expectedBoxes[i].min_, epsilon));
+            CHECK(actualBoxes[i].max_.Equals(expectedBoxes[i].max_, epsilon));
+        }
+
+        bool actualVisible[numElements]{};
+        TestBoundingBoxesInFrustum(frustum, boxes.data(), actualVisible, numElements);
+        for (unsigned i = 0; i < numElements; ++i)
+            CHECK(actualVisible[i] == expectedVisible[i]);
+
+        const BoundingBox actualMerged = MergeBoundingBoxes(boxes.data(), numElements);
+        CHECK(actualMerged.min_.Equals(expectedMerged.min_));
+        CHECK(actualMerged.max_.Equals(expectedMerged.max_));
+    }
+}
+
+TEST_CASE("Batch math functions support in-place operation")
+{
+    RandomEngine random{1u};
+    const Matrix3x4 transform = GetRandomTransform(random);
+
+    ea::vector<Vector3> points;
+    for (unsigned i = 0; i < numElements; ++i)
+        points.push_back(random.GetVector3(-Vector3::ONE, Vector3::ONE));
+
+    ea::vector<Vector3> expectedPoints;
+    for (const Vector3& point : points)
+        expectedPoints.push_back(transform * point);
+
+    TransformPoints(transform, points.data(), points.data(), numElements);
+    for (unsigned i = 0; i < numElements; ++i)
+        CHECK(points[i].Equals(expectedPoints[i], epsilon));
+
+    CHECK(MergeBoundingBoxes(nullptr, 0).Defined() == false);
+}
+
+TEST_CASE("Batch skinning matches generic implementation")
+{
+    RandomEngine random{2u};
+
+    // Vertex is position, normal and tangent with W component
+    const unsigned numBones = 8;
+    const unsigned maxBonesPerVertex = 4;
+    const unsigned vertexStride = 10;
+    const unsigned normalOffset = 3;
+    const unsigned tangentOffset = 6;
+
+    ea::vector<Matrix3x4> boneTransforms;
+    for (unsigned i = 0; i < numBones; ++i)
+        boneTransforms.push_back(GetRandomTransform(random));
+
+    ea::vector<float> vertices;
+    ea::vector<unsigned char> boneIndices;
+    ea::vector<float> boneWeights;
+    for (unsigned i = 0; i < numElements; ++i)
+    {
+        for (unsigned j = 0; j < vertexStride; ++j)
+            vertices.push_back(random.GetFloat(-1.0f, 1.0f));
+
+        float totalWeight = 0.0f;
+        for (unsigned j = 0; j < maxBonesPerVertex; ++j)
+        {
+            boneIndices.push_back(static_cast<unsigned char>(random.GetUInt(numBones)));
+            boneWeights.push_back(random.GetFloat(0.1f, 1.0f));
+            totalWeight += boneWeights.back();
+        }
+        for (unsigned j = 0; j < maxBonesPerVertex; ++j)
+            boneWeights[boneWeights.size() - 1 - j] /= totalWeight;
+    }
+
+    const auto skinVertices = [&](unsigned numBonesPerVertex, bool skinNormals, bool skinTangents)
+    {
+        ea::vector<float> result = vertices;
+        SkinVertices(boneTransforms.data(), boneIndices.data(), boneWeights.data(), numBonesPerVertex, result.data(),
+            vertexStride, skinNormals ? normalOffset : 0, skinTangents ? tangentOffset : 0, numElements);
+        return result;
+    };
+
+    for (const unsigned numBonesPerVertex : {1u, 2u, 4u})
+    {
+        for (const bool skinNormals : {false, true})
+        {
+            for (const bool skinTangents : {false, true})
+            {
+                ea::vector<float> expectedVertices;
+                {
+                    ScopedInstructionSet guard{BatchMathInstructionSet::Generic};
+                    expectedVertices = skinVertices(numBonesPerVertex, skinNormals, skinTangents);
+                }
+
+                // Tangent W component is never changed
+                for (unsigned i = 0; i < numElements; ++i)
+                    REQUIRE(expectedVertices[i * vertexStride + 9] == vertices[i * vertexStride + 9]);
+
+                for (const BatchMathInstructionSet instructionSet : instructionSets)
+                {
+                    if (!IsBatchMathInstructionSetSupported(instructionSet))
+                        continue;
+
+                    ScopedInstructionSet guard{instructionSet};
+                    const ea::vector<float> actualVertices = skinVertices(numBonesPerVertex, skinNormals, skinTangents);
+                    for (unsigned i = 0; i < vertices.size(); ++i)
+                        CHECK(Equals(actualVertices[i], expectedVertices[i], epsilon));
+                }
+            }
+        }
+    }
+}
@@ -52,3 +52,14 @@ TEST_CASE("StringHash is persistent and stable across builds and types")
     CHECK(StringHash{""}.IsEmpty());
     CHECK(!StringHash{testString}.IsEmpty());
 }
+
+TEST_CASE("StringHash is calculated at compile time")
+{
+    static constexpr StringHash testHash = "Test string 12345"_sh;
+    static_assert(testHash.Value() == 373547853u);
+    static_assert(StringHash{}.IsEmpty());
+    static_assert(""_sh.IsEmpty());
+
+    CHECK(testHash == StringHash{"Test string 12345"});
+    CHECK("Position"_sh == StringHash{ea::string{"Position"}});
+}
@@ -209,4 +209,58 @@ SharedPtr<ModelView> CreateSkinnedQuad_Model(Context* context)
     return modelView;
 }
 
+SharedPtr<ModelView> CreateSkinnedMorphedGrid_Model(Context* context, unsigned numBones, unsigned numQuads)
+{
+    auto modelView = MakeShared<ModelView>(context);
+
+    // Prepare vertex format
+    ModelVertexFormat format = GetVertexFormat();
+    format.tangent_ = TYPE_VECTOR4;
+    format.blendIndices_ = TYPE_UBYTE4;
+    format.blendWeights_ = TYPE_UBYTE4_NORM;
+
+    // Create geometry
+    auto& geometries = modelView->GetGeometries();
+    geometries.resize(1);
+    geometries[0].lods_.resize(1);
+    auto& geometry = geometries[0].lods_[0];
+    geometry.vertexFormat_ = format;
+
+    // Create bones
+    auto& bones = modelView->GetBones();
+    bones.resize(numBones);
+    for (unsigned i = 0; i < numBones; ++i)
+    {
+        bones[i].name_ = Format("Bone {}", i);
+        bones[i].parentIndex_ = i > 0 ? i - 1 : M_MAX_UNSIGNED;
+        bones[i].SetInitialTransform({ 0.0f, i > 0 ? 1.0f : 0.0f, 0.0f });
+        bones[i].RecalculateOffsetMatrix();
+    }
+
+    // Set geometry data
+    const float height = static_cast<float>(numBones);
+    for (unsigned i = 0; i < numQuads; ++i)
+    {
+        const float y = height * (i + 0.5f) / numQuads;
+        const unsigned firstBone = ea::min(static_cast<unsigned>(y), numBones - 1);
+        const Vector4 blendIndices{ static_cast<float>(firstBone),
+            static_cast<float>(ea::min(firstBone + 1, numBones - 1)),
+            static_cast<float>(ea::min(firstBone + 2, numBones - 1)),
+            static_cast<float>(ea::min(firstBone + 3, numBones - 1)) };
+        AppendSkinnedQuad(geometry, blendIndices, { 0.4f, 0.3f, 0.2f, 0.1f },
+            { 0.0f, y, 0.0f }, { 0.0f, Vector3::UP }, { 1.0f, height / numQuads }, Color::WHITE);
+    }
+
+    for (ModelVertex& vertex : geometry.vertices_)
+        vertex.tangent_ = { 1.0f, 0.0f, 0.0f, 1.0f };
+
+    // Create morph
+    ModelVertexMorphVector& morph = geometry.morphs_[0];
+    for (unsigned i = 0; i < geometry.vertices_.size(); i += 2)
+        morph.push_back(ModelVertexMorph{ i, Vector3::BACK * 0.5f, Vector3::BACK * 0.1f, Vector3::BACK * 0.1f });
+    modelView->SetMorphs({ ModelMorphView{ "Bend", 0.0f } });
+
+    return modelView;
+}
+
 }
@@ -60,4 +60,9 @@ SharedPtr<Animation> CreateCombinedAnimation(Context* context,
 ///   |-2: Second 1x1 quad at Y=1.5.
 SharedPtr<ModelView> CreateSkinnedQuad_Model(Context* context);
 
+/// Create test skinned and morphed model:
+/// chain of bones along Y axis and column of quads with tangents, each vertex is affected by 4 bones;
+/// morph 0 moves every other vertex along Z axis.
+SharedPtr<ModelView> CreateSkinnedMorphedGrid_Model(Context* context, unsigned numBones, unsigned numQuads);
+
 }
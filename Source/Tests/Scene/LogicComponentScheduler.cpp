@@ -0,0 +1,160 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../CommonUtils.h"
+#include "../SceneUtils.h"
+
+#include <Urho3D/Scene/LogicComponent.h>
+#include <Urho3D/Scene/LogicComponentScheduler.h>
+
+#include <atomic>
+
+namespace
+{
+
+ea::vector<ea::string> updateLog;
+
+class TestLogicComponentA : public LogicComponent
+{
+    URHO3D_OBJECT(TestLogicComponentA, LogicComponent);
+
+public:
+    using LogicComponent::LogicComponent;
+
+    void DelayedStart() override { updateLog.push_back(Format("{} DelayedStart", GetNode()->GetName())); }
+    void Update(float timeStep) override
+    {
+        updateLog.push_back(Format("{} Update", GetNode()->GetName()));
+        if (onUpdate_)
+            onUpdate_();
+    }
+    void PostUpdate(float timeStep) override { updateLog.push_back(Format("{} PostUpdate", GetNode()->GetName())); }
+
+    ea::function<void()> onUpdate_;
+};
+
+class TestLogicComponentB : public TestLogicComponentA
+{
+    URHO3D_OBJECT(TestLogicComponentB, TestLogicComponentA);
+
+public:
+    using TestLogicComponentA::TestLogicComponentA;
+};
+
+class TestParallelLogicComponent : public LogicComponent
+{
+    URHO3D_OBJECT(TestParallelLogicComponent, LogicComponent);
+
+public:
+    explicit TestParallelLogicComponent(Context* context)
+        : LogicComponent(context)
+    {
+        SetUpdateEventMask(USE_UPDATE | USE_PARALLEL_UPDATE);
+    }
+
+    void Update(float timeStep) override
+    {
+        ++numUpdates_;
+        numCalls_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    unsigned numUpdates_{};
+    static std::atomic<unsigned> numCalls_;
+};
+
+std::atomic<unsigned> TestParallelLogicComponent::numCalls_{};
+
+}
+
+TEST_CASE("LogicComponent updates are grouped by type")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto guard = Tests::MakeScopedReflection<TestLogicComponentA, TestLogicComponentB>(context);
+
+    auto scene = MakeShared<Scene>(context);
+    LogicComponentScheduler* scheduler = scene->GetLogicComponentScheduler();
+
+    auto componentA1 = scene->CreateChild("A1")->CreateComponent<TestLogicComponentA>();
+    auto componentB1 = scene->CreateChild("B1")->CreateComponent<TestLogicComponentB>();
+    auto componentA2 = scene->CreateChild("A2")->CreateComponent<TestLogicComponentA>();
+    componentB1->SetUpdateEventMask(USE_POSTUPDATE);
+
+    REQUIRE(scheduler->GetNumGroups() == 2);
+    REQUIRE(scheduler->GetNumComponents(LogicUpdatePhase::Update) == 3);
+    REQUIRE(scheduler->GetNumComponents(LogicUpdatePhase::PostUpdate) == 3);
+
+    updateLog.clear();
+    scene->Update(0.1f);
+    REQUIRE(updateLog == ea::vector<ea::string>{
+        "A1 DelayedStart", "A1 Update", "A2 DelayedStart", "A2 Update", "B1 DelayedStart",
+        "A1 PostUpdate", "A2 PostUpdate", "B1 PostUpdate"});
+    REQUIRE(scheduler->GetNumComponents(LogicUpdatePhase::Update) == 2);
+
+    // Component removes another component and disables itself during update
+    updateLog.clear();
+    componentA1->onUpdate_ = [&]
+    {
+        componentA2->Remove();
+        componentA1->SetEnabled(false);
+    };
+    scene->Update(0.1f);
+    REQUIRE(updateLog == ea::vector<ea::string>{"A1 Update", "B1 PostUpdate"});
+    REQUIRE(scheduler->GetNumComponents(LogicUpdatePhase::Update) == 0);
+    REQUIRE(scheduler->GetNumComponents(LogicUpdatePhase::PostUpdate) == 1);
+
+    updateLog.clear();
+    componentA1->onUpdate_ = nullptr;
+    componentA1->SetEnabled(true);
+    scene->Update(0.1f);
+    REQUIRE(updateLog == ea::vector<ea::string>{"A1 Update", "A1 PostUpdate", "B1 PostUpdate"});
+
+    // Components are not updated after removal from the scene
+    updateLog.clear();
+    componentA1->GetNode()->Remove();
+    componentB1->GetNode()->Remove();
+    scene->Update(0.1f);
+    REQUIRE(updateLog.empty());
+    REQUIRE(scheduler->GetNumComponents(LogicUpdatePhase::Update) == 0);
+    REQUIRE(scheduler->GetNumComponents(LogicUpdatePhase::PostUpdate) == 0);
+}
+
+TEST_CASE("LogicComponent updates are executed in parallel")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto guard = Tests::MakeScopedReflection<TestParallelLogicComponent>(context);
+
+    auto scene = MakeShared<Scene>(context);
+
+    static constexpr unsigned numComponents = 1000;
+    ea::vector<TestParallelLogicComponent*> components;
+    for (unsigned i = 0; i < numComponents; ++i)
+        components.push_back(scene->CreateChild()->CreateComponent<TestParallelLogicComponent>());
+
+    TestParallelLogicComponent::numCalls_ = 0;
+    scene->Update(0.1f);
+    scene->Update(0.1f);
+
+    REQUIRE(TestParallelLogicComponent::numCalls_ == 2 * numComponents);
+    REQUIRE(ea::all_of(components.begin(), components.end(),
+        [](const TestParallelLogicComponent* component) { return component->numUpdates_ == 2; }));
+}
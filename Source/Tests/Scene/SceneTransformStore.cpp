@@ -0,0 +1,114 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../CommonUtils.h"
+
+#include <Urho3D/Scene/Scene.h>
+#include <Urho3D/Scene/SceneTransformStore.h>
+
+namespace
+{
+
+Matrix3x4 CalculateWorldTransform(Node* node)
+{
+    if (node->IsTransformHierarchyRoot())
+        return node->GetTransformMatrix();
+    return CalculateWorldTransform(node->GetParent()) * node->GetTransformMatrix();
+}
+
+void CheckWorldTransforms(const ea::vector<Node*>& nodes)
+{
+    for (Node* node : nodes)
+    {
+        // Don't call GetWorldTransform, it would update dirty node
+        REQUIRE_FALSE(node->IsDirty());
+        REQUIRE(node->GetWorldTransform().Equals(CalculateWorldTransform(node), M_LARGE_EPSILON));
+    }
+}
+
+}
+
+TEST_CASE("Scene transform store updates world transforms of dirty nodes")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto scene = MakeShared<Scene>(context);
+    scene->SetTransformStoreEnabled(true);
+    SceneTransformStore* transformStore = scene->GetTransformStore();
+    REQUIRE(transformStore);
+
+    // Create 3 levels of hierarchy
+    ea::vector<Node*> nodes;
+    for (unsigned i = 0; i < 20; ++i)
+    {
+        Node* node = scene->CreateChild();
+        node->SetTransform({static_cast<float>(i), 0.0f, 1.0f}, Quaternion{i * 10.0f, Vector3::UP}, 1.5f);
+        nodes.push_back(node);
+
+        for (unsigned j = 0; j < 10; ++j)
+        {
+            Node* child = node->CreateChild();
+            child->SetTransform({0.0f, static_cast<float>(j), 0.0f}, Quaternion{j * 5.0f, Vector3::RIGHT}, 0.5f);
+            nodes.push_back(child);
+
+            Node* grandChild = child->CreateChild();
+            grandChild->SetPosition({1.0f, 2.0f, 3.0f});
+            nodes.push_back(grandChild);
+        }
+    }
+
+    scene->UpdateTransforms();
+    REQUIRE(transformStore->GetNumNodes() == nodes.size());
+    REQUIRE(transformStore->GetNumLevels() == 3);
+    CheckWorldTransforms(nodes);
+
+    // Move some nodes
+    nodes[0]->Translate({1.0f, 0.0f, 0.0f});
+    nodes[5]->Rotate(Quaternion{45.0f, Vector3::FORWARD});
+    nodes[42]->SetScale(2.0f);
+    REQUIRE(nodes[1]->IsDirty());
+    REQUIRE(nodes[6]->IsDirty());
+    REQUIRE_FALSE(nodes[30]->IsDirty());
+
+    scene->UpdateTransforms();
+    CheckWorldTransforms(nodes);
+
+    // Change hierarchy
+    Node* removedNode = nodes[21];
+    nodes.erase(nodes.begin() + 21, nodes.begin() + 42);
+    removedNode->Remove();
+
+    nodes[2]->SetParent(nodes[30]);
+    nodes[2]->Translate({0.0f, 1.0f, 0.0f});
+
+    scene->UpdateTransforms();
+    REQUIRE(transformStore->GetNumNodes() == nodes.size());
+    REQUIRE(transformStore->GetNumLevels() == 4);
+    CheckWorldTransforms(nodes);
+
+    // Disable store, node should be updated on demand
+    scene->SetTransformStoreEnabled(false);
+    nodes[1]->Translate({0.0f, 0.0f, 1.0f});
+    scene->UpdateTransforms();
+    REQUIRE(nodes[1]->IsDirty());
+    REQUIRE(nodes[1]->GetWorldTransform().Equals(CalculateWorldTransform(nodes[1]), M_LARGE_EPSILON));
+}
@@ -0,0 +1,230 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include <Urho3D/Core/Context.h>
+#include <Urho3D/Core/ProcessUtils.h>
+#include <Urho3D/Engine/Engine.h>
+#include <Urho3D/Engine/EngineDefs.h>
+#include <Urho3D/Graphics/Shader.h>
+#include <Urho3D/Graphics/ShaderBatchCompiler.h>
+#include <Urho3D/Graphics/ShaderCacheManifest.h>
+#include <Urho3D/IO/File.h>
+#include <Urho3D/IO/FileSystem.h>
+#include <Urho3D/IO/Log.h>
+#include <Urho3D/RenderAPI/RenderAPIUtils.h>
+#include <Urho3D/Resource/ResourceCache.h>
+
+#ifdef WIN32
+#include <windows.h>
+#endif
+
+#include <Urho3D/DebugNew.h>
+
+using namespace Urho3D;
+
+int main(int argc, char** argv);
+void Run(ea::vector<ea::string>& arguments);
+
+void Help()
+{
+    ErrorExit("Usage: ShaderPrecompiler -options <resource prefix directory> <shader cache directory>\n"
+        "\n"
+        "Compiles all shader variations listed in the shader cache manifest and stores them in shader cache directory.\n"
+        "The manifest is recorded by the application at runtime and is saved into its shader cache directory.\n"
+        "\n"
+        "Options:\n"
+        "-h Shows this help message.\n"
+        "-r Resource directories relative to prefix directory separated by ';'. CoreData;Data by default.\n"
+        "-b Render backend: d3d11, d3d12, opengl or vulkan. Taken from the manifest by default.\n"
+        "-p Shader translation policy: verbatim, translate or optimize. Default for render backend is used by default.\n"
+        "-m Directory with shader cache manifest. Shader cache directory is used by default.\n");
+}
+
+ea::optional<RenderBackend> ParseRenderBackend(const ea::string& name)
+{
+    for (int i = 0; i < static_cast<int>(RenderBackend::Count); ++i)
+    {
+        const auto backend = static_cast<RenderBackend>(i);
+        if (ToString(backend).comparei(name) == 0)
+            return backend;
+    }
+    return ea::nullopt;
+}
+
+ea::optional<ShaderTranslationPolicy> ParseShaderTranslationPolicy(const ea::string& name)
+{
+    const ea::string lowerName = name.to_lower();
+    if (lowerName == "verbatim")
+        return ShaderTranslationPolicy::Verbatim;
+    else if (lowerName == "translate")
+        return ShaderTranslationPolicy::Translate;
+    else if (lowerName == "optimize")
+        return ShaderTranslationPolicy::Optimize;
+    return ea::nullopt;
+}
+
+int main(int argc, char** argv)
+{
+    ea::vector<ea::string> arguments;
+
+#ifdef WIN32
+    arguments = ParseArguments(GetCommandLineW());
+#else
+    arguments = ParseArguments(argc, argv);
+#endif
+
+    Run(arguments);
+    return 0;
+}
+
+void Run(ea::vector<ea::string>& arguments)
+{
+    ea::string resourcePaths = "CoreData;Data";
+    ea::optional<RenderBackend> requestedBackend;
+    ea::optional<ShaderTranslationPolicy> requestedPolicy;
+    ea::string manifestDir;
+    ea::vector<ea::string> positionalArguments;
+
+    for (unsigned i = 0; i < arguments.size(); ++i)
+    {
+        const ea::string& arg = arguments[i];
+        if (arg.starts_with("-") && arg.length() == 2)
+        {
+            const char option = arg[1];
+            if (option == 'h' || i + 1 >= arguments.size())
+                Help();
+
+            const ea::string& value = arguments[++i];
+            switch (option)
+            {
+            case 'r':
+                resourcePaths = value;
+                break;
+
+            case 'b':
+                requestedBackend = ParseRenderBackend(value);
+                if (!requestedBackend)
+                    ErrorExit("Unknown render backend " + value);
+                break;
+
+            case 'p':
+                requestedPolicy = ParseShaderTranslationPolicy(value);
+                if (!requestedPolicy)
+                    ErrorExit("Unknown shader translation policy " + value);
+                break;
+
+            case 'm':
+                manifestDir = value;
+                break;
+
+            default:
+                Help();
+            }
+        }
+        else
+            positionalArguments.push_back(arg);
+    }
+
+    if (positionalArguments.size() != 2)
+        Help();
+
+    SharedPtr<Context> context(new Context());
+    SharedPtr<Engine> engine(new Engine(context));
+
+    auto fileSystem = context->GetSubsystem<FileSystem>();
+    const ea::string prefixDir = AddTrailingSlash(GetAbsolutePath(positionalArguments[0]));
+    const ea::string cacheDir = AddTrailingSlash(GetAbsolutePath(positionalArguments[1]));
+    manifestDir = manifestDir.empty() ? cacheDir : AddTrailingSlash(GetAbsolutePath(manifestDir));
+
+    StringVariantMap parameters;
+    parameters[EP_HEADLESS] = true;
+    parameters[EP_RESOURCE_PREFIX_PATHS] = prefixDir;
+    parameters[EP_RESOURCE_PATHS] = resourcePaths;
+    if (!engine->Initialize(parameters, {}))
+        ErrorExit("Failed to initialize engine");
+
+    // Manifest is bound to render backend, so try all backends unless specific one is requested
+    auto manifest = MakeShared<ShaderCacheManifest>(context);
+    const FileIdentifier manifestDirId = FileIdentifier::FromUri(manifestDir);
+    ea::optional<RenderBackend> renderBackend;
+    for (int i = 0; i < static_cast<int>(RenderBackend::Count) && !renderBackend; ++i)
+    {
+        const auto backend = static_cast<RenderBackend>(i);
+        if ((!requestedBackend || *requestedBackend == backend) && manifest->Load(manifestDirId, backend))
+            renderBackend = backend;
+    }
+
+    if (!renderBackend)
+        ErrorExit("Failed to load shader cache manifest from " + manifestDir);
+
+    const ShaderTranslationPolicy policy = SelectShaderTranslationPolicy(*renderBackend, requestedPolicy);
+
+    // Load shaders from main thread, compile variations on worker threads
+    auto cache = context->GetSubsystem<ResourceCache>();
+    auto compiler = MakeShared<ShaderBatchCompiler>(context);
+    ea::vector<ea::string> cachedNames;
+    for (const ShaderCacheManifestEntry& entry : manifest->GetEntries())
+    {
+        Shader* shader = cache->GetResource<Shader>(entry.shaderName_);
+        if (!shader)
+            continue;
+
+        ShaderVariationCompileDesc desc;
+        desc.shaderName_ = shader->GetShaderName();
+        desc.type_ = entry.type_;
+        desc.defines_ = entry.defines_;
+        desc.sourceCode_ = shader->GetSourceCode();
+        desc.renderBackend_ = *renderBackend;
+        desc.translationPolicy_ = policy;
+
+        compiler->AddVariation(desc);
+        cachedNames.push_back(ShaderVariation::GetCachedVariationName(
+            desc.shaderName_, desc.type_, desc.defines_, desc.renderBackend_, "bytecode"));
+    }
+
+    PrintLine(Format("Compiling {} unique shader variations out of {} for {}...",
+        compiler->GetNumUniqueVariations(), compiler->GetNumVariations(), ToString(*renderBackend)));
+    compiler->Compile();
+
+    unsigned numFailed = 0;
+    for (unsigned i = 0; i < compiler->GetNumVariations(); ++i)
+    {
+        if (!compiler->IsCompiled(i))
+        {
+            PrintLine("Failed to compile " + cachedNames[i], true);
+            ++numFailed;
+            continue;
+        }
+
+        const ea::string fileName = cacheDir + cachedNames[i];
+        fileSystem->CreateDirsRecursive(GetPath(fileName));
+
+        File file(context, fileName, FILE_WRITE);
+        if (!file.IsOpen() || !compiler->GetBytecode(i).SaveToFile(file))
+            ErrorExit("Failed to write " + fileName);
+    }
+
+    PrintLine(Format("Compiled {} shader variations, {} failed", compiler->GetNumVariations() - numFailed, numFailed));
+    if (numFailed > 0)
+        ErrorExit();
+}
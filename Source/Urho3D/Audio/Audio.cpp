@@ -397,7 +397,7 @@ void Audio::MixOutput(void* dest, unsigned samples)
             // Check for pause if necessary
             if (!pausedSoundTypes_.empty())
             {
-                if (pausedSoundTypes_.contains(source->GetSoundType()))
+                if (pausedSoundTypes_.contains(source->GetSoundTypeHash()))
                     continue;
             }
 
@@ -443,7 +443,7 @@ void Audio::UpdateInternal(float timeStep)
         // Check for pause if necessary; do not update paused sound sources
         if (!pausedSoundTypes_.empty())
         {
-            if (pausedSoundTypes_.contains(source->GetSoundType()))
+            if (pausedSoundTypes_.contains(source->GetSoundTypeHash()))
                 continue;
         }
 
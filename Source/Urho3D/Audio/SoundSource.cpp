@@ -264,8 +264,7 @@ void SoundSource::SetSoundType(const ea::string& type)
     if (type == SOUND_MASTER)
         return;
 
-    soundType_ = type;
-    soundTypeHash_ = StringHash(type);
+    soundType_ = InternedString{type};
     UpdateMasterGain();
 }
 
@@ -487,7 +486,7 @@ void SoundSource::Mix(int dest[], unsigned samples, int mixRate, SpeakerMode mod
 void SoundSource::UpdateMasterGain()
 {
     if (audio_)
-        masterGain_ = audio_->GetSoundSourceMasterGain(soundType_);
+        masterGain_ = audio_->GetSoundSourceMasterGain(soundType_.GetHash());
 }
 
 void SoundSource::SetSoundAttr(const ResourceRef& value)
@@ -23,6 +23,7 @@
 #pragma once
 
 #include "../Audio/AudioDefs.h"
+#include "../Container/InternedString.h"
 #include "../Scene/Component.h"
 
 namespace Urho3D
@@ -98,7 +99,9 @@ public:
 
     /// Return sound type, determines the master gain group.
     /// @property
-    ea::string GetSoundType() const { return soundType_; }
+    ea::string GetSoundType() const { return soundType_.ToString(); }
+    /// Return hash of sound type.
+    StringHash GetSoundTypeHash() const { return soundType_.GetHash(); }
 
     /// Return playback time position.
     /// @property
@@ -157,10 +160,8 @@ public:
 protected:
     /// Audio subsystem.
     WeakPtr<Audio> audio_;
-    /// SoundSource type, determines the master gain group.
-    ea::string soundType_;
-    /// SoundSource type hash.
-    StringHash soundTypeHash_;
+    /// SoundSource type, determines the master gain group. Interned to avoid copying and hashing in the mixer.
+    InternedString soundType_;
     /// Frequency.
     float frequency_;
     /// Gain.
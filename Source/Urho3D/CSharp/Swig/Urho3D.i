@@ -515,6 +515,8 @@ public:
 %ignore Urho3D::Node::SetEntity;
 %ignore Urho3D::Scene::GetRegistry;
 %ignore Urho3D::Scene::GetComponentIndex;
+%ignore Urho3D::Scene::GetLogicComponentScheduler;
+%ignore Urho3D::Scene::GetTransformStore;
 %ignore Urho3D::Animatable::animationEnabled_;
 %ignore Urho3D::Animatable::objectAnimation_;
 %ignore Urho3D::Component::node_;
@@ -619,6 +621,8 @@ public:
 %ignore Urho3D::PointOctreeQuery::TestDrawables;
 %ignore Urho3D::BoxOctreeQuery::TestDrawables;
 %ignore Urho3D::OctreeQuery::TestDrawables;
+%ignore Urho3D::DrawableBVH;
+%ignore Urho3D::Octree::GetBVH;
 %ignore Urho3D::ProcessLightWork;
 %ignore Urho3D::CheckVisibilityWork;
 %ignore Urho3D::ELEMENT_TYPESIZES;
@@ -641,6 +645,16 @@ public:
 %ignore Urho3D::DecalVertex::blendIndices_;
 %ignore Urho3D::DecalVertex::blendWeights_;
 %ignore Urho3D::ShaderVariation::elementSemanticNames;
+%ignore Urho3D::ShaderVariation::GetCompileDesc;
+%ignore Urho3D::ShaderVariation::CompileBytecode;
+%ignore Urho3D::ShaderVariationCompileDesc;
+%ignore Urho3D::Graphics::GetShaderCacheManifest;
+%ignore Urho3D::Animation::Compress;
+%ignore Urho3D::AnimationTrack::compressed_;
+%ignore Urho3D::AnimationTrack::Compress;
+%ignore Urho3D::AnimationBudgetSettings::buckets_;
+%ignore Urho3D::AnimationBudgetStats::numModels_;
+%ignore Urho3D::AnimationBudgetStats::numUpdates_;
 %ignore Urho3D::CustomGeometry::DrawOcclusion;
 %ignore Urho3D::CustomGeometry::MakeCircleGraph;
 %ignore Urho3D::CustomGeometry::ProcessRayQuery;
@@ -716,6 +730,9 @@ public:
 %include "Urho3D/Graphics/AnimationStateSource.h"
 %include "Urho3D/Graphics/AnimationController.h"
 %include "Urho3D/Graphics/AnimatedModel.h"
+%include "Urho3D/Graphics/AnimationBudgetManager.h"
+%include "Urho3D/Graphics/AnimationPalette.h"
+%include "Urho3D/Graphics/PaletteAnimatedModel.h"
 %include "Urho3D/Graphics/BillboardSet.h"
 %include "Urho3D/Graphics/DecalSet.h"
 %include "Urho3D/Graphics/Light.h"
@@ -1039,7 +1056,7 @@ using ImGuiConfigFlags = unsigned;
 #endif
 
 %template(StringMap)                    eastl::unordered_map<Urho3D::StringHash, eastl::string>;
-%template(VariantMap)                   eastl::unordered_map<Urho3D::StringHash, Urho3D::Variant, eastl::hash<Urho3D::StringHash>, eastl::equal_to<Urho3D::StringHash>, eastl::allocator, false>;
+%template(VariantMap)                   eastl::unordered_map<Urho3D::StringHash, Urho3D::Variant, eastl::hash<Urho3D::StringHash>, eastl::equal_to<Urho3D::StringHash>, Urho3D::PoolAllocator, false>;
 %template(StringVariantMap)             eastl::unordered_map<eastl::string, Urho3D::Variant, eastl::hash<eastl::string>, eastl::equal_to<eastl::string>, eastl::allocator, true>;
 %template(AttributeMap)                 eastl::unordered_map<Urho3D::StringHash, eastl::vector<Urho3D::AttributeInfo>>;
 %template(PackageMap)                   eastl::unordered_map<eastl::string, Urho3D::PackageEntry>;
@@ -0,0 +1,103 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../Precompiled.h"
+
+#include "../Container/InternedString.h"
+
+#include "../Container/LinearArena.h"
+#include "../Core/Mutex.h"
+
+#include <EASTL/unordered_map.h>
+
+namespace Urho3D
+{
+
+/// Global table of interned strings. Strings are stored in the arena and never released.
+class InternedStringTable
+{
+public:
+    using Entry = InternedString::Entry;
+
+    /// Return global instance.
+    static InternedStringTable& Get()
+    {
+        static InternedStringTable table;
+        return table;
+    }
+
+    /// Find or add string.
+    const Entry* Intern(ea::string_view str)
+    {
+        MutexLock lock(mutex_);
+
+        const auto iter = entries_.find(str);
+        if (iter != entries_.end())
+            return iter->second;
+
+        const auto length = static_cast<unsigned>(str.length());
+        auto data = static_cast<char*>(arena_.Allocate(length + 1, 1));
+        memcpy(data, str.data(), length);
+        data[length] = '\0';
+
+        auto entry = new (arena_.Allocate(sizeof(Entry), alignof(Entry))) Entry{StringHash{str}, length, data};
+        entries_.emplace(ea::string_view{data, length}, entry);
+        return entry;
+    }
+
+    /// Return number of strings.
+    unsigned GetNumStrings() const
+    {
+        MutexLock lock(mutex_);
+        return entries_.size();
+    }
+
+    /// Return memory used by the strings.
+    unsigned GetMemoryUse() const
+    {
+        MutexLock lock(mutex_);
+        return arena_.GetCapacity();
+    }
+
+private:
+    mutable Mutex mutex_;
+    LinearArena arena_;
+    ea::unordered_map<ea::string_view, const Entry*> entries_;
+};
+
+InternedString::InternedString(ea::string_view str)
+    : entry_(str.empty() ? nullptr : InternedStringTable::Get().Intern(str))
+{
+}
+
+unsigned InternedString::GetNumStrings()
+{
+    return InternedStringTable::Get().GetNumStrings();
+}
+
+unsigned InternedString::GetMemoryUse()
+{
+    return InternedStringTable::Get().GetMemoryUse();
+}
+
+}
@@ -0,0 +1,97 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+/// \file
+
+#pragma once
+
+#include "../Math/StringHash.h"
+
+#include <EASTL/string.h>
+#include <EASTL/string_view.h>
+
+namespace Urho3D
+{
+
+/// Immutable string stored in the global string table.
+/// Equal strings share the same storage, so copy and comparison cost as much as for a pointer.
+/// Use it instead of ea::string for long-living identifiers like names and resource paths.
+/// Interned strings are never released.
+class URHO3D_API InternedString
+{
+public:
+    /// Construct empty.
+    InternedString() = default;
+    /// Construct from string. Looks up the global string table and adds the string if it's missing.
+    explicit InternedString(ea::string_view str);
+
+    /// Return null-terminated string.
+    const char* c_str() const { return entry_ ? entry_->data_ : ""; }
+    /// Return length of the string.
+    unsigned length() const { return entry_ ? entry_->length_ : 0; }
+    /// Return whether the string is empty.
+    bool empty() const { return entry_ == nullptr; }
+    /// Return string view.
+    ea::string_view GetView() const { return {c_str(), length()}; }
+    /// Return copy of the string.
+    ea::string ToString() const { return ea::string{GetView()}; }
+
+    /// Return precomputed hash of the string.
+    StringHash GetHash() const { return entry_ ? entry_->hash_ : StringHash::Empty; }
+    /// Return precomputed hash of the string.
+    operator StringHash() const { return GetHash(); }
+    /// Return string view.
+    operator ea::string_view() const { return GetView(); }
+    /// Return hash value for HashSet & HashMap.
+    unsigned ToHash() const { return GetHash().Value(); }
+
+    /// Compare strings. Interned strings are compared by pointers.
+    /// @{
+    bool operator==(const InternedString& rhs) const { return entry_ == rhs.entry_; }
+    bool operator!=(const InternedString& rhs) const { return entry_ != rhs.entry_; }
+    bool operator==(ea::string_view rhs) const { return GetView() == rhs; }
+    bool operator!=(ea::string_view rhs) const { return GetView() != rhs; }
+    bool operator<(const InternedString& rhs) const { return GetView() < rhs.GetView(); }
+    /// @}
+
+    /// Return number of strings in the global string table.
+    static unsigned GetNumStrings();
+    /// Return memory used by the global string table, in bytes.
+    static unsigned GetMemoryUse();
+
+private:
+    friend class InternedStringTable;
+
+    /// Entry of the string table.
+    struct Entry
+    {
+        StringHash hash_;
+        unsigned length_{};
+        const char* data_{};
+    };
+
+    /// Entry in the global string table.
+    const Entry* entry_{};
+};
+
+}
@@ -24,8 +24,9 @@
 
 #include "../Core/Variant.h"
 
-#include <EASTL/vector.h>
+#include <EASTL/algorithm.h>
 #include <EASTL/sort.h>
+#include <EASTL/vector.h>
 
 namespace Urho3D
 {
@@ -102,15 +103,23 @@ struct KeyFrameSet
         if (time < 0.0f)
             time = 0.0f;
 
-        if (index >= keyFrames_.size())
-            index = keyFrames_.size() - 1;
+        const unsigned numKeyFrames = keyFrames_.size();
+        if (index >= numKeyFrames)
+            index = numKeyFrames - 1;
 
-        // Check for being too far ahead
-        while (index && time < keyFrames_[index].time_)
-            --index;
+        // Hint is usually valid or one keyframe behind during continuous playback.
+        // Fall back to binary search on seek or wrap around.
+        const bool isHintBehind = index + 2 < numKeyFrames && time >= keyFrames_[index + 2].time_;
+        if (time < keyFrames_[index].time_ || isHintBehind)
+        {
+            static const auto compare = [](float lhs, const KeyFrame& rhs) { return lhs < rhs.time_; };
+            const auto iter = ea::upper_bound(keyFrames_.begin(), keyFrames_.end(), time, compare);
+            index = iter != keyFrames_.begin() ? static_cast<unsigned>(iter - keyFrames_.begin()) - 1 : 0;
+            return true;
+        }
 
-        // Check for being too far behind
-        while (index < keyFrames_.size() - 1 && time >= keyFrames_[index + 1].time_)
+        // Check for being one keyframe behind
+        if (index < numKeyFrames - 1 && time >= keyFrames_[index + 1].time_)
             ++index;
 
         return true;
@@ -0,0 +1,121 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../Precompiled.h"
+
+#include "../Container/LinearArena.h"
+#include "../Core/Assert.h"
+
+#include <limits>
+#include <new>
+
+#include "../DebugNew.h"
+
+namespace Urho3D
+{
+
+LinearArena::LinearArena(unsigned blockSize)
+    : blockSize_(blockSize)
+{
+}
+
+LinearArena::~LinearArena()
+{
+}
+
+void* LinearArena::Allocate(unsigned size, unsigned alignment)
+{
+    URHO3D_ASSERT(alignment != 0 && (alignment & (alignment - 1)) == 0, "Alignment should be power of two");
+
+    // New block reserves space for alignment, so the size of the block should not overflow
+    if (size > std::numeric_limits<unsigned>::max() - alignment)
+        throw std::bad_alloc();
+
+    for (; currentBlock_ < blocks_.size(); ++currentBlock_, offset_ = 0)
+    {
+        if (void* ptr = TryAllocate(size, alignment))
+            return ptr;
+    }
+
+    // Reserve space for alignment so the allocation always fits into the new block
+    blocks_.push_back(CreateBlock(ea::max(blockSize_, size + alignment)));
+    currentBlock_ = blocks_.size() - 1;
+    offset_ = 0;
+
+    void* ptr = TryAllocate(size, alignment);
+    URHO3D_ASSERT(ptr);
+    return ptr;
+}
+
+void* LinearArena::TryAllocate(unsigned size, unsigned alignment)
+{
+    Block& block = blocks_[currentBlock_];
+    const auto blockBegin = reinterpret_cast<uintptr_t>(block.data_.get());
+    const uintptr_t alignedBegin = (blockBegin + offset_ + alignment - 1) & ~static_cast<uintptr_t>(alignment - 1);
+    const uintptr_t alignedEnd = alignedBegin + size;
+    if (alignedEnd > blockBegin + block.size_)
+        return nullptr;
+
+    offset_ = static_cast<unsigned>(alignedEnd - blockBegin);
+    allocatedSize_ += size;
+    return reinterpret_cast<void*>(alignedBegin);
+}
+
+void LinearArena::Reset()
+{
+    if (blocks_.size() > 1)
+    {
+        // Keep the blocks as is if merged block is too big
+        unsigned long long capacity = 0;
+        for (const Block& block : blocks_)
+            capacity += block.size_;
+
+        if (capacity <= std::numeric_limits<unsigned>::max())
+        {
+            blocks_.clear();
+            blocks_.push_back(CreateBlock(static_cast<unsigned>(capacity)));
+        }
+    }
+
+    currentBlock_ = 0;
+    offset_ = 0;
+    allocatedSize_ = 0;
+}
+
+unsigned LinearArena::GetCapacity() const
+{
+    unsigned capacity = 0;
+    for (const Block& block : blocks_)
+        capacity += block.size_;
+    return capacity;
+}
+
+LinearArena::Block LinearArena::CreateBlock(unsigned size)
+{
+    Block block;
+    block.data_ = ea::make_unique<unsigned char[]>(size);
+    block.size_ = size;
+    return block;
+}
+
+}
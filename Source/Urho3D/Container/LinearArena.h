@@ -0,0 +1,89 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#pragma once
+
+#include "../Core/NonCopyable.h"
+
+#include <Urho3D/Urho3D.h>
+
+#include <EASTL/unique_ptr.h>
+#include <EASTL/vector.h>
+
+#include <cstddef>
+
+namespace Urho3D
+{
+
+/// Allocator that linearly allocates memory from big blocks and releases all memory at once.
+/// Individual allocations cannot be freed. Not thread-safe.
+class URHO3D_API LinearArena : public NonCopyable
+{
+public:
+    /// Default size of the memory block.
+    static constexpr unsigned DefaultBlockSize = 64 * 1024;
+
+    /// Construct.
+    explicit LinearArena(unsigned blockSize = DefaultBlockSize);
+    /// Destruct.
+    ~LinearArena();
+
+    /// Allocate memory. Never returns null, throws std::bad_alloc if the size is too big.
+    void* Allocate(unsigned size, unsigned alignment = alignof(std::max_align_t));
+    /// Release all allocated memory for reuse.
+    /// If more than one block was used, blocks are merged so the next cycle doesn't need heap allocations.
+    void Reset();
+
+    /// Return total size of allocations since last reset.
+    unsigned GetAllocatedSize() const { return allocatedSize_; }
+    /// Return total size of all memory blocks.
+    unsigned GetCapacity() const;
+    /// Return number of memory blocks.
+    unsigned GetNumBlocks() const { return blocks_.size(); }
+
+private:
+    /// Memory block.
+    struct Block
+    {
+        ea::unique_ptr<unsigned char[]> data_;
+        unsigned size_{};
+    };
+
+    /// Try to allocate memory from current block.
+    void* TryAllocate(unsigned size, unsigned alignment);
+    /// Create new block of given size.
+    static Block CreateBlock(unsigned size);
+
+    /// Default size of the block.
+    const unsigned blockSize_{};
+    /// Memory blocks.
+    ea::vector<Block> blocks_;
+    /// Index of current block.
+    unsigned currentBlock_{};
+    /// Offset in current block.
+    unsigned offset_{};
+    /// Total size of allocations since last reset.
+    unsigned allocatedSize_{};
+};
+
+}
@@ -83,11 +83,15 @@ void EventReceiverGroup::EndSendEvent()
 void EventReceiverGroup::Add(Object* object)
 {
     if (object)
+    {
         receivers_.push_back(object);
+        handlersValid_ = false;
+    }
 }
 
 void EventReceiverGroup::Remove(Object* object)
 {
+    handlersValid_ = false;
     if (inSend_ > 0)
     {
         auto i = receivers_.find(object);
@@ -101,6 +105,13 @@ void EventReceiverGroup::Remove(Object* object)
         receivers_.erase_first(object);
 }
 
+void EventReceiverGroup::SetHandlers(ea::vector<EventHandler*>&& handlers)
+{
+    assert(inSend_ == 0 && handlers.size() == receivers_.size());
+    handlers_ = ea::move(handlers);
+    handlersValid_ = true;
+}
+
 void RemoveNamedAttribute(ea::unordered_map<StringHash, ea::vector<AttributeInfo> >& attributes, StringHash objectType, const char* name)
 {
     auto i = attributes.find(objectType);
@@ -324,6 +335,8 @@ void Context::RemoveEventSender(Object* sender)
     {
         for (auto j = i->second.begin(); j != i->second.end(); ++j)
         {
+            // Group may be still alive if the sender is destroyed during send
+            j->second->InvalidateHandlers();
             for (auto k = j->second->receivers_.begin(); k !=
                 j->second->receivers_.end(); ++k)
             {
@@ -350,14 +363,36 @@ void Context::RemoveEventReceiver(Object* receiver, Object* sender, StringHash e
         group->Remove(receiver);
 }
 
-void Context::BeginSendEvent(Object* sender, StringHash eventType)
+void Context::InvalidateEventHandlers(Object* sender, StringHash eventType)
+{
+    EventReceiverGroup* group = sender ? GetEventReceivers(sender, eventType) : GetEventReceivers(eventType);
+    if (group)
+        group->InvalidateHandlers();
+}
+
+void Context::BeginSendEvent(Object* sender, StringHash eventType, const void* typedEventData, TypedEventWriter writer)
 {
     eventSenders_.push_back(sender);
+    typedEventData_.push_back(TypedEventData{typedEventData, writer, false});
 }
 
 void Context::EndSendEvent()
 {
     eventSenders_.pop_back();
+    typedEventData_.pop_back();
+}
+
+void Context::WriteTypedEventData(VariantMap& eventData)
+{
+    if (typedEventData_.empty())
+        return;
+
+    TypedEventData& typedEventData = typedEventData_.back();
+    if (typedEventData.data_ && !typedEventData.written_)
+    {
+        typedEventData.writer_(typedEventData.data_, eventData);
+        typedEventData.written_ = true;
+    }
 }
 
 }
@@ -56,14 +56,27 @@ public:
     /// Remove receiver. Leave holes during send, which requires later cleanup.
     void Remove(Object* object);
 
+    /// Return whether event is being sent to the group.
+    bool IsInSend() const { return inSend_ > 0; }
+    /// Return whether cached handlers match receivers.
+    bool AreHandlersValid() const { return handlersValid_; }
+    /// Invalidate cached handlers. Called on any subscription change of receivers.
+    void InvalidateHandlers() { handlersValid_ = false; }
+    /// Set cached handlers. Should not be called during send.
+    void SetHandlers(ea::vector<EventHandler*>&& handlers);
+
     /// Receivers. May contain holes during sending.
     ea::vector<Object*> receivers_;
+    /// Event handlers of receivers, flat array parallel to receivers. Used only if valid.
+    ea::vector<EventHandler*> handlers_;
 
 private:
     /// "In send" recursion counter.
     unsigned inSend_;
     /// Cleanup required flag.
     bool dirty_;
+    /// Whether cached handlers are valid.
+    bool handlersValid_{};
 };
 
 /// Urho3D execution context. Provides access to subsystems, object factories and attributes, and event receivers.
@@ -170,13 +183,28 @@ private:
     void RemoveEventReceiver(Object* receiver, Object* sender, StringHash eventType);
     /// Remove event receiver from non-specific events.
     void RemoveEventReceiver(Object* receiver, StringHash eventType);
-    /// Begin event send.
-    void BeginSendEvent(Object* sender, StringHash eventType);
+    /// Invalidate cached handlers when receiver replaces its event handler. Sender is null for non-specific events.
+    void InvalidateEventHandlers(Object* sender, StringHash eventType);
+    /// Begin event send. Typed event data is null for regular events.
+    void BeginSendEvent(Object* sender, StringHash eventType, const void* typedEventData = nullptr,
+        TypedEventWriter writer = nullptr);
     /// End event send. Clean up event receivers removed in the meanwhile.
     void EndSendEvent();
 
     /// Set current event handler. Called by Object.
     void SetEventHandler(EventHandler* handler) { eventHandler_ = handler; }
+    /// Return typed data of the event being sent, or null if the event is not typed.
+    const void* GetTypedEventData() const { return !typedEventData_.empty() ? typedEventData_.back().data_ : nullptr; }
+    /// Write typed data of the event being sent into VariantMap. Does nothing if already written or not typed.
+    void WriteTypedEventData(VariantMap& eventData);
+
+    /// Typed data of the event being sent.
+    struct TypedEventData
+    {
+        const void* data_{};
+        TypedEventWriter writer_{};
+        bool written_{};
+    };
 
     /// Subsystems.
     SubsystemCache subsystems_;
@@ -188,6 +216,8 @@ private:
     ea::vector<Object*> eventSenders_;
     /// Event data stack.
     ea::vector<VariantMap*> eventDataMaps_;
+    /// Typed event data stack, parallel to event sender stack.
+    ea::vector<TypedEventData> typedEventData_;
     /// Active event handler. Not stored in a stack for performance reasons; is needed only in esoteric cases.
     EventHandler* eventHandler_;
     /// Variant map for global variables that can persist throughout application execution.
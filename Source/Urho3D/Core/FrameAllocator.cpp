@@ -0,0 +1,155 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../Precompiled.h"
+
+#include "../Container/LinearArena.h"
+#include "../Core/Assert.h"
+#include "../Core/FrameAllocator.h"
+#include "../IO/Log.h"
+
+#include <atomic>
+#include <limits>
+#include <new>
+
+namespace Urho3D
+{
+
+namespace
+{
+
+/// Number of frames after which the warning is logged if the arena still cannot be reset.
+static const unsigned MaxFramesWithoutReset = 60;
+
+/// Index of the current frame.
+std::atomic<unsigned> currentFrameIndex{1};
+
+/// Linear allocator of the thread that is reset lazily once per frame.
+struct ThreadFrameArena
+{
+    LinearArena allocator_;
+    /// Number of allocations that are not deallocated yet. Allocations may be deallocated from other threads.
+    std::atomic<unsigned> numLiveAllocations_{};
+    /// Frame when the arena was checked for the last time.
+    unsigned frameIndex_{};
+    /// Frame when the arena was reset for the last time.
+    unsigned resetFrameIndex_{};
+    /// Whether the warning about stale allocations is logged.
+    bool warningLogged_{};
+};
+
+/// Header stored right before each allocation.
+struct AllocationHeader
+{
+    ThreadFrameArena* arena_{};
+};
+
+/// Owner of the thread arena. Arena with live allocations is leaked on thread exit so they can be safely deallocated.
+struct ThreadFrameArenaHolder
+{
+    ThreadFrameArena* arena_{new ThreadFrameArena};
+
+    ~ThreadFrameArenaHolder()
+    {
+        if (arena_->numLiveAllocations_.load(std::memory_order_acquire) == 0)
+            delete arena_;
+    }
+};
+
+thread_local ThreadFrameArenaHolder threadArena;
+
+void ResetIfUnused(ThreadFrameArena& arena, unsigned frameIndex)
+{
+    if (arena.numLiveAllocations_.load(std::memory_order_acquire) == 0)
+    {
+        arena.allocator_.Reset();
+        arena.frameIndex_ = frameIndex;
+        arena.resetFrameIndex_ = frameIndex;
+        arena.warningLogged_ = false;
+    }
+    else if (!arena.warningLogged_ && frameIndex - arena.resetFrameIndex_ > MaxFramesWithoutReset)
+    {
+        URHO3D_LOGWARNING("Frame allocator is not reset for {} frames, some containers outlive the frame",
+            frameIndex - arena.resetFrameIndex_);
+        arena.warningLogged_ = true;
+    }
+}
+
+}
+
+void* FrameAllocator::allocate(size_t n, int flags)
+{
+    if (n > std::numeric_limits<unsigned>::max())
+        throw std::bad_alloc();
+    return Allocate(static_cast<unsigned>(n));
+}
+
+void* FrameAllocator::allocate(size_t n, size_t alignment, size_t offset, int flags)
+{
+    URHO3D_ASSERT(offset == 0, "Allocation offset is not supported");
+    if (n > std::numeric_limits<unsigned>::max() || alignment > std::numeric_limits<unsigned>::max())
+        throw std::bad_alloc();
+    return Allocate(static_cast<unsigned>(n), ea::max(static_cast<unsigned>(alignment), 1u));
+}
+
+void* FrameAllocator::Allocate(unsigned size, unsigned alignment)
+{
+    ThreadFrameArena& arena = *threadArena.arena_;
+    const unsigned frameIndex = currentFrameIndex.load(std::memory_order_relaxed);
+    if (arena.frameIndex_ != frameIndex)
+        ResetIfUnused(arena, frameIndex);
+
+    // Header is placed right before the returned pointer, padded to keep the alignment
+    alignment = ea::max<unsigned>(alignment, alignof(AllocationHeader));
+    const unsigned headerSize = (sizeof(AllocationHeader) + alignment - 1) & ~(alignment - 1);
+    if (size > std::numeric_limits<unsigned>::max() - headerSize)
+        throw std::bad_alloc();
+
+    auto data = static_cast<unsigned char*>(arena.allocator_.Allocate(headerSize + size, alignment));
+    unsigned char* ptr = data + headerSize;
+    new (ptr - sizeof(AllocationHeader)) AllocationHeader{&arena};
+
+    arena.numLiveAllocations_.fetch_add(1, std::memory_order_relaxed);
+    return ptr;
+}
+
+void FrameAllocator::Deallocate(void* ptr)
+{
+    if (!ptr)
+        return;
+
+    const auto header = reinterpret_cast<AllocationHeader*>(static_cast<unsigned char*>(ptr) - sizeof(AllocationHeader));
+    header->arena_->numLiveAllocations_.fetch_sub(1, std::memory_order_release);
+}
+
+void FrameAllocator::BeginFrame()
+{
+    currentFrameIndex.fetch_add(1, std::memory_order_relaxed);
+}
+
+unsigned FrameAllocator::GetFrameIndex()
+{
+    return currentFrameIndex.load(std::memory_order_relaxed);
+}
+
+}
@@ -0,0 +1,77 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#pragma once
+
+#include <Urho3D/Urho3D.h>
+
+#include <EASTL/unordered_map.h>
+#include <EASTL/vector.h>
+
+#include <cstddef>
+
+namespace Urho3D
+{
+
+/// EASTL-compatible allocator for transient data that is usually discarded before the end of the frame.
+/// Memory is allocated from the linear arena of the current thread and deallocation only tracks the number of live
+/// allocations. Arena is reset on the first allocation in the new frame if all its allocations are deallocated.
+/// Containers may outlive the frame, but the arena of the thread keeps growing until they are destroyed.
+class URHO3D_API FrameAllocator
+{
+public:
+    /// Construct.
+    explicit FrameAllocator(const char* name = nullptr) {}
+    /// Construct from another allocator.
+    FrameAllocator(const FrameAllocator& other, const char* name) {}
+
+    /// EASTL allocator interface
+    /// @{
+    void* allocate(size_t n, int flags = 0);
+    void* allocate(size_t n, size_t alignment, size_t offset, int flags = 0);
+    void deallocate(void* p, size_t n) { Deallocate(p); }
+
+    const char* get_name() const { return "FrameAllocator"; }
+    void set_name(const char* name) {}
+    /// @}
+
+    /// Allocate memory from the arena of the current thread. Throws std::bad_alloc if the size is too big.
+    static void* Allocate(unsigned size, unsigned alignment = alignof(std::max_align_t));
+    /// Deallocate memory. May be called from any thread.
+    static void Deallocate(void* ptr);
+    /// Begin new frame. Arena of each thread is reset on the first allocation in the new frame.
+    static void BeginFrame();
+    /// Return current frame index.
+    static unsigned GetFrameIndex();
+};
+
+inline bool operator==(const FrameAllocator& lhs, const FrameAllocator& rhs) { return true; }
+inline bool operator!=(const FrameAllocator& lhs, const FrameAllocator& rhs) { return false; }
+
+/// Vector allocated from frame allocator.
+template <class T> using FrameVector = ea::vector<T, FrameAllocator>;
+/// Hash map allocated from frame allocator.
+template <class Key, class Value>
+using FrameHashMap = ea::unordered_map<Key, Value, ea::hash<Key>, ea::equal_to<Key>, FrameAllocator>;
+
+}
@@ -56,8 +56,6 @@ void Object::OnEvent(Object* sender, StringHash eventType, VariantMap& eventData
     if (blockEvents_)
         return;
 
-    // Make a copy of the context pointer in case the object is destroyed during event handler invocation
-    Context* context = context_;
     EventHandler* specific = nullptr;
     EventHandler* nonSpecific = nullptr;
 
@@ -75,21 +73,29 @@ void Object::OnEvent(Object* sender, StringHash eventType, VariantMap& eventData
         }
     }
 
-    // Specific event handlers have priority, so if found, invoke first
-    if (specific)
-    {
-        context->SetEventHandler(specific);
-        specific->Invoke(eventData);
-        context->SetEventHandler(nullptr);
+    // Specific event handlers have priority
+    EventHandler* handler = specific ? specific : nonSpecific;
+    if (handler)
+        InvokeEventHandler(handler, eventData);
+}
+
+void Object::InvokeEventHandler(EventHandler* handler, VariantMap& eventData)
+{
+    if (blockEvents_)
         return;
-    }
 
-    if (nonSpecific)
+    // Make a copy of the context pointer in case the object is destroyed during event handler invocation
+    Context* context = context_;
+    context->SetEventHandler(handler);
+    const void* typedEventData = context->GetTypedEventData();
+    if (typedEventData && handler->IsTyped())
+        handler->InvokeTyped(typedEventData);
+    else
     {
-        context->SetEventHandler(nonSpecific);
-        nonSpecific->Invoke(eventData);
-        context->SetEventHandler(nullptr);
+        context->WriteTypedEventData(eventData);
+        handler->Invoke(eventData);
     }
+    context->SetEventHandler(nullptr);
 }
 
 void Object::SerializeInBlock(Archive& /*archive*/)
@@ -118,6 +124,7 @@ void Object::SubscribeToEventManual(StringHash eventType, EventHandler* handler)
     auto oldHandler = FindSpecificEventHandler(nullptr, eventType);
     if (oldHandler != eventHandlers_.end())
     {
+        context_->InvalidateEventHandlers(nullptr, eventType);
         EraseEventHandler(oldHandler);
         eventHandlers_.insert(eventHandlers_.begin(), *handler);
     }
@@ -142,6 +149,7 @@ void Object::SubscribeToEventManual(Object* sender, StringHash eventType, EventH
     auto oldHandler = FindSpecificEventHandler(sender, eventType);
     if (oldHandler != eventHandlers_.end())
     {
+        context_->InvalidateEventHandlers(sender, eventType);
         EraseEventHandler(oldHandler);
         eventHandlers_.insert(eventHandlers_.begin(), *handler);
     }
@@ -263,6 +271,12 @@ void Object::SendEvent(StringHash eventType)
 }
 
 void Object::SendEvent(StringHash eventType, VariantMap& eventData)
+{
+    SendEventInternal(eventType, eventData, nullptr, nullptr);
+}
+
+void Object::SendEventInternal(
+    StringHash eventType, VariantMap& eventData, const void* typedEventData, TypedEventWriter writer)
 {
     if (!Thread::IsMainThread())
     {
@@ -283,13 +297,14 @@ void Object::SendEvent(StringHash eventType, VariantMap& eventData)
     WeakPtr<Object> self(this);
     Context* context = context_;
 
-    context->BeginSendEvent(this, eventType);
+    context->BeginSendEvent(this, eventType, typedEventData, writer);
 
     // Check first the specific event receivers
     // Note: group is held alive with a shared ptr, as it may get destroyed along with the sender
     SharedPtr<EventReceiverGroup> group(context->GetEventReceivers(this, eventType));
     if (group)
     {
+        UpdateEventHandlers(*group, this, eventType);
         group->BeginSendEvent();
 
         const unsigned numReceivers = group->receivers_.size();
@@ -300,7 +315,11 @@ void Object::SendEvent(StringHash eventType, VariantMap& eventData)
             if (!receiver)
                 continue;
 
-            receiver->OnEvent(this, eventType, eventData);
+            // Cached handlers are invalidated if any subscription of the group changes during send
+            if (group->AreHandlersValid())
+                receiver->InvokeEventHandler(group->handlers_[i], eventData);
+            else
+                receiver->OnEvent(this, eventType, eventData);
 
             // If self has been destroyed as a result of event handling, exit
             if (self.Expired())
@@ -318,17 +337,25 @@ void Object::SendEvent(StringHash eventType, VariantMap& eventData)
     SharedPtr<EventReceiverGroup> groupNonSpec(context->GetEventReceivers(eventType));
     if (groupNonSpec)
     {
+        UpdateEventHandlers(*groupNonSpec, nullptr, eventType);
         groupNonSpec->BeginSendEvent();
 
         const unsigned numReceivers = groupNonSpec->receivers_.size();
         for (unsigned i = 0; i < numReceivers; ++i)
         {
             Object* receiver = groupNonSpec->receivers_[i];
-            // If there were specific receivers, check that the event is not sent doubly to them
-            if (!receiver || (group && group->receivers_.contains(receiver)))
+            if (!receiver)
+                continue;
+
+            // If there were specific receivers, check that the event is not sent doubly to them.
+            // Receiver is in the group of specific receivers if and only if it has specific handler.
+            if (group && receiver->FindSpecificEventHandler(this, eventType) != receiver->eventHandlers_.end())
                 continue;
 
-            receiver->OnEvent(this, eventType, eventData);
+            if (groupNonSpec->AreHandlersValid())
+                receiver->InvokeEventHandler(groupNonSpec->handlers_[i], eventData);
+            else
+                receiver->OnEvent(this, eventType, eventData);
 
             if (self.Expired())
             {
@@ -344,6 +371,40 @@ void Object::SendEvent(StringHash eventType, VariantMap& eventData)
     context->EndSendEvent();
 }
 
+bool Object::UpdateEventHandlers(EventReceiverGroup& group, Object* sender, StringHash eventType)
+{
+    if (group.AreHandlersValid() || group.IsInSend())
+        return group.AreHandlersValid();
+
+    ea::vector<EventHandler*> handlers;
+    handlers.reserve(group.receivers_.size());
+    for (Object* receiver : group.receivers_)
+    {
+        const auto iter = receiver->FindSpecificEventHandler(sender, eventType);
+        assert(iter != receiver->eventHandlers_.end());
+        handlers.push_back(&*iter);
+    }
+
+    group.SetHandlers(ea::move(handlers));
+    return true;
+}
+
+void Object::UnsubscribeFromTypedEvent(Object* sender, StringHash eventType)
+{
+    if (sender)
+    {
+        UnsubscribeFromEvent(sender, eventType);
+        return;
+    }
+
+    auto handler = FindSpecificEventHandler(nullptr, eventType);
+    if (handler != eventHandlers_.end())
+    {
+        context_->RemoveEventReceiver(this, eventType);
+        EraseEventHandler(handler);
+    }
+}
+
 VariantMap& Object::GetEventDataMap() const
 {
     return context_->GetEventDataMap();
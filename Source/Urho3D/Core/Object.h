@@ -42,6 +42,14 @@ class Archive;
 class ArchiveBlock;
 class Context;
 class EventHandler;
+class EventReceiverGroup;
+
+/// Type-erased handler of typed event. Receives pointer to event data structure.
+using TypedEventHandler = ea::function<void(const void* eventData)>;
+/// Invoke typed event handler with event data converted from VariantMap.
+using TypedEventReader = void (*)(const VariantMap& eventData, const TypedEventHandler& handler);
+/// Write typed event data into VariantMap.
+using TypedEventWriter = void (*)(const void* typedEventData, VariantMap& eventData);
 
 #define URHO3D_OBJECT(typeName, baseTypeName) \
     public: \
@@ -74,7 +82,8 @@ public:
     virtual const ea::string& GetTypeName() const = 0;
     /// Return type info.
     virtual const TypeInfo* GetTypeInfo() const = 0;
-    /// Handle event.
+    /// Handle event by looking up the handler for sender and event type.
+    /// SendEvent calls it only while subscriptions change during send, cached handlers are invoked directly otherwise.
     virtual void OnEvent(Object* sender, StringHash eventType, VariantMap& eventData);
 
     /// Serialize content from/to archive. May throw ArchiveException.
@@ -127,6 +136,22 @@ public:
         SendEvent(eventType, eventData);
     }
 
+    /// Typed events. Handlers of typed events receive event data structure instead of VariantMap.
+    /// Typed and regular subscriptions share receiver lists: they are invoked in subscription order,
+    /// replace each other and are removed by any of UnsubscribeFromEvent functions.
+    /// T::ToVariantMap(VariantMap&) fills event data for regular handlers, only if the event reaches any of them.
+    /// Static T::FromVariantMap(const VariantMap&) creates event data for typed handlers if the event is sent via SendEvent.
+    /// @{
+    /// Subscribe to typed event of specific sender. Handler signature: void(const T&) or member function of receiver.
+    template <class T, class Handler> void SubscribeToTypedEvent(Object* sender, StringHash eventType, Handler handler);
+    /// Subscribe to typed event that can be sent by any sender.
+    template <class T, class Handler> void SubscribeToTypedEvent(StringHash eventType, Handler handler);
+    /// Unsubscribe from typed or regular event. Sender is null for non-specific subscription.
+    void UnsubscribeFromTypedEvent(Object* sender, StringHash eventType);
+    /// Send typed event to all subscribers.
+    template <class T> void SendTypedEvent(StringHash eventType, const T& eventData);
+    /// @}
+
     /// Return execution context.
     Context* GetContext() const { return context_; }
     /// Return global variable based on key.
@@ -188,6 +213,12 @@ private:
     ea::intrusive_list<EventHandler>::iterator EraseEventHandler(ea::intrusive_list<EventHandler>::iterator handlerIter);
     /// Remove event handlers related to a specific sender.
     void RemoveEventSender(Object* sender);
+    /// Send event to all subscribers. Typed event data is optional.
+    void SendEventInternal(StringHash eventType, VariantMap& eventData, const void* typedEventData, TypedEventWriter writer);
+    /// Invoke event handler of this object unless events are blocked.
+    void InvokeEventHandler(EventHandler* handler, VariantMap& eventData);
+    /// Rebuild cached event handlers of receiver group if necessary. Return whether cached handlers can be used.
+    static bool UpdateEventHandlers(EventReceiverGroup& group, Object* sender, StringHash eventType);
 
     /// Event handlers. Sender is null for non-specific handlers.
     ea::intrusive_list<EventHandler> eventHandlers_;
@@ -221,6 +252,15 @@ public:
     {
     }
 
+    /// Construct typed event handler with specified receiver.
+    EventHandler(Object* receiver, TypedEventHandler handler, TypedEventReader reader)
+        : receiver_(receiver)
+        , sender_(nullptr)
+        , typedHandler_(ea::move(handler))
+        , typedReader_(reader)
+    {
+    }
+
     /// Set sender and event type.
     void SetSenderAndEventType(Object* sender, StringHash eventType)
     {
@@ -231,9 +271,18 @@ public:
     /// Invoke event handler function.
     void Invoke(VariantMap& eventData) const
     {
-        handler_(receiver_, eventType_, eventData);
+        if (typedHandler_)
+            typedReader_(eventData, typedHandler_);
+        else
+            handler_(receiver_, eventType_, eventData);
     }
 
+    /// Invoke typed event handler function. Should be called only if the handler is typed.
+    void InvokeTyped(const void* eventData) const { typedHandler_(eventData); }
+
+    /// Return whether the handler expects typed event data.
+    bool IsTyped() const { return !!typedHandler_; }
+
     /// Return event receiver.
     Object* GetReceiver() const { return receiver_; }
 
@@ -301,6 +350,8 @@ private:
     Object* sender_;
     StringHash eventType_;
     HandlerFunction handler_;
+    TypedEventHandler typedHandler_;
+    TypedEventReader typedReader_{};
 };
 
 template<typename T>
@@ -315,14 +366,80 @@ inline void Object::SubscribeToEvent(Object* sender, StringHash eventType, T han
     SubscribeToEventManual(sender, eventType, new Urho3D::EventHandler(this, ea::move(handler)));
 }
 
+template <class T, class Handler>
+void Object::SubscribeToTypedEvent(Object* sender, StringHash eventType, Handler handler)
+{
+    static_assert(ea::is_invocable_r_v<void, Handler, const T&> || ea::is_member_function_pointer_v<Handler>,
+        "Invalid handler signature");
+
+    TypedEventHandler typedHandler;
+    if constexpr (ea::is_member_function_pointer_v<Handler>)
+    {
+        using ObjectType = MemberFunctionObject<Handler>;
+        auto receiver = static_cast<ObjectType*>(this);
+        typedHandler = [receiver, handler](const void* eventData)
+        { (receiver->*handler)(*static_cast<const T*>(eventData)); };
+    }
+    else
+    {
+        typedHandler = [handler = ea::move(handler)](const void* eventData) mutable
+        { handler(*static_cast<const T*>(eventData)); };
+    }
+
+    const TypedEventReader reader = [](const VariantMap& eventData, const TypedEventHandler& handler)
+    {
+        const T typedEventData = T::FromVariantMap(eventData);
+        handler(&typedEventData);
+    };
+
+    auto eventHandler = new Urho3D::EventHandler(this, ea::move(typedHandler), reader);
+    if (sender)
+        SubscribeToEventManual(sender, eventType, eventHandler);
+    else
+        SubscribeToEventManual(eventType, eventHandler);
+}
+
+template <class T, class Handler>
+void Object::SubscribeToTypedEvent(StringHash eventType, Handler handler)
+{
+    SubscribeToTypedEvent<T>(nullptr, eventType, ea::move(handler));
+}
+
+template <class T> void Object::SendTypedEvent(StringHash eventType, const T& eventData)
+{
+    const TypedEventWriter writer = [](const void* typedEventData, VariantMap& eventData)
+    { static_cast<const T*>(typedEventData)->ToVariantMap(eventData); };
+
+    SendEventInternal(eventType, GetEventDataMap(), &eventData, writer);
+}
+
 /// Get register of event names.
 URHO3D_API StringHashRegister& GetEventNameRegister();
 URHO3D_API StringHashRegister& GetEventParamRegister();
 
+#ifdef URHO3D_EVENT_NAMES
+/// Describe an event's hash ID and begin a namespace in which to define its parameters.
+/// Hash is calculated at compile time, name is registered for the profiler and event loggers.
+#define URHO3D_EVENT(eventID, eventName) \
+    static const Urho3D::StringHash eventID(Urho3D::GetEventNameRegister().RegisterString( \
+        Urho3D::StringHash{Urho3D::StringHash::CalculateConstexpr(#eventName, sizeof(#eventName) - 1)}, #eventName)); \
+    namespace eventName
+/// Describe an event's parameter hash ID. Should be used inside an event namespace.
+#define URHO3D_PARAM(paramID, paramName) \
+    static const Urho3D::StringHash paramID(Urho3D::GetEventParamRegister().RegisterString( \
+        Urho3D::StringHash{Urho3D::StringHash::CalculateConstexpr(#paramName, sizeof(#paramName) - 1)}, #paramName))
+#else
 /// Describe an event's hash ID and begin a namespace in which to define its parameters.
-#define URHO3D_EVENT(eventID, eventName) static const Urho3D::StringHash eventID(Urho3D::GetEventNameRegister().RegisterString(#eventName)); namespace eventName
+/// Hash is calculated at compile time, name is not registered.
+#define URHO3D_EVENT(eventID, eventName) \
+    static constexpr Urho3D::StringHash eventID{ \
+        Urho3D::StringHash::CalculateConstexpr(#eventName, sizeof(#eventName) - 1)}; \
+    namespace eventName
 /// Describe an event's parameter hash ID. Should be used inside an event namespace.
-#define URHO3D_PARAM(paramID, paramName) static const Urho3D::StringHash paramID(Urho3D::GetEventParamRegister().RegisterString(#paramName))
+#define URHO3D_PARAM(paramID, paramName) \
+    static constexpr Urho3D::StringHash paramID{ \
+        Urho3D::StringHash::CalculateConstexpr(#paramName, sizeof(#paramName) - 1)}
+#endif
 /// Deprecated. Just use &className::function instead.
 #define URHO3D_HANDLER(className, function) (&className::function)
 
@@ -0,0 +1,292 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../Precompiled.h"
+
+#include "../Core/Assert.h"
+#include "../Core/PoolAllocator.h"
+
+#include <atomic>
+#include <new>
+
+namespace Urho3D
+{
+
+namespace
+{
+
+/// Number of pools for different block sizes.
+constexpr unsigned NumSizeClasses = PoolAllocator::MaxPooledSize / PoolAllocator::Granularity;
+/// Size and alignment of memory chunk that is split into blocks of the same size class.
+constexpr unsigned ChunkSize = 64 * 1024;
+/// Flag of chunk state that is set when the owner thread has exited.
+constexpr unsigned AbandonedFlag = 1u << 31;
+
+struct ThreadPool;
+
+/// Free block in the pool.
+struct FreeBlock
+{
+    FreeBlock* next_;
+};
+
+/// Header at the beginning of each chunk. Chunks are aligned to ChunkSize so the header is found by block address.
+struct ChunkHeader
+{
+    /// Pool of the thread that allocated the chunk.
+    ThreadPool* owner_{};
+    /// Neighbor chunks of the same size class in the owner pool.
+    /// @{
+    ChunkHeader* prev_{};
+    ChunkHeader* next_{};
+    /// @}
+    unsigned sizeClass_{};
+    /// Offset of the first block that was never allocated.
+    unsigned bumpOffset_{};
+    /// Blocks freed by the owner thread.
+    FreeBlock* freeBlocks_{};
+    /// Blocks freed by other threads. They are moved to the owner free list when it runs out.
+    std::atomic<FreeBlock*> remoteFreeBlocks_{};
+    /// Number of allocated blocks, including blocks in remote free list, and AbandonedFlag.
+    std::atomic<unsigned> state_{};
+};
+
+/// Offset of the first block in the chunk.
+constexpr unsigned FirstBlockOffset =
+    (sizeof(ChunkHeader) + PoolAllocator::Granularity - 1) / PoolAllocator::Granularity * PoolAllocator::Granularity;
+
+/// Pool of the thread. Trivial type so it can be used during static destruction.
+struct ThreadPool
+{
+    /// All chunks of the pool, per size class.
+    ChunkHeader* chunks_[NumSizeClasses];
+    /// Chunk used for allocation, per size class.
+    ChunkHeader* currentChunks_[NumSizeClasses];
+    /// Whether the pool is registered for cleanup on thread exit.
+    bool registered_;
+};
+
+thread_local ThreadPool threadPool;
+
+/// Abandons chunks of the thread pool on thread exit.
+/// Chunks with live blocks are released by the thread that frees the last block.
+struct ThreadPoolHolder
+{
+    ThreadPool* pool_{};
+
+    ~ThreadPoolHolder();
+};
+
+thread_local ThreadPoolHolder threadPoolHolder;
+
+unsigned GetSizeClass(unsigned size)
+{
+    return (ea::max(size, 1u) - 1) / PoolAllocator::Granularity;
+}
+
+unsigned GetBlockSize(unsigned sizeClass)
+{
+    return (sizeClass + 1) * PoolAllocator::Granularity;
+}
+
+ChunkHeader* GetChunk(void* ptr)
+{
+    return reinterpret_cast<ChunkHeader*>(reinterpret_cast<uintptr_t>(ptr) & ~static_cast<uintptr_t>(ChunkSize - 1));
+}
+
+void DestroyChunk(ChunkHeader* chunk)
+{
+    chunk->~ChunkHeader();
+    ::operator delete(chunk, std::align_val_t{ChunkSize});
+}
+
+ChunkHeader* CreateChunk(ThreadPool& pool, unsigned sizeClass)
+{
+    if (!pool.registered_)
+    {
+        threadPoolHolder.pool_ = &pool;
+        pool.registered_ = true;
+    }
+
+    void* memory = ::operator new(ChunkSize, std::align_val_t{ChunkSize});
+    auto chunk = ::new (memory) ChunkHeader;
+    chunk->owner_ = &pool;
+    chunk->sizeClass_ = sizeClass;
+    chunk->bumpOffset_ = FirstBlockOffset;
+
+    chunk->next_ = pool.chunks_[sizeClass];
+    if (chunk->next_)
+        chunk->next_->prev_ = chunk;
+    pool.chunks_[sizeClass] = chunk;
+    return chunk;
+}
+
+void ReleaseChunk(ThreadPool& pool, ChunkHeader* chunk)
+{
+    if (chunk->prev_)
+        chunk->prev_->next_ = chunk->next_;
+    else
+        pool.chunks_[chunk->sizeClass_] = chunk->next_;
+    if (chunk->next_)
+        chunk->next_->prev_ = chunk->prev_;
+
+    DestroyChunk(chunk);
+}
+
+bool HasFreeBlocks(ChunkHeader& chunk)
+{
+    if (chunk.freeBlocks_)
+        return true;
+
+    // Take over blocks freed by other threads before touching new memory
+    if (chunk.remoteFreeBlocks_.load(std::memory_order_relaxed))
+    {
+        chunk.freeBlocks_ = chunk.remoteFreeBlocks_.exchange(nullptr, std::memory_order_acquire);
+        return true;
+    }
+
+    return chunk.bumpOffset_ + GetBlockSize(chunk.sizeClass_) <= ChunkSize;
+}
+
+ChunkHeader* FindOrCreateChunk(ThreadPool& pool, unsigned sizeClass)
+{
+    for (ChunkHeader* chunk = pool.chunks_[sizeClass]; chunk; chunk = chunk->next_)
+    {
+        if (HasFreeBlocks(*chunk))
+            return chunk;
+    }
+    return CreateChunk(pool, sizeClass);
+}
+
+bool IsOwnedByThread(const ChunkHeader& chunk, const ThreadPool& pool)
+{
+    // Abandoned chunk may have the same owner if thread storage is reused by another thread
+    return chunk.owner_ == &pool && !(chunk.state_.load(std::memory_order_relaxed) & AbandonedFlag);
+}
+
+ThreadPoolHolder::~ThreadPoolHolder()
+{
+    if (!pool_)
+        return;
+
+    for (unsigned sizeClass = 0; sizeClass < NumSizeClasses; ++sizeClass)
+    {
+        ChunkHeader* chunk = pool_->chunks_[sizeClass];
+        while (chunk)
+        {
+            ChunkHeader* nextChunk = chunk->next_;
+            if (chunk->state_.fetch_or(AbandonedFlag, std::memory_order_acq_rel) == 0)
+                DestroyChunk(chunk);
+            chunk = nextChunk;
+        }
+        pool_->chunks_[sizeClass] = nullptr;
+        pool_->currentChunks_[sizeClass] = nullptr;
+    }
+}
+
+}
+
+void* PoolAllocator::allocate(size_t n, int flags)
+{
+    return Allocate(static_cast<unsigned>(n));
+}
+
+void* PoolAllocator::allocate(size_t n, size_t alignment, size_t offset, int flags)
+{
+    URHO3D_ASSERT(offset == 0, "Allocation offset is not supported");
+    URHO3D_ASSERT(alignment <= Granularity, "Alignment is not supported");
+    return Allocate(static_cast<unsigned>(n));
+}
+
+void PoolAllocator::deallocate(void* p, size_t n)
+{
+    Deallocate(p, static_cast<unsigned>(n));
+}
+
+void* PoolAllocator::Allocate(unsigned size)
+{
+    if (size > MaxPooledSize)
+        return ::operator new(size);
+
+    ThreadPool& pool = threadPool;
+    const unsigned sizeClass = GetSizeClass(size);
+    ChunkHeader* chunk = pool.currentChunks_[sizeClass];
+    if (!chunk || !HasFreeBlocks(*chunk))
+    {
+        chunk = FindOrCreateChunk(pool, sizeClass);
+        pool.currentChunks_[sizeClass] = chunk;
+    }
+
+    chunk->state_.fetch_add(1, std::memory_order_relaxed);
+    if (FreeBlock* block = chunk->freeBlocks_)
+    {
+        chunk->freeBlocks_ = block->next_;
+        return block;
+    }
+
+    void* result = reinterpret_cast<unsigned char*>(chunk) + chunk->bumpOffset_;
+    chunk->bumpOffset_ += GetBlockSize(sizeClass);
+    return result;
+}
+
+void PoolAllocator::Deallocate(void* ptr, unsigned size)
+{
+    if (!ptr)
+        return;
+
+    if (size > MaxPooledSize)
+    {
+        ::operator delete(ptr);
+        return;
+    }
+
+    ThreadPool& pool = threadPool;
+    ChunkHeader* chunk = GetChunk(ptr);
+    auto block = static_cast<FreeBlock*>(ptr);
+    if (IsOwnedByThread(*chunk, pool))
+    {
+        block->next_ = chunk->freeBlocks_;
+        chunk->freeBlocks_ = block;
+
+        // Release empty chunk unless it is used for allocation
+        const unsigned numBlocks = chunk->state_.fetch_sub(1, std::memory_order_acq_rel) - 1;
+        if (numBlocks == 0 && pool.currentChunks_[chunk->sizeClass_] != chunk)
+            ReleaseChunk(pool, chunk);
+    }
+    else
+    {
+        // Return the block to the owner pool
+        FreeBlock* head = chunk->remoteFreeBlocks_.load(std::memory_order_relaxed);
+        do
+        {
+            block->next_ = head;
+        } while (!chunk->remoteFreeBlocks_.compare_exchange_weak(
+            head, block, std::memory_order_release, std::memory_order_relaxed));
+
+        // Chunk is not accessed after the decrement unless the owner thread has exited
+        if (chunk->state_.fetch_sub(1, std::memory_order_acq_rel) == (AbandonedFlag | 1))
+            DestroyChunk(chunk);
+    }
+}
+
+}
@@ -0,0 +1,70 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#pragma once
+
+#include <Urho3D/Urho3D.h>
+
+#include <cstddef>
+
+namespace Urho3D
+{
+
+/// EASTL-compatible allocator that recycles small blocks via free lists of the current thread.
+/// Intended for node-based containers that frequently insert and remove elements, like VariantMap.
+/// Blocks larger than MaxPooledSize are allocated on the heap.
+/// Blocks may be freed on any thread, they are returned to the pool of the thread that allocated them.
+/// Memory chunks are returned to the system when all their blocks are freed.
+class URHO3D_API PoolAllocator
+{
+public:
+    /// Max size of the pooled block.
+    static constexpr unsigned MaxPooledSize = 128;
+    /// Size and max alignment granularity of pooled blocks.
+    static constexpr unsigned Granularity = 16;
+
+    /// Construct.
+    explicit PoolAllocator(const char* name = nullptr) {}
+    /// Construct from another allocator.
+    PoolAllocator(const PoolAllocator& other, const char* name) {}
+
+    /// EASTL allocator interface
+    /// @{
+    void* allocate(size_t n, int flags = 0);
+    void* allocate(size_t n, size_t alignment, size_t offset, int flags = 0);
+    void deallocate(void* p, size_t n);
+
+    const char* get_name() const { return "PoolAllocator"; }
+    void set_name(const char* name) {}
+    /// @}
+
+    /// Allocate memory.
+    static void* Allocate(unsigned size);
+    /// Deallocate memory. Size should be the same as the one used for allocation.
+    static void Deallocate(void* ptr, unsigned size);
+};
+
+inline bool operator==(const PoolAllocator& lhs, const PoolAllocator& rhs) { return true; }
+inline bool operator!=(const PoolAllocator& lhs, const PoolAllocator& rhs) { return false; }
+
+}
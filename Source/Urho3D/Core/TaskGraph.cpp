@@ -0,0 +1,206 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "Urho3D/Precompiled.h"
+
+#include "Urho3D/Core/TaskGraph.h"
+
+#ifdef URHO3D_THREADING
+#include <enkiTS/src/TaskScheduler.h>
+#endif
+
+namespace Urho3D
+{
+
+namespace
+{
+
+/// Number of sub-ranges per thread that parallel tasks are split into, to balance uneven workloads.
+static constexpr unsigned NumRangesPerThread = 4;
+
+}
+
+#ifdef URHO3D_THREADING
+
+class TaskGraph::InternalGraph
+{
+public:
+    class Task : public enki::ITaskSet
+    {
+    public:
+        Task(const TaskDesc& desc)
+            : enki::ITaskSet(ea::max(desc.size_, 1u), desc.grainSize_)
+            , desc_(desc)
+        {
+            m_Priority = static_cast<enki::TaskPriority>(TaskPriority::Immediate);
+        }
+
+        void ExecuteRange(enki::TaskSetPartition range, uint32_t threadNum) override
+        {
+            if (desc_.size_ != 0)
+                desc_.function_(range.start, range.end, threadNum);
+        }
+
+    private:
+        const TaskDesc& desc_;
+    };
+
+    InternalGraph(const ea::vector<TaskDesc>& tasks)
+    {
+        ea::vector<bool> hasDependents(tasks.size());
+
+        tasks_.reserve(tasks.size());
+        for (const TaskDesc& desc : tasks)
+        {
+            auto& task = tasks_.emplace_back(ea::make_unique<Task>(desc));
+            for (TaskId dependency : desc.dependencies_)
+            {
+                auto& link = dependencies_.emplace_back(ea::make_unique<enki::Dependency>());
+                task->SetDependency(*link, tasks_[dependency].get());
+                hasDependents[dependency] = true;
+            }
+
+            if (desc.dependencies_.empty())
+                rootTasks_.push_back(task.get());
+        }
+
+        for (unsigned i = 0; i < tasks_.size(); ++i)
+        {
+            if (!hasDependents[i])
+            {
+                auto& link = dependencies_.emplace_back(ea::make_unique<enki::Dependency>());
+                observer_.SetDependency(*link, tasks_[i].get());
+            }
+        }
+    }
+
+    ~InternalGraph()
+    {
+        // Dependencies should be destroyed before the tasks they reference
+        dependencies_.clear();
+    }
+
+    void Execute(enki::TaskScheduler* taskScheduler)
+    {
+        static const auto priority = static_cast<enki::TaskPriority>(TaskPriority::Immediate);
+
+        for (Task* task : rootTasks_)
+            taskScheduler->AddTaskSetToPipe(task);
+        taskScheduler->WaitforTask(&observer_, priority);
+    }
+
+private:
+    ea::vector<ea::unique_ptr<Task>> tasks_;
+    ea::vector<Task*> rootTasks_;
+    /// Dependencies are stored by pointer because they cannot be moved.
+    ea::vector<ea::unique_ptr<enki::Dependency>> dependencies_;
+    enki::ICompletable observer_;
+};
+
+#endif
+
+TaskGraph::TaskGraph(WorkQueue* workQueue)
+    : workQueue_(workQueue)
+{
+    URHO3D_ASSERT(workQueue_);
+}
+
+TaskGraph::~TaskGraph()
+{
+}
+
+void TaskGraph::AddDependency(TaskId task, TaskId dependency)
+{
+    URHO3D_ASSERT(task < tasks_.size());
+    URHO3D_ASSERT(dependency < task, "Dependency should be added to the graph before the task");
+
+    ea::vector<TaskId>& dependencies = tasks_[task].dependencies_;
+    if (!dependencies.contains(dependency))
+        dependencies.push_back(dependency);
+
+#ifdef URHO3D_THREADING
+    internalGraph_ = nullptr;
+#endif
+}
+
+TaskGraph::TaskId TaskGraph::AddTaskInternal(TaskRangeFunction function, unsigned size, unsigned grainSize,
+    std::initializer_list<TaskId> dependencies)
+{
+    const auto taskId = static_cast<TaskId>(tasks_.size());
+
+    TaskDesc& desc = tasks_.emplace_back();
+    desc.function_ = ea::move(function);
+    desc.size_ = size;
+    desc.grainSize_ = grainSize;
+    for (TaskId dependency : dependencies)
+        AddDependency(taskId, dependency);
+
+#ifdef URHO3D_THREADING
+    internalGraph_ = nullptr;
+#endif
+    return taskId;
+}
+
+unsigned TaskGraph::GetGrainSize(unsigned size, unsigned minGrainSize) const
+{
+    const unsigned numRanges = workQueue_->GetNumProcessingThreads() * NumRangesPerThread;
+    return ea::max({minGrainSize, (size + numRanges - 1) / numRanges, 1u});
+}
+
+void TaskGraph::Execute()
+{
+    if (tasks_.empty())
+        return;
+
+#ifdef URHO3D_THREADING
+    if (enki::TaskScheduler* taskScheduler = workQueue_->taskScheduler_.get())
+    {
+        if (!internalGraph_)
+            internalGraph_ = ea::make_unique<InternalGraph>(tasks_);
+        internalGraph_->Execute(taskScheduler);
+        return;
+    }
+#endif
+
+    ExecuteSequential();
+}
+
+void TaskGraph::ExecuteSequential()
+{
+    const unsigned threadIndex = WorkQueue::GetThreadIndex();
+    for (const TaskDesc& desc : tasks_)
+    {
+        if (desc.size_ != 0)
+            desc.function_(0, desc.size_, threadIndex);
+    }
+}
+
+void TaskGraph::Clear()
+{
+#ifdef URHO3D_THREADING
+    internalGraph_ = nullptr;
+#endif
+    tasks_.clear();
+}
+
+}
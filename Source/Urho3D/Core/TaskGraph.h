@@ -0,0 +1,154 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#pragma once
+
+#include "Urho3D/Core/WorkQueue.h"
+
+#include <EASTL/functional.h>
+#include <EASTL/unique_ptr.h>
+#include <EASTL/vector.h>
+
+#include <initializer_list>
+
+namespace Urho3D
+{
+
+/// Signature of task function executed by TaskGraph for the range of elements.
+using TaskRangeFunction = ea::function<void(unsigned beginIndex, unsigned endIndex, unsigned threadIndex)>;
+
+/// Graph of tasks with explicit dependencies executed by WorkQueue.
+/// Each task is started as soon as all its dependencies are completed, so independent chains of tasks run concurrently
+/// instead of being separated by fork/join barriers.
+/// Dependencies of the task should be added before the task itself, so the order of insertion is always valid order of
+/// execution. This order is used if WorkQueue is not multithreaded.
+/// Graph can be executed multiple times. It should not be modified while executing.
+class URHO3D_API TaskGraph : public NonCopyable
+{
+public:
+    using TaskId = unsigned;
+
+    /// Construct.
+    explicit TaskGraph(WorkQueue* workQueue);
+    /// Destruct.
+    ~TaskGraph();
+
+    /// Add single task. Supports any signature supported by WorkQueue::PostTask.
+    template <class T> TaskId AddTask(T task, std::initializer_list<TaskId> dependencies = {});
+    /// Add task that processes elements in range [0, size) in parallel.
+    /// Callback may be invoked concurrently from different threads for different sub-ranges.
+    /// Signature of callback: void(unsigned beginIndex, unsigned endIndex) or with trailing thread index.
+    template <class T>
+    TaskId AddParallelTask(unsigned size, T callback, std::initializer_list<TaskId> dependencies = {},
+        unsigned minGrainSize = 1);
+    /// Add task that processes each element of the collection in parallel.
+    /// Collection is referenced and should not be resized until the graph is executed.
+    /// Signature of callback: void(unsigned index, T&& element)
+    template <class Callback, class Collection>
+    TaskId AddForEachTask(Collection& collection, Callback callback, std::initializer_list<TaskId> dependencies = {},
+        unsigned minGrainSize = 1);
+    /// Add dependency between two tasks already in the graph. Dependency should be added before the task.
+    void AddDependency(TaskId task, TaskId dependency);
+
+    /// Execute all tasks and wait for completion. Current thread takes part in execution.
+    void Execute();
+    /// Remove all tasks.
+    void Clear();
+
+    /// Return number of tasks.
+    unsigned GetNumTasks() const { return tasks_.size(); }
+    /// Return whether the graph has no tasks.
+    bool IsEmpty() const { return tasks_.empty(); }
+    /// Return grain size used to split range of given size between threads.
+    unsigned GetGrainSize(unsigned size, unsigned minGrainSize) const;
+
+private:
+    /// Description of the task.
+    struct TaskDesc
+    {
+        TaskRangeFunction function_;
+        unsigned size_{};
+        unsigned grainSize_{};
+        ea::vector<TaskId> dependencies_;
+    };
+
+    /// Add task from function.
+    TaskId AddTaskInternal(TaskRangeFunction function, unsigned size, unsigned grainSize,
+        std::initializer_list<TaskId> dependencies);
+    /// Execute tasks one by one in current thread.
+    void ExecuteSequential();
+
+    WorkQueue* workQueue_{};
+    ea::vector<TaskDesc> tasks_;
+
+#ifdef URHO3D_THREADING
+    class InternalGraph;
+    /// Scheduler tasks, created on demand and reused between executions.
+    ea::unique_ptr<InternalGraph> internalGraph_;
+#endif
+};
+
+template <class T> TaskGraph::TaskId TaskGraph::AddTask(T task, std::initializer_list<TaskId> dependencies)
+{
+    TaskFunction wrappedTask = WorkQueue::WrapTask(ea::move(task));
+    auto function = [task = ea::move(wrappedTask), workQueue = workQueue_](unsigned, unsigned, unsigned threadIndex) mutable
+    { task(threadIndex, workQueue); };
+    return AddTaskInternal(ea::move(function), 1, 1, dependencies);
+}
+
+template <class T>
+TaskGraph::TaskId TaskGraph::AddParallelTask(
+    unsigned size, T callback, std::initializer_list<TaskId> dependencies, unsigned minGrainSize)
+{
+    static constexpr bool hasIndex = ea::is_invocable_r_v<void, const T, unsigned, unsigned, unsigned>;
+    static constexpr bool hasNone = ea::is_invocable_r_v<void, const T, unsigned, unsigned>;
+    static_assert(hasIndex || hasNone, "Invalid callback signature");
+
+    const unsigned grainSize = GetGrainSize(size, minGrainSize);
+    if constexpr (hasIndex)
+        return AddTaskInternal(ea::move(callback), size, grainSize, dependencies);
+    else
+    {
+        auto function = [callback = ea::move(callback)](unsigned beginIndex, unsigned endIndex, unsigned)
+        { callback(beginIndex, endIndex); };
+        return AddTaskInternal(ea::move(function), size, grainSize, dependencies);
+    }
+}
+
+template <class Callback, class Collection>
+TaskGraph::TaskId TaskGraph::AddForEachTask(
+    Collection& collection, Callback callback, std::initializer_list<TaskId> dependencies, unsigned minGrainSize)
+{
+    using namespace ea;
+    const auto collectionSize = static_cast<unsigned>(size(collection));
+    auto function = [&collection, callback = ea::move(callback)](unsigned beginIndex, unsigned endIndex)
+    {
+        auto iter = begin(collection);
+        iter += beginIndex;
+        for (unsigned index = beginIndex; index < endIndex; ++index, ++iter)
+            callback(index, *iter);
+    };
+    return AddParallelTask(collectionSize, ea::move(function), dependencies, minGrainSize);
+}
+
+}
@@ -34,6 +34,7 @@
 #include "../Container/ByteVector.h"
 #include "../Core/Assert.h"
 #include "../Core/Exception.h"
+#include "../Core/PoolAllocator.h"
 #include "../Core/TypeTrait.h"
 #include "../Math/Color.h"
 #include "../Math/Matrix3.h"
@@ -97,8 +98,9 @@ using VariantVector = ea::vector<Variant>;
 /// Vector of strings.
 using StringVector = ea::vector<ea::string>;
 
-/// Map of variants.
-using VariantMap = ea::unordered_map<StringHash, Variant>;
+/// Map of variants. Nodes are recycled by PoolAllocator, so maps that are filled and cleared often
+/// (e.g. event data) don't use the heap after warm-up.
+using VariantMap = ea::unordered_map<StringHash, Variant, ea::hash<StringHash>, ea::equal_to<StringHash>, PoolAllocator>;
 
 /// Map from string to Variant. Cache string hashes.
 using StringVariantMap = ea::unordered_map<ea::string, Variant,
@@ -567,6 +569,12 @@ public:
         *this = value;
     }
 
+    /// Construct from a string, moving the value.
+    Variant(ea::string&& value)    // NOLINT(google-explicit-constructor)
+    {
+        *this = ea::move(value);
+    }
+
     /// Construct from a C string.
     Variant(const char* value)          // NOLINT(google-explicit-constructor)
     {
@@ -579,6 +587,12 @@ public:
         *this = value;
     }
 
+    /// Construct from a buffer, moving the value.
+    Variant(VariantBuffer&& value)    // NOLINT(google-explicit-constructor)
+    {
+        *this = ea::move(value);
+    }
+
     /// Construct from a %VectorBuffer and store as a buffer.
     Variant(const VectorBuffer& value)  // NOLINT(google-explicit-constructor)
     {
@@ -597,30 +611,60 @@ public:
         *this = value;
     }
 
+    /// Construct from a resource reference, moving the value.
+    Variant(ResourceRef&& value)    // NOLINT(google-explicit-constructor)
+    {
+        *this = ea::move(value);
+    }
+
     /// Construct from a resource reference list.
     Variant(const ResourceRefList& value)   // NOLINT(google-explicit-constructor)
     {
         *this = value;
     }
 
+    /// Construct from a resource reference list, moving the value.
+    Variant(ResourceRefList&& value)    // NOLINT(google-explicit-constructor)
+    {
+        *this = ea::move(value);
+    }
+
     /// Construct from a variant vector.
     Variant(const VariantVector& value) // NOLINT(google-explicit-constructor)
     {
         *this = value;
     }
 
+    /// Construct from a variant vector, moving the value.
+    Variant(VariantVector&& value)    // NOLINT(google-explicit-constructor)
+    {
+        *this = ea::move(value);
+    }
+
     /// Construct from a variant map.
     Variant(const VariantMap& value)    // NOLINT(google-explicit-constructor)
     {
         *this = value;
     }
 
+    /// Construct from a variant map, moving the value.
+    Variant(VariantMap&& value)    // NOLINT(google-explicit-constructor)
+    {
+        *this = ea::move(value);
+    }
+
     /// Construct from a string vector.
     Variant(const StringVector& value)  // NOLINT(google-explicit-constructor)
     {
         *this = value;
     }
 
+    /// Construct from a string vector, moving the value.
+    Variant(StringVector&& value)    // NOLINT(google-explicit-constructor)
+    {
+        *this = ea::move(value);
+    }
+
     /// Construct from a rect.
     Variant(const Rect& value)          // NOLINT(google-explicit-constructor)
     {
@@ -681,6 +725,12 @@ public:
         *this = value;
     }
 
+    /// Construct from a string variant map, moving the value.
+    Variant(StringVariantMap&& value)    // NOLINT(google-explicit-constructor)
+    {
+        *this = ea::move(value);
+    }
+
     /// Construct from type and value.
     Variant(const ea::string& type, const ea::string& value)
     {
@@ -850,6 +900,14 @@ public:
         return *this;
     }
 
+    /// Assign from a string, moving the value.
+    Variant& operator =(ea::string&& rhs)
+    {
+        SetType(VAR_STRING);
+        value_.string_ = ea::move(rhs);
+        return *this;
+    }
+
     /// Assign from a C string.
     Variant& operator =(const char* rhs)
     {
@@ -866,6 +924,14 @@ public:
         return *this;
     }
 
+    /// Assign from a buffer, moving the value.
+    Variant& operator =(VariantBuffer&& rhs)
+    {
+        SetType(VAR_BUFFER);
+        value_.buffer_ = ea::move(rhs);
+        return *this;
+    }
+
     /// Assign from a %VectorBuffer and store as a buffer.
     Variant& operator =(const VectorBuffer& rhs);
 
@@ -885,6 +951,14 @@ public:
         return *this;
     }
 
+    /// Assign from a resource reference, moving the value.
+    Variant& operator =(ResourceRef&& rhs)
+    {
+        SetType(VAR_RESOURCEREF);
+        value_.resourceRef_ = ea::move(rhs);
+        return *this;
+    }
+
     /// Assign from a resource reference list.
     Variant& operator =(const ResourceRefList& rhs)
     {
@@ -893,6 +967,14 @@ public:
         return *this;
     }
 
+    /// Assign from a resource reference list, moving the value.
+    Variant& operator =(ResourceRefList&& rhs)
+    {
+        SetType(VAR_RESOURCEREFLIST);
+        value_.resourceRefList_ = ea::move(rhs);
+        return *this;
+    }
+
     /// Assign from a variant vector.
     Variant& operator =(const VariantVector& rhs)
     {
@@ -901,6 +983,14 @@ public:
         return *this;
     }
 
+    /// Assign from a variant vector, moving the value.
+    Variant& operator =(VariantVector&& rhs)
+    {
+        SetType(VAR_VARIANTVECTOR);
+        value_.variantVector_ = ea::move(rhs);
+        return *this;
+    }
+
     /// Assign from a string vector.
     Variant& operator =(const StringVector& rhs)
     {
@@ -909,6 +999,14 @@ public:
         return *this;
     }
 
+    /// Assign from a string vector, moving the value.
+    Variant& operator =(StringVector&& rhs)
+    {
+        SetType(VAR_STRINGVECTOR);
+        value_.stringVector_ = ea::move(rhs);
+        return *this;
+    }
+
     /// Assign from a variant map.
     Variant& operator =(const VariantMap& rhs)
     {
@@ -917,6 +1015,14 @@ public:
         return *this;
     }
 
+    /// Assign from a variant map, moving the value.
+    Variant& operator =(VariantMap&& rhs)
+    {
+        SetType(VAR_VARIANTMAP);
+        *value_.variantMap_ = ea::move(rhs);
+        return *this;
+    }
+
     /// Assign from a rect.
     Variant& operator =(const Rect& rhs)
     {
@@ -992,6 +1098,14 @@ public:
         return *this;
     }
 
+    /// Assign from a string variant map, moving the value.
+    Variant& operator =(StringVariantMap&& rhs)
+    {
+        SetType(VAR_STRINGVARIANTMAP);
+        *value_.stringVariantMap_ = ea::move(rhs);
+        return *this;
+    }
+
     /// Test for equality with another variant.
     bool operator ==(const Variant& rhs) const;
 
@@ -25,6 +25,7 @@
 #include "Urho3D/Core/WorkQueue.h"
 
 #include "Urho3D/Core/CoreEvents.h"
+#include "Urho3D/Core/FrameAllocator.h"
 #include "Urho3D/Core/ProcessUtils.h"
 #include "Urho3D/Core/Profiler.h"
 #include "Urho3D/Core/Thread.h"
@@ -310,6 +311,9 @@ void WorkQueue::Update()
 {
     ProcessPostedTasks();
     ProcessMainThreadTasks();
+
+    // Immediate tasks of the previous frame are completed, frame memory can be reused
+    FrameAllocator::BeginFrame();
 }
 
 void WorkQueue::ProcessPostedTasks()
@@ -119,6 +119,7 @@ class URHO3D_API WorkQueue : public Object
     URHO3D_OBJECT(WorkQueue, Object);
 
     friend class WorkerThread;
+    friend class TaskGraph;
 
 public:
     /// Construct.
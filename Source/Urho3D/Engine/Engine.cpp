@@ -38,6 +38,7 @@
 #include "../Engine/Engine.h"
 #include "../Engine/EngineDefs.h"
 #include "../Engine/StateManager.h"
+#include "../Graphics/AnimationBudgetManager.h"
 #include "../Graphics/Graphics.h"
 #include "../Graphics/GraphicsEvents.h"
 #include "../RenderAPI/PipelineState.h"
@@ -88,6 +89,7 @@
 #include "../Particles/ParticleGraphSystem.h"
 #endif
 #include "../Plugins/PluginManager.h"
+#include "../Utility/AnimationCompressor.h"
 #include "../Utility/AnimationVelocityExtractor.h"
 #include "../Utility/AssetPipeline.h"
 #include "../Utility/AssetTransformer.h"
@@ -201,6 +203,9 @@ Engine::Engine(Context* context) :
     StaticModelForLightmap::RegisterObject(context_);
 #endif
 
+    // Animation budget is disabled by default and is used only if enabled by the application.
+    context_->RegisterSubsystem<AnimationBudgetManager>();
+
     // Register render pipeline.
     // Extract this code into function if you are adding more.
     RenderPipeline::RegisterObject(context_);
@@ -233,6 +238,7 @@ Engine::Engine(Context* context) :
     context_->AddFactoryReflection<AssetPipeline>();
     context_->AddFactoryReflection<AssetTransformer>();
     AnimationVelocityExtractor::RegisterObject(context_);
+    AnimationCompressor::RegisterObject(context_);
 
     SubscribeToEvent(E_EXITREQUESTED, URHO3D_HANDLER(Engine, HandleExitRequested));
     SubscribeToEvent(E_ENDFRAME, URHO3D_HANDLER(Engine, HandleEndFrame));
@@ -444,6 +450,8 @@ bool Engine::Initialize(const StringVariantMap& applicationParameters, const Str
             graphics->Maximize();
 
         graphics->InitializePipelineStateCache(FileIdentifier::FromUri(GetParameter(EP_PSO_CACHE).GetString()));
+        if (GetParameter(EP_PREWARM_SHADER_CACHE).GetBool())
+            graphics->PrewarmShaderCache();
 
         renderer->SetTextureQuality((MaterialQuality)GetParameter(EP_TEXTURE_QUALITY).GetInt());
         renderer->SetTextureFilterMode((TextureFilterMode)GetParameter(EP_TEXTURE_FILTER_MODE).GetInt());
@@ -1084,6 +1092,7 @@ void Engine::DefineParameters(CLI::App& commandLine, StringVariantMap& enginePar
     addFlag("--log-shader-sources", EP_SHADER_LOG_SOURCES, true, "Log shader sources into shader cache directory");
     addFlag("--discard-shader-cache", EP_DISCARD_SHADER_CACHE, true, "Discard all cached shader bytecode and logged shader sources");
     addFlag("--no-save-shader-cache", EP_SAVE_SHADER_CACHE, false, "Disable saving shader bytecode to cache directory");
+    addFlag("--no-prewarm-shader-cache", EP_PREWARM_SHADER_CACHE, false, "Disable background compilation of shaders used in previous runs");
     addFlag("--xr", EP_XR, true, "Launch the engine in XR mode");
 
     addFlag("--d3d11", EP_RENDER_BACKEND, static_cast<int>(RenderBackend::D3D11), "Use Direct3D11 rendering backend");
@@ -1157,6 +1166,7 @@ void Engine::PopulateDefaultParameters()
     engineParameters_->DefineVariable(EP_ORIENTATIONS, "LandscapeLeft LandscapeRight");
     engineParameters_->DefineVariable(EP_PACKAGE_CACHE_DIR, EMPTY_STRING);
     engineParameters_->DefineVariable(EP_PLUGINS, EMPTY_STRING);
+    engineParameters_->DefineVariable(EP_PREWARM_SHADER_CACHE, true);
     engineParameters_->DefineVariable(EP_REFRESH_RATE, 0).Overridable();
     engineParameters_->DefineVariable(EP_RESOURCE_PACKAGES, EMPTY_STRING).CommandLinePriority();
     engineParameters_->DefineVariable(EP_RESOURCE_PATHS, "Data;CoreData").CommandLinePriority();
@@ -1218,6 +1228,7 @@ void Engine::DoExit()
     if (graphics)
     {
         graphics->SavePipelineStateCache(FileIdentifier::FromUri(GetParameter(EP_PSO_CACHE).GetString()));
+        graphics->SaveShaderCacheManifest();
         graphics->Close();
     }
 
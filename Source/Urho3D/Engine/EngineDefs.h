@@ -55,6 +55,7 @@ URHO3D_GLOBAL_CONSTANT(ConstString EP_ORGANIZATION_NAME{"OrganizationName"});
 URHO3D_GLOBAL_CONSTANT(ConstString EP_ORIENTATIONS{"Orientations"});
 URHO3D_GLOBAL_CONSTANT(ConstString EP_PACKAGE_CACHE_DIR{"PackageCacheDir"});
 URHO3D_GLOBAL_CONSTANT(ConstString EP_PLUGINS{"Plugins"});
+URHO3D_GLOBAL_CONSTANT(ConstString EP_PREWARM_SHADER_CACHE{"PrewarmShaderCache"});
 URHO3D_GLOBAL_CONSTANT(ConstString EP_REFRESH_RATE{"RefreshRate"});
 URHO3D_GLOBAL_CONSTANT(ConstString EP_RESOURCE_PACKAGES{"ResourcePackages"});
 URHO3D_GLOBAL_CONSTANT(ConstString EP_RESOURCE_PATHS{"ResourcePaths"});
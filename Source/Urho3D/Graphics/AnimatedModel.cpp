@@ -28,6 +28,7 @@
 #include "../Core/Profiler.h"
 #include "../Graphics/AnimatedModel.h"
 #include "../Graphics/Animation.h"
+#include "../Graphics/AnimationBudgetManager.h"
 #include "../Graphics/AnimationState.h"
 #include "../Graphics/Camera.h"
 #include "../Graphics/DebugRenderer.h"
@@ -52,6 +53,9 @@ namespace Urho3D
 
 static const unsigned MAX_ANIMATION_STATES = 256;
 
+/// Counter used to stagger updates of animated models within animation budget.
+static std::atomic<unsigned> nextAnimationBudgetPhase{0};
+
 AnimatedModel::AnimatedModel(Context* context) :
     StaticModel(context),
     animationLodFrameNumber_(0),
@@ -61,7 +65,8 @@ AnimatedModel::AnimatedModel(Context* context) :
     updateInvisible_(false),
     isMaster_(true),
     assignBonesPending_(false),
-    forceAnimationUpdate_(false)
+    forceAnimationUpdate_(false),
+    animationBudgetPhase_(nextAnimationBudgetPhase.fetch_add(1, std::memory_order_relaxed))
 {
     UpdateSoftwareSkinningState();
 }
@@ -188,15 +193,21 @@ void AnimatedModel::ProcessRayQuery(const RayOctreeQuery& query, ea::vector<RayQ
     ProcessCustomRayQuery(query, GetWorldBoundingBox(), node_->GetWorldTransform(), {}, results);
 }
 
-bool AnimatedModel::PrepareForThreadedUpdate(Camera* camera, unsigned frameNumber)
+bool AnimatedModel::PrepareForThreadedUpdate(
+    Camera* camera, unsigned frameNumber, const AnimationBudgetManager* animationBudget)
 {
     // If node was invisible last frame, need to decide animation LOD distance here
     // If headless, retain the current animation distance (should be 0)
-    if (camera && abs(static_cast<int>(frameNumber - viewFrameNumber_)) > 1)
+    if (IsOffscreen(camera, frameNumber))
     {
+        // Animation budget may disable updates of invisible models regardless of the flag
+        const bool updateInvisible = updateInvisible_
+            && !(animationBudget && animationBudget->IsEnabled()
+                && animationBudget->GetSettings().offscreenUpdateInterval_ == 0);
+
         // First check for no update at all when invisible, except on first update. In that case reset LOD timer to ensure update
         // next time the model is in view
-        if (viewFrameNumber_ && !updateInvisible_)
+        if (viewFrameNumber_ && !updateInvisible)
         {
             if (animationDirty_)
             {
@@ -223,7 +234,11 @@ bool AnimatedModel::PrepareForThreadedUpdate(Camera* camera, unsigned frameNumbe
 
 void AnimatedModel::Update(const FrameInfo& frame)
 {
-    if (!PrepareForThreadedUpdate(frame.camera_, frame.frameNumber_))
+    auto animationBudget = GetSubsystem<AnimationBudgetManager>();
+    if (animationBudget && !animationBudget->IsEnabled())
+        animationBudget = nullptr;
+
+    if (!PrepareForThreadedUpdate(frame.camera_, frame.frameNumber_, animationBudget))
         return;
 
     if (isMaster_)
@@ -236,7 +251,10 @@ void AnimatedModel::Update(const FrameInfo& frame)
 
             if (animationDirty_)
             {
-                if (UpdateAndCheckAnimationTimers(frame.timeStep_))
+                const bool needUpdate = animationBudget
+                    ? ScheduleAnimationUpdate(animationBudget, frame.camera_, frame.frameNumber_)
+                    : UpdateAndCheckAnimationTimers(frame.timeStep_);
+                if (needUpdate)
                 {
                     CalculateAnimations();
                     transformsDirty = true;
@@ -253,9 +271,8 @@ void AnimatedModel::Update(const FrameInfo& frame)
             for (unsigned boneIndex = 0; boneIndex < skeleton_.GetNumBones(); ++boneIndex)
             {
                 Node* node = skeleton_.GetBone(boneIndex)->node_;
-                const Transform& transform = skeletonData_[boneIndex].localToParent_;
                 if (node)
-                    octree->QueueNodeTransformUpdate(node, transform);
+                    octree->QueueNodeTransformUpdate(node, pose_.GetBone(boneIndex));
             }
         }
     }
@@ -273,26 +290,15 @@ void AnimatedModel::Update(const FrameInfo& frame)
 
 void AnimatedModel::InitializeLocalBoneTransforms(bool reset)
 {
-    URHO3D_ASSERT(skeleton_.GetNumBones() == skeletonData_.size());
+    URHO3D_ASSERT(skeleton_.GetNumBones() == pose_.GetNumBones());
 
     for (unsigned i = 0; i < skeleton_.GetNumBones(); ++i)
     {
         Bone* bone = skeleton_.GetBone(i);
-        ModelAnimationOutput& output = skeletonData_[i];
-
-        output.dirty_ = CHANNEL_NONE;
         if (!reset && bone->node_)
-        {
-            output.localToParent_.position_ = bone->node_->GetPosition();
-            output.localToParent_.rotation_ = bone->node_->GetRotation();
-            output.localToParent_.scale_ = bone->node_->GetScale();
-        }
+            pose_.ResetBone(i, bone->node_->GetPosition(), bone->node_->GetRotation(), bone->node_->GetScale());
         else
-        {
-            output.localToParent_.position_ = bone->initialPosition_;
-            output.localToParent_.rotation_ = bone->initialRotation_;
-            output.localToParent_.scale_ = bone->initialScale_;
-        }
+            pose_.ResetBone(i, bone->initialPosition_, bone->initialRotation_, bone->initialScale_);
     }
 }
 
@@ -301,12 +307,11 @@ void AnimatedModel::CalculateFinalBoneTransforms()
     for (unsigned boneIndex : skeleton_.GetBonesOrder())
     {
         Bone* bone = skeleton_.GetBone(boneIndex);
-        ModelAnimationOutput& output = skeletonData_[boneIndex];
 
         if (bone->parentIndex_ == boneIndex)
-            output.localToComponent_ = output.localToParent_.ToMatrix3x4();
+            boneLocalToComponent_[boneIndex] = pose_.GetBoneMatrix(boneIndex);
         else
-            output.localToComponent_ = skeletonData_[bone->parentIndex_].localToComponent_ * output.localToParent_.ToMatrix3x4();
+            boneLocalToComponent_[boneIndex] = boneLocalToComponent_[bone->parentIndex_] * pose_.GetBoneMatrix(boneIndex);
     }
 }
 
@@ -437,7 +442,8 @@ void AnimatedModel::SetModel(Model* model, bool createBones)
 
         // Reserve space for skinning matrices
         skinMatrices_.resize(skeleton_.GetNumBones());
-        skeletonData_.resize(skeleton_.GetNumBones());
+        pose_.Resize(skeleton_.GetNumBones());
+        boneLocalToComponent_.resize(skeleton_.GetNumBones());
         SetGeometryBoneMappings();
 
         // Reconsider software skinning
@@ -487,7 +493,8 @@ void AnimatedModel::SetModel(Model* model, bool createBones)
         geometryBoneMappings_.clear();
         modelAnimator_ = nullptr;
         morphs_.clear();
-        skeletonData_.clear();
+        pose_.Resize(0);
+        boneLocalToComponent_.clear();
         SetBoundingBox(BoundingBox());
         SetSkeleton(Skeleton(), false);
     }
@@ -783,7 +790,7 @@ void AnimatedModel::CalculateLocalBoundingBox()
         for (unsigned boneIndex = 0; boneIndex < skeleton_.GetNumBones(); ++boneIndex)
         {
             Bone* bone = skeleton_.GetBone(boneIndex);
-            const Matrix3x4& transform = skeletonData_[boneIndex].localToComponent_;
+            const Matrix3x4& transform = boneLocalToComponent_[boneIndex];
 
             // Use hitbox if available. If not, use only half of the sphere radius
             /// \todo The sphere radius should be multiplied with bone scale
@@ -1032,6 +1039,29 @@ bool AnimatedModel::UpdateAndCheckAnimationTimers(float timeStep)
     return true;
 }
 
+bool AnimatedModel::ScheduleAnimationUpdate(
+    AnimationBudgetManager* animationBudget, Camera* camera, unsigned frameNumber)
+{
+    // Perform the first update always regardless of the budget
+    if (animationLodTimer_ < 0.0f)
+    {
+        animationLodTimer_ = 0.0f;
+        return true;
+    }
+
+    if (IsOffscreen(camera, frameNumber))
+        return animationBudget->ScheduleOffscreenUpdate(frameNumber, animationBudgetPhase_);
+
+    // Zero bias disables animation LOD
+    const float lodDistance = animationLodBias_ > 0.0f ? animationLodDistance_ * animationLodBias_ : 0.0f;
+    return animationBudget->ScheduleUpdate(lodDistance, frameNumber, animationBudgetPhase_);
+}
+
+bool AnimatedModel::IsOffscreen(Camera* camera, unsigned frameNumber) const
+{
+    return camera && abs(static_cast<int>(frameNumber - viewFrameNumber_)) > 1;
+}
+
 void AnimatedModel::CalculateAnimations()
 {
     URHO3D_ASSERT(isMaster_);
@@ -1040,7 +1070,7 @@ void AnimatedModel::CalculateAnimations()
     if (AnimationStateSource* animationStateSource = animationStateSource_)
     {
         for (AnimationState* state : animationStateSource->GetAnimationStates())
-            state->CalculateModelTracks(skeletonData_);
+            state->CalculateModelTracks(pose_, poseSamples_);
     }
 
     animationDirty_ = false;
@@ -1065,9 +1095,11 @@ void AnimatedModel::ApplyBoneTransformsToNodes()
     for (unsigned boneIndex = 0; boneIndex < skeleton_.GetNumBones(); ++boneIndex)
     {
         Bone* bone = skeleton_.GetBone(boneIndex);
-        const Transform& transform = skeletonData_[boneIndex].localToParent_;
         if (Node* node = bone->node_)
-            node->SetTransformSilent(transform.position_, transform.rotation_, transform.scale_);
+        {
+            node->SetTransformSilent(pose_.GetPositions()[boneIndex], pose_.GetRotations()[boneIndex],
+                pose_.GetScales()[boneIndex]);
+        }
     }
 
     // Skeleton reset and animations apply the node transforms "silently" to avoid repeated marking dirty. Mark dirty now
@@ -1124,17 +1156,13 @@ void AnimatedModel::UpdateSkinning()
 
 void AnimatedModel::UpdateMorphs()
 {
-    auto* graphics = GetSubsystem<Graphics>();
-    if (!graphics)
-        return;
-
     if (modelAnimator_)
     {
-        modelAnimator_->ResetAnimation();
-        modelAnimator_->ApplyMorphs(morphs_);
-        if (softwareSkinning_)
-            modelAnimator_->ApplySkinning(skinMatrices_);
-        modelAnimator_->Commit();
+        modelAnimator_->Update(morphs_, softwareSkinning_ ? ea::span<const Matrix3x4>(skinMatrices_) : ea::span<const Matrix3x4>{});
+
+        // Vertices are still animated in shadow data without Graphics, e.g. on headless server
+        if (GetSubsystem<Graphics>())
+            modelAnimator_->Commit();
     }
 
     morphsDirty_ = false;
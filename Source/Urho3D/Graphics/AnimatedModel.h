@@ -22,6 +22,7 @@
 
 #pragma once
 
+#include "../Graphics/AnimationPose.h"
 #include "../Graphics/AnimationStateSource.h"
 #include "../Graphics/Model.h"
 #include "../Graphics/Skeleton.h"
@@ -31,6 +32,7 @@ namespace Urho3D
 {
 
 class Animation;
+class AnimationBudgetManager;
 class AnimationState;
 class SoftwareModelAnimator;
 
@@ -178,13 +180,14 @@ private:
     void CloneGeometries();
     /// Handle model reload finished.
     void HandleModelReloadFinished(StringHash eventType, VariantMap& eventData);
-    /// Reconsider whether to use software skinning.
+    /// Reconsider whether to use software skinning. Software skinning is never selected without Renderer.
     void UpdateSoftwareSkinningState();
 
     /// Animation update sequence. Called from Update whenever possible, and from UpdateGeometry in other cases.
     /// @{
-    bool PrepareForThreadedUpdate(Camera* camera, unsigned frameNumber);
+    bool PrepareForThreadedUpdate(Camera* camera, unsigned frameNumber, const AnimationBudgetManager* animationBudget);
     bool UpdateAndCheckAnimationTimers(float timeStep);
+    bool ScheduleAnimationUpdate(AnimationBudgetManager* animationBudget, Camera* camera, unsigned frameNumber);
 
     void InitializeLocalBoneTransforms(bool reset);
     void CalculateFinalBoneTransforms();
@@ -196,6 +199,9 @@ private:
     void UpdateMorphs();
     /// @}
 
+    /// Return whether the model was not visible last frame.
+    bool IsOffscreen(Camera* camera, unsigned frameNumber) const;
+
     /// Dirty flags used in animation update sequence.
     /// @{
     bool animationDirty_{};
@@ -207,7 +213,11 @@ private:
     /// Skeleton.
     Skeleton skeleton_;
     /// Animation data of Skeleton, used only during Update.
-    ea::vector<ModelAnimationOutput> skeletonData_;
+    AnimationPose pose_;
+    /// Temporary buffer for animation sampling.
+    AnimationPoseSamples poseSamples_;
+    /// Bone transforms in model space.
+    ea::vector<Matrix3x4> boneLocalToComponent_;
     /// Component that provides animation states for the model.
     WeakPtr<AnimationStateSource> animationStateSource_;
     /// Software model animator.
@@ -246,6 +256,8 @@ private:
     bool assignBonesPending_;
     /// Force animation update after becoming visible flag.
     bool forceAnimationUpdate_;
+    /// Frame offset of animation updates within animation budget.
+    unsigned animationBudgetPhase_;
 };
 
 }
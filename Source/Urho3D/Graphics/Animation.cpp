@@ -200,7 +200,6 @@ bool Animation::BeginLoad(Deserializer& source)
     ResetToDefault();
 
     auto* cache = GetSubsystem<ResourceCache>();
-    unsigned memoryUse = sizeof(Animation);
 
     // Try to load as XML if possible
     if (source.GetName().ends_with(".xml", false))
@@ -228,7 +227,6 @@ bool Animation::BeginLoad(Deserializer& source)
     length_ = source.ReadFloat();
 
     const unsigned tracks = source.ReadUInt();
-    memoryUse += tracks * sizeof(AnimationTrack);
 
     // Read tracks
     for (unsigned i = 0; i < tracks; ++i)
@@ -239,9 +237,20 @@ bool Animation::BeginLoad(Deserializer& source)
         if (version >= trackWeightVersion)
             newTrack->weight_ = source.ReadFloat();
 
+        if (version >= compressedTrackVersion && source.ReadBool())
+        {
+            auto compressed = ea::make_shared<CompressedAnimationTrack>();
+            if (!compressed->Load(source))
+            {
+                URHO3D_LOGERROR("{} has invalid compressed track '{}'", source.GetName(), newTrack->name_);
+                return false;
+            }
+            newTrack->compressed_ = compressed;
+            continue;
+        }
+
         const unsigned keyFrames = source.ReadUInt();
         newTrack->keyFrames_.resize(keyFrames);
-        memoryUse += keyFrames * sizeof(AnimationKeyFrame);
 
         // Read keyframes of the track
         for (unsigned j = 0; j < keyFrames; ++j)
@@ -256,7 +265,6 @@ bool Animation::BeginLoad(Deserializer& source)
     if (version >= variantTrackVersion)
     {
         const unsigned variantTracks = source.ReadUInt();
-        memoryUse += variantTracks * sizeof(VariantAnimationTrack);
 
         for (unsigned i = 0; i < variantTracks; ++i)
         {
@@ -271,7 +279,6 @@ bool Animation::BeginLoad(Deserializer& source)
 
             const unsigned keyFrames = source.ReadUInt();
             newTrack->keyFrames_.resize(keyFrames);
-            memoryUse += keyFrames * sizeof(VariantAnimationKeyFrame);
 
             // Read keyframes of the track
             for (unsigned j = 0; j < keyFrames; ++j)
@@ -306,13 +313,9 @@ bool Animation::BeginLoad(Deserializer& source)
         XMLElement rootElem = file->GetRoot();
         LoadTriggersFromXML(rootElem);
         LoadMetadataFromXML(rootElem);
-
-        memoryUse += triggers_.size() * sizeof(AnimationTriggerPoint);
-        SetMemoryUse(memoryUse);
-        return true;
     }
 
-    SetMemoryUse(memoryUse);
+    UpdateMemoryUse();
     return true;
 }
 
@@ -343,6 +346,14 @@ bool Animation::Save(Serializer& dest) const
         dest.WriteString(track.name_);
         dest.WriteUByte(track.channelMask_);
         dest.WriteFloat(track.weight_);
+
+        dest.WriteBool(track.IsCompressed());
+        if (track.IsCompressed())
+        {
+            track.compressed_->Save(dest);
+            continue;
+        }
+
         dest.WriteUInt(track.keyFrames_.size());
 
         // Write keyframes of the track
@@ -582,6 +593,52 @@ VariantAnimationTrack* Animation::GetVariantTrack(StringHash nameHash)
     return iter != variantTracks_.end() ? &iter->second : nullptr;
 }
 
+AnimationCompressionReport Animation::Compress(const AnimationCompressionSettings& settings)
+{
+    MarkRevisionUpdated();
+
+    AnimationCompressionReport report;
+    for (auto& [nameHash, track] : tracks_)
+    {
+        if (!track.IsCompressed())
+            track.Compress(settings, &report);
+    }
+
+    UpdateMemoryUse();
+    return report;
+}
+
+void Animation::Decompress()
+{
+    MarkRevisionUpdated();
+
+    for (auto& [nameHash, track] : tracks_)
+        track.Decompress();
+
+    UpdateMemoryUse();
+}
+
+void Animation::UpdateMemoryUse()
+{
+    unsigned memoryUse = sizeof(Animation);
+
+    memoryUse += tracks_.size() * sizeof(AnimationTrack);
+    for (const auto& [nameHash, track] : tracks_)
+    {
+        if (track.IsCompressed())
+            memoryUse += track.compressed_->GetMemoryUse();
+        else
+            memoryUse += track.keyFrames_.size() * sizeof(AnimationKeyFrame);
+    }
+
+    memoryUse += variantTracks_.size() * sizeof(VariantAnimationTrack);
+    for (const auto& [nameHash, track] : variantTracks_)
+        memoryUse += track.keyFrames_.size() * sizeof(VariantAnimationKeyFrame);
+
+    memoryUse += triggers_.size() * sizeof(AnimationTriggerPoint);
+    SetMemoryUse(memoryUse);
+}
+
 AnimationTriggerPoint* Animation::GetTrigger(unsigned index)
 {
     return index < triggers_.size() ? &triggers_[index] : nullptr;
@@ -26,6 +26,7 @@
 
 #include "Urho3D/Container/Ptr.h"
 #include "Urho3D/Core/ObjectRevisionTracker.h"
+#include "Urho3D/Graphics/AnimationCompression.h"
 #include "Urho3D/Graphics/AnimationTrack.h"
 #include "Urho3D/Resource/Resource.h"
 
@@ -145,16 +146,24 @@ public:
     /// Set all animation tracks.
     void SetTracks(const ea::vector<AnimationTrack>& tracks);
 
+    /// Compress keyframes of all tracks that are not compressed yet. Return memory and accuracy report.
+    AnimationCompressionReport Compress(const AnimationCompressionSettings& settings);
+    /// Decompress keyframes of all tracks.
+    void Decompress();
+
 private:
     void LoadTriggersFromXML(const XMLElement& source);
+    /// Update memory use according to tracks and triggers.
+    void UpdateMemoryUse();
 
     /// Class versions (used for serialization)
     /// @{
     static const unsigned legacyVersion = 1; // Fake version for legacy unversioned UANI file
     static const unsigned variantTrackVersion = 2; // VariantAnimationTrack support added here
     static const unsigned trackWeightVersion = 3; // Per-track weights added here
+    static const unsigned compressedTrackVersion = 4; // Compressed tracks added here
 
-    static const unsigned currentVersion = trackWeightVersion;
+    static const unsigned currentVersion = compressedTrackVersion;
     /// @}
 
     /// Animation name.
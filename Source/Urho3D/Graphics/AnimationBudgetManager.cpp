@@ -0,0 +1,119 @@
+// Copyright (c) 2023-2023 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#include "Urho3D/Precompiled.h"
+
+#include "Urho3D/Graphics/AnimationBudgetManager.h"
+
+#include "Urho3D/Core/CoreEvents.h"
+#include "Urho3D/IO/Log.h"
+
+#include <EASTL/numeric.h>
+
+#include "Urho3D/DebugNew.h"
+
+namespace Urho3D
+{
+
+unsigned AnimationBudgetStats::GetNumModels() const
+{
+    return ea::accumulate(numModels_.begin(), numModels_.end(), numOffscreenModels_);
+}
+
+unsigned AnimationBudgetStats::GetNumUpdates() const
+{
+    return ea::accumulate(numUpdates_.begin(), numUpdates_.end(), numOffscreenUpdates_);
+}
+
+ea::string AnimationBudgetStats::ToString() const
+{
+    ea::string result = Format("{} of {} models updated", GetNumUpdates(), GetNumModels());
+    for (unsigned i = 0; i < MaxAnimationBudgetBuckets; ++i)
+    {
+        if (numModels_[i] != 0)
+            result += Format(", bucket {}: {}/{}", i, numUpdates_[i], numModels_[i]);
+    }
+    if (numOffscreenModels_ != 0)
+        result += Format(", offscreen: {}/{}", numOffscreenUpdates_, numOffscreenModels_);
+    return result;
+}
+
+AnimationBudgetManager::AnimationBudgetManager(Context* context)
+    : Object(context)
+{
+    SubscribeToEvent(E_BEGINFRAME, [this] { HandleBeginFrame(); });
+}
+
+AnimationBudgetManager::~AnimationBudgetManager() = default;
+
+void AnimationBudgetManager::SetSettings(const AnimationBudgetSettings& settings)
+{
+    settings_ = settings;
+
+    if (settings_.buckets_.empty())
+        settings_.buckets_.push_back(AnimationBudgetBucket{});
+
+    if (settings_.buckets_.size() > MaxAnimationBudgetBuckets)
+    {
+        URHO3D_LOGWARNING("Animation budget supports up to {} buckets", MaxAnimationBudgetBuckets);
+        settings_.buckets_.resize(MaxAnimationBudgetBuckets);
+    }
+
+    for (AnimationBudgetBucket& bucket : settings_.buckets_)
+        bucket.updateInterval_ = ea::max(1u, bucket.updateInterval_);
+}
+
+unsigned AnimationBudgetManager::GetBucketIndex(float lodDistance) const
+{
+    const unsigned numBuckets = settings_.buckets_.size();
+    for (unsigned i = 0; i + 1 < numBuckets; ++i)
+    {
+        if (lodDistance <= settings_.buckets_[i].maxLodDistance_)
+            return i;
+    }
+    return numBuckets - 1;
+}
+
+bool AnimationBudgetManager::ScheduleUpdate(float lodDistance, unsigned frameNumber, unsigned phase)
+{
+    const unsigned bucketIndex = GetBucketIndex(lodDistance);
+    const unsigned updateInterval = settings_.buckets_[bucketIndex].updateInterval_;
+
+    counters_.numModels_[bucketIndex].fetch_add(1, std::memory_order_relaxed);
+    if (!IsUpdateFrame(frameNumber, phase, updateInterval))
+        return false;
+
+    counters_.numUpdates_[bucketIndex].fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+bool AnimationBudgetManager::ScheduleOffscreenUpdate(unsigned frameNumber, unsigned phase)
+{
+    counters_.numOffscreenModels_.fetch_add(1, std::memory_order_relaxed);
+
+    const unsigned updateInterval = settings_.offscreenUpdateInterval_;
+    if (updateInterval == 0 || !IsUpdateFrame(frameNumber, phase, updateInterval))
+        return false;
+
+    counters_.numOffscreenUpdates_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+void AnimationBudgetManager::HandleBeginFrame()
+{
+    for (unsigned i = 0; i < MaxAnimationBudgetBuckets; ++i)
+    {
+        stats_.numModels_[i] = counters_.numModels_[i].exchange(0, std::memory_order_relaxed);
+        stats_.numUpdates_[i] = counters_.numUpdates_[i].exchange(0, std::memory_order_relaxed);
+    }
+    stats_.numOffscreenModels_ = counters_.numOffscreenModels_.exchange(0, std::memory_order_relaxed);
+    stats_.numOffscreenUpdates_ = counters_.numOffscreenUpdates_.exchange(0, std::memory_order_relaxed);
+}
+
+bool AnimationBudgetManager::IsUpdateFrame(unsigned frameNumber, unsigned phase, unsigned interval)
+{
+    return (frameNumber + phase) % interval == 0;
+}
+
+}
@@ -0,0 +1,114 @@
+// Copyright (c) 2023-2023 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#pragma once
+
+#include "Urho3D/Core/Object.h"
+
+#include <EASTL/array.h>
+#include <EASTL/vector.h>
+
+#include <atomic>
+
+namespace Urho3D
+{
+
+/// Max number of animation budget buckets.
+static const unsigned MaxAnimationBudgetBuckets = 8;
+
+/// Update rate of animated models within the range of animation LOD distances.
+struct URHO3D_API AnimationBudgetBucket
+{
+    /// Max animation LOD distance of the bucket.
+    /// LOD distance grows with distance to the camera and shrinks with screen size of the model.
+    float maxLodDistance_{M_LARGE_VALUE};
+    /// Animation is evaluated once per this number of frames.
+    unsigned updateInterval_{1};
+};
+
+/// Settings of animation budget.
+struct URHO3D_API AnimationBudgetSettings
+{
+    /// Whether the budget is used. Otherwise each model uses its own animation LOD timer.
+    bool enabled_{};
+    /// Buckets sorted by max LOD distance. Models beyond the last bucket use the last bucket.
+    ea::vector<AnimationBudgetBucket> buckets_{{20.0f, 1}, {50.0f, 2}, {100.0f, 4}, {M_LARGE_VALUE, 8}};
+    /// Animation of offscreen models with enabled "update invisible" is evaluated once per this number of frames.
+    /// If zero, offscreen models are not evaluated at all and get updated once they are visible again.
+    unsigned offscreenUpdateInterval_{8};
+};
+
+/// Animation budget statistics of single frame.
+struct URHO3D_API AnimationBudgetStats
+{
+    /// Number of models that had dirty animation, per bucket.
+    ea::array<unsigned, MaxAnimationBudgetBuckets> numModels_{};
+    /// Number of models that evaluated animation, per bucket.
+    ea::array<unsigned, MaxAnimationBudgetBuckets> numUpdates_{};
+    /// Number of offscreen models that had dirty animation.
+    unsigned numOffscreenModels_{};
+    /// Number of offscreen models that evaluated animation.
+    unsigned numOffscreenUpdates_{};
+
+    /// Return total number of models that had dirty animation.
+    unsigned GetNumModels() const;
+    /// Return total number of models that evaluated animation.
+    unsigned GetNumUpdates() const;
+    /// Return total number of models that postponed animation evaluation.
+    unsigned GetNumSkippedUpdates() const { return GetNumModels() - GetNumUpdates(); }
+    /// Return human-readable statistics.
+    ea::string ToString() const;
+};
+
+/// Shared animation budget of all animated models.
+/// Models are sorted into buckets by animation LOD distance, and distant models are evaluated at reduced rate.
+/// Updates of the models within the same bucket are staggered across frames to keep frame time stable.
+/// Models that are not evaluated don't move bones and therefore don't recalculate skinning matrices either.
+class URHO3D_API AnimationBudgetManager : public Object
+{
+    URHO3D_OBJECT(AnimationBudgetManager, Object);
+
+public:
+    explicit AnimationBudgetManager(Context* context);
+    ~AnimationBudgetManager() override;
+
+    /// Set settings. Should not be called during scene update.
+    void SetSettings(const AnimationBudgetSettings& settings);
+    /// Return settings.
+    const AnimationBudgetSettings& GetSettings() const { return settings_; }
+    /// Return whether the budget is used.
+    bool IsEnabled() const { return settings_.enabled_; }
+
+    /// Return index of the bucket for given LOD distance.
+    unsigned GetBucketIndex(float lodDistance) const;
+    /// Check whether the visible model should evaluate animation on given frame. Safe to call from multiple threads.
+    bool ScheduleUpdate(float lodDistance, unsigned frameNumber, unsigned phase);
+    /// Check whether the offscreen model should evaluate animation on given frame. Safe to call from multiple threads.
+    bool ScheduleOffscreenUpdate(unsigned frameNumber, unsigned phase);
+
+    /// Return statistics of the last finished frame.
+    const AnimationBudgetStats& GetStats() const { return stats_; }
+
+private:
+    /// Counters of the current frame.
+    struct FrameCounters
+    {
+        ea::array<std::atomic<unsigned>, MaxAnimationBudgetBuckets> numModels_{};
+        ea::array<std::atomic<unsigned>, MaxAnimationBudgetBuckets> numUpdates_{};
+        std::atomic<unsigned> numOffscreenModels_{};
+        std::atomic<unsigned> numOffscreenUpdates_{};
+    };
+
+    /// Handle beginning of the frame.
+    void HandleBeginFrame();
+    /// Return whether the update with given interval and phase happens on given frame.
+    static bool IsUpdateFrame(unsigned frameNumber, unsigned phase, unsigned interval);
+
+    AnimationBudgetSettings settings_;
+
+    FrameCounters counters_;
+    AnimationBudgetStats stats_;
+};
+
+}
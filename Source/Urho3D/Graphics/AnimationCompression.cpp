@@ -0,0 +1,646 @@
+// Copyright (c) 2023-2023 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#include "Urho3D/Precompiled.h"
+
+#include "Urho3D/Graphics/AnimationCompression.h"
+
+#include "Urho3D/IO/Deserializer.h"
+#include "Urho3D/IO/Serializer.h"
+
+#include "Urho3D/DebugNew.h"
+
+namespace Urho3D
+{
+
+namespace
+{
+
+const float MaxVectorValue = 65535.0f;
+const int MaxSmallestThreeValue = 32767;
+const float Sqrt2 = 1.41421356f;
+const float InvSqrt2 = 0.70710678f;
+
+/// Upper bound of rotation error introduced by smallest-three quantization, in radians.
+const float MaxRotationQuantizationError = 4.0f * Sqrt2 / MaxSmallestThreeValue;
+
+/// Size of single keyframe in uncompressed animation track.
+unsigned GetUncompressedKeyFrameSize(AnimationChannelFlags channelMask)
+{
+    unsigned size = sizeof(float);
+    if (channelMask & CHANNEL_POSITION)
+        size += sizeof(Vector3);
+    if (channelMask & CHANNEL_ROTATION)
+        size += sizeof(Quaternion);
+    if (channelMask & CHANNEL_SCALE)
+        size += sizeof(Vector3);
+    return size;
+}
+
+float GetRotationError(const Quaternion& lhs, const Quaternion& rhs)
+{
+    // Evaluate angle via chord length, acos is too imprecise for small angles
+    const float sign = lhs.DotProduct(rhs) < 0.0f ? -1.0f : 1.0f;
+    const float chord = Sqrt((lhs - rhs * sign).LengthSquared());
+    return 4.0f * asinf(Min(chord * 0.5f, 1.0f));
+}
+
+/// Pack quaternion into three 16-bit values: three smallest components with 15 bits each
+/// and index of the largest component in the highest bits.
+void EncodeQuaternion(const Quaternion& value, unsigned short* dest)
+{
+    const Quaternion normalized = value.Normalized();
+    const float components[4]{normalized.w_, normalized.x_, normalized.y_, normalized.z_};
+
+    unsigned largestIndex = 0;
+    for (unsigned i = 1; i < 4; ++i)
+    {
+        if (Abs(components[i]) > Abs(components[largestIndex]))
+            largestIndex = i;
+    }
+
+    // q and -q are the same rotation, so the largest component is always positive
+    const float sign = components[largestIndex] < 0.0f ? -1.0f : 1.0f;
+    unsigned destIndex = 0;
+    for (unsigned i = 0; i < 4; ++i)
+    {
+        if (i == largestIndex)
+            continue;
+
+        // Smallest components are within [-1/sqrt(2), 1/sqrt(2)]
+        const float unitValue = components[i] * sign * InvSqrt2 + 0.5f;
+        const int quantizedValue = Clamp(RoundToInt(unitValue * MaxSmallestThreeValue), 0, MaxSmallestThreeValue);
+        dest[destIndex++] = static_cast<unsigned short>(quantizedValue);
+    }
+
+    dest[0] |= static_cast<unsigned short>((largestIndex & 1u) << 15);
+    dest[1] |= static_cast<unsigned short>((largestIndex >> 1u) << 15);
+}
+
+Quaternion DecodeQuaternion(const unsigned short* source)
+{
+    const unsigned largestIndex = (source[0] >> 15u) | ((source[1] >> 15u) << 1u);
+
+    float components[4]{};
+    float sumSquares = 0.0f;
+    unsigned sourceIndex = 0;
+    for (unsigned i = 0; i < 4; ++i)
+    {
+        if (i == largestIndex)
+            continue;
+
+        const unsigned quantizedValue = source[sourceIndex++] & 0x7fffu;
+        const float value = (quantizedValue / static_cast<float>(MaxSmallestThreeValue) - 0.5f) * Sqrt2;
+        components[i] = value;
+        sumSquares += value * value;
+    }
+    components[largestIndex] = Sqrt(Max(0.0f, 1.0f - sumSquares));
+
+    return Quaternion{components[0], components[1], components[2], components[3]};
+}
+
+void WriteKeys(Serializer& dest, const ea::vector<unsigned short>& keys)
+{
+    dest.WriteVLE(keys.size());
+    for (unsigned short key : keys)
+        dest.WriteUShort(key);
+}
+
+bool ReadKeys(Deserializer& source, ea::vector<unsigned short>& keys, unsigned numKeyFrames)
+{
+    const unsigned numKeys = source.ReadVLE();
+    if (numKeys != 0 && numKeys != numKeyFrames * 3)
+        return false;
+
+    keys.resize(numKeys);
+    for (unsigned short& key : keys)
+        key = source.ReadUShort();
+    return true;
+}
+
+void WriteValues(Serializer& dest, const ea::vector<Vector3>& values)
+{
+    dest.WriteVLE(values.size());
+    for (const Vector3& value : values)
+        dest.WriteVector3(value);
+}
+
+void WriteValues(Serializer& dest, const ea::vector<Quaternion>& values)
+{
+    dest.WriteVLE(values.size());
+    for (const Quaternion& value : values)
+        dest.WriteQuaternion(value);
+}
+
+bool ReadValues(Deserializer& source, ea::vector<Vector3>& values, unsigned numKeyFrames)
+{
+    const unsigned numValues = source.ReadVLE();
+    if (numValues != 0 && numValues != numKeyFrames)
+        return false;
+
+    values.resize(numValues);
+    for (Vector3& value : values)
+        value = source.ReadVector3();
+    return true;
+}
+
+bool ReadValues(Deserializer& source, ea::vector<Quaternion>& values, unsigned numKeyFrames)
+{
+    const unsigned numValues = source.ReadVLE();
+    if (numValues != 0 && numValues != numKeyFrames)
+        return false;
+
+    values.resize(numValues);
+    for (Quaternion& value : values)
+        value = source.ReadQuaternion();
+    return true;
+}
+
+/// Split of channel error tolerance between quantization and keyframe reduction.
+struct ChannelErrorBudget
+{
+    /// Whether the channel is quantized. Otherwise it is stored in full precision.
+    bool quantized_{};
+    /// Error tolerance left for keyframe reduction.
+    float reductionError_{};
+};
+
+ChannelErrorBudget GetChannelErrorBudget(float quantizationError, float maxError)
+{
+    // Quantize only if at least half of the tolerance is left for keyframe reduction
+    if (quantizationError <= maxError * 0.5f)
+        return {true, maxError - quantizationError};
+    return {false, maxError};
+}
+
+/// Return max error of 16-bit quantization of vector channel within its bounding box.
+float GetVectorQuantizationError(const ea::vector<AnimationKeyFrame>& keyFrames, Vector3 Transform::*channel)
+{
+    if (keyFrames.empty())
+        return 0.0f;
+
+    Vector3 min = keyFrames.front().*channel;
+    Vector3 max = min;
+    for (const AnimationKeyFrame& keyFrame : keyFrames)
+    {
+        min = VectorMin(min, keyFrame.*channel);
+        max = VectorMax(max, keyFrame.*channel);
+    }
+    return 0.5f * ((max - min) / MaxVectorValue).Length();
+}
+
+/// Helper class to evaluate compression of a single track.
+class TrackCompressor
+{
+public:
+    TrackCompressor(const AnimationTrack& track, const AnimationCompressionSettings& settings)
+        : keyFrames_(track.keyFrames_)
+        , settings_(settings)
+    {
+        const bool isNotEmpty = !keyFrames_.empty();
+        positionAnimated_ = isNotEmpty && track.channelMask_.Test(CHANNEL_POSITION) && !IsPositionConstant();
+        rotationAnimated_ = isNotEmpty && track.channelMask_.Test(CHANNEL_ROTATION) && !IsRotationConstant();
+        scaleAnimated_ = isNotEmpty && track.channelMask_.Test(CHANNEL_SCALE) && !IsScaleConstant();
+
+        positionBudget_ = GetChannelErrorBudget(
+            GetVectorQuantizationError(keyFrames_, &Transform::position_), settings_.positionError_);
+        rotationBudget_ = GetChannelErrorBudget(MaxRotationQuantizationError, settings_.rotationError_);
+        scaleBudget_ = GetChannelErrorBudget(
+            GetVectorQuantizationError(keyFrames_, &Transform::scale_), settings_.scaleError_);
+    }
+
+    /// Return indices of keyframes that should be stored.
+    ea::vector<unsigned> SelectKeyFrames() const
+    {
+        const unsigned numKeyFrames = keyFrames_.size();
+        if (numKeyFrames == 0)
+            return {};
+
+        if (!positionAnimated_ && !rotationAnimated_ && !scaleAnimated_)
+            return {0};
+
+        ea::vector<unsigned> result;
+        if (!settings_.reduceKeyFrames_)
+        {
+            result.resize(numKeyFrames);
+            for (unsigned i = 0; i < numKeyFrames; ++i)
+                result[i] = i;
+            return result;
+        }
+
+        // Extend each segment as long as all skipped keyframes can be interpolated.
+        // The first and the last keyframes are always kept to preserve looping.
+        unsigned anchorIndex = 0;
+        result.push_back(anchorIndex);
+        for (unsigned nextIndex = 2; nextIndex < numKeyFrames; ++nextIndex)
+        {
+            if (!CanInterpolate(anchorIndex, nextIndex))
+            {
+                anchorIndex = nextIndex - 1;
+                result.push_back(anchorIndex);
+            }
+        }
+        if (numKeyFrames > 1)
+            result.push_back(numKeyFrames - 1);
+        return result;
+    }
+
+    bool IsPositionAnimated() const { return positionAnimated_; }
+    bool IsRotationAnimated() const { return rotationAnimated_; }
+    bool IsScaleAnimated() const { return scaleAnimated_; }
+
+    bool IsPositionQuantized() const { return positionBudget_.quantized_; }
+    bool IsRotationQuantized() const { return rotationBudget_.quantized_; }
+    bool IsScaleQuantized() const { return scaleBudget_.quantized_; }
+
+private:
+    bool IsPositionConstant() const
+    {
+        const Vector3& firstValue = keyFrames_.front().position_;
+        return ea::all_of(keyFrames_.begin(), keyFrames_.end(), [&](const AnimationKeyFrame& keyFrame)
+            { return (keyFrame.position_ - firstValue).Length() <= settings_.positionError_; });
+    }
+
+    bool IsRotationConstant() const
+    {
+        const Quaternion& firstValue = keyFrames_.front().rotation_;
+        return ea::all_of(keyFrames_.begin(), keyFrames_.end(), [&](const AnimationKeyFrame& keyFrame)
+            { return GetRotationError(keyFrame.rotation_, firstValue) <= settings_.rotationError_; });
+    }
+
+    bool IsScaleConstant() const
+    {
+        const Vector3& firstValue = keyFrames_.front().scale_;
+        return ea::all_of(keyFrames_.begin(), keyFrames_.end(), [&](const AnimationKeyFrame& keyFrame)
+            { return (keyFrame.scale_ - firstValue).Length() <= settings_.scaleError_; });
+    }
+
+    bool CanInterpolate(unsigned firstIndex, unsigned lastIndex) const
+    {
+        const AnimationKeyFrame& firstKeyFrame = keyFrames_[firstIndex];
+        const AnimationKeyFrame& lastKeyFrame = keyFrames_[lastIndex];
+        const float timeInterval = lastKeyFrame.time_ - firstKeyFrame.time_;
+
+        for (unsigned i = firstIndex + 1; i < lastIndex; ++i)
+        {
+            const AnimationKeyFrame& keyFrame = keyFrames_[i];
+            const float factor = timeInterval > 0.0f ? (keyFrame.time_ - firstKeyFrame.time_) / timeInterval : 1.0f;
+
+            if (positionAnimated_)
+            {
+                const Vector3 position = firstKeyFrame.position_.Lerp(lastKeyFrame.position_, factor);
+                if ((position - keyFrame.position_).Length() > positionBudget_.reductionError_)
+                    return false;
+            }
+            if (rotationAnimated_)
+            {
+                const Quaternion rotation = firstKeyFrame.rotation_.Slerp(lastKeyFrame.rotation_, factor);
+                if (GetRotationError(rotation, keyFrame.rotation_) > rotationBudget_.reductionError_)
+                    return false;
+            }
+            if (scaleAnimated_)
+            {
+                const Vector3 scale = firstKeyFrame.scale_.Lerp(lastKeyFrame.scale_, factor);
+                if ((scale - keyFrame.scale_).Length() > scaleBudget_.reductionError_)
+                    return false;
+            }
+        }
+        return true;
+    }
+
+    const ea::vector<AnimationKeyFrame>& keyFrames_;
+    const AnimationCompressionSettings& settings_;
+
+    bool positionAnimated_{};
+    bool rotationAnimated_{};
+    bool scaleAnimated_{};
+
+    ChannelErrorBudget positionBudget_;
+    ChannelErrorBudget rotationBudget_;
+    ChannelErrorBudget scaleBudget_;
+};
+
+}
+
+void AnimationCompressionReport::Merge(const AnimationCompressionReport& other)
+{
+    numTracks_ += other.numTracks_;
+    numConstantChannels_ += other.numConstantChannels_;
+    numKeyFrames_ += other.numKeyFrames_;
+    numCompressedKeyFrames_ += other.numCompressedKeyFrames_;
+    uncompressedSize_ += other.uncompressedSize_;
+    compressedSize_ += other.compressedSize_;
+    maxPositionError_ = Max(maxPositionError_, other.maxPositionError_);
+    maxRotationError_ = Max(maxRotationError_, other.maxRotationError_);
+    maxScaleError_ = Max(maxScaleError_, other.maxScaleError_);
+}
+
+float AnimationCompressionReport::GetCompressionRatio() const
+{
+    return compressedSize_ > 0 ? static_cast<float>(uncompressedSize_) / compressedSize_ : 1.0f;
+}
+
+ea::string AnimationCompressionReport::ToString() const
+{
+    return Format("{} tracks, {} constant channels, {} of {} keyframes kept, {} -> {} bytes ({:.2f}x), "
+                  "max errors: position {:.6f}, rotation {:.6f} rad, scale {:.6f}",
+        numTracks_, numConstantChannels_, numCompressedKeyFrames_, numKeyFrames_, uncompressedSize_, compressedSize_,
+        GetCompressionRatio(), maxPositionError_, maxRotationError_, maxScaleError_);
+}
+
+void CompressedAnimationTrack::Compress(
+    const AnimationTrack& track, const AnimationCompressionSettings& settings, AnimationCompressionReport* report)
+{
+    URHO3D_ASSERT(!track.IsCompressed(), "Track should be decompressed before compression");
+
+    const ea::vector<AnimationKeyFrame>& keyFrames = track.keyFrames_;
+    const TrackCompressor compressor{track, settings};
+    const ea::vector<unsigned> keyFrameIndices = compressor.SelectKeyFrames();
+    const unsigned numKeyFrames = keyFrameIndices.size();
+
+    keyTimes_.keyFrames_.resize(numKeyFrames);
+    for (unsigned i = 0; i < numKeyFrames; ++i)
+        keyTimes_.keyFrames_[i].time_ = keyFrames[keyFrameIndices[i]].time_;
+
+    const AnimationKeyFrame defaultKeyFrame = !keyFrames.empty() ? keyFrames.front() : AnimationKeyFrame{};
+
+    ea::vector<Vector3> vectorValues(numKeyFrames);
+    if (compressor.IsPositionAnimated())
+    {
+        for (unsigned i = 0; i < numKeyFrames; ++i)
+            vectorValues[i] = keyFrames[keyFrameIndices[i]].position_;
+        if (compressor.IsPositionQuantized())
+            position_.Quantize(vectorValues);
+        else
+            position_.Store(vectorValues);
+    }
+    else
+        position_.SetConstant(defaultKeyFrame.position_);
+
+    if (compressor.IsScaleAnimated())
+    {
+        for (unsigned i = 0; i < numKeyFrames; ++i)
+            vectorValues[i] = keyFrames[keyFrameIndices[i]].scale_;
+        if (compressor.IsScaleQuantized())
+            scale_.Quantize(vectorValues);
+        else
+            scale_.Store(vectorValues);
+    }
+    else
+        scale_.SetConstant(defaultKeyFrame.scale_);
+
+    if (compressor.IsRotationAnimated())
+    {
+        ea::vector<Quaternion> rotationValues(numKeyFrames);
+        for (unsigned i = 0; i < numKeyFrames; ++i)
+            rotationValues[i] = keyFrames[keyFrameIndices[i]].rotation_;
+        if (compressor.IsRotationQuantized())
+            rotation_.Quantize(rotationValues);
+        else
+            rotation_.Store(rotationValues);
+    }
+    else
+        rotation_.SetConstant(defaultKeyFrame.rotation_);
+
+    if (!report)
+        return;
+
+    // Measure actual error at original keyframes
+    AnimationCompressionReport trackReport;
+    trackReport.numTracks_ = 1;
+    trackReport.numKeyFrames_ = keyFrames.size();
+    trackReport.numCompressedKeyFrames_ = numKeyFrames;
+    trackReport.uncompressedSize_ = keyFrames.size() * GetUncompressedKeyFrameSize(track.channelMask_);
+    trackReport.compressedSize_ = GetMemoryUse();
+
+    if (track.channelMask_.Test(CHANNEL_POSITION) && !compressor.IsPositionAnimated())
+        ++trackReport.numConstantChannels_;
+    if (track.channelMask_.Test(CHANNEL_ROTATION) && !compressor.IsRotationAnimated())
+        ++trackReport.numConstantChannels_;
+    if (track.channelMask_.Test(CHANNEL_SCALE) && !compressor.IsScaleAnimated())
+        ++trackReport.numConstantChannels_;
+
+    unsigned frameIndex = 0;
+    for (const AnimationKeyFrame& keyFrame : keyFrames)
+    {
+        Transform value;
+        Sample(keyFrame.time_, 0.0f, false, frameIndex, track.channelMask_, value);
+
+        if (track.channelMask_.Test(CHANNEL_POSITION))
+        {
+            const float error = (value.position_ - keyFrame.position_).Length();
+            trackReport.maxPositionError_ = Max(trackReport.maxPositionError_, error);
+        }
+        if (track.channelMask_.Test(CHANNEL_ROTATION))
+        {
+            const float error = GetRotationError(value.rotation_, keyFrame.rotation_);
+            trackReport.maxRotationError_ = Max(trackReport.maxRotationError_, error);
+        }
+        if (track.channelMask_.Test(CHANNEL_SCALE))
+        {
+            const float error = (value.scale_ - keyFrame.scale_).Length();
+            trackReport.maxScaleError_ = Max(trackReport.maxScaleError_, error);
+        }
+    }
+
+    report->Merge(trackReport);
+}
+
+void CompressedAnimationTrack::Decompress(ea::vector<AnimationKeyFrame>& keyFrames) const
+{
+    const unsigned numKeyFrames = GetNumKeyFrames();
+    keyFrames.resize(numKeyFrames);
+    for (unsigned i = 0; i < numKeyFrames; ++i)
+        keyFrames[i] = GetKeyFrame(i);
+}
+
+void CompressedAnimationTrack::Sample(float time, float duration, bool isLooped, unsigned& frameIndex,
+    AnimationChannelFlags channelMask, Transform& value) const
+{
+    if (keyTimes_.keyFrames_.empty())
+        return;
+
+    float blendFactor{};
+    unsigned nextFrameIndex{};
+    keyTimes_.GetKeyFrames(time, duration, isLooped, frameIndex, nextFrameIndex, blendFactor);
+
+    if (channelMask & CHANNEL_POSITION)
+        value.position_ = position_.Sample(frameIndex, nextFrameIndex, blendFactor);
+    if (channelMask & CHANNEL_ROTATION)
+        value.rotation_ = rotation_.Sample(frameIndex, nextFrameIndex, blendFactor);
+    if (channelMask & CHANNEL_SCALE)
+        value.scale_ = scale_.Sample(frameIndex, nextFrameIndex, blendFactor);
+}
+
+AnimationKeyFrame CompressedAnimationTrack::GetKeyFrame(unsigned index) const
+{
+    const float time = keyTimes_.keyFrames_[index].time_;
+    return AnimationKeyFrame{time, position_.Decode(index), rotation_.Decode(index), scale_.Decode(index)};
+}
+
+bool CompressedAnimationTrack::Load(Deserializer& source)
+{
+    const unsigned numKeyFrames = source.ReadVLE();
+    keyTimes_.keyFrames_.resize(numKeyFrames);
+    for (KeyTime& keyTime : keyTimes_.keyFrames_)
+        keyTime.time_ = source.ReadFloat();
+
+    position_.min_ = source.ReadVector3();
+    position_.step_ = source.ReadVector3();
+    if (!ReadKeys(source, position_.keys_, numKeyFrames))
+        return false;
+    if (!ReadValues(source, position_.values_, numKeyFrames))
+        return false;
+
+    rotation_.constant_ = source.ReadQuaternion();
+    if (!ReadKeys(source, rotation_.keys_, numKeyFrames))
+        return false;
+    if (!ReadValues(source, rotation_.values_, numKeyFrames))
+        return false;
+
+    scale_.min_ = source.ReadVector3();
+    scale_.step_ = source.ReadVector3();
+    if (!ReadKeys(source, scale_.keys_, numKeyFrames))
+        return false;
+    if (!ReadValues(source, scale_.values_, numKeyFrames))
+        return false;
+
+    return true;
+}
+
+void CompressedAnimationTrack::Save(Serializer& dest) const
+{
+    dest.WriteVLE(keyTimes_.keyFrames_.size());
+    for (const KeyTime& keyTime : keyTimes_.keyFrames_)
+        dest.WriteFloat(keyTime.time_);
+
+    dest.WriteVector3(position_.min_);
+    dest.WriteVector3(position_.step_);
+    WriteKeys(dest, position_.keys_);
+    WriteValues(dest, position_.values_);
+
+    dest.WriteQuaternion(rotation_.constant_);
+    WriteKeys(dest, rotation_.keys_);
+    WriteValues(dest, rotation_.values_);
+
+    dest.WriteVector3(scale_.min_);
+    dest.WriteVector3(scale_.step_);
+    WriteKeys(dest, scale_.keys_);
+    WriteValues(dest, scale_.values_);
+}
+
+unsigned CompressedAnimationTrack::GetMemoryUse() const
+{
+    const unsigned numKeys = position_.keys_.size() + rotation_.keys_.size() + scale_.keys_.size();
+    const unsigned numVectorValues = position_.values_.size() + scale_.values_.size();
+    return sizeof(CompressedAnimationTrack) + keyTimes_.keyFrames_.size() * sizeof(KeyTime)
+        + numKeys * sizeof(unsigned short) + numVectorValues * sizeof(Vector3)
+        + rotation_.values_.size() * sizeof(Quaternion);
+}
+
+void CompressedAnimationTrack::VectorChannel::SetConstant(const Vector3& value)
+{
+    min_ = value;
+    step_ = Vector3::ZERO;
+    keys_.clear();
+    values_.clear();
+}
+
+void CompressedAnimationTrack::VectorChannel::Quantize(const ea::vector<Vector3>& values)
+{
+    values_.clear();
+    min_ = values.front();
+    Vector3 max = values.front();
+    for (const Vector3& value : values)
+    {
+        min_ = VectorMin(min_, value);
+        max = VectorMax(max, value);
+    }
+    step_ = (max - min_) / MaxVectorValue;
+
+    keys_.resize(values.size() * 3);
+    for (unsigned i = 0; i < values.size(); ++i)
+    {
+        for (unsigned j = 0; j < 3; ++j)
+        {
+            const float step = step_.Data()[j];
+            const float offset = values[i].Data()[j] - min_.Data()[j];
+            const int quantizedValue = step > 0.0f ? RoundToInt(offset / step) : 0;
+            keys_[i * 3 + j] = static_cast<unsigned short>(Clamp(quantizedValue, 0, static_cast<int>(MaxVectorValue)));
+        }
+    }
+}
+
+void CompressedAnimationTrack::VectorChannel::Store(const ea::vector<Vector3>& values)
+{
+    min_ = Vector3::ZERO;
+    step_ = Vector3::ZERO;
+    keys_.clear();
+    values_ = values;
+}
+
+Vector3 CompressedAnimationTrack::VectorChannel::Decode(unsigned index) const
+{
+    if (!values_.empty())
+        return values_[index];
+    if (keys_.empty())
+        return min_;
+
+    const unsigned short* key = &keys_[index * 3];
+    return min_ + step_ * Vector3{static_cast<float>(key[0]), static_cast<float>(key[1]), static_cast<float>(key[2])};
+}
+
+Vector3 CompressedAnimationTrack::VectorChannel::Sample(unsigned index, unsigned nextIndex, float blendFactor) const
+{
+    if (keys_.empty() && values_.empty())
+        return min_;
+
+    const Vector3 value = Decode(index);
+    return blendFactor >= M_EPSILON ? value.Lerp(Decode(nextIndex), blendFactor) : value;
+}
+
+void CompressedAnimationTrack::RotationChannel::SetConstant(const Quaternion& value)
+{
+    constant_ = value;
+    keys_.clear();
+    values_.clear();
+}
+
+void CompressedAnimationTrack::RotationChannel::Quantize(const ea::vector<Quaternion>& values)
+{
+    constant_ = Quaternion::IDENTITY;
+    values_.clear();
+    keys_.resize(values.size() * 3);
+    for (unsigned i = 0; i < values.size(); ++i)
+        EncodeQuaternion(values[i], &keys_[i * 3]);
+}
+
+void CompressedAnimationTrack::RotationChannel::Store(const ea::vector<Quaternion>& values)
+{
+    constant_ = Quaternion::IDENTITY;
+    keys_.clear();
+    values_ = values;
+}
+
+Quaternion CompressedAnimationTrack::RotationChannel::Decode(unsigned index) const
+{
+    if (!values_.empty())
+        return values_[index];
+    if (keys_.empty())
+        return constant_;
+
+    return DecodeQuaternion(&keys_[index * 3]);
+}
+
+Quaternion CompressedAnimationTrack::RotationChannel::Sample(
+    unsigned index, unsigned nextIndex, float blendFactor) const
+{
+    if (keys_.empty() && values_.empty())
+        return constant_;
+
+    const Quaternion value = Decode(index);
+    return blendFactor >= M_EPSILON ? value.Slerp(Decode(nextIndex), blendFactor) : value;
+}
+
+}
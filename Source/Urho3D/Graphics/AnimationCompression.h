@@ -0,0 +1,136 @@
+// Copyright (c) 2023-2023 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#pragma once
+
+#include "Urho3D/Graphics/AnimationTrack.h"
+
+namespace Urho3D
+{
+
+class Deserializer;
+class Serializer;
+
+/// Settings of skeletal animation compression.
+struct URHO3D_API AnimationCompressionSettings
+{
+    /// Max position error, in units of bone space.
+    float positionError_{0.0005f};
+    /// Max rotation error, in radians.
+    float rotationError_{0.0005f};
+    /// Max scale error.
+    float scaleError_{0.0005f};
+    /// Whether to remove keyframes that can be interpolated from neighbor keyframes within error bounds.
+    bool reduceKeyFrames_{true};
+};
+
+/// Memory and accuracy statistics of animation compression.
+struct URHO3D_API AnimationCompressionReport
+{
+    unsigned numTracks_{};
+    /// Number of channels that are stored as single value.
+    unsigned numConstantChannels_{};
+    unsigned numKeyFrames_{};
+    unsigned numCompressedKeyFrames_{};
+    /// Size of keyframe data in bytes.
+    /// @{
+    unsigned uncompressedSize_{};
+    unsigned compressedSize_{};
+    /// @}
+    /// Max errors measured at original keyframes.
+    /// @{
+    float maxPositionError_{};
+    float maxRotationError_{};
+    float maxScaleError_{};
+    /// @}
+
+    /// Accumulate statistics of another track or animation.
+    void Merge(const AnimationCompressionReport& other);
+    /// Return ratio of uncompressed size to compressed size.
+    float GetCompressionRatio() const;
+    /// Return human-readable report.
+    ea::string ToString() const;
+};
+
+/// Compressed keyframes of skeletal animation track.
+/// Rotations are stored as smallest-three quaternions packed into 48 bits.
+/// Positions and scales are quantized to 16 bits per component within the range of the track.
+/// Channels that cannot be quantized within half of the error tolerance are stored in full precision.
+/// Channels that don't change are stored as single full-precision value.
+class URHO3D_API CompressedAnimationTrack
+{
+public:
+    /// Compress keyframes of the track. Channels not included into channel mask are ignored.
+    void Compress(const AnimationTrack& track, const AnimationCompressionSettings& settings,
+        AnimationCompressionReport* report = nullptr);
+    /// Decompress all keyframes.
+    void Decompress(ea::vector<AnimationKeyFrame>& keyFrames) const;
+
+    /// Sample value at given time. Safe to call from multiple threads.
+    void Sample(float time, float duration, bool isLooped, unsigned& frameIndex, AnimationChannelFlags channelMask,
+        Transform& value) const;
+    /// Return keyframe at index.
+    AnimationKeyFrame GetKeyFrame(unsigned index) const;
+    /// Return keyframe index based on time and previous index as hint. Return false if track is empty.
+    bool GetKeyFrameIndex(float time, unsigned& index) const { return keyTimes_.GetKeyFrameIndex(time, index); }
+
+    /// Serialize from/to stream.
+    /// @{
+    bool Load(Deserializer& source);
+    void Save(Serializer& dest) const;
+    /// @}
+
+    /// Return number of stored keyframes.
+    unsigned GetNumKeyFrames() const { return keyTimes_.GetNumKeyFrames(); }
+    /// Return size of keyframe data in bytes.
+    unsigned GetMemoryUse() const;
+
+private:
+    /// Time of the keyframe. Other keyframe data is stored per channel.
+    struct KeyTime
+    {
+        float time_{};
+    };
+
+    /// Vector channel quantized within bounding box.
+    struct VectorChannel
+    {
+        Vector3 min_;
+        /// Size of quantization step. Zero components are constant.
+        Vector3 step_;
+        /// Three quantized components per keyframe. Empty if channel is constant or not quantized.
+        ea::vector<unsigned short> keys_;
+        /// Full-precision value per keyframe. Empty if channel is constant or quantized.
+        ea::vector<Vector3> values_;
+
+        void SetConstant(const Vector3& value);
+        void Quantize(const ea::vector<Vector3>& values);
+        void Store(const ea::vector<Vector3>& values);
+        Vector3 Decode(unsigned index) const;
+        Vector3 Sample(unsigned index, unsigned nextIndex, float blendFactor) const;
+    };
+
+    /// Rotation channel with smallest-three quaternions.
+    struct RotationChannel
+    {
+        Quaternion constant_;
+        /// Three packed components per keyframe. Empty if channel is constant or not quantized.
+        ea::vector<unsigned short> keys_;
+        /// Full-precision value per keyframe. Empty if channel is constant or quantized.
+        ea::vector<Quaternion> values_;
+
+        void SetConstant(const Quaternion& value);
+        void Quantize(const ea::vector<Quaternion>& values);
+        void Store(const ea::vector<Quaternion>& values);
+        Quaternion Decode(unsigned index) const;
+        Quaternion Sample(unsigned index, unsigned nextIndex, float blendFactor) const;
+    };
+
+    KeyFrameSet<KeyTime> keyTimes_;
+    VectorChannel position_;
+    RotationChannel rotation_;
+    VectorChannel scale_;
+};
+
+}
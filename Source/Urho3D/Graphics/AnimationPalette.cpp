@@ -0,0 +1,294 @@
+// Copyright (c) 2023-2023 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#include "Urho3D/Precompiled.h"
+
+#include "Urho3D/Graphics/AnimationPalette.h"
+
+#include "Urho3D/Core/Context.h"
+#include "Urho3D/Graphics/Animation.h"
+#include "Urho3D/Graphics/Material.h"
+#include "Urho3D/Graphics/Model.h"
+#include "Urho3D/Graphics/Texture2D.h"
+#include "Urho3D/IO/Log.h"
+#include "Urho3D/Math/Sphere.h"
+#include "Urho3D/RenderAPI/RenderDevice.h"
+#include "Urho3D/Resource/ResourceCache.h"
+
+#include "Urho3D/DebugNew.h"
+
+namespace Urho3D
+{
+
+namespace
+{
+
+bool HasGeometryBoneMappings(const Model& model)
+{
+    for (const ea::vector<unsigned>& boneMapping : model.GetGeometryBoneMappings())
+    {
+        if (!boneMapping.empty())
+            return true;
+    }
+    return false;
+}
+
+}
+
+const ea::string AnimationPalette::TextureName = "AnimationPalette";
+const ea::string AnimationPalette::ShaderDefine = "URHO3D_ANIMATION_PALETTE";
+
+AnimationPalette::AnimationPalette(Context* context)
+    : Resource(context)
+{
+}
+
+AnimationPalette::~AnimationPalette() = default;
+
+void AnimationPalette::RegisterObject(Context* context)
+{
+    context->AddFactoryReflection<AnimationPalette>();
+}
+
+SharedPtr<AnimationPalette> AnimationPalette::GetOrCreate(
+    Model* model, const ea::vector<SharedPtr<Animation>>& animations, float frameRate)
+{
+    if (!model)
+        return nullptr;
+
+    // Procedural models cannot be identified by name, bake them every time
+    Context* context = model->GetContext();
+    if (model->GetName().empty())
+    {
+        auto palette = MakeShared<AnimationPalette>(context);
+        return palette->Bake(model, animations, frameRate) ? palette : nullptr;
+    }
+
+    unsigned hash = 0;
+    for (Animation* animation : animations)
+        CombineHash(hash, animation ? MakeHash(animation->GetName()) : 0u);
+    CombineHash(hash, MakeHash(frameRate));
+
+    auto cache = context->GetSubsystem<ResourceCache>();
+    const ea::string paletteName = Format("{}#AnimationPalette{:08X}", model->GetName(), hash);
+    if (auto palette = cache->GetExistingResource<AnimationPalette>(paletteName))
+        return SharedPtr<AnimationPalette>(palette);
+
+    auto palette = MakeShared<AnimationPalette>(context);
+    palette->SetName(paletteName);
+    if (!palette->Bake(model, animations, frameRate))
+        return nullptr;
+
+    cache->AddManualResource(palette);
+    return palette;
+}
+
+bool AnimationPalette::Bake(Model* model, const ea::vector<SharedPtr<Animation>>& animations, float frameRate)
+{
+    clips_.clear();
+    skinMatrices_.clear();
+    boundingBox_.Clear();
+    numBones_ = 0;
+    numFrames_ = 0;
+    frameRate_ = frameRate;
+
+    if (!model)
+    {
+        URHO3D_LOGERROR("Cannot bake animation palette without model");
+        return false;
+    }
+
+    if (frameRate <= 0.0f)
+    {
+        URHO3D_LOGERROR("Cannot bake animation palette for model '{}' with non-positive frame rate", model->GetName());
+        return false;
+    }
+
+    const Skeleton& skeleton = model->GetSkeleton();
+    if (skeleton.GetNumBones() == 0)
+    {
+        URHO3D_LOGERROR("Cannot bake animation palette for model '{}' without skeleton", model->GetName());
+        return false;
+    }
+
+    // Vertex bone indices should refer to the skeleton directly, so the palette is shared by all geometries
+    if (HasGeometryBoneMappings(*model))
+    {
+        URHO3D_LOGERROR("Cannot bake animation palette for model '{}' with per-geometry bone mappings", model->GetName());
+        return false;
+    }
+
+    numBones_ = skeleton.GetNumBones();
+    for (Animation* animation : animations)
+    {
+        if (!animation)
+            continue;
+
+        const float length = animation->GetLength();
+        AnimationPaletteClip& clip = clips_.emplace_back();
+        clip.animation_ = animation;
+        clip.firstFrame_ = numFrames_;
+        clip.numFrames_ = ea::max(1, CeilToInt(length * frameRate)) + 1;
+        clip.frameInterval_ = length / (clip.numFrames_ - 1);
+        numFrames_ += clip.numFrames_;
+    }
+
+    if (numBones_ * 3 > MaxTextureSize || numFrames_ > MaxTextureSize)
+    {
+        URHO3D_LOGERROR("Animation palette for model '{}' is too big: {} bones and {} frames",
+            model->GetName(), numBones_, numFrames_);
+        clips_.clear();
+        numFrames_ = 0;
+        return false;
+    }
+
+    skinMatrices_.resize(numFrames_ * numBones_);
+
+    ea::vector<unsigned> keyFrameCursors;
+    ea::vector<Matrix3x4> boneTransforms(numBones_);
+    const ea::vector<Bone>& bones = skeleton.GetBones();
+    for (const AnimationPaletteClip& clip : clips_)
+    {
+        // Frames are evaluated in order, so cached keyframe cursors are valid between frames
+        keyFrameCursors.assign(numBones_, 0u);
+        for (unsigned frame = 0; frame < clip.numFrames_; ++frame)
+        {
+            const float time = ea::min(frame * clip.frameInterval_, clip.animation_->GetLength());
+            EvaluateFrame(*model, *clip.animation_, time, keyFrameCursors, boneTransforms);
+
+            Matrix3x4* frameSkinMatrices = &skinMatrices_[(clip.firstFrame_ + frame) * numBones_];
+            for (unsigned boneIndex = 0; boneIndex < numBones_; ++boneIndex)
+            {
+                const Bone& bone = bones[boneIndex];
+                const Matrix3x4& transform = boneTransforms[boneIndex];
+                frameSkinMatrices[boneIndex] = transform * bone.offsetMatrix_;
+
+                if (bone.collisionMask_ & BONECOLLISION_BOX)
+                    boundingBox_.Merge(bone.boundingBox_.Transformed(transform));
+                else if (bone.collisionMask_ & BONECOLLISION_SPHERE)
+                    boundingBox_.Merge(Sphere(transform.Translation(), bone.radius_ * 0.5f));
+            }
+        }
+    }
+
+    if (!boundingBox_.Defined())
+        boundingBox_ = model->GetBoundingBox();
+
+    CreateTexture();
+    for (const auto& [sourceMaterial, paletteMaterial] : materials_)
+        paletteMaterial->SetTexture(TextureName, texture_);
+
+    SetMemoryUse(skinMatrices_.size() * sizeof(Matrix3x4));
+    return true;
+}
+
+void AnimationPalette::EvaluateFrame(const Model& model, Animation& animation, float time,
+    ea::vector<unsigned>& keyFrameCursors, ea::vector<Matrix3x4>& boneTransforms) const
+{
+    const Skeleton& skeleton = model.GetSkeleton();
+    const float length = animation.GetLength();
+    for (unsigned boneIndex : skeleton.GetBonesOrder())
+    {
+        const Bone& bone = skeleton.GetBones()[boneIndex];
+
+        Transform transform{bone.initialPosition_, bone.initialRotation_, bone.initialScale_};
+        if (bone.animated_)
+        {
+            if (const AnimationTrack* track = animation.GetTrack(bone.nameHash_))
+                track->Sample(time, length, false, keyFrameCursors[boneIndex], transform);
+        }
+
+        const Matrix3x4 localTransform = transform.ToMatrix3x4();
+        if (bone.parentIndex_ == boneIndex)
+            boneTransforms[boneIndex] = localTransform;
+        else
+            boneTransforms[boneIndex] = boneTransforms[bone.parentIndex_] * localTransform;
+    }
+}
+
+void AnimationPalette::CreateTexture()
+{
+    texture_ = nullptr;
+    if (!GetSubsystem<RenderDevice>() || skinMatrices_.empty())
+        return;
+
+    // Matrices are fetched texel by texel, filtering is never used
+    texture_ = MakeShared<Texture2D>(context_);
+    texture_->SetName(GetName());
+    texture_->SetNumLevels(1);
+    texture_->SetFilterMode(FILTER_NEAREST);
+    texture_->SetAddressMode(TextureCoordinate::U, ADDRESS_CLAMP);
+    texture_->SetAddressMode(TextureCoordinate::V, ADDRESS_CLAMP);
+
+    const int width = static_cast<int>(numBones_ * 3);
+    const int height = static_cast<int>(numFrames_);
+    if (!texture_->SetSize(width, height, TextureFormat::TEX_FORMAT_RGBA32_FLOAT)
+        || !texture_->SetData(0, 0, 0, width, height, skinMatrices_.data()))
+    {
+        URHO3D_LOGERROR("Failed to create animation palette texture {}x{}", width, height);
+        texture_ = nullptr;
+    }
+}
+
+Material* AnimationPalette::GetMaterial(Material* material)
+{
+    if (!material)
+        return nullptr;
+
+    for (const auto& [sourceMaterial, paletteMaterial] : materials_)
+    {
+        if (sourceMaterial == material || paletteMaterial == material)
+            return paletteMaterial;
+    }
+
+    const ea::string& defines = material->GetVertexShaderDefines();
+    SharedPtr<Material> paletteMaterial = material->Clone();
+    paletteMaterial->SetVertexShaderDefines(defines.empty() ? ShaderDefine : defines + " " + ShaderDefine);
+    paletteMaterial->SetTexture(TextureName, texture_);
+
+    materials_.emplace_back(SharedPtr<Material>(material), paletteMaterial);
+    return paletteMaterial;
+}
+
+Material* AnimationPalette::GetSourceMaterial(Material* material) const
+{
+    for (const auto& [sourceMaterial, paletteMaterial] : materials_)
+    {
+        if (paletteMaterial == material)
+            return sourceMaterial;
+    }
+    return material;
+}
+
+Vector4 AnimationPalette::GetInstanceData(unsigned clipIndex, float time, bool looped) const
+{
+    if (clipIndex >= clips_.size())
+        return Vector4::ZERO;
+
+    const AnimationPaletteClip& clip = clips_[clipIndex];
+    const float length = clip.frameInterval_ * (clip.numFrames_ - 1);
+    if (length <= 0.0f)
+        return Vector4(static_cast<float>(clip.firstFrame_), static_cast<float>(clip.firstFrame_), 0.0f, 0.0f);
+
+    time = looped ? AbsMod(time, length) : Clamp(time, 0.0f, length);
+
+    const float position = time / clip.frameInterval_;
+    const unsigned frame = ea::min(static_cast<unsigned>(ea::max(0, FloorToInt(position))), clip.numFrames_ - 2);
+    const float blendFactor = Clamp(position - frame, 0.0f, 1.0f);
+
+    const unsigned firstFrame = clip.firstFrame_ + frame;
+    return Vector4(static_cast<float>(firstFrame), static_cast<float>(firstFrame + 1), blendFactor, 0.0f);
+}
+
+unsigned AnimationPalette::GetClipIndex(const ea::string& animationName) const
+{
+    for (unsigned i = 0; i < clips_.size(); ++i)
+    {
+        if (clips_[i].animation_->GetName() == animationName)
+            return i;
+    }
+    return M_MAX_UNSIGNED;
+}
+
+}
@@ -0,0 +1,110 @@
+// Copyright (c) 2023-2023 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#pragma once
+
+#include "Urho3D/Math/BoundingBox.h"
+#include "Urho3D/Math/Matrix3x4.h"
+#include "Urho3D/Resource/Resource.h"
+
+#include <EASTL/vector.h>
+
+namespace Urho3D
+{
+
+class Animation;
+class Material;
+class Model;
+class Texture2D;
+
+/// Animation clip baked into animation palette.
+struct AnimationPaletteClip
+{
+    SharedPtr<Animation> animation_;
+    /// Index of the first frame of the clip in the palette.
+    unsigned firstFrame_{};
+    /// Number of frames of the clip, including the frames at the start and at the end of the clip.
+    unsigned numFrames_{};
+    /// Time between frames.
+    float frameInterval_{};
+};
+
+/// Skinning matrices of the model baked for all frames of the animation clips.
+/// Matrices are stored in model space in the texture, one frame per row and three texels per bone.
+/// Animated instances sample the texture in vertex shader and need only the current frames as per-instance data,
+/// so they are batched and instanced like static models.
+class URHO3D_API AnimationPalette : public Resource
+{
+    URHO3D_OBJECT(AnimationPalette, Resource);
+
+public:
+    /// Name of the material texture that contains the palette.
+    static const ea::string TextureName;
+    /// Vertex shader define that enables palette skinning in the material.
+    static const ea::string ShaderDefine;
+    /// Max width and height of the palette texture.
+    static const unsigned MaxTextureSize = 4096;
+
+    explicit AnimationPalette(Context* context);
+    ~AnimationPalette() override;
+    /// Register object factory.
+    /// @nobind
+    static void RegisterObject(Context* context);
+
+    /// Return palette shared by all users of the same model, animations and frame rate. Palette is baked on first use.
+    /// Palettes of named models are kept in resource cache as manual resources.
+    static SharedPtr<AnimationPalette> GetOrCreate(
+        Model* model, const ea::vector<SharedPtr<Animation>>& animations, float frameRate);
+
+    /// Bake animations of the model. Should be called from main thread.
+    bool Bake(Model* model, const ea::vector<SharedPtr<Animation>>& animations, float frameRate);
+
+    /// Return copy of the material with palette texture. Copies are shared between users of the palette.
+    Material* GetMaterial(Material* material);
+    /// Return source material of the material copy. Return material itself if it's not a copy made by this palette.
+    Material* GetSourceMaterial(Material* material) const;
+    /// Return per-instance data for the clip at given time:
+    /// indices of two nearest frames in the palette and blend factor between them.
+    Vector4 GetInstanceData(unsigned clipIndex, float time, bool looped) const;
+
+    /// Return index of the clip with given animation name, or M_MAX_UNSIGNED if not found.
+    unsigned GetClipIndex(const ea::string& animationName) const;
+    /// Return clip by index.
+    const AnimationPaletteClip& GetClip(unsigned index) const { return clips_[index]; }
+    /// Return number of clips.
+    unsigned GetNumClips() const { return clips_.size(); }
+    /// Return number of bones.
+    unsigned GetNumBones() const { return numBones_; }
+    /// Return total number of frames.
+    unsigned GetNumFrames() const { return numFrames_; }
+    /// Return frame rate used for baking.
+    float GetFrameRate() const { return frameRate_; }
+    /// Return skinning matrix of the bone in model space.
+    const Matrix3x4& GetSkinMatrix(unsigned frame, unsigned bone) const { return skinMatrices_[frame * numBones_ + bone]; }
+    /// Return bounding box of the model in all frames.
+    const BoundingBox& GetBoundingBox() const { return boundingBox_; }
+    /// Return palette texture. Null if there's no render device.
+    Texture2D* GetTexture() const { return texture_; }
+
+private:
+    /// Evaluate model-space transforms of all bones for given time of the clip.
+    void EvaluateFrame(const Model& model, Animation& animation, float time,
+        ea::vector<unsigned>& keyFrameCursors, ea::vector<Matrix3x4>& boneTransforms) const;
+    /// Create texture from baked matrices.
+    void CreateTexture();
+
+    ea::vector<AnimationPaletteClip> clips_;
+    unsigned numBones_{};
+    unsigned numFrames_{};
+    float frameRate_{};
+    /// Skinning matrices of all bones for all frames.
+    ea::vector<Matrix3x4> skinMatrices_;
+    BoundingBox boundingBox_;
+
+    SharedPtr<Texture2D> texture_;
+    /// Source and palette materials.
+    ea::vector<ea::pair<SharedPtr<Material>, SharedPtr<Material>>> materials_;
+};
+
+}
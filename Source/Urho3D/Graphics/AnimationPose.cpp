@@ -0,0 +1,113 @@
+// Copyright (c) 2023-2023 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#include "Urho3D/Precompiled.h"
+
+#include "Urho3D/Graphics/AnimationPose.h"
+
+#include "Urho3D/DebugNew.h"
+
+namespace Urho3D
+{
+
+namespace
+{
+
+template <class T, class Interpolate>
+void BlendChannelLerp(ea::vector<T>& values, ea::vector<AnimationChannelFlags>& dirty, AnimationChannel channel,
+    const AnimationChannelSamples<T>& samples, float weight, const Interpolate& interpolate)
+{
+    const unsigned numSamples = samples.Size();
+    const unsigned* boneIndices = samples.boneIndices_.data();
+    const T* sampledValues = samples.values_.data();
+    const float* trackWeights = samples.weights_.data();
+
+    for (unsigned i = 0; i < numSamples; ++i)
+    {
+        const unsigned boneIndex = boneIndices[i];
+        const float sampleWeight = weight * trackWeights[i];
+
+        // Disable interpolation if bone is not animated yet
+        AnimationChannelFlags& boneDirty = dirty[boneIndex];
+        if (!Equals(sampleWeight, 1.0f) && boneDirty.Test(channel))
+            values[boneIndex] = interpolate(values[boneIndex], sampledValues[i], sampleWeight);
+        else
+        {
+            boneDirty |= channel;
+            values[boneIndex] = sampledValues[i];
+        }
+    }
+}
+
+void BlendVectorsAdditive(ea::vector<Vector3>& values, const ea::vector<AnimationChannelFlags>& dirty,
+    AnimationChannel channel, const AnimationChannelSamples<Vector3>& samples, float weight)
+{
+    const unsigned numSamples = samples.Size();
+    for (unsigned i = 0; i < numSamples; ++i)
+    {
+        const unsigned boneIndex = samples.boneIndices_[i];
+        if (!dirty[boneIndex].Test(channel))
+            continue;
+
+        const Vector3 delta = samples.values_[i] - samples.baseValues_[i];
+        values[boneIndex] += delta * (weight * samples.weights_[i]);
+    }
+}
+
+void BlendRotationsAdditive(ea::vector<Quaternion>& values, const ea::vector<AnimationChannelFlags>& dirty,
+    const AnimationChannelSamples<Quaternion>& samples, float weight)
+{
+    const unsigned numSamples = samples.Size();
+    for (unsigned i = 0; i < numSamples; ++i)
+    {
+        const unsigned boneIndex = samples.boneIndices_[i];
+        if (!dirty[boneIndex].Test(CHANNEL_ROTATION))
+            continue;
+
+        const float sampleWeight = weight * samples.weights_[i];
+        const Quaternion delta = samples.values_[i] * samples.baseValues_[i].Inverse();
+        if (Equals(sampleWeight, 1.0f))
+            values[boneIndex] = delta * values[boneIndex];
+        else
+            values[boneIndex] = Quaternion::IDENTITY.Slerp(delta, sampleWeight) * values[boneIndex];
+    }
+}
+
+}
+
+void AnimationPose::Resize(unsigned numBones)
+{
+    positions_.resize(numBones, Vector3::ZERO);
+    rotations_.resize(numBones, Quaternion::IDENTITY);
+    scales_.resize(numBones, Vector3::ONE);
+    dirty_.resize(numBones, CHANNEL_NONE);
+}
+
+void AnimationPose::ResetBone(unsigned index, const Vector3& position, const Quaternion& rotation, const Vector3& scale)
+{
+    positions_[index] = position;
+    rotations_[index] = rotation;
+    scales_[index] = scale;
+    dirty_[index] = CHANNEL_NONE;
+}
+
+void AnimationPose::BlendLerp(const AnimationPoseSamples& samples, float weight)
+{
+    const auto lerpVector = [](const Vector3& lhs, const Vector3& rhs, float factor) { return lhs.Lerp(rhs, factor); };
+    const auto slerpQuaternion = [](const Quaternion& lhs, const Quaternion& rhs, float factor)
+    { return lhs.Slerp(rhs, factor); };
+
+    BlendChannelLerp(positions_, dirty_, CHANNEL_POSITION, samples.positions_, weight, lerpVector);
+    BlendChannelLerp(rotations_, dirty_, CHANNEL_ROTATION, samples.rotations_, weight, slerpQuaternion);
+    BlendChannelLerp(scales_, dirty_, CHANNEL_SCALE, samples.scales_, weight, lerpVector);
+}
+
+void AnimationPose::BlendAdditive(const AnimationPoseSamples& samples, float weight)
+{
+    BlendVectorsAdditive(positions_, dirty_, CHANNEL_POSITION, samples.positions_, weight);
+    BlendRotationsAdditive(rotations_, dirty_, samples.rotations_, weight);
+    BlendVectorsAdditive(scales_, dirty_, CHANNEL_SCALE, samples.scales_, weight);
+}
+
+}
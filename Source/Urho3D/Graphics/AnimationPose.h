@@ -0,0 +1,100 @@
+// Copyright (c) 2023-2023 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#pragma once
+
+#include "Urho3D/Graphics/Skeleton.h"
+#include "Urho3D/Math/Matrix3x4.h"
+#include "Urho3D/Math/Transform.h"
+
+#include <EASTL/vector.h>
+
+namespace Urho3D
+{
+
+/// Values of single animation channel sampled from all tracks of animation state.
+template <class T> struct AnimationChannelSamples
+{
+    ea::vector<unsigned> boneIndices_;
+    ea::vector<T> values_;
+    /// Weights of the tracks.
+    ea::vector<float> weights_;
+    /// Values of the first keyframes of the tracks, used for additive blending.
+    ea::vector<T> baseValues_;
+
+    void Clear()
+    {
+        boneIndices_.clear();
+        values_.clear();
+        weights_.clear();
+        baseValues_.clear();
+    }
+
+    void Add(unsigned boneIndex, const T& value, float weight, const T& baseValue)
+    {
+        boneIndices_.push_back(boneIndex);
+        values_.push_back(value);
+        weights_.push_back(weight);
+        baseValues_.push_back(baseValue);
+    }
+
+    unsigned Size() const { return boneIndices_.size(); }
+};
+
+/// Bone transforms sampled from all tracks of animation state.
+struct AnimationPoseSamples
+{
+    AnimationChannelSamples<Vector3> positions_;
+    AnimationChannelSamples<Quaternion> rotations_;
+    AnimationChannelSamples<Vector3> scales_;
+
+    void Clear()
+    {
+        positions_.Clear();
+        rotations_.Clear();
+        scales_.Clear();
+    }
+};
+
+/// Local transforms of skeleton bones stored as structure of arrays.
+/// Animation states are blended into the pose one channel at a time,
+/// and the final pose is written to bone nodes once.
+class URHO3D_API AnimationPose
+{
+public:
+    /// Resize pose. New bones have identity transforms.
+    void Resize(unsigned numBones);
+    /// Set local transform of the bone and mark it as not animated yet.
+    void ResetBone(unsigned index, const Vector3& position, const Quaternion& rotation, const Vector3& scale);
+
+    /// Blend samples into the pose with linear interpolation.
+    /// The first sample of each channel overwrites initial value of the bone.
+    void BlendLerp(const AnimationPoseSamples& samples, float weight);
+    /// Add difference between samples and base values to the pose.
+    /// Channels that are not animated yet are ignored.
+    void BlendAdditive(const AnimationPoseSamples& samples, float weight);
+
+    /// Return number of bones.
+    unsigned GetNumBones() const { return positions_.size(); }
+    /// Return local transform of the bone.
+    Transform GetBone(unsigned index) const { return Transform{positions_[index], rotations_[index], scales_[index]}; }
+    /// Return local transform matrix of the bone.
+    Matrix3x4 GetBoneMatrix(unsigned index) const { return Matrix3x4{positions_[index], rotations_[index], scales_[index]}; }
+
+    /// Return transforms of all bones.
+    /// @{
+    const ea::vector<Vector3>& GetPositions() const { return positions_; }
+    const ea::vector<Quaternion>& GetRotations() const { return rotations_; }
+    const ea::vector<Vector3>& GetScales() const { return scales_; }
+    /// @}
+
+private:
+    ea::vector<Vector3> positions_;
+    ea::vector<Quaternion> rotations_;
+    ea::vector<Vector3> scales_;
+    /// Channels of the bone that are already animated.
+    ea::vector<AnimationChannelFlags> dirty_;
+};
+
+}
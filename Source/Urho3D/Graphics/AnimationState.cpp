@@ -159,6 +159,10 @@ void AnimationState::ClearAllTracks()
 void AnimationState::AddModelTrack(const ModelAnimationStateTrack& track)
 {
     modelTracks_.push_back(track);
+
+    ModelAnimationStateTrack& addedTrack = modelTracks_.back();
+    if (!addedTrack.track_->IsEmpty())
+        addedTrack.baseValue_ = addedTrack.track_->GetKeyFrameValue(0);
 }
 
 void AnimationState::AddNodeTrack(const NodeAnimationStateTrack& track)
@@ -232,24 +236,42 @@ float AnimationState::GetLength() const
     return animation_ ? animation_->GetLength() : 0.0f;
 }
 
-void AnimationState::CalculateModelTracks(ea::vector<ModelAnimationOutput>& output) const
+void AnimationState::CalculateModelTracks(AnimationPose& pose, AnimationPoseSamples& samples) const
 {
     if (!animation_ || !IsEnabled())
         return;
 
+    samples.Clear();
+
+    const float length = animation_->GetLength();
     for (const ModelAnimationStateTrack& stateTrack : modelTracks_)
     {
+        const AnimationTrack& track = *stateTrack.track_;
+
         // Do not apply if the bone has animation disabled
-        if (!stateTrack.bone_->animated_)
+        if (!stateTrack.bone_->animated_ || track.IsEmpty())
             continue;
 
-        URHO3D_ASSERT(output.size() > stateTrack.boneIndex_);
-        ModelAnimationOutput& trackOutput = output[stateTrack.boneIndex_];
+        URHO3D_ASSERT(pose.GetNumBones() > stateTrack.boneIndex_);
 
-        unsigned keyFrame = stateTrack.keyFrame_;
-        CalculateTransformTrack(trackOutput, *stateTrack.track_, keyFrame, weight_);
-        stateTrack.keyFrame_ = keyFrame;
+        // Key frame hint makes sampling O(1) for continuous playback
+        Transform value;
+        track.Sample(time_, length, looped_, stateTrack.keyFrame_, value);
+
+        const unsigned boneIndex = stateTrack.boneIndex_;
+        const Transform& baseValue = stateTrack.baseValue_;
+        if (track.channelMask_.Test(CHANNEL_POSITION))
+            samples.positions_.Add(boneIndex, value.position_, track.weight_, baseValue.position_);
+        if (track.channelMask_.Test(CHANNEL_ROTATION))
+            samples.rotations_.Add(boneIndex, value.rotation_, track.weight_, baseValue.rotation_);
+        if (track.channelMask_.Test(CHANNEL_SCALE))
+            samples.scales_.Add(boneIndex, value.scale_, track.weight_, baseValue.scale_);
     }
+
+    if (blendingMode_ == ABM_ADDITIVE)
+        pose.BlendAdditive(samples, weight_);
+    else
+        pose.BlendLerp(samples, weight_);
 }
 
 void AnimationState::CalculateNodeTracks(ea::unordered_map<Node*, NodeAnimationOutput>& output) const
@@ -285,18 +307,19 @@ void AnimationState::CalculateAttributeTracks(ea::unordered_map<AnimatedAttribut
 void AnimationState::CalculateTransformTrack(
     NodeAnimationOutput& output, const AnimationTrack& track, unsigned& frame, float baseWeight) const
 {
-    if (track.keyFrames_.empty())
+    if (track.IsEmpty())
         return;
 
     const float weight = baseWeight * track.weight_;
     const bool isFullWeight = Equals(weight, 1.0f);
-    const AnimationKeyFrame& baseValue = track.keyFrames_.front();
 
     Transform sampledValue;
     track.Sample(time_, animation_->GetLength(), looped_, frame, sampledValue);
 
     if (blendingMode_ == ABM_ADDITIVE)
     {
+        const AnimationKeyFrame baseValue = track.GetKeyFrameValue(0);
+
         // In additive mode, check for output being already initialzed
         if ((track.channelMask_ & output.dirty_).Test(CHANNEL_POSITION))
         {
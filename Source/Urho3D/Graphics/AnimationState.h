@@ -27,6 +27,7 @@
 #include <EASTL/unordered_map.h>
 
 #include "../Container/Ptr.h"
+#include "../Graphics/AnimationPose.h"
 #include "../Graphics/Skeleton.h"
 #include "../Math/StringHash.h"
 #include "../Math/Transform.h"
@@ -78,13 +79,8 @@ struct ModelAnimationStateTrack : public NodeAnimationStateTrack
 {
     unsigned boneIndex_{};
     Bone* bone_{};
-};
-
-/// Output that aggregates all ModelAnimationStateTrack-s targeted at the same bone.
-struct ModelAnimationOutput : public NodeAnimationOutput
-{
-    // Unused by AnimationState, but it's just convinient to have here.
-    Matrix3x4 localToComponent_;
+    /// Value of the first keyframe, used for additive blending.
+    Transform baseValue_;
 };
 
 /// Custom attribute type, used to support sub-attribute animation in special cases.
@@ -209,7 +205,8 @@ public:
     float GetLength() const;
 
     /// Calculate animation for the model skeleton.
-    void CalculateModelTracks(ea::vector<ModelAnimationOutput>& output) const;
+    /// All tracks are sampled into temporary buffer first and then blended into the pose.
+    void CalculateModelTracks(AnimationPose& pose, AnimationPoseSamples& samples) const;
     /// Apply animation to a scene node hierarchy.
     void CalculateNodeTracks(ea::unordered_map<Node*, NodeAnimationOutput>& output) const;
     /// Apply animation to attributes.
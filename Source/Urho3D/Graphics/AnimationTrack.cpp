@@ -23,6 +23,7 @@
 #include "../Precompiled.h"
 
 #include "../Graphics/AnimationTrack.h"
+#include "../Graphics/AnimationCompression.h"
 #include "../IO/ArchiveSerialization.h"
 
 #include "../DebugNew.h"
@@ -32,6 +33,12 @@ namespace Urho3D
 
 void AnimationTrack::Sample(float time, float duration, bool isLooped, unsigned& frameIndex, Transform& value) const
 {
+    if (compressed_)
+    {
+        compressed_->Sample(time, duration, isLooped, frameIndex, channelMask_, value);
+        return;
+    }
+
     float blendFactor{};
     unsigned nextFrameIndex{};
     GetKeyFrames(time, duration, isLooped, frameIndex, nextFrameIndex, blendFactor);
@@ -61,11 +68,12 @@ void AnimationTrack::Sample(float time, float duration, bool isLooped, unsigned&
 
 bool AnimationTrack::IsLooped(float positionThreshold, float rotationThreshold, float scaleThreshold) const
 {
-    if (keyFrames_.empty())
+    const unsigned numKeyFrames = GetNumKeyFrames();
+    if (numKeyFrames == 0)
         return true;
 
-    const Transform& firstTransform = keyFrames_.front();
-    const Transform& lastTransform = keyFrames_.back();
+    const Transform firstTransform = GetKeyFrameValue(0);
+    const Transform lastTransform = GetKeyFrameValue(numKeyFrames - 1);
 
     if (channelMask_.Test(CHANNEL_POSITION) && !firstTransform.position_.Equals(lastTransform.position_, positionThreshold))
         return false;
@@ -77,6 +85,71 @@ bool AnimationTrack::IsLooped(float positionThreshold, float rotationThreshold,
     return true;
 }
 
+void AnimationTrack::Compress(const AnimationCompressionSettings& settings, AnimationCompressionReport* report)
+{
+    if (compressed_)
+        Decompress();
+
+    auto compressed = ea::make_shared<CompressedAnimationTrack>();
+    compressed->Compress(*this, settings, report);
+    compressed_ = compressed;
+    keyFrames_.clear();
+}
+
+void AnimationTrack::Decompress()
+{
+    if (!compressed_)
+        return;
+
+    compressed_->Decompress(keyFrames_);
+    compressed_ = nullptr;
+}
+
+void AnimationTrack::SortKeyFrames()
+{
+    Decompress();
+    KeyFrameSet::SortKeyFrames();
+}
+
+void AnimationTrack::AddKeyFrame(const AnimationKeyFrame& keyFrame)
+{
+    Decompress();
+    KeyFrameSet::AddKeyFrame(keyFrame);
+}
+
+void AnimationTrack::RemoveKeyFrame(unsigned index)
+{
+    Decompress();
+    KeyFrameSet::RemoveKeyFrame(index);
+}
+
+void AnimationTrack::RemoveAllKeyFrames()
+{
+    compressed_ = nullptr;
+    KeyFrameSet::RemoveAllKeyFrames();
+}
+
+AnimationKeyFrame* AnimationTrack::GetKeyFrame(unsigned index)
+{
+    Decompress();
+    return KeyFrameSet::GetKeyFrame(index);
+}
+
+unsigned AnimationTrack::GetNumKeyFrames() const
+{
+    return compressed_ ? compressed_->GetNumKeyFrames() : keyFrames_.size();
+}
+
+AnimationKeyFrame AnimationTrack::GetKeyFrameValue(unsigned index) const
+{
+    return compressed_ ? compressed_->GetKeyFrame(index) : keyFrames_[index];
+}
+
+bool AnimationTrack::GetKeyFrameIndex(float time, unsigned& index) const
+{
+    return compressed_ ? compressed_->GetKeyFrameIndex(time, index) : KeyFrameSet::GetKeyFrameIndex(time, index);
+}
+
 bool VariantAnimationTrack::IsLooped() const
 {
     if (keyFrames_.empty())
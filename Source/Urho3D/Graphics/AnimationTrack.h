@@ -30,9 +30,15 @@
 #include "../Graphics/Skeleton.h"
 #include "../Math/Transform.h"
 
+#include <EASTL/shared_ptr.h>
+
 namespace Urho3D
 {
 
+class CompressedAnimationTrack;
+struct AnimationCompressionReport;
+struct AnimationCompressionSettings;
+
 /// Skeletal animation keyframe.
 /// TODO: Replace inheritance with composition?
 struct AnimationKeyFrame : public Transform
@@ -50,9 +56,12 @@ struct AnimationKeyFrame : public Transform
 };
 
 /// Skeletal animation track, stores keyframes of a single bone.
+/// KeyFrameSet is a protected base so its methods cannot bypass compressed keyframes.
 /// @fakeref
-struct URHO3D_API AnimationTrack : public KeyFrameSet<AnimationKeyFrame>
+struct URHO3D_API AnimationTrack : protected KeyFrameSet<AnimationKeyFrame>
 {
+    using KeyFrame = AnimationKeyFrame;
+
     /// Bone or scene node name.
     ea::string name_;
     /// Name hash.
@@ -62,10 +71,40 @@ struct URHO3D_API AnimationTrack : public KeyFrameSet<AnimationKeyFrame>
     /// Weight of the track.
     float weight_{1.0f};
 
+    /// Uncompressed keyframes. Empty if the track is compressed, call Decompress before accessing them directly.
+    using KeyFrameSet<AnimationKeyFrame>::keyFrames_;
+    /// Compressed keyframes. If present, uncompressed keyframes are empty.
+    ea::shared_ptr<const CompressedAnimationTrack> compressed_;
+
+    /// Keyframe mutators. Compressed keyframes are decompressed first so the edits are not lost.
+    /// @{
+    void SortKeyFrames();
+    void AddKeyFrame(const AnimationKeyFrame& keyFrame);
+    void RemoveKeyFrame(unsigned index);
+    void RemoveAllKeyFrames();
+    AnimationKeyFrame* GetKeyFrame(unsigned index);
+    /// @}
+
     /// Sample value at given time.
     void Sample(float time, float duration, bool isLooped, unsigned& frameIndex, Transform& transform) const;
     /// Return whether the track is looped, i.e. the first and the last keyframes have the same value.
     bool IsLooped(float positionThreshold = 0.001f, float rotationThreshold = 0.001f, float scaleThreshold = 0.001f) const;
+
+    /// Compress keyframes. Uncompressed keyframes are removed.
+    void Compress(const AnimationCompressionSettings& settings, AnimationCompressionReport* report = nullptr);
+    /// Decompress keyframes so they can be edited.
+    void Decompress();
+    /// Return whether the keyframes are compressed.
+    bool IsCompressed() const { return compressed_ != nullptr; }
+
+    /// Return number of keyframes, compressed or not.
+    unsigned GetNumKeyFrames() const;
+    /// Return whether the track has no keyframes, compressed or not.
+    bool IsEmpty() const { return GetNumKeyFrames() == 0; }
+    /// Return keyframe at index, compressed or not.
+    AnimationKeyFrame GetKeyFrameValue(unsigned index) const;
+    /// Return keyframe index based on time and previous index as hint, compressed or not. Return false if track is empty.
+    bool GetKeyFrameIndex(float time, unsigned& index) const;
 };
 
 /// Generic variant animation keyframe.
@@ -173,7 +173,7 @@ struct URHO3D_API SourceBatch
     const Matrix3x4* worldTransform_{&Matrix3x4::IDENTITY};
     /// Number of world transforms.
     unsigned numWorldTransforms_{1};
-    /// Per-instance data. If not null, must contain enough data to fill instancing buffer.
+    /// Per-instance data. If not null, must point to Vector4 used as custom instancing data or Object_InstanceData uniform.
     void* instancingData_{};
     /// %Geometry type.
     GeometryType geometryType_{GEOM_STATIC};
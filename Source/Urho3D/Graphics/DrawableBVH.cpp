@@ -0,0 +1,463 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "../Precompiled.h"
+
+#include "../Graphics/DrawableBVH.h"
+
+#include "../Core/WorkQueue.h"
+#include "../Graphics/DebugRenderer.h"
+#include "../Graphics/Drawable.h"
+
+#include <EASTL/fixed_vector.h>
+#include <EASTL/sort.h>
+
+#include "../DebugNew.h"
+
+namespace Urho3D
+{
+
+namespace
+{
+
+static const unsigned PendingLocationFlag = 0x80000000u;
+static const unsigned InvalidLocation = M_MAX_UNSIGNED;
+
+/// Spread lower 10 bits of value so that there are two zero bits between each bit.
+unsigned ExpandBits(unsigned value)
+{
+    value = (value * 0x00010001u) & 0xff0000ffu;
+    value = (value * 0x00000101u) & 0x0f00f00fu;
+    value = (value * 0x00000011u) & 0xc30c30c3u;
+    value = (value * 0x00000005u) & 0x49249249u;
+    return value;
+}
+
+/// Return 30-bit Morton code for point normalized to [0, 1] range.
+unsigned CalculateMortonCode(const Vector3& position)
+{
+    const unsigned x = static_cast<unsigned>(Clamp(position.x_ * 1024.0f, 0.0f, 1023.0f));
+    const unsigned y = static_cast<unsigned>(Clamp(position.y_ * 1024.0f, 0.0f, 1023.0f));
+    const unsigned z = static_cast<unsigned>(Clamp(position.z_ * 1024.0f, 0.0f, 1023.0f));
+    return (ExpandBits(x) << 2u) | (ExpandBits(y) << 1u) | ExpandBits(z);
+}
+
+float GetSurfaceArea(const BoundingBox& box)
+{
+    if (!box.Defined())
+        return 0.0f;
+    const Vector3 size = box.Size();
+    return 2.0f * (size.x_ * size.y_ + size.y_ * size.z_ + size.z_ * size.x_);
+}
+
+}
+
+void DrawableBVH::AddDrawable(Drawable* drawable)
+{
+    pendingDrawables_.push_back(drawable);
+    SetLocation(drawable, PendingLocationFlag | (pendingDrawables_.size() - 1));
+}
+
+void DrawableBVH::RemoveDrawable(Drawable* drawable)
+{
+    const unsigned location = GetLocation(drawable);
+    if (location == InvalidLocation)
+        return;
+
+    SetLocation(drawable, InvalidLocation);
+
+    if (location & PendingLocationFlag)
+    {
+        const unsigned pendingIndex = location & ~PendingLocationFlag;
+        Drawable* replacement = pendingDrawables_.back();
+        pendingDrawables_[pendingIndex] = replacement;
+        pendingDrawables_.pop_back();
+        if (replacement != drawable)
+            SetLocation(replacement, location);
+        return;
+    }
+
+    // Move the last drawable of the leaf into the freed slot
+    const unsigned leafIndex = slotLeaves_[location];
+    Node& leaf = nodes_[leafIndex];
+    const unsigned lastSlot = leaf.first_ + leaf.count_ - 1;
+    if (location != lastSlot)
+    {
+        Drawable* replacement = drawables_[lastSlot];
+        drawables_[location] = replacement;
+        SetLocation(replacement, location);
+    }
+    drawables_[lastSlot] = nullptr;
+    --leaf.count_;
+    --numDrawables_;
+    ++numRemovedDrawables_;
+
+    if (!isLeafDirty_[leafIndex])
+    {
+        isLeafDirty_[leafIndex] = true;
+        dirtyLeaves_.push_back(leafIndex);
+    }
+}
+
+void DrawableBVH::OnDrawableIndexChanged(unsigned oldIndex, unsigned newIndex)
+{
+    if (oldIndex >= locations_.size())
+        return;
+
+    if (newIndex >= locations_.size())
+        locations_.resize(newIndex + 1, InvalidLocation);
+    locations_[newIndex] = locations_[oldIndex];
+    locations_[oldIndex] = InvalidLocation;
+}
+
+void DrawableBVH::MarkDrawableDirty(Drawable* drawable)
+{
+    const unsigned location = GetLocation(drawable);
+    if (location == InvalidLocation || (location & PendingLocationFlag))
+        return;
+
+    const unsigned leafIndex = slotLeaves_[location];
+    if (!isLeafDirty_[leafIndex])
+    {
+        isLeafDirty_[leafIndex] = true;
+        dirtyLeaves_.push_back(leafIndex);
+    }
+}
+
+void DrawableBVH::Clear()
+{
+    nodes_.clear();
+    drawables_.clear();
+    slotLeaves_.clear();
+    locations_.clear();
+    pendingDrawables_.clear();
+    dirtyLeaves_.clear();
+    isLeafDirty_.clear();
+    numDrawables_ = 0;
+    numRemovedDrawables_ = 0;
+    initialCost_ = 0.0f;
+    currentCost_ = 0.0f;
+}
+
+void DrawableBVH::Update(WorkQueue* workQueue)
+{
+    if (IsRebuildNeeded())
+    {
+        Rebuild(workQueue);
+        return;
+    }
+
+    if (dirtyLeaves_.empty())
+        return;
+
+    ForEachParallel(workQueue, 32u, dirtyLeaves_, [this](unsigned, unsigned leafIndex) { RefitLeaf(leafIndex); });
+    for (unsigned leafIndex : dirtyLeaves_)
+        isLeafDirty_[leafIndex] = false;
+    dirtyLeaves_.clear();
+
+    currentCost_ = RefitInternalNodes();
+    if (IsRebuildNeeded())
+        Rebuild(workQueue);
+}
+
+void DrawableBVH::Rebuild(WorkQueue* workQueue)
+{
+    // Collect all drawables
+    sortBuffer_.clear();
+    sortBuffer_.reserve(numDrawables_ + pendingDrawables_.size());
+    for (const Node& node : nodes_)
+    {
+        if (!node.isLeaf_)
+            continue;
+        for (unsigned i = node.first_; i < node.first_ + node.count_; ++i)
+            sortBuffer_.push_back({0u, drawables_[i]});
+    }
+    for (Drawable* drawable : pendingDrawables_)
+        sortBuffer_.push_back({0u, drawable});
+
+    pendingDrawables_.clear();
+    dirtyLeaves_.clear();
+    numRemovedDrawables_ = 0;
+    numDrawables_ = sortBuffer_.size();
+
+    nodes_.clear();
+    drawables_.resize(numDrawables_);
+    slotLeaves_.resize(numDrawables_);
+    if (numDrawables_ == 0)
+    {
+        isLeafDirty_.clear();
+        initialCost_ = currentCost_ = 0.0f;
+        return;
+    }
+
+    // Calculate Morton codes of drawable centers
+    BoundingBox centerBounds;
+    for (const SortedDrawable& item : sortBuffer_)
+        centerBounds.Merge(item.drawable_->GetWorldBoundingBox().Center());
+
+    const Vector3 centerOffset = centerBounds.min_;
+    const Vector3 centerScale = VectorMax(centerBounds.Size(), Vector3::ONE * M_EPSILON);
+    ForEachParallel(workQueue, 256u, sortBuffer_, [&](unsigned, SortedDrawable& item)
+    {
+        const Vector3 center = item.drawable_->GetWorldBoundingBox().Center();
+        item.code_ = CalculateMortonCode((center - centerOffset) / centerScale);
+    });
+
+    ea::sort(sortBuffer_.begin(), sortBuffer_.end());
+
+    for (unsigned i = 0; i < numDrawables_; ++i)
+    {
+        drawables_[i] = sortBuffer_[i].drawable_;
+        SetLocation(drawables_[i], i);
+    }
+
+    // Build hierarchy
+    nodes_.reserve(2 * (numDrawables_ / MaxLeafSize + 1));
+    BuildNode(0, numDrawables_ - 1);
+    isLeafDirty_.clear();
+    isLeafDirty_.resize(nodes_.size(), false);
+
+    // Refit all leaves
+    ForEachParallel(workQueue, 256u, static_cast<unsigned>(nodes_.size()), [this](unsigned beginIndex, unsigned endIndex)
+    {
+        for (unsigned nodeIndex = beginIndex; nodeIndex < endIndex; ++nodeIndex)
+        {
+            if (nodes_[nodeIndex].isLeaf_)
+                RefitLeaf(nodeIndex);
+        }
+    });
+
+    initialCost_ = currentCost_ = RefitInternalNodes();
+}
+
+void DrawableBVH::GetDrawables(OctreeQuery& query) const
+{
+    ea::fixed_vector<ea::pair<unsigned, bool>, 64> stack;
+    if (!nodes_.empty())
+        stack.emplace_back(0u, false);
+
+    while (!stack.empty())
+    {
+        auto [nodeIndex, inside] = stack.back();
+        stack.pop_back();
+
+        const Node& node = nodes_[nodeIndex];
+        if (!node.box_.Defined())
+            continue;
+
+        const Intersection res = query.TestOctant(node.box_, inside);
+        if (res == OUTSIDE)
+            continue;
+        if (res == INSIDE)
+            inside = true;
+
+        if (node.isLeaf_)
+        {
+            auto** start = const_cast<Drawable**>(&drawables_[node.first_]);
+            query.TestDrawables(start, start + node.count_, inside);
+        }
+        else
+        {
+            stack.emplace_back(node.first_, inside);
+            stack.emplace_back(nodeIndex + 1, inside);
+        }
+    }
+
+    if (!pendingDrawables_.empty())
+    {
+        auto** start = const_cast<Drawable**>(pendingDrawables_.data());
+        query.TestDrawables(start, start + pendingDrawables_.size(), false);
+    }
+}
+
+void DrawableBVH::GetDrawables(RayOctreeQuery& query) const
+{
+    const auto processDrawable = [&query](Drawable* drawable)
+    {
+        if ((drawable->GetDrawableFlags() & query.drawableFlags_) && (drawable->GetViewMask() & query.viewMask_))
+            drawable->ProcessRayQuery(query, query.result_);
+    };
+
+    ea::fixed_vector<unsigned, 64> stack;
+    if (!nodes_.empty())
+        stack.push_back(0u);
+
+    while (!stack.empty())
+    {
+        const unsigned nodeIndex = stack.back();
+        stack.pop_back();
+
+        const Node& node = nodes_[nodeIndex];
+        if (!node.box_.Defined() || query.ray_.HitDistance(node.box_) >= query.maxDistance_)
+            continue;
+
+        if (node.isLeaf_)
+        {
+            for (unsigned i = node.first_; i < node.first_ + node.count_; ++i)
+                processDrawable(drawables_[i]);
+        }
+        else
+        {
+            stack.push_back(node.first_);
+            stack.push_back(nodeIndex + 1);
+        }
+    }
+
+    for (Drawable* drawable : pendingDrawables_)
+        processDrawable(drawable);
+}
+
+void DrawableBVH::GetDrawablesOnly(RayOctreeQuery& query, ea::vector<Drawable*>& drawables) const
+{
+    const auto addDrawable = [&query, &drawables](Drawable* drawable)
+    {
+        if ((drawable->GetDrawableFlags() & query.drawableFlags_) && (drawable->GetViewMask() & query.viewMask_))
+            drawables.push_back(drawable);
+    };
+
+    ea::fixed_vector<unsigned, 64> stack;
+    if (!nodes_.empty())
+        stack.push_back(0u);
+
+    while (!stack.empty())
+    {
+        const unsigned nodeIndex = stack.back();
+        stack.pop_back();
+
+        const Node& node = nodes_[nodeIndex];
+        if (!node.box_.Defined() || query.ray_.HitDistance(node.box_) >= query.maxDistance_)
+            continue;
+
+        if (node.isLeaf_)
+        {
+            for (unsigned i = node.first_; i < node.first_ + node.count_; ++i)
+                addDrawable(drawables_[i]);
+        }
+        else
+        {
+            stack.push_back(node.first_);
+            stack.push_back(nodeIndex + 1);
+        }
+    }
+
+    for (Drawable* drawable : pendingDrawables_)
+        addDrawable(drawable);
+}
+
+void DrawableBVH::DrawDebugGeometry(DebugRenderer* debug, bool depthTest) const
+{
+    if (!debug)
+        return;
+
+    for (const Node& node : nodes_)
+    {
+        if (node.isLeaf_ && node.box_.Defined() && debug->IsInside(node.box_))
+            debug->AddBoundingBox(node.box_, Color(0.25f, 0.25f, 0.25f), depthTest);
+    }
+}
+
+unsigned DrawableBVH::BuildNode(unsigned first, unsigned last)
+{
+    const unsigned nodeIndex = nodes_.size();
+    nodes_.emplace_back();
+
+    const unsigned count = last - first + 1;
+    if (count <= MaxLeafSize)
+    {
+        Node& node = nodes_[nodeIndex];
+        node.first_ = first;
+        node.count_ = count;
+        node.isLeaf_ = true;
+        for (unsigned i = first; i <= last; ++i)
+            slotLeaves_[i] = nodeIndex;
+        return nodeIndex;
+    }
+
+    // Split at the highest bit that differs within the range, or in the middle if all codes are equal
+    const unsigned firstCode = sortBuffer_[first].code_;
+    const unsigned lastCode = sortBuffer_[last].code_;
+    unsigned split = first + count / 2;
+    if (firstCode != lastCode)
+    {
+        const unsigned highestBit = LogBaseTwo(firstCode ^ lastCode);
+        const SortedDrawable splitValue{(lastCode >> highestBit) << highestBit, nullptr};
+        const auto iter = ea::lower_bound(sortBuffer_.begin() + first, sortBuffer_.begin() + last + 1, splitValue);
+        split = static_cast<unsigned>(iter - sortBuffer_.begin());
+    }
+
+    BuildNode(first, split - 1);
+    const unsigned rightIndex = BuildNode(split, last);
+    nodes_[nodeIndex].first_ = rightIndex;
+    return nodeIndex;
+}
+
+float DrawableBVH::RefitInternalNodes()
+{
+    // Children always follow parents, so iterate backwards
+    float cost = 0.0f;
+    for (unsigned nodeIndex = nodes_.size(); nodeIndex-- > 0;)
+    {
+        Node& node = nodes_[nodeIndex];
+        if (!node.isLeaf_)
+        {
+            node.box_ = nodes_[nodeIndex + 1].box_;
+            node.box_.Merge(nodes_[node.first_].box_);
+        }
+        cost += GetSurfaceArea(node.box_);
+    }
+    return cost;
+}
+
+void DrawableBVH::RefitLeaf(unsigned nodeIndex)
+{
+    Node& node = nodes_[nodeIndex];
+    node.box_ = BoundingBox{};
+    for (unsigned i = node.first_; i < node.first_ + node.count_; ++i)
+        node.box_.Merge(drawables_[i]->GetWorldBoundingBox());
+}
+
+void DrawableBVH::SetLocation(Drawable* drawable, unsigned location)
+{
+    const unsigned index = drawable->GetDrawableIndex();
+    assert(index != M_MAX_UNSIGNED);
+    if (index >= locations_.size())
+        locations_.resize(index + 1, InvalidLocation);
+    locations_[index] = location;
+}
+
+unsigned DrawableBVH::GetLocation(Drawable* drawable) const
+{
+    const unsigned index = drawable->GetDrawableIndex();
+    return index < locations_.size() ? locations_[index] : InvalidLocation;
+}
+
+bool DrawableBVH::IsRebuildNeeded() const
+{
+    const unsigned numChanges = pendingDrawables_.size() + numRemovedDrawables_;
+    if (numChanges > 0 && numChanges >= ea::max(MinChangesForRebuild, numDrawables_ / 8))
+        return true;
+    if (nodes_.empty() && !pendingDrawables_.empty())
+        return true;
+    return currentCost_ > initialCost_ * MaxCostRatio;
+}
+
+}
@@ -0,0 +1,151 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#pragma once
+
+#include "../Graphics/OctreeQuery.h"
+#include "../Math/BoundingBox.h"
+
+#include <EASTL/vector.h>
+
+namespace Urho3D
+{
+
+class DebugRenderer;
+class Drawable;
+class WorkQueue;
+
+/// Linear bounding volume hierarchy of drawables stored in flat arrays.
+/// Drawables are sorted by Morton code of their centers and grouped into small leaves.
+/// Moving drawables only refit the leaves they belong to, the hierarchy is rebuilt when it degrades
+/// or when too many drawables were added or removed since the last build.
+/// Drawables are identified by Drawable::GetDrawableIndex(), owner is responsible for keeping it stable.
+/// @nobind
+class URHO3D_API DrawableBVH
+{
+public:
+    /// Max number of drawables in leaf node.
+    static constexpr unsigned MaxLeafSize = 8;
+    /// Min number of added or removed drawables that triggers rebuild.
+    static constexpr unsigned MinChangesForRebuild = 64;
+    /// Ratio of current to initial hierarchy cost that triggers rebuild.
+    static constexpr float MaxCostRatio = 2.0f;
+
+    /// Add drawable. It is tested linearly until the next rebuild.
+    void AddDrawable(Drawable* drawable);
+    /// Remove drawable.
+    void RemoveDrawable(Drawable* drawable);
+    /// Notify that drawable index has changed.
+    void OnDrawableIndexChanged(unsigned oldIndex, unsigned newIndex);
+    /// Mark drawable as moved or resized.
+    void MarkDrawableDirty(Drawable* drawable);
+    /// Remove all drawables.
+    void Clear();
+
+    /// Refit dirty leaves or rebuild the hierarchy if needed. Drawable bounding boxes should be up to date.
+    void Update(WorkQueue* workQueue);
+    /// Rebuild the hierarchy from scratch.
+    void Rebuild(WorkQueue* workQueue);
+
+    /// Return drawables by a query.
+    void GetDrawables(OctreeQuery& query) const;
+    /// Process ray query for all drawables intersecting the ray.
+    void GetDrawables(RayOctreeQuery& query) const;
+    /// Return drawables whose nodes intersect the ray, without processing them.
+    void GetDrawablesOnly(RayOctreeQuery& query, ea::vector<Drawable*>& drawables) const;
+    /// Draw leaf bounds to the debug graphics.
+    void DrawDebugGeometry(DebugRenderer* debug, bool depthTest) const;
+
+    /// Return number of drawables, including pending ones.
+    unsigned GetNumDrawables() const { return numDrawables_ + pendingDrawables_.size(); }
+    /// Return number of drawables that are not in the hierarchy yet.
+    unsigned GetNumPendingDrawables() const { return pendingDrawables_.size(); }
+    /// Return number of nodes.
+    unsigned GetNumNodes() const { return nodes_.size(); }
+    /// Return bounding box of all drawables in the hierarchy.
+    BoundingBox GetBoundingBox() const { return nodes_.empty() ? BoundingBox{} : nodes_[0].box_; }
+
+private:
+    /// Hierarchy node. Left child of internal node immediately follows the parent.
+    struct Node
+    {
+        /// Bounding box of all drawables in the node.
+        BoundingBox box_;
+        /// Index of first drawable for leaf node, index of right child for internal node.
+        unsigned first_{};
+        /// Number of drawables in leaf node. Always zero for internal nodes.
+        unsigned count_{};
+        /// Whether the node is leaf.
+        bool isLeaf_{};
+    };
+
+    /// Drawable and its Morton code.
+    struct SortedDrawable
+    {
+        unsigned code_{};
+        Drawable* drawable_{};
+
+        bool operator<(const SortedDrawable& rhs) const { return code_ < rhs.code_; }
+    };
+
+    /// Build nodes for range of sorted drawables recursively.
+    unsigned BuildNode(unsigned first, unsigned last);
+    /// Refit all internal nodes and return hierarchy cost.
+    float RefitInternalNodes();
+    /// Refit single leaf.
+    void RefitLeaf(unsigned nodeIndex);
+    /// Set location of drawable.
+    void SetLocation(Drawable* drawable, unsigned location);
+    /// Return location of drawable.
+    unsigned GetLocation(Drawable* drawable) const;
+    /// Return whether the hierarchy should be rebuilt.
+    bool IsRebuildNeeded() const;
+
+    /// Nodes in depth-first order.
+    ea::vector<Node> nodes_;
+    /// Drawables sorted by leaves. Leaves may have unused slots after removals.
+    ea::vector<Drawable*> drawables_;
+    /// Leaf node index for each drawable slot.
+    ea::vector<unsigned> slotLeaves_;
+    /// Drawable slot or pending index for each drawable index.
+    ea::vector<unsigned> locations_;
+    /// Drawables added after the last rebuild.
+    ea::vector<Drawable*> pendingDrawables_;
+    /// Leaves that should be refit.
+    ea::vector<unsigned> dirtyLeaves_;
+    /// Whether the leaf is dirty, per node.
+    ea::vector<bool> isLeafDirty_;
+    /// Temporary buffer for rebuild.
+    ea::vector<SortedDrawable> sortBuffer_;
+
+    /// Number of drawables in the hierarchy.
+    unsigned numDrawables_{};
+    /// Number of drawables removed since the last rebuild.
+    unsigned numRemovedDrawables_{};
+    /// Hierarchy cost after the last rebuild.
+    float initialCost_{};
+    /// Current hierarchy cost.
+    float currentCost_{};
+};
+
+}
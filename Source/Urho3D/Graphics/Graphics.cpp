@@ -27,6 +27,7 @@
 #include "../Graphics/AnimatedModel.h"
 #include "../Graphics/Animation.h"
 #include "../Graphics/AnimationController.h"
+#include "../Graphics/AnimationPalette.h"
 #include "../Graphics/Camera.h"
 #include "../Graphics/Geometry.h"
 #include "../Graphics/CustomGeometry.h"
@@ -42,11 +43,13 @@
 #include "../Graphics/OcclusionBuffer.h"
 #include "../Graphics/Octree.h"
 #include "../Graphics/OutlineGroup.h"
+#include "../Graphics/PaletteAnimatedModel.h"
 #include "../Graphics/ParticleEffect.h"
 #include "../Graphics/ParticleEmitter.h"
 #include "../Graphics/ReflectionProbe.h"
 #include "../Graphics/RibbonTrail.h"
 #include "../Graphics/Shader.h"
+#include "../Graphics/ShaderCacheManifest.h"
 #include "../Graphics/Skybox.h"
 #include "../Graphics/StaticModelGroup.h"
 #include "../Graphics/Technique.h"
@@ -113,6 +116,7 @@ Graphics::Graphics(Context* context)
     , shaderPath_("Shaders/HLSL/")
     , shaderExtension_(".hlsl")
     , apiName_("Diligent")
+    , shaderCacheManifest_(MakeShared<ShaderCacheManifest>(context))
 {
     // TODO: This can be used to have DPI scaling work on Windows, but it leads to blurry fonts
     // SDL_SetHint(SDL_HINT_WINDOWS_DPI_SCALING, "1");
@@ -358,6 +362,25 @@ void Graphics::SavePipelineStateCache(const FileIdentifier& fileName)
         file->Write(cachedData.data(), cachedData.size());
 }
 
+void Graphics::PrewarmShaderCache()
+{
+    if (!renderDevice_ || !settings_.shaderCacheDir_)
+        return;
+
+    const RenderBackend renderBackend = GetRenderBackend();
+    if (shaderCacheManifest_->Load(settings_.shaderCacheDir_, renderBackend))
+        shaderCacheManifest_->Prewarm(settings_.shaderCacheDir_, renderBackend, settings_.shaderTranslationPolicy_);
+}
+
+void Graphics::SaveShaderCacheManifest()
+{
+    if (!renderDevice_ || !settings_.shaderCacheDir_ || !settings_.cacheShaders_)
+        return;
+
+    shaderCacheManifest_->SavePrewarmedBytecode(settings_.shaderCacheDir_);
+    shaderCacheManifest_->Save(settings_.shaderCacheDir_, GetRenderBackend());
+}
+
 bool Graphics::ToggleFullscreen()
 {
     ea::swap(primaryWindowSettings_, secondaryWindowSettings_);
@@ -714,6 +737,8 @@ void RegisterGraphicsLibrary(Context* context)
     Skybox::RegisterObject(context);
     AnimatedModel::RegisterObject(context);
     AnimationController::RegisterObject(context);
+    AnimationPalette::RegisterObject(context);
+    PaletteAnimatedModel::RegisterObject(context);
     BillboardSet::RegisterObject(context);
     ParticleEffect::RegisterObject(context);
     ParticleEmitter::RegisterObject(context);
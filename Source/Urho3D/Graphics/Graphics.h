@@ -47,6 +47,7 @@ class Image;
 class IndexBuffer;
 class RenderSurface;
 class Shader;
+class ShaderCacheManifest;
 class ShaderVariation;
 class Texture;
 class Texture2D;
@@ -122,6 +123,13 @@ public:
     void InitializePipelineStateCache(const FileIdentifier& fileName);
     /// Save pipeline state cache.
     void SavePipelineStateCache(const FileIdentifier& fileName);
+    /// Load manifest of shader variations used in previous runs and compile missing ones on worker threads.
+    /// Should be called after GPU is initialized.
+    void PrewarmShaderCache();
+    /// Save manifest of used shader variations and prewarmed shaders into shader cache directory.
+    void SaveShaderCacheManifest();
+    /// Return manifest of used shader variations.
+    ShaderCacheManifest* GetShaderCacheManifest() const { return shaderCacheManifest_; }
 
     /// Toggle between full screen and windowed mode. Return true if successful.
     bool ToggleFullscreen();
@@ -330,6 +338,7 @@ private:
     GraphicsSettings settings_;
 
     SharedPtr<RenderDevice> renderDevice_;
+    SharedPtr<ShaderCacheManifest> shaderCacheManifest_;
 
     /// Max number of bones which can be skinned on GPU. Zero means default value.
     static unsigned maxBonesHWSkinned;
@@ -63,6 +63,11 @@ bool OcclusionBuffer::SetSize(int width, int height, bool threaded)
     if (height & 1u)
         ++height;
 
+    // Triangles are prepared in worker threads, tiles are rasterized in parallel
+    threaded_ = threaded;
+    const unsigned numThreads = threaded ? GetSubsystem<WorkQueue>()->GetNumProcessingThreads() : 1;
+    threadTriangles_.resize(numThreads);
+
     if (width == width_ && height == height_)
         return true;
 
@@ -78,17 +83,13 @@ bool OcclusionBuffer::SetSize(int width, int height, bool threaded)
     width_ = width;
     height_ = height;
 
-    // Build work buffers for threading
-    unsigned numThreadBuffers = threaded ? GetSubsystem<WorkQueue>()->GetNumProcessingThreads() : 1;
-    buffers_.resize(numThreadBuffers);
-    for (unsigned i = 0; i < numThreadBuffers; ++i)
-    {
-        // Reserve extra memory in case 3D clipping is not exact
-        OcclusionBufferData& buffer = buffers_[i];
-        buffer.dataWithSafety_ = new int[width * (height + 2) + 2];
-        buffer.data_ = buffer.dataWithSafety_.get() + width + 1;
-        buffer.used_ = false;
-    }
+    // Reserve extra memory in case 3D clipping is not exact
+    buffer_.dataWithSafety_ = new int[width * (height + 2) + 2];
+    buffer_.data_ = buffer_.dataWithSafety_.get() + width + 1;
+
+    numTilesX_ = (width + OCCLUSION_TILE_SIZE - 1) / OCCLUSION_TILE_SIZE;
+    numTilesY_ = (height + OCCLUSION_TILE_SIZE - 1) / OCCLUSION_TILE_SIZE;
+    tiles_.resize(numTilesX_ * numTilesY_);
 
     mipBuffers_.clear();
 
@@ -105,7 +106,7 @@ bool OcclusionBuffer::SetSize(int width, int height, bool threaded)
     }
 
     URHO3D_LOGDEBUG("Set occlusion buffer size " + ea::to_string(width_) + "x" + ea::to_string(height_) + " with " +
-             ea::to_string(mipBuffers_.size()) + " mip levels and " + ea::to_string(numThreadBuffers) + " thread buffers");
+             ea::to_string(mipBuffers_.size()) + " mip levels and " + ea::to_string(numTilesX_ * numTilesY_) + " tiles");
 
     CalculateViewport();
     return true;
@@ -146,16 +147,14 @@ void OcclusionBuffer::Reset()
 {
     numTriangles_ = 0;
     batches_.clear();
+    for (auto& triangles : threadTriangles_)
+        triangles.clear();
 }
 
 void OcclusionBuffer::Clear()
 {
     Reset();
-
-    // Only clear the main thread buffer. Rest are cleared on-demand when drawing the first batch
-    ClearBuffer(0);
-    for (unsigned i = 1; i < buffers_.size(); ++i)
-        buffers_[i].used_ = false;
+    ClearBuffer();
 
     depthHierarchyDirty_ = true;
 }
@@ -200,33 +199,47 @@ void OcclusionBuffer::DrawTriangles()
 {
     URHO3D_PROFILE("DrawOcclusionBatchWork");
 
-    if (buffers_.size() == 1)
+    if (!buffer_.data_)
     {
-        // Not threaded
-        for (auto i = batches_.begin(); i != batches_.end(); ++i)
-            DrawBatch(*i, 0);
+        batches_.clear();
+        return;
+    }
 
-        depthHierarchyDirty_ = true;
+    // Transform, clip and set up triangles
+    auto* queue = GetSubsystem<WorkQueue>();
+    if (!threaded_)
+    {
+        for (const OcclusionBatch& batch : batches_)
+            DrawBatch(batch, 0);
     }
-    else if (buffers_.size() > 1)
+    else
     {
-        // Threaded
-        auto* queue = GetSubsystem<WorkQueue>();
         ForEachParallel(queue, batches_, [this](unsigned, const OcclusionBatch& batch)
         {
             DrawBatch(batch, WorkQueue::GetThreadIndex());
         });
+    }
+    batches_.clear();
 
-        MergeBuffers();
-        depthHierarchyDirty_ = true;
+    // Sort triangles into tiles and rasterize each tile independently
+    BinTriangles();
+    if (!triangles_.empty())
+    {
+        if (!threaded_)
+            RasterizeTileRows(0, numTilesY_);
+        else
+        {
+            ForEachParallel(queue, 1u, static_cast<unsigned>(numTilesY_),
+                [this](unsigned beginIndex, unsigned endIndex) { RasterizeTileRows(beginIndex, endIndex); });
+        }
     }
 
-    batches_.clear();
+    depthHierarchyDirty_ = true;
 }
 
 void OcclusionBuffer::BuildDepthHierarchy()
 {
-    if (buffers_.empty() || !depthHierarchyDirty_)
+    if (!buffer_.data_ || !depthHierarchyDirty_)
         return;
 
     URHO3D_PROFILE("BuildDepthHierarchy");
@@ -238,7 +251,7 @@ void OcclusionBuffer::BuildDepthHierarchy()
     {
         for (int y = 0; y < height; ++y)
         {
-            int* src = buffers_[0].data_ + (y * 2) * width_;
+            int* src = buffer_.data_ + (y * 2) * width_;
             DepthValue* dest = mipBuffers_[0].get() + y * width;
             DepthValue* end = dest + width;
 
@@ -328,10 +341,68 @@ void OcclusionBuffer::ResetUseTimer()
 
 bool OcclusionBuffer::IsVisible(const BoundingBox& worldSpaceBox) const
 {
-    if (buffers_.empty())
+    if (!buffer_.data_)
         return true;
 
-    // Transform corners to projection space
+    // Transform corners to screen space. If any of the corners cross the near plane, assume visible
+    float minX, maxX, minY, maxY, minZ;
+
+#ifdef URHO3D_SSE
+    {
+        const Matrix4& m = viewProj_;
+        const __m128 cornersX = _mm_setr_ps(worldSpaceBox.min_.x_, worldSpaceBox.max_.x_, worldSpaceBox.min_.x_, worldSpaceBox.max_.x_);
+        const __m128 cornersY = _mm_setr_ps(worldSpaceBox.min_.y_, worldSpaceBox.min_.y_, worldSpaceBox.max_.y_, worldSpaceBox.max_.y_);
+        const float cornersZ[2] = {worldSpaceBox.min_.z_, worldSpaceBox.max_.z_};
+
+        const auto transformRow = [&](float m0, float m1, float m2, float m3, __m128 z)
+        {
+            const __m128 xy = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(m0), cornersX), _mm_mul_ps(_mm_set1_ps(m1), cornersY));
+            return _mm_add_ps(xy, _mm_add_ps(_mm_mul_ps(_mm_set1_ps(m2), z), _mm_set1_ps(m3)));
+        };
+
+        __m128 minXv = _mm_set1_ps(M_INFINITY);
+        __m128 maxXv = _mm_set1_ps(-M_INFINITY);
+        __m128 minYv = _mm_set1_ps(M_INFINITY);
+        __m128 maxYv = _mm_set1_ps(-M_INFINITY);
+        __m128 minZv = _mm_set1_ps(M_INFINITY);
+        for (float cornerZ : cornersZ)
+        {
+            const __m128 z = _mm_set1_ps(cornerZ);
+            const __m128 clipX = transformRow(m.m00_, m.m01_, m.m02_, m.m03_, z);
+            const __m128 clipY = transformRow(m.m10_, m.m11_, m.m12_, m.m13_, z);
+            // Apply a far clip relative bias
+            const __m128 clipZ = _mm_sub_ps(transformRow(m.m20_, m.m21_, m.m22_, m.m23_, z), _mm_set1_ps(OCCLUSION_RELATIVE_BIAS));
+            const __m128 clipW = transformRow(m.m30_, m.m31_, m.m32_, m.m33_, z);
+
+            if (_mm_movemask_ps(_mm_cmple_ps(clipZ, _mm_setzero_ps())))
+                return true;
+
+            const __m128 invW = _mm_div_ps(_mm_set1_ps(1.0f), clipW);
+            const __m128 screenX = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(clipX, invW), _mm_set1_ps(scaleX_)), _mm_set1_ps(offsetX_));
+            const __m128 screenY = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(clipY, invW), _mm_set1_ps(scaleY_)), _mm_set1_ps(offsetY_));
+            const __m128 screenZ = _mm_mul_ps(_mm_mul_ps(clipZ, invW), _mm_set1_ps(OCCLUSION_Z_SCALE));
+
+            minXv = _mm_min_ps(minXv, screenX);
+            maxXv = _mm_max_ps(maxXv, screenX);
+            minYv = _mm_min_ps(minYv, screenY);
+            maxYv = _mm_max_ps(maxYv, screenY);
+            minZv = _mm_min_ps(minZv, screenZ);
+        }
+
+        alignas(16) float values[4];
+        const auto reduce = [&](__m128 v, bool isMax)
+        {
+            _mm_store_ps(values, v);
+            return isMax ? Max(Max(values[0], values[1]), Max(values[2], values[3]))
+                         : Min(Min(values[0], values[1]), Min(values[2], values[3]));
+        };
+        minX = reduce(minXv, false);
+        maxX = reduce(maxXv, true);
+        minY = reduce(minYv, false);
+        maxY = reduce(maxYv, true);
+        minZ = reduce(minZv, false);
+    }
+#else
     Vector4 vertices[8];
     vertices[0] = ModelTransform(viewProj_, worldSpaceBox.min_);
     vertices[1] = ModelTransform(viewProj_, Vector3(worldSpaceBox.max_.x_, worldSpaceBox.min_.y_, worldSpaceBox.min_.z_));
@@ -346,9 +417,6 @@ bool OcclusionBuffer::IsVisible(const BoundingBox& worldSpaceBox) const
     for (auto& vertice : vertices)
         vertice.z_ -= OCCLUSION_RELATIVE_BIAS;
 
-    // Transform to screen space. If any of the corners cross the near plane, assume visible
-    float minX, maxX, minY, maxY, minZ;
-
     if (vertices[0].z_ <= 0.0f)
         return true;
 
@@ -371,6 +439,7 @@ bool OcclusionBuffer::IsVisible(const BoundingBox& worldSpaceBox) const
         if (projected.y_ > maxY) maxY = projected.y_;
         if (projected.z_ < minZ) minZ = projected.z_;
     }
+#endif
 
     // Expand the bounding box 1 pixel in each direction to be conservative and correct rasterization offset
     IntRect rect((int)(minX - 1.5f), (int)(minY - 1.5f), RoundToInt(maxX), RoundToInt(maxY));
@@ -430,8 +499,32 @@ bool OcclusionBuffer::IsVisible(const BoundingBox& worldSpaceBox) const
     }
 
     // If no conclusive result, finally check the pixel-level data
-    int* row = buffers_[0].data_ + rect.top_ * width_;
-    int* endRow = buffers_[0].data_ + rect.bottom_ * width_;
+    int* row = buffer_.data_ + rect.top_ * width_;
+    int* endRow = buffer_.data_ + rect.bottom_ * width_;
+#ifdef URHO3D_SSE
+    // Compare four pixels at once, last pixels of the row are masked out
+    const int rectWidth = rect.right_ - rect.left_ + 1;
+    const __m128i zMinusOne = _mm_set1_epi32(z - 1);
+    const __m128i lastMask = _mm_cmplt_epi32(_mm_setr_epi32(0, 1, 2, 3), _mm_set1_epi32(((rectWidth - 1) & 3) + 1));
+    while (row <= endRow)
+    {
+        const int* src = row + rect.left_;
+        int remaining = rectWidth;
+        while (remaining > 4)
+        {
+            const __m128i depth = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+            if (_mm_movemask_epi8(_mm_cmpgt_epi32(depth, zMinusOne)))
+                return true;
+            src += 4;
+            remaining -= 4;
+        }
+
+        const __m128i depth = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+        if (_mm_movemask_epi8(_mm_and_si128(_mm_cmpgt_epi32(depth, zMinusOne), lastMask)))
+            return true;
+        row += width_;
+    }
+#else
     while (row <= endRow)
     {
         int* src = row + rect.left_;
@@ -444,10 +537,71 @@ bool OcclusionBuffer::IsVisible(const BoundingBox& worldSpaceBox) const
         }
         row += width_;
     }
+#endif
 
     return false;
 }
 
+void OcclusionBuffer::StoreDepthHistory()
+{
+    if (!buffer_.data_)
+        return;
+
+    historyDepth_.assign(buffer_.data_, buffer_.data_ + width_ * height_);
+    historyViewProj_ = viewProj_;
+    historySize_ = {width_, height_};
+}
+
+bool OcclusionBuffer::ReprojectDepthHistory()
+{
+    if (!buffer_.data_ || historyDepth_.empty() || historySize_ != IntVector2{width_, height_})
+        return false;
+
+    URHO3D_PROFILE("ReprojectOcclusionDepth");
+
+    // Transform from previous normalized device coordinates to current clip space
+    const Matrix4 reprojection = viewProj_ * historyViewProj_.Inverse();
+    const auto clearValue = (int)OCCLUSION_Z_SCALE;
+
+    // Scatter each covered pixel to its new location. Pixels that nothing is reprojected to stay cleared,
+    // so the result never occludes more than actual geometry would
+    for (int y = 0; y < height_; ++y)
+    {
+        const int* row = historyDepth_.data() + y * width_;
+        const float ndcY = (y + 1.0f - offsetY_) / scaleY_;
+        for (int x = 0; x < width_; ++x)
+        {
+            const int depth = row[x];
+            if (depth >= clearValue)
+                continue;
+
+            const float ndcX = (x + 1.0f - offsetX_) / scaleX_;
+            const Vector4 clip = reprojection * Vector4(ndcX, ndcY, depth / OCCLUSION_Z_SCALE, 1.0f);
+            if (clip.w_ <= 0.0f || clip.z_ < 0.0f)
+                continue;
+
+            const Vector3 projected = ViewportTransform(clip);
+            const int targetX = RoundToInt(projected.x_ - 1.0f);
+            const int targetY = RoundToInt(projected.y_ - 1.0f);
+            if (targetX < 0 || targetY < 0 || targetX >= width_ || targetY >= height_)
+                continue;
+
+            int& dest = buffer_.data_[targetY * width_ + targetX];
+            dest = Min(dest, RoundToInt(projected.z_));
+        }
+    }
+
+    UpdateTiles();
+    depthHierarchyDirty_ = true;
+    return true;
+}
+
+void OcclusionBuffer::ResetDepthHistory()
+{
+    historyDepth_.clear();
+    historySize_ = IntVector2::ZERO;
+}
+
 unsigned OcclusionBuffer::GetUseTimer()
 {
     return useTimer_.GetMSec(false);
@@ -456,13 +610,6 @@ unsigned OcclusionBuffer::GetUseTimer()
 
 void OcclusionBuffer::DrawBatch(const OcclusionBatch& batch, unsigned threadIndex)
 {
-    // If buffer not yet used, clear it
-    if (threadIndex > 0 && !buffers_[threadIndex].used_)
-    {
-        ClearBuffer(threadIndex);
-        buffers_[threadIndex].used_ = true;
-    }
-
     Matrix4 modelViewProj = viewProj_ * batch.model_;
 
     // Theoretical max. amount of vertices if each of the 6 clipping planes doubles the triangle count
@@ -626,7 +773,7 @@ void OcclusionBuffer::DrawTriangle(Vector4* vertices, unsigned threadIndex)
         bool clockwise = SignedArea(projected[0], projected[1], projected[2]) < 0.0f;
         if (cullMode_ == CULL_NONE || (cullMode_ == CULL_CCW && clockwise) || (cullMode_ == CULL_CW && !clockwise))
         {
-            DrawTriangle2D(projected, clockwise, threadIndex);
+            SetupTriangle2D(projected, threadIndex);
             drawOk = true;
         }
     }
@@ -664,7 +811,7 @@ void OcclusionBuffer::DrawTriangle(Vector4* vertices, unsigned threadIndex)
                 bool clockwise = SignedArea(projected[0], projected[1], projected[2]) < 0.0f;
                 if (cullMode_ == CULL_NONE || (cullMode_ == CULL_CCW && clockwise) || (cullMode_ == CULL_CW && !clockwise))
                 {
-                    DrawTriangle2D(projected, clockwise, threadIndex);
+                    SetupTriangle2D(projected, threadIndex);
                     drawOk = true;
                 }
             }
@@ -745,290 +892,332 @@ void OcclusionBuffer::ClipVertices(const Vector4& plane, Vector4* vertices, bool
     }
 }
 
-// Code based on Chris Hecker's Perspective Texture Mapping series in the Game Developer magazine
-// Also available online at http://chrishecker.com/Miscellaneous_Technical_Articles
-
-/// %Gradients of a software rasterized triangle.
-struct Gradients
+void OcclusionBuffer::SetupTriangle2D(const Vector3* vertices, unsigned threadIndex)
 {
-    /// Construct from vertices.
-    explicit Gradients(const Vector3* vertices)
-    {
-        float invdX = 1.0f / (((vertices[1].x_ - vertices[2].x_) *
-                               (vertices[0].y_ - vertices[2].y_)) -
-                              ((vertices[0].x_ - vertices[2].x_) *
-                               (vertices[1].y_ - vertices[2].y_)));
-
-        float invdY = -invdX;
-
-        dInvZdX_ = invdX * (((vertices[1].z_ - vertices[2].z_) * (vertices[0].y_ - vertices[2].y_)) -
-                            ((vertices[0].z_ - vertices[2].z_) * (vertices[1].y_ - vertices[2].y_)));
-
-        dInvZdY_ = invdY * (((vertices[1].z_ - vertices[2].z_) * (vertices[0].x_ - vertices[2].x_)) -
-                            ((vertices[0].z_ - vertices[2].z_) * (vertices[1].x_ - vertices[2].x_)));
+    // Pixels are sampled at integer coordinates offset by one, same as edge walking used to do
+    const float minX = Min(Min(vertices[0].x_, vertices[1].x_), vertices[2].x_) - 1.0f;
+    const float maxX = Max(Max(vertices[0].x_, vertices[1].x_), vertices[2].x_) - 1.0f;
+    const float minY = Min(Min(vertices[0].y_, vertices[1].y_), vertices[2].y_) - 1.0f;
+    const float maxY = Max(Max(vertices[0].y_, vertices[1].y_), vertices[2].y_) - 1.0f;
+
+    const int minPixelX = Max(CeilToInt(minX), 0);
+    const int maxPixelX = Min(FloorToInt(maxX), width_ - 1);
+    const int minPixelY = Max(CeilToInt(minY), 0);
+    const int maxPixelY = Min(FloorToInt(maxY), height_ - 1);
+    if (minPixelX > maxPixelX || minPixelY > maxPixelY)
+        return;
 
-        dInvZdXInt_ = (int)dInvZdX_;
-    }
+    // Make edge equations positive inside regardless of winding
+    const Vector2 origin{vertices[0].x_ - 1.0f, vertices[0].y_ - 1.0f};
+    const Vector2 v1{vertices[1].x_ - 1.0f - origin.x_, vertices[1].y_ - 1.0f - origin.y_};
+    const Vector2 v2{vertices[2].x_ - 1.0f - origin.x_, vertices[2].y_ - 1.0f - origin.y_};
+    const float area = v1.x_ * v2.y_ - v1.y_ * v2.x_;
+    if (area == 0.0f)
+        return;
+    const float sign = area > 0.0f ? 1.0f : -1.0f;
 
-    /// Integer horizontal gradient.
-    int dInvZdXInt_;
-    /// Horizontal gradient.
-    float dInvZdX_;
-    /// Vertical gradient.
-    float dInvZdY_;
-};
+    OcclusionTriangle triangle;
+    triangle.origin_ = origin;
+    const auto makeEdge = [sign](const Vector2& from, const Vector2& to)
+    {
+        const float a = -(to.y_ - from.y_) * sign;
+        const float b = (to.x_ - from.x_) * sign;
+        return Vector3{a, b, -(a * from.x_ + b * from.y_)};
+    };
+    triangle.edges_[0] = makeEdge(Vector2::ZERO, v1);
+    triangle.edges_[1] = makeEdge(v1, v2);
+    triangle.edges_[2] = makeEdge(v2, Vector2::ZERO);
+
+    const float dz1 = vertices[1].z_ - vertices[0].z_;
+    const float dz2 = vertices[2].z_ - vertices[0].z_;
+    triangle.depth_ = vertices[0].z_;
+    triangle.depthGradient_.x_ = (dz1 * v2.y_ - dz2 * v1.y_) / area;
+    triangle.depthGradient_.y_ = (v1.x_ * dz2 - v2.x_ * dz1) / area;
+    triangle.minDepth_ = RoundToInt(Min(Min(vertices[0].z_, vertices[1].z_), vertices[2].z_));
+
+    triangle.minTile_ = IntVector2{minPixelX, minPixelY} / OCCLUSION_TILE_SIZE;
+    triangle.maxTile_ = IntVector2{maxPixelX, maxPixelY} / OCCLUSION_TILE_SIZE;
+
+    threadTriangles_[threadIndex].push_back(triangle);
+}
 
-/// %Edge of a software rasterized triangle.
-struct Edge
+void OcclusionBuffer::BinTriangles()
 {
-    /// Construct from gradients and top & bottom vertices.
-    Edge(const Gradients& gradients, const Vector3& top, const Vector3& bottom, int topY)
+    URHO3D_PROFILE("BinOcclusionTriangles");
+
+    // Take over triangles of the first thread without copying, storage is handed back for the next frame
+    triangles_.clear();
+    triangles_.swap(threadTriangles_[0]);
+    for (unsigned i = 1; i < threadTriangles_.size(); ++i)
     {
-        float height = (bottom.y_ - top.y_);
-        float slope = (height != 0.0f) ? (bottom.x_ - top.x_) / height : 0.0f;
-        float yPreStep = (float)(topY + 1) - top.y_;
-        float xPreStep = slope * yPreStep;
-
-        x_ = RoundToInt((xPreStep + top.x_) * OCCLUSION_X_SCALE);
-        xStep_ = RoundToInt(slope * OCCLUSION_X_SCALE);
-        invZ_ = RoundToInt(top.z_ + xPreStep * gradients.dInvZdX_ + yPreStep * gradients.dInvZdY_);
-        invZStep_ = RoundToInt(slope * gradients.dInvZdX_ + gradients.dInvZdY_);
+        triangles_.insert(triangles_.end(), threadTriangles_[i].begin(), threadTriangles_[i].end());
+        threadTriangles_[i].clear();
     }
 
-    /// X coordinate.
-    int x_;
-    /// X coordinate step.
-    int xStep_;
-    /// Inverse Z.
-    int invZ_;
-    /// Inverse Z step.
-    int invZStep_;
-};
-
-void OcclusionBuffer::DrawTriangle2D(const Vector3* vertices, bool clockwise, unsigned threadIndex)
-{
-    int top, middle, bottom;
-    bool middleIsRight;
-
-    // Sort vertices in Y-direction
-    if (vertices[0].y_ < vertices[1].y_)
+    // Count triangles per tile, then fill tile lists in place
+    const unsigned numTiles = numTilesX_ * numTilesY_;
+    tileOffsets_.clear();
+    tileOffsets_.resize(numTiles + 1, 0u);
+    for (const OcclusionTriangle& triangle : triangles_)
     {
-        if (vertices[2].y_ < vertices[0].y_)
+        for (int y = triangle.minTile_.y_; y <= triangle.maxTile_.y_; ++y)
         {
-            top = 2;
-            middle = 0;
-            bottom = 1;
-            middleIsRight = true;
-        }
-        else
-        {
-            top = 0;
-            if (vertices[1].y_ < vertices[2].y_)
-            {
-                middle = 1;
-                bottom = 2;
-                middleIsRight = true;
-            }
-            else
-            {
-                middle = 2;
-                bottom = 1;
-                middleIsRight = false;
-            }
+            for (int x = triangle.minTile_.x_; x <= triangle.maxTile_.x_; ++x)
+                ++tileOffsets_[y * numTilesX_ + x + 1];
         }
     }
-    else
+
+    for (unsigned i = 1; i <= numTiles; ++i)
+        tileOffsets_[i] += tileOffsets_[i - 1];
+
+    tileTriangles_.resize(tileOffsets_[numTiles]);
+    for (unsigned i = 0; i < triangles_.size(); ++i)
     {
-        if (vertices[2].y_ < vertices[1].y_)
+        const OcclusionTriangle& triangle = triangles_[i];
+        for (int y = triangle.minTile_.y_; y <= triangle.maxTile_.y_; ++y)
         {
-            top = 2;
-            middle = 1;
-            bottom = 0;
-            middleIsRight = false;
-        }
-        else
-        {
-            top = 1;
-            if (vertices[0].y_ < vertices[2].y_)
-            {
-                middle = 0;
-                bottom = 2;
-                middleIsRight = false;
-            }
-            else
-            {
-                middle = 2;
-                bottom = 0;
-                middleIsRight = true;
-            }
+            for (int x = triangle.minTile_.x_; x <= triangle.maxTile_.x_; ++x)
+                tileTriangles_[tileOffsets_[y * numTilesX_ + x]++] = i;
         }
     }
 
-    auto topY = (int)vertices[top].y_;
-    auto middleY = (int)vertices[middle].y_;
-    auto bottomY = (int)vertices[bottom].y_;
+    // Offsets were advanced to the end of each tile, shift them back
+    for (unsigned i = numTiles; i > 0; --i)
+        tileOffsets_[i] = tileOffsets_[i - 1];
+    tileOffsets_[0] = 0;
+}
 
-    // Check for degenerate triangle
-    if (topY == bottomY)
-        return;
+void OcclusionBuffer::RasterizeTileRows(int beginTileY, int endTileY)
+{
+    for (int tileY = beginTileY; tileY < endTileY; ++tileY)
+    {
+        for (int tileX = 0; tileX < numTilesX_; ++tileX)
+        {
+            const unsigned tileIndex = tileY * numTilesX_ + tileX;
+            OcclusionTile& tile = tiles_[tileIndex];
 
-    // Reverse middleIsRight test if triangle is counterclockwise
-    if (!clockwise)
-        middleIsRight = !middleIsRight;
+            for (unsigned i = tileOffsets_[tileIndex]; i < tileOffsets_[tileIndex + 1]; ++i)
+            {
+                const OcclusionTriangle& triangle = triangles_[tileTriangles_[i]];
 
-    const bool topDegenerate = topY == middleY;
-    const bool bottomDegenerate = middleY == bottomY;
+                // Skip triangle if it's behind everything already drawn to the tile
+                if (triangle.minDepth_ >= tile.maxDepth_)
+                    continue;
 
-    Gradients gradients(vertices);
-    Edge topToBottom(gradients, vertices[top], vertices[bottom], topY);
+                RasterizeTriangle(triangle, tileX, tileY, tile);
+            }
+        }
+    }
+}
 
-    int* bufferData = buffers_[threadIndex].data_;
+void OcclusionBuffer::RasterizeTriangle(const OcclusionTriangle& triangle, int tileX, int tileY, OcclusionTile& tile)
+{
+    static const float maxPixelOffset = static_cast<float>(OCCLUSION_TILE_SIZE - 1);
+
+    const int beginX = tileX * OCCLUSION_TILE_SIZE;
+    const int beginY = tileY * OCCLUSION_TILE_SIZE;
+    const int endY = Min(beginY + OCCLUSION_TILE_SIZE, height_);
+    const float minDepth = static_cast<float>(triangle.minDepth_);
+
+    // Evaluate equations at the first pixel of the tile. Skip the tile if it's outside of any edge,
+    // which is common for tiles near the corners of triangle bounding box
+    const float tileOffsetX = beginX - triangle.origin_.x_;
+    const float tileOffsetY = beginY - triangle.origin_.y_;
+    float edgeRow[3];
+    for (unsigned i = 0; i < 3; ++i)
+    {
+        const Vector3& edge = triangle.edges_[i];
+        edgeRow[i] = edge.x_ * tileOffsetX + edge.y_ * tileOffsetY + edge.z_;
+        if (edgeRow[i] + (Max(edge.x_, 0.0f) + Max(edge.y_, 0.0f)) * maxPixelOffset < 0.0f)
+            return;
+    }
+    float depthRow = triangle.depth_ + triangle.depthGradient_.x_ * tileOffsetX + triangle.depthGradient_.y_ * tileOffsetY;
 
-    if (middleIsRight)
+    static const unsigned long long fullCoverage = ~0ull;
+    unsigned long long coverage = 0;
+#ifdef URHO3D_SSE
+    if (beginX + OCCLUSION_TILE_SIZE <= width_)
     {
-        // Top half
-        if (!topDegenerate)
+        // Process the tile as rows of two groups of four pixels. Max depth of the tile is accumulated
+        // along the way and is used only if the tile ends up fully covered
+        const __m128 laneOffsets = _mm_setr_ps(0.0f, 1.0f, 2.0f, 3.0f);
+        __m128 edgeSteps[3];
+        __m128 edgeLanes[3];
+        for (unsigned i = 0; i < 3; ++i)
+        {
+            edgeSteps[i] = _mm_set1_ps(triangle.edges_[i].x_ * 4.0f);
+            edgeLanes[i] = _mm_mul_ps(_mm_set1_ps(triangle.edges_[i].x_), laneOffsets);
+        }
+        const __m128 depthStep = _mm_set1_ps(triangle.depthGradient_.x_ * 4.0f);
+        const __m128 depthLanes = _mm_mul_ps(_mm_set1_ps(triangle.depthGradient_.x_), laneOffsets);
+        const __m128 minDepthVec = _mm_set1_ps(minDepth);
+        const __m128 zero = _mm_setzero_ps();
+        __m128i maxDepth = _mm_setzero_si128();
+
+        unsigned shift = 0;
+        for (int y = beginY; y < endY; ++y)
         {
-            Edge topToMiddle(gradients, vertices[top], vertices[middle], topY);
-            int* row = bufferData + topY * width_;
-            int* endRow = bufferData + middleY * width_;
-            while (row < endRow)
+            int* row = buffer_.data_ + y * width_ + beginX;
+            __m128 edge0 = _mm_add_ps(_mm_set1_ps(edgeRow[0]), edgeLanes[0]);
+            __m128 edge1 = _mm_add_ps(_mm_set1_ps(edgeRow[1]), edgeLanes[1]);
+            __m128 edge2 = _mm_add_ps(_mm_set1_ps(edgeRow[2]), edgeLanes[2]);
+            __m128 depth = _mm_add_ps(_mm_set1_ps(depthRow), depthLanes);
+
+            for (int half = 0; half < 2; ++half, shift += 4)
             {
-                int invZ = topToBottom.invZ_;
-                int* dest = row + (topToBottom.x_ >> 16u);
-                int* end = row + (topToMiddle.x_ >> 16u);
-                while (dest < end)
+                auto* dest = reinterpret_cast<__m128i*>(row + half * 4);
+                __m128i resultDepth = _mm_loadu_si128(dest);
+
+                const __m128 inside = _mm_and_ps(_mm_and_ps(_mm_cmpge_ps(edge0, zero), _mm_cmpge_ps(edge1, zero)),
+                    _mm_cmpge_ps(edge2, zero));
+                const int insideMask = _mm_movemask_ps(inside);
+                if (insideMask)
                 {
-                    if (invZ < *dest)
-                        *dest = invZ;
-                    invZ += gradients.dInvZdXInt_;
-                    ++dest;
+                    coverage |= static_cast<unsigned long long>(insideMask) << shift;
+
+                    const __m128i newDepth = _mm_cvtps_epi32(_mm_max_ps(depth, minDepthVec));
+                    const __m128i mask = _mm_and_si128(_mm_castps_si128(inside), _mm_cmplt_epi32(newDepth, resultDepth));
+                    if (_mm_movemask_epi8(mask))
+                    {
+                        resultDepth = _mm_or_si128(_mm_and_si128(mask, newDepth), _mm_andnot_si128(mask, resultDepth));
+                        _mm_storeu_si128(dest, resultDepth);
+                    }
                 }
 
-                topToBottom.x_ += topToBottom.xStep_;
-                topToBottom.invZ_ += topToBottom.invZStep_;
-                topToMiddle.x_ += topToMiddle.xStep_;
-                row += width_;
+                // SSE2 has no integer max, so select it with comparison
+                const __m128i greater = _mm_cmpgt_epi32(resultDepth, maxDepth);
+                maxDepth = _mm_or_si128(_mm_and_si128(greater, resultDepth), _mm_andnot_si128(greater, maxDepth));
+
+                edge0 = _mm_add_ps(edge0, edgeSteps[0]);
+                edge1 = _mm_add_ps(edge1, edgeSteps[1]);
+                edge2 = _mm_add_ps(edge2, edgeSteps[2]);
+                depth = _mm_add_ps(depth, depthStep);
             }
+
+            for (unsigned i = 0; i < 3; ++i)
+                edgeRow[i] += triangle.edges_[i].y_;
+            depthRow += triangle.depthGradient_.y_;
         }
 
-        // Bottom half
-        if (!bottomDegenerate)
+        tile.coverage_ |= coverage;
+        if (coverage && tile.coverage_ == fullCoverage)
         {
-            Edge middleToBottom(gradients, vertices[middle], vertices[bottom], middleY);
-            int* row = bufferData + middleY * width_;
-            int* endRow = bufferData + bottomY * width_;
-            while (row < endRow)
-            {
-                int invZ = topToBottom.invZ_;
-                int* dest = row + (topToBottom.x_ >> 16u);
-                int* end = row + (middleToBottom.x_ >> 16u);
-                while (dest < end)
-                {
-                    if (invZ < *dest)
-                        *dest = invZ;
-                    invZ += gradients.dInvZdXInt_;
-                    ++dest;
-                }
-
-                topToBottom.x_ += topToBottom.xStep_;
-                topToBottom.invZ_ += topToBottom.invZStep_;
-                middleToBottom.x_ += middleToBottom.xStep_;
-                row += width_;
-            }
+            alignas(16) int maxDepths[4];
+            _mm_store_si128(reinterpret_cast<__m128i*>(maxDepths), maxDepth);
+            tile.maxDepth_ = Max(Max(maxDepths[0], maxDepths[1]), Max(maxDepths[2], maxDepths[3]));
         }
+        return;
     }
-    else
+#endif
+
+    const int endX = Min(beginX + OCCLUSION_TILE_SIZE, width_);
+    for (int y = beginY; y < endY; ++y)
     {
-        // Top half
-        if (!topDegenerate)
+        int* row = buffer_.data_ + y * width_;
+        for (int x = beginX; x < endX; ++x)
         {
-            Edge topToMiddle(gradients, vertices[top], vertices[middle], topY);
-            int* row = bufferData + topY * width_;
-            int* endRow = bufferData + middleY * width_;
-            while (row < endRow)
+            const float offset = static_cast<float>(x - beginX);
+            const float edge0 = edgeRow[0] + triangle.edges_[0].x_ * offset;
+            const float edge1 = edgeRow[1] + triangle.edges_[1].x_ * offset;
+            const float edge2 = edgeRow[2] + triangle.edges_[2].x_ * offset;
+            if (edge0 >= 0.0f && edge1 >= 0.0f && edge2 >= 0.0f)
             {
-                int invZ = topToMiddle.invZ_;
-                int* dest = row + (topToMiddle.x_ >> 16u);
-                int* end = row + (topToBottom.x_ >> 16u);
-                while (dest < end)
-                {
-                    if (invZ < *dest)
-                        *dest = invZ;
-                    invZ += gradients.dInvZdXInt_;
-                    ++dest;
-                }
-
-                topToMiddle.x_ += topToMiddle.xStep_;
-                topToMiddle.invZ_ += topToMiddle.invZStep_;
-                topToBottom.x_ += topToBottom.xStep_;
-                row += width_;
+                coverage |= 1ull << ((y - beginY) * OCCLUSION_TILE_SIZE + x - beginX);
+                const int depth = RoundToInt(Max(depthRow + triangle.depthGradient_.x_ * offset, minDepth));
+                if (depth < row[x])
+                    row[x] = depth;
             }
         }
 
-        // Bottom half
-        if (!bottomDegenerate)
-        {
-            Edge middleToBottom(gradients, vertices[middle], vertices[bottom], middleY);
-            int* row = bufferData + middleY * width_;
-            int* endRow = bufferData + bottomY * width_;
-            while (row < endRow)
-            {
-                int invZ = middleToBottom.invZ_;
-                int* dest = row + (middleToBottom.x_ >> 16u);
-                int* end = row + (topToBottom.x_ >> 16u);
-                while (dest < end)
-                {
-                    if (invZ < *dest)
-                        *dest = invZ;
-                    invZ += gradients.dInvZdXInt_;
-                    ++dest;
-                }
-
-                middleToBottom.x_ += middleToBottom.xStep_;
-                middleToBottom.invZ_ += middleToBottom.invZStep_;
-                topToBottom.x_ += topToBottom.xStep_;
-                row += width_;
-            }
-        }
+        for (unsigned i = 0; i < 3; ++i)
+            edgeRow[i] += triangle.edges_[i].y_;
+        depthRow += triangle.depthGradient_.y_;
     }
+
+    tile.coverage_ |= coverage;
+    if (coverage && tile.coverage_ == fullCoverage)
+        tile.maxDepth_ = CalculateTileMaxDepth(tileX, tileY);
 }
 
-void OcclusionBuffer::MergeBuffers()
+unsigned long long OcclusionBuffer::GetTileOutsideMask(int tileX, int tileY) const
 {
-    URHO3D_PROFILE("MergeBuffers");
+    const int numColumns = Min(width_ - tileX * OCCLUSION_TILE_SIZE, OCCLUSION_TILE_SIZE);
+    const int numRows = Min(height_ - tileY * OCCLUSION_TILE_SIZE, OCCLUSION_TILE_SIZE);
 
-    for (unsigned i = 1; i < buffers_.size(); ++i)
+    unsigned long long mask = 0;
+    for (int y = 0; y < OCCLUSION_TILE_SIZE; ++y)
     {
-        if (!buffers_[i].used_)
-            continue;
+        for (int x = 0; x < OCCLUSION_TILE_SIZE; ++x)
+        {
+            if (x >= numColumns || y >= numRows)
+                mask |= 1ull << (y * OCCLUSION_TILE_SIZE + x);
+        }
+    }
+    return mask;
+}
 
-        int* src = buffers_[i].data_;
-        int* dest = buffers_[0].data_;
-        int count = width_ * height_;
+int OcclusionBuffer::CalculateTileMaxDepth(int tileX, int tileY) const
+{
+    const int beginX = tileX * OCCLUSION_TILE_SIZE;
+    const int beginY = tileY * OCCLUSION_TILE_SIZE;
+    const int endX = Min(beginX + OCCLUSION_TILE_SIZE, width_);
+    const int endY = Min(beginY + OCCLUSION_TILE_SIZE, height_);
+    int maxDepth = 0;
+    for (int y = beginY; y < endY; ++y)
+    {
+        const int* row = buffer_.data_ + y * width_;
+        for (int x = beginX; x < endX; ++x)
+            maxDepth = Max(maxDepth, row[x]);
+    }
+    return maxDepth;
+}
 
-        while (count--)
+void OcclusionBuffer::UpdateTiles()
+{
+    const auto clearValue = (int)OCCLUSION_Z_SCALE;
+    for (int tileY = 0; tileY < numTilesY_; ++tileY)
+    {
+        for (int tileX = 0; tileX < numTilesX_; ++tileX)
         {
-            // If thread buffer's depth value is closer, overwrite the original
-            if (*src < *dest)
-                *dest = *src;
-            ++src;
-            ++dest;
+            OcclusionTile& tile = tiles_[tileY * numTilesX_ + tileX];
+            tile.coverage_ = GetTileOutsideMask(tileX, tileY);
+
+            const int beginX = tileX * OCCLUSION_TILE_SIZE;
+            const int beginY = tileY * OCCLUSION_TILE_SIZE;
+            const int endX = Min(beginX + OCCLUSION_TILE_SIZE, width_);
+            const int endY = Min(beginY + OCCLUSION_TILE_SIZE, height_);
+            for (int y = beginY; y < endY; ++y)
+            {
+                const int* row = buffer_.data_ + y * width_;
+                for (int x = beginX; x < endX; ++x)
+                {
+                    if (row[x] < clearValue)
+                        tile.coverage_ |= 1ull << ((y - beginY) * OCCLUSION_TILE_SIZE + x - beginX);
+                }
+            }
+
+            tile.maxDepth_ = CalculateTileMaxDepth(tileX, tileY);
         }
     }
 }
 
-void OcclusionBuffer::ClearBuffer(unsigned threadIndex)
+void OcclusionBuffer::ClearBuffer()
 {
-    if (threadIndex >= buffers_.size())
+    if (!buffer_.data_)
         return;
 
-    int* dest = buffers_[threadIndex].data_;
+    int* dest = buffer_.data_;
     int count = width_ * height_;
     auto fillValue = (int)OCCLUSION_Z_SCALE;
 
     while (count--)
         *dest++ = fillValue;
+
+    for (int tileY = 0; tileY < numTilesY_; ++tileY)
+    {
+        for (int tileX = 0; tileX < numTilesX_; ++tileX)
+            tiles_[tileY * numTilesX_ + tileX] = OcclusionTile{fillValue, GetTileOutsideMask(tileX, tileY)};
+    }
 }
 
 }
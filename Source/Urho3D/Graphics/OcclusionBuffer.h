@@ -30,6 +30,7 @@
 #include "../Core/Timer.h"
 #include "../Graphics/GraphicsDefs.h"
 #include "../Math/Frustum.h"
+#include "../Math/Vector2.h"
 
 namespace Urho3D
 {
@@ -39,8 +40,6 @@ class Camera;
 class IndexBuffer;
 class IntRect;
 class VertexBuffer;
-struct Edge;
-struct Gradients;
 
 /// Occlusion hierarchy depth value.
 struct DepthValue
@@ -51,15 +50,13 @@ struct DepthValue
     int max_;
 };
 
-/// Per-thread occlusion buffer data.
+/// Occlusion buffer data.
 struct OcclusionBufferData
 {
     /// Full buffer data with safety padding.
     ea::shared_array<int> dataWithSafety_;
     /// Buffer data.
-    int* data_;
-    /// Use flag.
-    bool used_;
+    int* data_{};
 };
 
 /// Stored occlusion render job.
@@ -81,7 +78,34 @@ struct OcclusionBatch
     unsigned drawCount_;
 };
 
+/// Screen-space triangle prepared for tiled rasterization.
+struct OcclusionTriangle
+{
+    /// Reference vertex position, used as origin for edge and depth equations.
+    Vector2 origin_;
+    /// Edge equations relative to origin in form of (a, b, c), positive inside the triangle.
+    Vector3 edges_[3];
+    /// Depth at origin.
+    float depth_;
+    /// Depth gradient along X and Y.
+    Vector2 depthGradient_;
+    /// Minimum depth of the triangle.
+    int minDepth_;
+    /// Covered range of tiles, inclusive.
+    IntVector2 minTile_;
+    IntVector2 maxTile_;
+};
+
+struct OcclusionTile
+{
+    /// Maximum depth value in the tile. Equal to clear depth until the tile is fully covered.
+    int maxDepth_;
+    /// Mask of pixels covered by rasterized triangles, one bit per pixel in row-major order.
+    unsigned long long coverage_;
+};
+
 static const int OCCLUSION_MIN_SIZE = 8;
+static const int OCCLUSION_TILE_SIZE = 8;
 static const int OCCLUSION_DEFAULT_MAX_TRIANGLES = 5000;
 static const float OCCLUSION_RELATIVE_BIAS = 0.00001f;
 static const int OCCLUSION_FIXED_BIAS = 16;
@@ -125,9 +149,16 @@ public:
     void BuildDepthHierarchy();
     /// Reset last used timer.
     void ResetUseTimer();
+    /// Store current depth and view to be reprojected in the next frame.
+    void StoreDepthHistory();
+    /// Seed cleared buffer with stored depth reprojected to the current view.
+    /// Return false if there is no history or it has different size.
+    bool ReprojectDepthHistory();
+    /// Discard stored depth history.
+    void ResetDepthHistory();
 
     /// Return highest level depth values.
-    int* GetBuffer() const { return buffers_.size() ? buffers_[0].data_ : nullptr; }
+    int* GetBuffer() const { return buffer_.data_; }
 
     /// Return view transform matrix.
     const Matrix3x4& GetView() const { return view_; }
@@ -151,7 +182,10 @@ public:
     CullMode GetCullMode() const { return cullMode_; }
 
     /// Return whether is using threads to speed up rendering.
-    bool IsThreaded() const { return buffers_.size() > 1; }
+    bool IsThreaded() const { return threaded_; }
+
+    /// Return whether depth history is stored.
+    bool HasDepthHistory() const { return !historyDepth_.empty(); }
 
     /// Test a bounding box for visibility. For best performance, build depth hierarchy first.
     bool IsVisible(const BoundingBox& worldSpaceBox) const;
@@ -176,15 +210,47 @@ private:
     void DrawTriangle(Vector4* vertices, unsigned threadIndex);
     /// Clip vertices against a plane.
     void ClipVertices(const Vector4& plane, Vector4* vertices, bool* triangles, unsigned& numTriangles);
-    /// Draw a clipped triangle.
-    void DrawTriangle2D(const Vector3* vertices, bool clockwise, unsigned threadIndex);
-    /// Clear a thread work buffer.
-    void ClearBuffer(unsigned threadIndex);
-    /// Merge thread work buffers into the first buffer.
-    void MergeBuffers();
-
-    /// Highest-level buffer data per thread.
-    ea::vector<OcclusionBufferData> buffers_;
+    /// Prepare a clipped triangle for rasterization.
+    void SetupTriangle2D(const Vector3* vertices, unsigned threadIndex);
+    /// Sort prepared triangles into tiles.
+    void BinTriangles();
+    /// Rasterize all triangles in given rows of tiles.
+    void RasterizeTileRows(int beginTileY, int endTileY);
+    /// Rasterize triangle into the tile and update tile coverage and max depth.
+    void RasterizeTriangle(const OcclusionTriangle& triangle, int tileX, int tileY, OcclusionTile& tile);
+    /// Clear the buffer data.
+    void ClearBuffer();
+    /// Return mask of tile pixels that are outside of the buffer and are treated as covered.
+    unsigned long long GetTileOutsideMask(int tileX, int tileY) const;
+    /// Return max depth within the tile.
+    int CalculateTileMaxDepth(int tileX, int tileY) const;
+    /// Recalculate coverage and max depth of all tiles from buffer data.
+    void UpdateTiles();
+
+    /// Highest-level buffer data.
+    OcclusionBufferData buffer_;
+    /// Triangles prepared by each thread.
+    ea::vector<ea::vector<OcclusionTriangle>> threadTriangles_;
+    /// Triangles of all threads, merged before binning.
+    ea::vector<OcclusionTriangle> triangles_;
+    /// Offsets of first triangle index in each tile, plus end offset.
+    ea::vector<unsigned> tileOffsets_;
+    /// Triangle indices sorted by tiles.
+    ea::vector<unsigned> tileTriangles_;
+    /// Coverage and maximum depth of each tile, used to reject hidden triangles quickly.
+    ea::vector<OcclusionTile> tiles_;
+    /// Number of tiles horizontally.
+    int numTilesX_{};
+    /// Number of tiles vertically.
+    int numTilesY_{};
+    /// Whether to use worker threads.
+    bool threaded_{};
+    /// Depth stored for reprojection.
+    ea::vector<int> historyDepth_;
+    /// Combined view and projection matrix of stored depth.
+    Matrix4 historyViewProj_;
+    /// Size of stored depth.
+    IntVector2 historySize_;
     /// Reduced size depth buffers.
     ea::vector<ea::shared_array<DepthValue> > mipBuffers_;
     /// Submitted render jobs.
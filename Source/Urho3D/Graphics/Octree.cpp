@@ -26,6 +26,7 @@
 
 #include "../Core/Context.h"
 #include "../Core/CoreEvents.h"
+#include "../Core/FrameAllocator.h"
 #include "../Core/Profiler.h"
 #include "../Core/Thread.h"
 #include "../Graphics/DebugRenderer.h"
@@ -35,6 +36,7 @@
 #include "../Graphics/Renderer.h"
 #include "../Graphics/Zone.h"
 #include "../IO/Log.h"
+#include "../Math/BatchMath.h"
 #include "../Scene/Scene.h"
 #include "../Scene/SceneEvents.h"
 
@@ -50,6 +52,55 @@ namespace Urho3D
 static const float DEFAULT_OCTREE_SIZE = 1000.0f;
 static const int DEFAULT_OCTREE_LEVELS = 8;
 
+static const ea::vector<ea::string> spatialIndexNames = {
+    "Octants",
+    "BVH",
+};
+
+/// Number of octants processed by one task of batched frustum culling.
+static const unsigned FRUSTUM_CULLING_OCTANTS_PER_TASK = 16;
+/// Number of bounding boxes tested at once during batched frustum culling.
+static const unsigned FRUSTUM_CULLING_BATCH_SIZE = 64;
+
+namespace
+{
+
+/// Range of drawables from one octant or BVH leaf.
+struct DrawableSpan
+{
+    Drawable** begin_{};
+    Drawable** end_{};
+    bool inside_{};
+};
+
+/// Query that collects ranges of drawables intersecting the frustum without testing the drawables themselves.
+class FrustumSpanOctreeQuery : public OctreeQuery
+{
+public:
+    FrustumSpanOctreeQuery(ea::vector<Drawable*>& result, const Frustum& frustum, FrameVector<DrawableSpan>& spans)
+        : OctreeQuery(result, DRAWABLE_ANY, DEFAULT_VIEWMASK)
+        , frustum_(frustum)
+        , spans_(spans)
+    {
+    }
+
+    Intersection TestOctant(const BoundingBox& box, bool inside) override
+    {
+        return inside ? INSIDE : frustum_.IsInside(box);
+    }
+
+    void TestDrawables(Drawable** start, Drawable** end, bool inside) override
+    {
+        spans_.push_back({start, end, inside});
+    }
+
+private:
+    const Frustum& frustum_;
+    FrameVector<DrawableSpan>& spans_;
+};
+
+}
+
 inline bool CompareRayQueryResults(const RayQueryResult& lhs, const RayQueryResult& rhs)
 {
     return lhs.distance_ < rhs.distance_;
@@ -206,6 +257,23 @@ void Octant::ResetOctree()
     }
 }
 
+void Octant::DetachDrawables()
+{
+    for (Drawable* drawable : drawables_)
+        drawable->SetOctant(nullptr);
+    drawables_.clear();
+    numDrawables_ = 0;
+
+    for (unsigned i = 0; i < NUM_OCTANTS; ++i)
+    {
+        if (children_[i])
+        {
+            children_[i]->DetachDrawables();
+            DeleteChild(i);
+        }
+    }
+}
+
 void Octant::DrawDebugGeometry(DebugRenderer* debug, bool depthTest)
 {
     if (debug && debug->IsInside(worldBoundingBox_))
@@ -420,6 +488,16 @@ Octree::~Octree()
     // Reset root pointer from all child octants now so that they do not move their drawables to root
     drawableUpdates_.clear();
     rootOctant_.ResetOctree();
+
+    // Drawables indexed by BVH are not stored in octants
+    if (spatialIndex_ == OctreeSpatialIndex::BVH)
+    {
+        for (Drawable* drawable : drawables_)
+        {
+            drawable->SetOctant(nullptr);
+            drawable->SetDrawableIndex(M_MAX_UNSIGNED);
+        }
+    }
 }
 
 void Octree::RegisterObject(Context* context)
@@ -432,6 +510,7 @@ void Octree::RegisterObject(Context* context)
     URHO3D_ATTRIBUTE_EX("Bounding Box Min", Vector3, worldBoundingBox_.min_, UpdateOctreeSize, defaultBoundsMin, AM_DEFAULT);
     URHO3D_ATTRIBUTE_EX("Bounding Box Max", Vector3, worldBoundingBox_.max_, UpdateOctreeSize, defaultBoundsMax, AM_DEFAULT);
     URHO3D_ATTRIBUTE_EX("Number of Levels", int, numLevels_, UpdateOctreeSize, DEFAULT_OCTREE_LEVELS, AM_DEFAULT);
+    URHO3D_ENUM_ACCESSOR_ATTRIBUTE("Spatial Index", GetSpatialIndex, SetSpatialIndex, OctreeSpatialIndex, spatialIndexNames, OctreeSpatialIndex::Octants, AM_DEFAULT);
 }
 
 void Octree::DrawDebugGeometry(DebugRenderer* debug, bool depthTest)
@@ -440,7 +519,10 @@ void Octree::DrawDebugGeometry(DebugRenderer* debug, bool depthTest)
     {
         URHO3D_PROFILE("OctreeDrawDebug");
 
-        rootOctant_.DrawDebugGeometry(debug, depthTest);
+        if (spatialIndex_ == OctreeSpatialIndex::BVH)
+            bvh_.DrawDebugGeometry(debug, depthTest);
+        else
+            rootOctant_.DrawDebugGeometry(debug, depthTest);
     }
 }
 
@@ -453,6 +535,36 @@ void Octree::SetSize(const BoundingBox& box, unsigned numLevels)
     numLevels_ = Max(numLevels, 1U);
 }
 
+void Octree::SetSpatialIndex(OctreeSpatialIndex spatialIndex)
+{
+    if (spatialIndex_ == spatialIndex)
+        return;
+
+    URHO3D_PROFILE("ChangeOctreeSpatialIndex");
+
+    spatialIndex_ = spatialIndex;
+    if (spatialIndex_ == OctreeSpatialIndex::BVH)
+    {
+        // Drawables only refer to the root octant so they can find the octree
+        rootOctant_.DetachDrawables();
+        for (Drawable* drawable : drawables_)
+        {
+            drawable->SetOctant(&rootOctant_);
+            bvh_.AddDrawable(drawable);
+        }
+        bvh_.Rebuild(GetSubsystem<WorkQueue>());
+    }
+    else
+    {
+        bvh_.Clear();
+        for (Drawable* drawable : drawables_)
+        {
+            drawable->SetOctant(nullptr);
+            rootOctant_.InsertDrawable(drawable);
+        }
+    }
+}
+
 void Octree::Update(const FrameInfo& frame)
 {
     if (!Thread::IsMainThread())
@@ -537,6 +649,13 @@ void Octree::Update(const FrameInfo& frame)
             // Skip if no octant or does not belong to this octree anymore
             if (!octant || octant->GetOctree() != this)
                 continue;
+            drawableBoxes_[drawable->GetDrawableIndex()] = box;
+            // BVH reads bounding boxes from worker threads later, they are already updated at this point
+            if (spatialIndex_ == OctreeSpatialIndex::BVH)
+            {
+                bvh_.MarkDrawableDirty(drawable);
+                continue;
+            }
             // Skip if still fits the current octant
             if (drawable->IsOccludee() && octant->GetCullingBox().IsInside(box) == INSIDE && octant->CheckDrawableFit(box))
                 continue;
@@ -557,6 +676,12 @@ void Octree::Update(const FrameInfo& frame)
 
     drawableUpdates_.clear();
 
+    if (spatialIndex_ == OctreeSpatialIndex::BVH)
+    {
+        URHO3D_PROFILE("UpdateOctreeBVH");
+        bvh_.Update(GetSubsystem<WorkQueue>());
+    }
+
     // Update other singletons.
     // TODO: Refactor it, maybe split Octree?
     zones_.Commit();
@@ -601,10 +726,17 @@ void Octree::AddDrawable(Drawable* drawable)
     // Add drawable to index
     const unsigned index = drawables_.size();
     drawables_.push_back(drawable);
+    drawableBoxes_.push_back(drawable->GetWorldBoundingBox());
     drawable->SetDrawableIndex(index);
 
     // Insert drawable to common Octree
-    rootOctant_.InsertDrawable(drawable);
+    if (spatialIndex_ == OctreeSpatialIndex::BVH)
+    {
+        drawable->SetOctant(&rootOctant_);
+        bvh_.AddDrawable(drawable);
+    }
+    else
+        rootOctant_.InsertDrawable(drawable);
 
     // Insert drawable to zone index
     if (drawable->GetDrawableFlags().Test(DRAWABLE_ZONE))
@@ -631,7 +763,13 @@ void Octree::RemoveDrawable(Drawable* drawable, Octant* octant)
     }
 
     // Remove drawable from Octree
-    octant->RemoveDrawable(drawable);
+    if (spatialIndex_ == OctreeSpatialIndex::BVH)
+    {
+        bvh_.RemoveDrawable(drawable);
+        drawable->SetOctant(nullptr);
+    }
+    else
+        octant->RemoveDrawable(drawable);
 
     // Remove drawable from Zone index
     if (drawable->GetDrawableFlags().Test(DRAWABLE_ZONE))
@@ -646,9 +784,13 @@ void Octree::RemoveDrawable(Drawable* drawable, Octant* octant)
     {
         Drawable* replacement = drawables_.back();
         drawables_[index] = replacement;
+        drawableBoxes_[index] = drawableBoxes_.back();
         replacement->SetDrawableIndex(index);
+        if (spatialIndex_ == OctreeSpatialIndex::BVH)
+            bvh_.OnDrawableIndexChanged(drawables_.size() - 1, index);
     }
     drawables_.pop_back();
+    drawableBoxes_.pop_back();
     drawable->SetDrawableIndex(M_MAX_UNSIGNED);
     drawable->updateQueued_ = false;
 
@@ -664,7 +806,73 @@ void Octree::MarkZoneDirty(Zone* zone)
 void Octree::GetDrawables(OctreeQuery& query) const
 {
     query.result_.clear();
-    rootOctant_.GetDrawablesInternal(query, false);
+    if (spatialIndex_ == OctreeSpatialIndex::BVH)
+        bvh_.GetDrawables(query);
+    else
+        rootOctant_.GetDrawablesInternal(query, false);
+}
+
+void Octree::GetDrawablesInFrustum(ea::vector<Drawable*>& result, const Frustum& frustum,
+    DrawableFlags drawableFlags, unsigned viewMask) const
+{
+    FrameVector<DrawableSpan> spans;
+    FrustumSpanOctreeQuery spanQuery(result, frustum, spans);
+    GetDrawables(spanQuery);
+
+    const unsigned numTasks = (spans.size() + FRUSTUM_CULLING_OCTANTS_PER_TASK - 1) / FRUSTUM_CULLING_OCTANTS_PER_TASK;
+    FrameVector<FrameVector<Drawable*>> taskResults(numTasks);
+
+    auto* workQueue = GetSubsystem<WorkQueue>();
+    ForEachParallel(workQueue, FRUSTUM_CULLING_OCTANTS_PER_TASK, static_cast<unsigned>(spans.size()),
+        [&](unsigned beginIndex, unsigned endIndex)
+    {
+        FrameVector<Drawable*>& taskResult = taskResults[beginIndex / FRUSTUM_CULLING_OCTANTS_PER_TASK];
+
+        BoundingBox boxes[FRUSTUM_CULLING_BATCH_SIZE];
+        Drawable* candidates[FRUSTUM_CULLING_BATCH_SIZE];
+        bool visible[FRUSTUM_CULLING_BATCH_SIZE];
+        unsigned numCandidates = 0;
+
+        const auto flushCandidates = [&]()
+        {
+            TestBoundingBoxesInFrustum(frustum, boxes, visible, numCandidates);
+            for (unsigned i = 0; i < numCandidates; ++i)
+            {
+                if (visible[i])
+                    taskResult.push_back(candidates[i]);
+            }
+            numCandidates = 0;
+        };
+
+        for (unsigned spanIndex = beginIndex; spanIndex < endIndex; ++spanIndex)
+        {
+            const DrawableSpan& span = spans[spanIndex];
+            for (Drawable** iter = span.begin_; iter != span.end_; ++iter)
+            {
+                Drawable* drawable = *iter;
+                if (!(drawable->GetDrawableFlags() & drawableFlags) || !(drawable->GetViewMask() & viewMask))
+                    continue;
+
+                if (span.inside_)
+                {
+                    taskResult.push_back(drawable);
+                    continue;
+                }
+
+                candidates[numCandidates] = drawable;
+                boxes[numCandidates] = drawableBoxes_[drawable->GetDrawableIndex()];
+                if (++numCandidates == FRUSTUM_CULLING_BATCH_SIZE)
+                    flushCandidates();
+            }
+        }
+
+        if (numCandidates > 0)
+            flushCandidates();
+    });
+
+    result.clear();
+    for (const FrameVector<Drawable*>& taskResult : taskResults)
+        result.insert(result.end(), taskResult.begin(), taskResult.end());
 }
 
 void Octree::Raycast(RayOctreeQuery& query) const
@@ -672,7 +880,10 @@ void Octree::Raycast(RayOctreeQuery& query) const
     URHO3D_PROFILE("Raycast");
 
     query.result_.clear();
-    rootOctant_.GetDrawablesInternal(query);
+    if (spatialIndex_ == OctreeSpatialIndex::BVH)
+        bvh_.GetDrawables(query);
+    else
+        rootOctant_.GetDrawablesInternal(query);
     ea::quick_sort(query.result_.begin(), query.result_.end(), CompareRayQueryResults);
 }
 
@@ -682,7 +893,10 @@ void Octree::RaycastSingle(RayOctreeQuery& query) const
 
     query.result_.clear();
     rayQueryDrawables_.clear();
-    rootOctant_.GetDrawablesOnlyInternal(query, rayQueryDrawables_);
+    if (spatialIndex_ == OctreeSpatialIndex::BVH)
+        bvh_.GetDrawablesOnly(query, rayQueryDrawables_);
+    else
+        rootOctant_.GetDrawablesOnlyInternal(query, rayQueryDrawables_);
 
     // Sort by increasing hit distance to AABB
     for (auto i = rayQueryDrawables_.begin(); i != rayQueryDrawables_.end(); ++i)
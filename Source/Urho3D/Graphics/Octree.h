@@ -26,6 +26,7 @@
 #include "../Core/Mutex.h"
 #include "../Core/WorkQueue.h"
 #include "../Graphics/Drawable.h"
+#include "../Graphics/DrawableBVH.h"
 #include "../Graphics/OctreeQuery.h"
 #include "../Math/Transform.h"
 
@@ -38,6 +39,15 @@ class Zone;
 static const int NUM_OCTANTS = 8;
 static const unsigned ROOT_INDEX = M_MAX_UNSIGNED;
 
+/// Spatial index used by Octree to answer queries.
+enum class OctreeSpatialIndex
+{
+    /// Loose octree of octants.
+    Octants,
+    /// Linear bounding volume hierarchy.
+    BVH,
+};
+
 /// %Octree octant.
 /// @nobind
 class URHO3D_API Octant
@@ -104,6 +114,8 @@ public:
     void SetRootSize(const BoundingBox& box);
     /// Reset octree pointer recursively. Called when the whole octree is being destroyed.
     void ResetOctree();
+    /// Detach drawables and delete child octants recursively. Called when the octree switches to another spatial index.
+    void DetachDrawables();
     /// Draw bounds to the debug graphics recursively.
     /// @nobind
     void DrawDebugGeometry(DebugRenderer* debug, bool depthTest);
@@ -229,6 +241,9 @@ public:
 
     /// Set size and maximum subdivision levels. If octree is not empty, drawable objects will be temporarily moved to the root.
     void SetSize(const BoundingBox& box, unsigned numLevels);
+    /// Set spatial index used for queries. Octants are cheaper to update, BVH is faster to query for large static scenes.
+    /// @property
+    void SetSpatialIndex(OctreeSpatialIndex spatialIndex);
     /// Update and reinsert drawable objects.
     void Update(const FrameInfo& frame);
     /// Add a drawable manually.
@@ -246,6 +261,10 @@ public:
     /// Return drawable objects by a query.
     /// @nobind
     void GetDrawables(OctreeQuery& query) const;
+    /// Return drawable objects inside the frustum. Same as FrustumOctreeQuery, but bounding boxes are tested in batches
+    /// and octants are split between worker threads. Should be called from the main thread.
+    void GetDrawablesInFrustum(ea::vector<Drawable*>& result, const Frustum& frustum,
+        DrawableFlags drawableFlags = DRAWABLE_ANY, unsigned viewMask = DEFAULT_VIEWMASK) const;
     /// Return drawable objects by a ray query.
     void Raycast(RayOctreeQuery& query) const;
     /// Return the closest drawable object by a ray query.
@@ -267,6 +286,13 @@ public:
     /// @property
     unsigned GetNumLevels() const { return numLevels_; }
 
+    /// Return spatial index used for queries.
+    /// @property
+    OctreeSpatialIndex GetSpatialIndex() const { return spatialIndex_; }
+
+    /// Return bounding volume hierarchy. Empty unless BVH spatial index is used.
+    const DrawableBVH& GetBVH() const { return bvh_; }
+
     /// Return all drawables in all octants.
     const ea::vector<Drawable*>& GetAllDrawables() const { return drawables_; }
 
@@ -296,12 +322,19 @@ private:
     WorkQueueVector<ea::pair<Node*, Transform>> pendingNodeTransforms_;
     /// All Drawable objects.
     ea::vector<Drawable*> drawables_;
+    /// World bounding boxes of drawables, same order as drawables_. Updated on reinsertion after MarkForUpdate,
+    /// so frustum culling reads contiguous boxes instead of Drawable objects.
+    ea::vector<BoundingBox> drawableBoxes_;
     /// Mutex for octree reinsertions.
     Mutex octreeMutex_;
     /// Ray query temporary list of drawables.
     mutable ea::vector<Drawable*> rayQueryDrawables_;
     /// Subdivision level.
     unsigned numLevels_;
+    /// Spatial index used for queries.
+    OctreeSpatialIndex spatialIndex_{};
+    /// Bounding volume hierarchy, used instead of octants for BVH spatial index.
+    DrawableBVH bvh_;
     /// World bounding box.
     BoundingBox worldBoundingBox_;
     /// Zones.
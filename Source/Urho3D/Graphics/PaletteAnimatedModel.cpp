@@ -0,0 +1,189 @@
+// Copyright (c) 2023-2023 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#include "Urho3D/Precompiled.h"
+
+#include "Urho3D/Graphics/PaletteAnimatedModel.h"
+
+#include "Urho3D/Core/Context.h"
+#include "Urho3D/Graphics/Animation.h"
+#include "Urho3D/Graphics/AnimationPalette.h"
+#include "Urho3D/Graphics/Material.h"
+#include "Urho3D/Graphics/Model.h"
+#include "Urho3D/IO/Log.h"
+#include "Urho3D/Resource/ResourceCache.h"
+#include "Urho3D/Scene/Scene.h"
+
+#include "Urho3D/DebugNew.h"
+
+namespace Urho3D
+{
+
+PaletteAnimatedModel::PaletteAnimatedModel(Context* context)
+    : StaticModel(context)
+    , animationsAttr_(Animation::GetTypeStatic())
+{
+}
+
+PaletteAnimatedModel::~PaletteAnimatedModel() = default;
+
+void PaletteAnimatedModel::RegisterObject(Context* context)
+{
+    context->AddFactoryReflection<PaletteAnimatedModel>(Category_Geometry);
+
+    URHO3D_COPY_BASE_ATTRIBUTES(StaticModel);
+    URHO3D_ACCESSOR_ATTRIBUTE("Animations", GetAnimationsAttr, SetAnimationsAttr, ResourceRefList, ResourceRefList(Animation::GetTypeStatic()), AM_DEFAULT);
+    URHO3D_ATTRIBUTE_EX("Frame Rate", float, frameRate_, MarkPaletteDirty, DefaultFrameRate, AM_DEFAULT);
+    URHO3D_ATTRIBUTE("Clip Index", unsigned, clipIndex_, 0, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Time", GetTime, SetTime, float, 0.0f, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Speed", GetSpeed, SetSpeed, float, 1.0f, AM_DEFAULT);
+    URHO3D_ATTRIBUTE("Is Looped", bool, looped_, true, AM_DEFAULT);
+}
+
+void PaletteAnimatedModel::ApplyAttributes()
+{
+    if (paletteDirty_)
+        UpdatePalette();
+}
+
+void PaletteAnimatedModel::UpdateBatches(const FrameInfo& frame)
+{
+    StaticModel::UpdateBatches(frame);
+
+    if (palette_)
+        instanceData_ = palette_->GetInstanceData(clipIndex_, GetTime(), looped_);
+}
+
+void PaletteAnimatedModel::SetModel(Model* model)
+{
+    if (model == model_)
+        return;
+
+    StaticModel::SetModel(model);
+    UpdatePalette();
+}
+
+void PaletteAnimatedModel::SetMaterial(Material* material)
+{
+    for (unsigned i = 0; i < batches_.size(); ++i)
+        SetMaterial(i, material);
+}
+
+bool PaletteAnimatedModel::SetMaterial(unsigned index, Material* material)
+{
+    return StaticModel::SetMaterial(index, palette_ ? palette_->GetMaterial(material) : material);
+}
+
+Material* PaletteAnimatedModel::GetMaterial(unsigned index) const
+{
+    Material* material = StaticModel::GetMaterial(index);
+    return palette_ ? palette_->GetSourceMaterial(material) : material;
+}
+
+void PaletteAnimatedModel::SetAnimations(const ea::vector<SharedPtr<Animation>>& animations)
+{
+    animations_ = animations;
+    UpdatePalette();
+}
+
+void PaletteAnimatedModel::SetFrameRate(float frameRate)
+{
+    if (frameRate_ != frameRate)
+    {
+        frameRate_ = frameRate;
+        UpdatePalette();
+    }
+}
+
+void PaletteAnimatedModel::Play(unsigned clipIndex, bool looped)
+{
+    clipIndex_ = clipIndex;
+    looped_ = looped;
+    SetTime(0.0f);
+}
+
+bool PaletteAnimatedModel::Play(const ea::string& animationName, bool looped)
+{
+    for (unsigned i = 0; i < animations_.size(); ++i)
+    {
+        if (animations_[i] && animations_[i]->GetName() == animationName)
+        {
+            Play(i, looped);
+            return true;
+        }
+    }
+    return false;
+}
+
+void PaletteAnimatedModel::SetTime(float time)
+{
+    timeOffset_ = time;
+    timeOrigin_ = GetSceneTime();
+}
+
+void PaletteAnimatedModel::SetSpeed(float speed)
+{
+    // Keep current time so the change of speed doesn't make the animation jump
+    SetTime(GetTime());
+    speed_ = speed;
+}
+
+float PaletteAnimatedModel::GetTime() const
+{
+    return timeOffset_ + (GetSceneTime() - timeOrigin_) * speed_;
+}
+
+void PaletteAnimatedModel::SetAnimationsAttr(const ResourceRefList& value)
+{
+    auto cache = GetSubsystem<ResourceCache>();
+    animations_.clear();
+    for (const ea::string& name : value.names_)
+        animations_.emplace_back(cache->GetResource<Animation>(name));
+    MarkPaletteDirty();
+}
+
+const ResourceRefList& PaletteAnimatedModel::GetAnimationsAttr() const
+{
+    animationsAttr_.names_.resize(animations_.size());
+    for (unsigned i = 0; i < animations_.size(); ++i)
+        animationsAttr_.names_[i] = GetResourceName(animations_[i]);
+    return animationsAttr_;
+}
+
+float PaletteAnimatedModel::GetSceneTime() const
+{
+    const Scene* scene = GetScene();
+    return scene ? scene->GetElapsedTime() : 0.0f;
+}
+
+void PaletteAnimatedModel::UpdatePalette()
+{
+    paletteDirty_ = false;
+
+    // Materials of batches are palette copies if there's a palette, so remember the source materials first
+    ea::vector<SharedPtr<Material>> sourceMaterials(batches_.size());
+    for (unsigned i = 0; i < batches_.size(); ++i)
+        sourceMaterials[i] = GetMaterial(i);
+
+    // Palette is not created for animations that failed to load, instance data would refer to wrong clips otherwise
+    const bool hasAnimations = !animations_.empty()
+        && ea::all_of(animations_.begin(), animations_.end(), [](const Animation* animation) { return animation != nullptr; });
+    palette_ = model_ && hasAnimations ? AnimationPalette::GetOrCreate(model_, animations_, frameRate_) : nullptr;
+
+    for (unsigned i = 0; i < batches_.size(); ++i)
+    {
+        batches_[i].material_ = palette_ ? palette_->GetMaterial(sourceMaterials[i]) : sourceMaterials[i].Get();
+        batches_[i].instancingData_ = palette_ ? &instanceData_ : nullptr;
+    }
+
+    if (palette_)
+    {
+        instanceData_ = palette_->GetInstanceData(clipIndex_, GetTime(), looped_);
+        SetBoundingBox(palette_->GetBoundingBox());
+    }
+    else
+        SetBoundingBox(model_ ? model_->GetBoundingBox() : BoundingBox{});
+}
+
+}
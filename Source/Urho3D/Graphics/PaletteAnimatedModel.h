@@ -0,0 +1,130 @@
+// Copyright (c) 2023-2023 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#pragma once
+
+#include "Urho3D/Graphics/StaticModel.h"
+
+namespace Urho3D
+{
+
+class Animation;
+class AnimationPalette;
+
+/// Skinned model that plays animations baked into shared AnimationPalette.
+/// Unlike AnimatedModel, it has no bone nodes and computes no skinning on CPU:
+/// each instance only carries current clip and time, so crowds of such models are instanced like static models.
+/// Render pipeline should have "Instancing Custom Data" enabled for instanced rendering of palette frames,
+/// otherwise each model is drawn separately with instance data passed as shader parameter.
+class URHO3D_API PaletteAnimatedModel : public StaticModel
+{
+    URHO3D_OBJECT(PaletteAnimatedModel, StaticModel);
+
+public:
+    /// Default frame rate of baked animations.
+    static constexpr float DefaultFrameRate = 30.0f;
+
+    explicit PaletteAnimatedModel(Context* context);
+    ~PaletteAnimatedModel() override;
+    /// Register object factory. StaticModel must be registered first.
+    /// @nobind
+    static void RegisterObject(Context* context);
+
+    /// Apply attribute changes that can not be applied immediately. Called after scene load or a network update.
+    void ApplyAttributes() override;
+    /// Calculate distance and prepare batches for rendering. May be called from worker thread(s), possibly re-entrantly.
+    void UpdateBatches(const FrameInfo& frame) override;
+
+    /// Set model.
+    void SetModel(Model* model) override;
+    /// Set material on all geometries.
+    void SetMaterial(Material* material) override;
+    /// Set material on one geometry. Return true if successful.
+    bool SetMaterial(unsigned index, Material* material) override;
+    /// Return source material by geometry index.
+    Material* GetMaterial(unsigned index) const override;
+
+    /// Set animations baked into palette. Palette is shared by all models with the same model, animations and frame rate.
+    void SetAnimations(const ea::vector<SharedPtr<Animation>>& animations);
+    /// Set frame rate of baked animations.
+    /// @property
+    void SetFrameRate(float frameRate);
+    /// Play clip from the beginning.
+    void Play(unsigned clipIndex, bool looped = true);
+    /// Play clip with given animation name from the beginning. Return true if the animation is found.
+    bool Play(const ea::string& animationName, bool looped = true);
+    /// Set current clip without changing current time.
+    /// @property
+    void SetClipIndex(unsigned clipIndex) { clipIndex_ = clipIndex; }
+    /// Set current time of the clip.
+    /// @property
+    void SetTime(float time);
+    /// Set playback speed.
+    /// @property
+    void SetSpeed(float speed);
+    /// Set whether the clip is looped.
+    /// @property
+    void SetLooped(bool looped) { looped_ = looped; }
+
+    /// Return animations baked into palette.
+    const ea::vector<SharedPtr<Animation>>& GetAnimations() const { return animations_; }
+    /// Return frame rate of baked animations.
+    /// @property
+    float GetFrameRate() const { return frameRate_; }
+    /// Return current clip.
+    /// @property
+    unsigned GetClipIndex() const { return clipIndex_; }
+    /// Return current time of the clip, not wrapped or clamped to clip length.
+    /// @property
+    float GetTime() const;
+    /// Return playback speed.
+    /// @property
+    float GetSpeed() const { return speed_; }
+    /// Return whether the clip is looped.
+    /// @property
+    bool IsLooped() const { return looped_; }
+    /// Return animation palette. Null if there's no model or animations.
+    AnimationPalette* GetPalette() const { return palette_; }
+    /// Return per-instance palette data evaluated during last batch update.
+    const Vector4& GetInstanceData() const { return instanceData_; }
+
+    /// Set animations attribute.
+    void SetAnimationsAttr(const ResourceRefList& value);
+    /// Return animations attribute.
+    const ResourceRefList& GetAnimationsAttr() const;
+
+private:
+    /// Return elapsed time of the scene.
+    float GetSceneTime() const;
+    /// Mark palette for update on ApplyAttributes.
+    void MarkPaletteDirty() { paletteDirty_ = true; }
+    /// Get or create palette and replace materials of batches with palette materials.
+    void UpdatePalette();
+
+    /// Animations baked into palette.
+    ea::vector<SharedPtr<Animation>> animations_;
+    /// Animations attribute.
+    mutable ResourceRefList animationsAttr_;
+    /// Frame rate of baked animations.
+    float frameRate_{DefaultFrameRate};
+    /// Current clip.
+    unsigned clipIndex_{};
+    /// Playback speed.
+    float speed_{1.0f};
+    /// Whether the clip is looped.
+    bool looped_{true};
+    /// Clip time at the scene time of the origin.
+    float timeOffset_{};
+    /// Scene time when the time offset was set.
+    float timeOrigin_{};
+
+    /// Shared palette.
+    SharedPtr<AnimationPalette> palette_;
+    /// Whether the palette should be updated.
+    bool paletteDirty_{};
+    /// Per-instance data referenced by batches.
+    Vector4 instanceData_;
+};
+
+}
@@ -139,8 +139,7 @@ void Shader::RegisterObject(Context* context)
 bool Shader::BeginLoad(Deserializer& source)
 {
     auto* graphics = GetSubsystem<Graphics>();
-    if (!graphics)
-        return false;
+    const bool validateShaders = graphics && graphics->GetSettings().validateShaders_;
 
     // Load the shader source code and resolve any includes
     ea::string shaderCode;
@@ -148,7 +147,7 @@ bool Shader::BeginLoad(Deserializer& source)
     ProcessSource(shaderCode, timeStamp, source);
 
     // Validate shader code
-    if (graphics->GetSettings().validateShaders_)
+    if (validateShaders)
     {
         static const auto characterMask = GenerateAllowedCharacterMask();
         static const unsigned maxSnippetSize = 5;
@@ -227,6 +226,7 @@ void Shader::ProcessSource(ea::string& code, FileTime& timeStamp, Deserializer&
     auto* cache = GetSubsystem<ResourceCache>();
     auto* vfs = GetSubsystem<VirtualFileSystem>();
     auto* graphics = GetSubsystem<Graphics>();
+    const bool validateShaders = graphics && graphics->GetSettings().validateShaders_;
 
     const ea::string& fileName = source.GetName();
     // TODO: Support HLSL and MSL shaders.
@@ -272,7 +272,7 @@ void Shader::ProcessSource(ea::string& code, FileTime& timeStamp, Deserializer&
                 line.erase(line.end() - 1);
 
             // If shader validation is enabled, trim comments manually to avoid validating comment contents
-            if (!graphics->GetSettings().validateShaders_ || !line.trimmed().starts_with("//"))
+            if (!validateShaders || !line.trimmed().starts_with("//"))
                 code += line;
 
             ++numNewLines;
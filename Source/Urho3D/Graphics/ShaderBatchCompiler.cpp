@@ -0,0 +1,100 @@
+// Copyright (c) 2023-2023 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#include "Urho3D/Precompiled.h"
+
+#include "Urho3D/Graphics/ShaderBatchCompiler.h"
+
+#include "Urho3D/Core/WorkQueue.h"
+#include "Urho3D/IO/Log.h"
+
+#include "Urho3D/DebugNew.h"
+
+namespace Urho3D
+{
+
+namespace
+{
+
+unsigned GetSourceHash(const ShaderVariationCompileDesc& desc)
+{
+    unsigned hash = 0;
+    CombineHash(hash, MakeHash(desc.sourceCode_));
+    CombineHash(hash, MakeHash(desc.type_));
+    CombineHash(hash, MakeHash(desc.defines_));
+    CombineHash(hash, MakeHash(desc.renderBackend_));
+    CombineHash(hash, MakeHash(desc.translationPolicy_));
+    return hash;
+}
+
+bool IsSameSource(const ShaderVariationCompileDesc& lhs, const ShaderVariationCompileDesc& rhs)
+{
+    return lhs.type_ == rhs.type_
+        && lhs.renderBackend_ == rhs.renderBackend_
+        && lhs.translationPolicy_ == rhs.translationPolicy_
+        && lhs.defines_ == rhs.defines_
+        && lhs.sourceCode_ == rhs.sourceCode_;
+}
+
+} // namespace
+
+ShaderBatchCompiler::ShaderBatchCompiler(Context* context)
+    : Object(context)
+{
+}
+
+ShaderBatchCompiler::~ShaderBatchCompiler()
+{
+}
+
+unsigned ShaderBatchCompiler::AddVariation(const ShaderVariationCompileDesc& desc)
+{
+    const unsigned variationIndex = variationToUnique_.size();
+
+    const unsigned hash = GetSourceHash(desc);
+    const auto range = uniqueVariationsByHash_.equal_range(hash);
+    for (auto iter = range.first; iter != range.second; ++iter)
+    {
+        if (IsSameSource(uniqueVariations_[iter->second].desc_, desc))
+        {
+            variationToUnique_.push_back(iter->second);
+            return variationIndex;
+        }
+    }
+
+    const unsigned uniqueIndex = uniqueVariations_.size();
+    uniqueVariations_.emplace_back().desc_ = desc;
+    uniqueVariationsByHash_.emplace(hash, uniqueIndex);
+    variationToUnique_.push_back(uniqueIndex);
+    return variationIndex;
+}
+
+void ShaderBatchCompiler::Compile()
+{
+    URHO3D_PROFILE("CompileShaderBatch");
+
+    const unsigned numPendingVariations = uniqueVariations_.size() - firstPendingVariation_;
+    if (numPendingVariations == 0)
+        return;
+
+    const auto pendingVariations = ea::span(uniqueVariations_).subspan(firstPendingVariation_);
+    ForEachParallel(GetSubsystem<WorkQueue>(), pendingVariations,
+        [](unsigned, UniqueVariation& variation)
+    {
+        variation.compiled_ =
+            ShaderVariation::CompileBytecode(variation.bytecode_, variation.translatedSource_, variation.desc_);
+    });
+
+    firstPendingVariation_ = uniqueVariations_.size();
+}
+
+void ShaderBatchCompiler::Clear()
+{
+    uniqueVariations_.clear();
+    uniqueVariationsByHash_.clear();
+    variationToUnique_.clear();
+    firstPendingVariation_ = 0;
+}
+
+} // namespace Urho3D
@@ -0,0 +1,66 @@
+// Copyright (c) 2023-2023 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#pragma once
+
+#include "Urho3D/Core/Object.h"
+#include "Urho3D/Graphics/ShaderVariation.h"
+#include "Urho3D/RenderAPI/ShaderBytecode.h"
+
+#include <EASTL/unordered_map.h>
+
+namespace Urho3D
+{
+
+/// Compiles many shader variations concurrently on worker threads.
+/// Variations with the same source code, type, defines and compilation settings are compiled only once.
+class URHO3D_API ShaderBatchCompiler : public Object
+{
+    URHO3D_OBJECT(ShaderBatchCompiler, Object);
+
+public:
+    explicit ShaderBatchCompiler(Context* context);
+    ~ShaderBatchCompiler() override;
+
+    /// Add variation to the batch. Return index of the variation.
+    unsigned AddVariation(const ShaderVariationCompileDesc& desc);
+    /// Compile all variations added since the last call and wait for completion.
+    /// Should be called from main thread.
+    void Compile();
+    /// Remove all variations.
+    void Clear();
+
+    /// Return number of added variations.
+    unsigned GetNumVariations() const { return variationToUnique_.size(); }
+    /// Return number of variations that are actually compiled.
+    unsigned GetNumUniqueVariations() const { return uniqueVariations_.size(); }
+
+    /// Return variation description.
+    const ShaderVariationCompileDesc& GetDesc(unsigned index) const { return GetUnique(index).desc_; }
+    /// Return whether the variation was successfully compiled.
+    bool IsCompiled(unsigned index) const { return GetUnique(index).compiled_; }
+    /// Return compiled bytecode of the variation.
+    const ShaderBytecode& GetBytecode(unsigned index) const { return GetUnique(index).bytecode_; }
+    /// Return translated source code of the variation, if available.
+    const ea::string& GetTranslatedSource(unsigned index) const { return GetUnique(index).translatedSource_; }
+
+private:
+    struct UniqueVariation
+    {
+        ShaderVariationCompileDesc desc_;
+        ShaderBytecode bytecode_;
+        ea::string translatedSource_;
+        bool compiled_{};
+    };
+
+    const UniqueVariation& GetUnique(unsigned index) const { return uniqueVariations_[variationToUnique_[index]]; }
+
+    ea::vector<UniqueVariation> uniqueVariations_;
+    ea::unordered_multimap<unsigned, unsigned> uniqueVariationsByHash_;
+    ea::vector<unsigned> variationToUnique_;
+    /// Index of the first unique variation that is not compiled yet.
+    unsigned firstPendingVariation_{};
+};
+
+} // namespace Urho3D
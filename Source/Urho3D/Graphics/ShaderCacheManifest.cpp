@@ -0,0 +1,289 @@
+// Copyright (c) 2023-2023 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#include "Urho3D/Precompiled.h"
+
+#include "Urho3D/Graphics/ShaderCacheManifest.h"
+
+#include "Urho3D/Core/ProcessUtils.h"
+#include "Urho3D/Core/WorkQueue.h"
+#include "Urho3D/Graphics/Shader.h"
+#include "Urho3D/Graphics/ShaderVariation.h"
+#include "Urho3D/IO/ArchiveSerialization.h"
+#include "Urho3D/IO/Log.h"
+#include "Urho3D/IO/VirtualFileSystem.h"
+#include "Urho3D/RenderAPI/RenderAPIUtils.h"
+#include "Urho3D/Resource/JSONFile.h"
+#include "Urho3D/Resource/ResourceCache.h"
+
+#include "Urho3D/DebugNew.h"
+
+namespace Urho3D
+{
+
+namespace
+{
+
+/// Serializable content of the manifest file.
+struct ShaderCacheManifestData
+{
+    unsigned version_{};
+    ea::string renderBackend_;
+    ea::vector<ShaderCacheManifestEntry> entries_;
+
+    void SerializeInBlock(Archive& archive)
+    {
+        SerializeValue(archive, "version", version_);
+        SerializeValue(archive, "renderBackend", renderBackend_);
+        SerializeVectorAsObjects(archive, "variations", entries_, "variation");
+    }
+};
+
+bool IsBytecodeUpToDate(VirtualFileSystem* vfs, const FileIdentifier& fileName, FileTime sourceTimeStamp)
+{
+    if (!vfs->Exists(fileName))
+        return false;
+
+    if (!sourceTimeStamp)
+        return true;
+
+    const FileTime bytecodeTimeStamp = vfs->GetLastModifiedTime(fileName, false);
+    return !bytecodeTimeStamp || bytecodeTimeStamp >= sourceTimeStamp;
+}
+
+} // namespace
+
+void ShaderCacheManifestEntry::SerializeInBlock(Archive& archive)
+{
+    SerializeValue(archive, "shader", shaderName_);
+    SerializeValue(archive, "type", type_);
+    SerializeValue(archive, "defines", defines_);
+    SerializeValue(archive, "unusedRuns", numUnusedRuns_);
+}
+
+unsigned ShaderCacheManifestEntry::ToHash() const
+{
+    unsigned hash = 0;
+    CombineHash(hash, MakeHash(shaderName_));
+    CombineHash(hash, MakeHash(type_));
+    CombineHash(hash, MakeHash(defines_));
+    return hash;
+}
+
+const ea::string ShaderCacheManifest::FileName = "ShaderCacheManifest.json";
+
+ShaderCacheManifest::ShaderCacheManifest(Context* context)
+    : Object(context)
+    , prewarmed_(ea::make_shared<PrewarmedBytecode>())
+{
+}
+
+ShaderCacheManifest::~ShaderCacheManifest()
+{
+}
+
+void ShaderCacheManifest::AddVariation(const ea::string& shaderName, ShaderType type, const ea::string& defines)
+{
+    const ShaderCacheManifestEntry entry{shaderName, type, defines};
+    const auto [iter, isNew] = entryIndices_.emplace(entry, entries_.size());
+    if (isNew)
+        entries_.push_back(entry);
+    else
+        entries_[iter->second].numUnusedRuns_ = 0;
+}
+
+bool ShaderCacheManifest::Load(const FileIdentifier& cacheDir, RenderBackend renderBackend)
+{
+    auto vfs = GetSubsystem<VirtualFileSystem>();
+    const FileIdentifier fileName = cacheDir + FileName;
+    if (!vfs->Exists(fileName))
+        return false;
+
+    JSONFile file(context_);
+    ShaderCacheManifestData data;
+    if (!file.LoadFile(fileName) || !file.LoadObject("shaderCacheManifest", data))
+    {
+        URHO3D_LOGWARNING("Failed to load shader cache manifest '{}'", fileName.ToUri());
+        return false;
+    }
+
+    if (data.version_ != Version || data.renderBackend_ != ToString(renderBackend))
+    {
+        URHO3D_LOGINFO("Shader cache manifest '{}' is outdated and is ignored", fileName.ToUri());
+        return false;
+    }
+
+    for (ShaderCacheManifestEntry& entry : data.entries_)
+    {
+        // Variations recorded before loading are used in this run
+        ++entry.numUnusedRuns_;
+        if (entryIndices_.emplace(entry, entries_.size()).second)
+            entries_.push_back(entry);
+    }
+    return true;
+}
+
+bool ShaderCacheManifest::Save(const FileIdentifier& cacheDir, RenderBackend renderBackend) const
+{
+    ShaderCacheManifestData data;
+    data.version_ = Version;
+    data.renderBackend_ = ToString(renderBackend);
+    for (const ShaderCacheManifestEntry& entry : entries_)
+    {
+        if (entry.numUnusedRuns_ < MaxUnusedRuns)
+            data.entries_.push_back(entry);
+    }
+
+    JSONFile file(context_);
+    if (!file.SaveObject("shaderCacheManifest", data))
+        return false;
+
+    return file.SaveFile(cacheDir + FileName);
+}
+
+void ShaderCacheManifest::Prewarm(
+    const FileIdentifier& cacheDir, RenderBackend renderBackend, ShaderTranslationPolicy policy)
+{
+    URHO3D_PROFILE("PrewarmShaderCache");
+
+    auto cache = GetSubsystem<ResourceCache>();
+    auto vfs = GetSubsystem<VirtualFileSystem>();
+    auto workQueue = GetSubsystem<WorkQueue>();
+    if (!cache || !workQueue)
+        return;
+
+    unsigned numTasks = 0;
+    for (const ShaderCacheManifestEntry& entry : entries_)
+    {
+        Shader* shader = cache->GetResource<Shader>(entry.shaderName_, false);
+        if (!shader)
+            continue;
+
+        // Variations with valid bytecode on the disk are cheap to create on demand
+        const ea::string cachedName = ShaderVariation::GetCachedVariationName(
+            shader->GetShaderName(), entry.type_, entry.defines_, renderBackend, "bytecode");
+        if (IsBytecodeUpToDate(vfs, cacheDir + cachedName, shader->GetTimeStamp()))
+            continue;
+
+        ShaderVariationCompileDesc desc;
+        desc.shaderName_ = shader->GetShaderName();
+        desc.type_ = entry.type_;
+        desc.defines_ = entry.defines_;
+        desc.sourceCode_ = shader->GetSourceCode();
+        desc.renderBackend_ = renderBackend;
+        desc.translationPolicy_ = policy;
+
+        // Bytecode of shaders from packages is not stored on the disk, same as for ShaderVariation
+        const bool cacheable = !!shader->GetTimeStamp();
+
+        {
+            std::lock_guard<std::mutex> lock(prewarmed_->mutex_);
+            const bool isPrewarmed = prewarmed_->shaders_.contains(cachedName);
+            if (isPrewarmed || !prewarmed_->pendingShaders_.emplace(cachedName, false).second)
+                continue;
+            ++prewarmed_->numPendingTasks_;
+        }
+
+        workQueue->PostTask([prewarmed = prewarmed_, cachedName, shaderName = entry.shaderName_, desc, cacheable]()
+        {
+            {
+                std::lock_guard<std::mutex> lock(prewarmed->mutex_);
+                const auto iter = prewarmed->pendingShaders_.find(cachedName);
+                if (iter == prewarmed->pendingShaders_.end())
+                {
+                    // Variation was requested before the task started and is compiled by the main thread
+                    --prewarmed->numPendingTasks_;
+                    return;
+                }
+                iter->second = true;
+            }
+
+            PrewarmedShader result;
+            ea::string translatedSource;
+            const bool compiled = ShaderVariation::CompileBytecode(result.bytecode_, translatedSource, desc);
+            result.shaderName_ = shaderName;
+            result.sourceHash_ = MakeHash(desc.sourceCode_);
+            result.cacheable_ = cacheable;
+
+            {
+                std::lock_guard<std::mutex> lock(prewarmed->mutex_);
+                --prewarmed->numPendingTasks_;
+                prewarmed->pendingShaders_.erase(cachedName);
+                if (compiled)
+                    prewarmed->shaders_[cachedName] = ea::move(result);
+            }
+            prewarmed->shaderCompiled_.notify_all();
+        }, TaskPriority::Low);
+        ++numTasks;
+    }
+
+    if (numTasks > 0)
+        URHO3D_LOGINFO("Prewarming {} shader variations in background", numTasks);
+}
+
+bool ShaderCacheManifest::TakePrewarmedBytecode(
+    const ea::string& cachedName, unsigned sourceHash, ShaderBytecode& bytecode)
+{
+    std::unique_lock<std::mutex> lock(prewarmed_->mutex_);
+
+    const auto pendingIter = prewarmed_->pendingShaders_.find(cachedName);
+    if (pendingIter != prewarmed_->pendingShaders_.end())
+    {
+        // Cancel the task if it is not started, so the variation is not compiled twice
+        if (!pendingIter->second)
+        {
+            prewarmed_->pendingShaders_.erase(pendingIter);
+            return false;
+        }
+
+        // Variation is being compiled on worker thread, wait for it
+        prewarmed_->shaderCompiled_.wait(
+            lock, [&] { return !prewarmed_->pendingShaders_.contains(cachedName); });
+    }
+
+    const auto iter = prewarmed_->shaders_.find(cachedName);
+    if (iter == prewarmed_->shaders_.end())
+        return false;
+
+    // Shader may be reloaded after prewarming started
+    const bool isUpToDate = iter->second.sourceHash_ == sourceHash;
+    if (isUpToDate)
+        bytecode = ea::move(iter->second.bytecode_);
+    prewarmed_->shaders_.erase(iter);
+    return isUpToDate;
+}
+
+void ShaderCacheManifest::SavePrewarmedBytecode(const FileIdentifier& cacheDir)
+{
+    // TODO: Enable shader cache in Web. Currently it is disabled because of suboptimal persistent storage support.
+    if (GetPlatform() == PlatformId::Web)
+        return;
+
+    auto cache = GetSubsystem<ResourceCache>();
+    auto vfs = GetSubsystem<VirtualFileSystem>();
+
+    std::lock_guard<std::mutex> lock(prewarmed_->mutex_);
+    for (const auto& [cachedName, shader] : prewarmed_->shaders_)
+    {
+        if (!shader.cacheable_)
+            continue;
+
+        // Don't store bytecode of shaders reloaded after prewarming started
+        const Shader* sourceShader = cache ? cache->GetExistingResource<Shader>(shader.shaderName_) : nullptr;
+        if (!sourceShader || MakeHash(sourceShader->GetSourceCode()) != shader.sourceHash_)
+            continue;
+
+        if (const AbstractFilePtr file = vfs->OpenFile(cacheDir + cachedName, FILE_WRITE))
+            shader.bytecode_.SaveToFile(*file);
+    }
+    prewarmed_->shaders_.clear();
+}
+
+unsigned ShaderCacheManifest::GetNumPendingPrewarmTasks() const
+{
+    std::lock_guard<std::mutex> lock(prewarmed_->mutex_);
+    return prewarmed_->numPendingTasks_;
+}
+
+} // namespace Urho3D
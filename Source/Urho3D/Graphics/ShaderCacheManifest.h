@@ -0,0 +1,118 @@
+// Copyright (c) 2023-2023 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#pragma once
+
+#include "Urho3D/Core/Object.h"
+#include "Urho3D/IO/FileIdentifier.h"
+#include "Urho3D/RenderAPI/RenderAPIDefs.h"
+#include "Urho3D/RenderAPI/ShaderBytecode.h"
+
+#include <EASTL/shared_ptr.h>
+#include <EASTL/unordered_map.h>
+
+#include <condition_variable>
+#include <mutex>
+
+namespace Urho3D
+{
+
+class Archive;
+
+/// Shader variation recorded in the shader cache manifest.
+struct URHO3D_API ShaderCacheManifestEntry
+{
+    /// Name of shader resource.
+    ea::string shaderName_;
+    ShaderType type_{};
+    /// Normalized defines separated by spaces.
+    ea::string defines_;
+    /// Number of application runs since the variation was used last time. Ignored by comparison.
+    unsigned numUnusedRuns_{};
+
+    void SerializeInBlock(Archive& archive);
+
+    unsigned ToHash() const;
+    bool operator==(const ShaderCacheManifestEntry& rhs) const
+    {
+        return shaderName_ == rhs.shaderName_ && type_ == rhs.type_ && defines_ == rhs.defines_;
+    }
+};
+
+/// Manifest of shader variations used by the application.
+/// The manifest is stored in the shader cache directory between runs,
+/// so the variations can be compiled on worker threads at startup instead of on first use.
+class URHO3D_API ShaderCacheManifest : public Object
+{
+    URHO3D_OBJECT(ShaderCacheManifest, Object);
+
+public:
+    /// Version of the manifest. Increment when the format or shader compilation pipeline changes.
+    static const unsigned Version = 2;
+    /// Variations that are not used for this number of runs are removed from the manifest.
+    static const unsigned MaxUnusedRuns = 8;
+    /// Name of the manifest file within shader cache directory.
+    static const ea::string FileName;
+
+    explicit ShaderCacheManifest(Context* context);
+    ~ShaderCacheManifest() override;
+
+    /// Record shader variation used in this run. Should be called from main thread.
+    void AddVariation(const ea::string& shaderName, ShaderType type, const ea::string& defines);
+    /// Load manifest from the shader cache directory and merge it with recorded variations.
+    /// Loaded variations that are not recorded in this run are considered unused for one more run.
+    /// Manifests of different version or render backend are ignored.
+    bool Load(const FileIdentifier& cacheDir, RenderBackend renderBackend);
+    /// Save manifest into the shader cache directory.
+    /// Variations that are not used for MaxUnusedRuns runs are not saved.
+    bool Save(const FileIdentifier& cacheDir, RenderBackend renderBackend) const;
+
+    /// Compile recorded variations that are missing in the shader cache on worker threads.
+    /// Shader resources are loaded from main thread.
+    void Prewarm(const FileIdentifier& cacheDir, RenderBackend renderBackend, ShaderTranslationPolicy policy);
+    /// Take bytecode compiled by prewarming. Wait if the variation is being compiled right now.
+    /// Return false if there is no such bytecode, if it was compiled from another source code,
+    /// or if its compilation is not started yet. In the latter case the prewarming task is cancelled.
+    bool TakePrewarmedBytecode(const ea::string& cachedName, unsigned sourceHash, ShaderBytecode& bytecode);
+    /// Save prewarmed bytecode that was not used yet into the shader cache directory.
+    void SavePrewarmedBytecode(const FileIdentifier& cacheDir);
+
+    /// Return recorded variations.
+    const ea::vector<ShaderCacheManifestEntry>& GetEntries() const { return entries_; }
+    /// Return number of prewarming tasks that are not completed yet.
+    unsigned GetNumPendingPrewarmTasks() const;
+
+private:
+    /// Shader compiled by prewarming.
+    struct PrewarmedShader
+    {
+        ShaderBytecode bytecode_;
+        /// Name of shader resource.
+        ea::string shaderName_;
+        /// Hash of the source code the bytecode is compiled from.
+        unsigned sourceHash_{};
+        /// Whether the bytecode can be stored in the shader cache directory.
+        bool cacheable_{};
+    };
+
+    /// Storage of prewarmed shaders shared with worker threads.
+    struct PrewarmedBytecode
+    {
+        std::mutex mutex_;
+        /// Notified when compilation of any variation is finished.
+        std::condition_variable shaderCompiled_;
+        ea::unordered_map<ea::string, PrewarmedShader> shaders_;
+        /// Variations that are not compiled yet and whether their compilation is started.
+        ea::unordered_map<ea::string, bool> pendingShaders_;
+        unsigned numPendingTasks_{};
+    };
+
+    ea::vector<ShaderCacheManifestEntry> entries_;
+    /// Index of each entry in entries_.
+    ea::unordered_map<ShaderCacheManifestEntry, unsigned> entryIndices_;
+
+    ea::shared_ptr<PrewarmedBytecode> prewarmed_;
+};
+
+} // namespace Urho3D
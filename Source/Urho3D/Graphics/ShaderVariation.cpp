@@ -25,8 +25,10 @@
 #include "Urho3D/Graphics/ShaderVariation.h"
 
 #include "Urho3D/Core/ProcessUtils.h"
+#include "Urho3D/Core/Thread.h"
 #include "Urho3D/Graphics/Graphics.h"
 #include "Urho3D/Graphics/Shader.h"
+#include "Urho3D/Graphics/ShaderCacheManifest.h"
 #include "Urho3D/IO/Log.h"
 #include "Urho3D/IO/VirtualFileSystem.h"
 #include "Urho3D/RenderAPI/RenderAPIUtils.h"
@@ -90,6 +92,174 @@ template <class T> ConstByteSpan ToByteSpan(const T& value)
     return {dataBytes, sizeInBytes};
 }
 
+bool NeedShaderTranslation(const ShaderVariationCompileDesc& desc)
+{
+    return desc.translationPolicy_ != ShaderTranslationPolicy::Verbatim;
+}
+
+bool NeedShaderOptimization(const ShaderVariationCompileDesc& desc)
+{
+    return desc.translationPolicy_ == ShaderTranslationPolicy::Optimize;
+}
+
+ea::string GetShaderVariationName(const ShaderVariationCompileDesc& desc)
+{
+    return Format("{}({})", desc.shaderName_, desc.defines_);
+}
+
+/// Shader file list is maintained by main thread only.
+ea::string GetShaderFileListIfAvailable()
+{
+    return Thread::IsMainThread() ? Shader::GetShaderFileList() : EMPTY_STRING;
+}
+
+ea::string PrepareGLSLShaderCode(const ShaderVariationCompileDesc& desc, const ea::string& originalShaderCode)
+{
+    ea::string shaderCode;
+
+    const RenderBackend renderBackend = desc.renderBackend_;
+    const bool skipVersionTag = NeedShaderTranslation(desc);
+
+    // Check if the shader code contains a version define
+    const auto versionTag = FindVersionTag(originalShaderCode);
+    if (!skipVersionTag)
+    {
+        if (versionTag)
+        {
+            // If version define found, insert it first
+            const ea::string versionDefine =
+                originalShaderCode.substr(versionTag->first, versionTag->second - versionTag->first);
+            shaderCode += versionDefine + "\n";
+        }
+        else
+        {
+            const bool isOpenGLES = IsOpenGLESBackend(renderBackend);
+            const bool isCompute = desc.type_ == CS;
+
+            static const char* versions[2][2] = {
+                {"#version 410\n", "#version 430\n"},
+                {"#version 300 es\n", "#version 310 es\n"},
+            };
+
+            shaderCode += versions[isOpenGLES][isCompute];
+        }
+    }
+
+    static const char* shaderTypeDefines[] = {
+        "#define COMPILEVS\n", // VS
+        "#define COMPILEPS\n", // PS
+        "#define COMPILEGS\n", // GS
+        "#define COMPILEHS\n", // HS
+        "#define COMPILEDS\n", // DS
+        "#define COMPILECS\n", // CS
+    };
+    shaderCode += shaderTypeDefines[desc.type_];
+
+    shaderCode += Format("#define URHO3D_{}\n", ToString(renderBackend).to_upper());
+
+    // Prepend the defines to the shader code
+    const StringVector defineVec = desc.defines_.split(' ');
+    for (const ea::string& define : defineVec)
+    {
+        const ea::string defineString = "#define " + define.replaced('=', ' ') + " \n";
+        shaderCode += defineString;
+    }
+
+    // When version define found, do not insert it a second time
+    if (!versionTag)
+        shaderCode += originalShaderCode;
+    else
+    {
+        shaderCode += originalShaderCode.substr(0, versionTag->first);
+        shaderCode += "//";
+        shaderCode += originalShaderCode.substr(versionTag->first);
+    }
+
+    return shaderCode;
+}
+
+bool ProcessShaderSource(const ShaderVariationCompileDesc& desc, ea::string_view& translatedSource,
+    const SpirVShader*& translatedSpirv, ConstByteSpan& translatedBytecode, ea::string_view originalShaderCode)
+{
+    translatedSource = originalShaderCode;
+    translatedSpirv = nullptr;
+    translatedBytecode = ToByteSpan(originalShaderCode);
+
+    const RenderBackend renderBackend = desc.renderBackend_;
+    const TargetShaderLanguage targetShaderLanguage = GetTargetShaderLanguage(renderBackend);
+    const bool needShaderTranslation = NeedShaderTranslation(desc);
+    const bool needShaderOptimization = NeedShaderOptimization(desc);
+
+#ifdef URHO3D_SHADER_TRANSLATOR
+    if (needShaderTranslation)
+    {
+        static thread_local SpirVShader spirvShader;
+        ParseUniversalShader(spirvShader, desc.type_, originalShaderCode, {}, targetShaderLanguage);
+        if (!spirvShader)
+        {
+            URHO3D_LOGERROR("Failed to convert shader {} from GLSL to SPIR-V:\n{}{}", GetShaderVariationName(desc),
+                GetShaderFileListIfAvailable(), spirvShader.compilerOutput_);
+            return false;
+        }
+
+        translatedSpirv = &spirvShader;
+
+    #ifdef URHO3D_SHADER_OPTIMIZER
+        if (needShaderOptimization)
+        {
+            ea::string optimizerOutput;
+            if (!OptimizeSpirVShader(spirvShader, optimizerOutput, targetShaderLanguage))
+            {
+                URHO3D_LOGERROR("Failed to optimize SPIR-V shader {}:\n{}", GetShaderVariationName(desc), optimizerOutput);
+                return false;
+            }
+        }
+    #endif
+
+        // Vulkan uses SPIRV directly
+        if (targetShaderLanguage == TargetShaderLanguage::VULKAN_1_0)
+        {
+            translatedBytecode = ToByteSpan(spirvShader.bytecode_);
+        }
+        else
+        {
+            // Translate to target language
+            static thread_local TargetShader targetShader;
+            TranslateSpirVShader(targetShader, spirvShader, targetShaderLanguage);
+            if (!targetShader)
+            {
+                URHO3D_LOGERROR("Failed to convert shader {} from SPIR-V to HLSL:\n{}{}", GetShaderVariationName(desc),
+                    GetShaderFileListIfAvailable(), targetShader.compilerOutput_);
+                return false;
+            }
+
+            translatedSource = targetShader.sourceCode_;
+            if (renderBackend == RenderBackend::D3D11 || renderBackend == RenderBackend::D3D12)
+            {
+                // On D3D backends, compile the translated source code
+                static thread_local ByteVector hlslBytecode;
+                ea::string compilerOutput;
+                if (!CompileHLSLToBinary(hlslBytecode, compilerOutput, targetShader.sourceCode_, desc.type_))
+                {
+                    URHO3D_LOGERROR("Failed to compile HLSL shader {}:\n{}{}", GetShaderVariationName(desc),
+                        GetShaderFileListIfAvailable(), compilerOutput);
+                    return false;
+                }
+
+                translatedBytecode = hlslBytecode;
+            }
+            else
+            {
+                // On OpenGL backends, just store the translated source code
+                translatedBytecode = ToByteSpan(targetShader.sourceCode_);
+            }
+        }
+    }
+#endif
+
+    return true;
+}
+
 } // namespace
 
 ShaderVariation::ShaderVariation(Shader* owner, ShaderType type, const ea::string& defines)
@@ -99,6 +269,8 @@ ShaderVariation::ShaderVariation(Shader* owner, ShaderType type, const ea::strin
     , defines_(defines)
 {
     SetDebugName(GetShaderVariationName());
+    if (graphics_)
+        graphics_->GetShaderCacheManifest()->AddVariation(owner->GetName(), type, defines_);
     Create();
 
     owner->OnReloaded.Subscribe(this, &ShaderVariation::OnReloaded);
@@ -134,12 +306,13 @@ bool ShaderVariation::Create()
 
     const GraphicsSettings& settings = graphics_->GetSettings();
     const FileIdentifier& cacheDir = settings.shaderCacheDir_;
-    const FileIdentifier binaryShaderName = cacheDir + GetCachedVariationName("bytecode");
+    const ea::string binaryShaderCachedName = GetCachedVariationName("bytecode");
+    const FileIdentifier binaryShaderName = cacheDir + binaryShaderCachedName;
 
     if (!LoadByteCode(binaryShaderName))
     {
-        // Compile shader if don't have valid bytecode
-        if (!CompileFromSource())
+        // Compile shader if don't have valid bytecode, unless it was already compiled by prewarming
+        if (!CreateFromPrewarmedByteCode(binaryShaderCachedName) && !CompileFromSource())
         {
             // Notify everyone if compilation failed
             CreateFromBinary({GetShaderType()});
@@ -154,36 +327,59 @@ bool ShaderVariation::Create()
     return true;
 }
 
-bool ShaderVariation::CompileFromSource()
+ShaderVariationCompileDesc ShaderVariation::GetCompileDesc() const
+{
+    ShaderVariationCompileDesc desc;
+    desc.shaderName_ = GetShaderName();
+    desc.type_ = GetShaderType();
+    desc.defines_ = defines_;
+    desc.sourceCode_ = owner_ ? owner_->GetSourceCode() : EMPTY_STRING;
+    desc.renderBackend_ = graphics_->GetRenderBackend();
+    desc.translationPolicy_ = graphics_->GetSettings().shaderTranslationPolicy_;
+    return desc;
+}
+
+bool ShaderVariation::CompileBytecode(
+    ShaderBytecode& bytecode, ea::string& translatedSource, const ShaderVariationCompileDesc& desc)
 {
-    const ea::string& originalShaderCode = owner_->GetSourceCode();
-    const ea::string sourceCode = PrepareGLSLShaderCode(originalShaderCode);
+    const ea::string sourceCode = PrepareGLSLShaderCode(desc, desc.sourceCode_);
 
-    ea::string_view translatedSource;
+    ea::string_view translatedSourceView;
     const SpirVShader* translatedSpirv{};
     ConstByteSpan translatedBytecode;
-    const bool processed = ProcessShaderSource(translatedSource, translatedSpirv, translatedBytecode, sourceCode);
-
-    const FileIdentifier& cacheDir = graphics_->GetSettings().shaderCacheDir_;
-    const FileIdentifier loggedSourceShaderName = cacheDir + GetCachedVariationName("glsl");
-    LogShaderSource(loggedSourceShaderName, defines_, translatedSource);
+    const bool processed =
+        ProcessShaderSource(desc, translatedSourceView, translatedSpirv, translatedBytecode, sourceCode);
 
+    translatedSource = translatedSourceView;
     if (!processed)
         return false;
 
-    const RenderBackend renderBackend = graphics_->GetRenderBackend();
-
-    ShaderBytecode bytecode;
-    bytecode.type_ = GetShaderType();
-    bytecode.mime_ = GetCompiledShaderMIME(renderBackend);
+    bytecode.type_ = desc.type_;
+    bytecode.mime_ = GetCompiledShaderMIME(desc.renderBackend_);
     bytecode.bytecode_.assign(translatedBytecode.begin(), translatedBytecode.end());
-    if (translatedSpirv && GetShaderType() == VS)
+    bytecode.vertexAttributes_.clear();
+    if (translatedSpirv && desc.type_ == VS)
         bytecode.vertexAttributes_ = GetVertexAttributesFromSpirV(*translatedSpirv);
+    return true;
+}
+
+bool ShaderVariation::CompileFromSource()
+{
+    ShaderBytecode bytecode;
+    ea::string translatedSource;
+    const bool compiled = CompileBytecode(bytecode, translatedSource, GetCompileDesc());
+
+    const FileIdentifier& cacheDir = graphics_->GetSettings().shaderCacheDir_;
+    const FileIdentifier loggedSourceShaderName = cacheDir + GetCachedVariationName("glsl");
+    LogShaderSource(loggedSourceShaderName, defines_, translatedSource);
+
+    if (!compiled)
+        return false;
 
     CreateFromBinary(bytecode);
     if (!GetHandle())
     {
-        if (renderBackend == RenderBackend::OpenGL)
+        if (graphics_->GetRenderBackend() == RenderBackend::OpenGL)
             URHO3D_LOGINFO("Shader files:\n{}", Shader::GetShaderFileList());
         return false;
     }
@@ -191,6 +387,17 @@ bool ShaderVariation::CompileFromSource()
     return true;
 }
 
+bool ShaderVariation::CreateFromPrewarmedByteCode(const ea::string& cachedName)
+{
+    ShaderBytecode bytecode;
+    const unsigned sourceHash = MakeHash(owner_->GetSourceCode());
+    if (!graphics_->GetShaderCacheManifest()->TakePrewarmedBytecode(cachedName, sourceHash, bytecode))
+        return false;
+
+    CreateFromBinary(bytecode);
+    return !!GetHandle();
+}
+
 bool ShaderVariation::LoadByteCode(const FileIdentifier& binaryShaderName)
 {
     Context* context = Context::GetInstance();
@@ -244,170 +451,17 @@ void ShaderVariation::SaveByteCode(const FileIdentifier& binaryShaderName)
 
 ea::string ShaderVariation::GetCachedVariationName(ea::string_view extension) const
 {
-    const ea::string backendName = ToString(graphics_->GetRenderBackend()).to_lower();
-    const ea::string shortName = owner_->GetShaderName();
-    const ea::string shaderTypeName = ToString(GetShaderType()).to_lower();
-    const StringHash definesHash{defines_};
-    return Format("{}_{}_{}_{}.{}", shortName, shaderTypeName, definesHash.ToString(), backendName, extension);
-}
-
-bool ShaderVariation::NeedShaderTranslation() const
-{
-    const ShaderTranslationPolicy policy = graphics_->GetSettings().shaderTranslationPolicy_;
-    return policy != ShaderTranslationPolicy::Verbatim;
-}
-
-bool ShaderVariation::NeedShaderOptimization() const
-{
-    const ShaderTranslationPolicy policy = graphics_->GetSettings().shaderTranslationPolicy_;
-    return policy == ShaderTranslationPolicy::Optimize;
-}
-
-ea::string ShaderVariation::PrepareGLSLShaderCode(const ea::string& originalShaderCode) const
-{
-    ea::string shaderCode;
-
-    const RenderBackend renderBackend = graphics_->GetRenderBackend();
-    const bool skipVersionTag = NeedShaderTranslation();
-
-    // Check if the shader code contains a version define
-    const auto versionTag = FindVersionTag(originalShaderCode);
-    if (!skipVersionTag)
-    {
-        if (versionTag)
-        {
-            // If version define found, insert it first
-            const ea::string versionDefine =
-                originalShaderCode.substr(versionTag->first, versionTag->second - versionTag->first);
-            shaderCode += versionDefine + "\n";
-        }
-        else
-        {
-            const bool isOpenGLES = IsOpenGLESBackend(renderBackend);
-            const bool isCompute = GetShaderType() == CS;
-
-            static const char* versions[2][2] = {
-                {"#version 410\n", "#version 430\n"},
-                {"#version 300 es\n", "#version 310 es\n"},
-            };
-
-            shaderCode += versions[isOpenGLES][isCompute];
-        }
-    }
-
-    static const char* shaderTypeDefines[] = {
-        "#define COMPILEVS\n", // VS
-        "#define COMPILEPS\n", // PS
-        "#define COMPILEGS\n", // GS
-        "#define COMPILEHS\n", // HS
-        "#define COMPILEDS\n", // DS
-        "#define COMPILECS\n", // CS
-    };
-    shaderCode += shaderTypeDefines[GetShaderType()];
-
-    shaderCode += Format("#define URHO3D_{}\n", ToString(renderBackend).to_upper());
-
-    // Prepend the defines to the shader code
-    const StringVector defineVec = defines_.split(' ');
-    for (const ea::string& define : defineVec)
-    {
-        const ea::string defineString = "#define " + define.replaced('=', ' ') + " \n";
-        shaderCode += defineString;
-    }
-
-    // When version define found, do not insert it a second time
-    if (!versionTag)
-        shaderCode += originalShaderCode;
-    else
-    {
-        shaderCode += originalShaderCode.substr(0, versionTag->first);
-        shaderCode += "//";
-        shaderCode += originalShaderCode.substr(versionTag->first);
-    }
-
-    return shaderCode;
+    return GetCachedVariationName(
+        owner_->GetShaderName(), GetShaderType(), defines_, graphics_->GetRenderBackend(), extension);
 }
 
-bool ShaderVariation::ProcessShaderSource(ea::string_view& translatedSource, const SpirVShader*& translatedSpirv,
-    ConstByteSpan& translatedBytecode, ea::string_view originalShaderCode)
+ea::string ShaderVariation::GetCachedVariationName(ea::string_view shaderName, ShaderType type,
+    ea::string_view defines, RenderBackend renderBackend, ea::string_view extension)
 {
-    translatedSource = originalShaderCode;
-    translatedSpirv = nullptr;
-    translatedBytecode = ToByteSpan(originalShaderCode);
-
-    const RenderBackend renderBackend = graphics_->GetRenderBackend();
-    const TargetShaderLanguage targetShaderLanguage = GetTargetShaderLanguage(renderBackend);
-    const bool needShaderTranslation = NeedShaderTranslation();
-    const bool needShaderOptimization = NeedShaderOptimization();
-
-#ifdef URHO3D_SHADER_TRANSLATOR
-    if (needShaderTranslation)
-    {
-        static thread_local SpirVShader spirvShader;
-        ParseUniversalShader(spirvShader, GetShaderType(), originalShaderCode, {}, targetShaderLanguage);
-        if (!spirvShader)
-        {
-            URHO3D_LOGERROR("Failed to convert shader {} from GLSL to SPIR-V:\n{}{}", GetShaderVariationName(),
-                Shader::GetShaderFileList(), spirvShader.compilerOutput_);
-            return false;
-        }
-
-        translatedSpirv = &spirvShader;
-
-    #ifdef URHO3D_SHADER_OPTIMIZER
-        if (needShaderOptimization)
-        {
-            ea::string optimizerOutput;
-            if (!OptimizeSpirVShader(spirvShader, optimizerOutput, targetShaderLanguage))
-            {
-                URHO3D_LOGERROR("Failed to optimize SPIR-V shader {}:\n{}", GetShaderVariationName(), optimizerOutput);
-                return false;
-            }
-        }
-    #endif
-
-        // Vulkan uses SPIRV directly
-        if (targetShaderLanguage == TargetShaderLanguage::VULKAN_1_0)
-        {
-            translatedBytecode = ToByteSpan(spirvShader.bytecode_);
-        }
-        else
-        {
-            // Translate to target language
-            static thread_local TargetShader targetShader;
-            TranslateSpirVShader(targetShader, spirvShader, targetShaderLanguage);
-            if (!targetShader)
-            {
-                URHO3D_LOGERROR("Failed to convert shader {} from SPIR-V to HLSL:\n{}{}", GetShaderVariationName(),
-                    Shader::GetShaderFileList(), targetShader.compilerOutput_);
-                return false;
-            }
-
-            translatedSource = targetShader.sourceCode_;
-            if (renderBackend == RenderBackend::D3D11 || renderBackend == RenderBackend::D3D12)
-            {
-                // On D3D backends, compile the translated source code
-                static thread_local ByteVector hlslBytecode;
-                ea::string compilerOutput;
-                if (!CompileHLSLToBinary(hlslBytecode, compilerOutput, targetShader.sourceCode_, GetShaderType()))
-                {
-                    URHO3D_LOGERROR("Failed to compile HLSL shader {}:\n{}{}", GetShaderVariationName(),
-                        Shader::GetShaderFileList(), compilerOutput);
-                    return false;
-                }
-
-                translatedBytecode = hlslBytecode;
-            }
-            else
-            {
-                // On OpenGL backends, just store the translated source code
-                translatedBytecode = ToByteSpan(targetShader.sourceCode_);
-            }
-        }
-    }
-#endif
-
-    return true;
+    const ea::string backendName = ToString(renderBackend).to_lower();
+    const ea::string shaderTypeName = ToString(type).to_lower();
+    const StringHash definesHash{defines};
+    return Format("{}_{}_{}_{}.{}", shaderName, shaderTypeName, definesHash.ToString(), backendName, extension);
 }
 
 } // namespace Urho3D
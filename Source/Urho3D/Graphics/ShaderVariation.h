@@ -40,6 +40,20 @@ class Shader;
 struct FileIdentifier;
 struct SpirVShader;
 
+/// Everything needed to compile shader variation without access to Graphics and Shader objects.
+struct ShaderVariationCompileDesc
+{
+    /// Shader name, used for logging only.
+    ea::string shaderName_;
+    ShaderType type_{};
+    /// Normalized defines separated by spaces.
+    ea::string defines_;
+    /// Shader source code with resolved includes.
+    ea::string sourceCode_;
+    RenderBackend renderBackend_{};
+    ShaderTranslationPolicy translationPolicy_{};
+};
+
 /// Vertex or pixel shader on the GPU.
 class URHO3D_API ShaderVariation
     : public RawShader
@@ -53,19 +67,24 @@ public:
     ea::string GetShaderVariationName() const;
     /// Return defines used to create the shader.
     const ea::string& GetDefines() const { return defines_; }
+    /// Return description of the variation compilation.
+    ShaderVariationCompileDesc GetCompileDesc() const;
+
+    /// Compile shader bytecode from source code. Safe to call from any thread.
+    /// Translated source code is returned if available, even if compilation has failed.
+    static bool CompileBytecode(
+        ShaderBytecode& bytecode, ea::string& translatedSource, const ShaderVariationCompileDesc& desc);
+    /// Return file name of cached shader variation within shader cache directory.
+    static ea::string GetCachedVariationName(ea::string_view shaderName, ShaderType type, ea::string_view defines,
+        RenderBackend renderBackend, ea::string_view extension);
 
 private:
     ea::string GetCachedVariationName(ea::string_view extension) const;
-    bool NeedShaderTranslation() const;
-    bool NeedShaderOptimization() const;
-
-    ea::string PrepareGLSLShaderCode(const ea::string& originalShaderCode) const;
-    bool ProcessShaderSource(ea::string_view& translatedSource, const SpirVShader*& translatedSpirv,
-        ConstByteSpan& translatedBytecode, ea::string_view originalShaderCode);
 
     void OnReloaded();
     bool Create();
     bool CompileFromSource();
+    bool CreateFromPrewarmedByteCode(const ea::string& cachedName);
     bool LoadByteCode(const FileIdentifier& binaryShaderName);
     void SaveByteCode(const FileIdentifier& binaryShaderName);
 
@@ -23,11 +23,13 @@
 #include "../Precompiled.h"
 
 #include "../Core/Context.h"
+#include "../Core/WorkQueue.h"
 #include "../IO/Log.h"
 #include "../Graphics/Geometry.h"
 #include "../Graphics/IndexBuffer.h"
 #include "../Graphics/SoftwareModelAnimator.h"
 #include "../Graphics/VertexBuffer.h"
+#include "../Math/BatchMath.h"
 
 #include <EASTL/sort.h>
 
@@ -39,13 +41,61 @@ namespace Urho3D
 namespace
 {
 
-Vector3 TransformNormal(const Matrix3x4& m, const Vector3& v)
+/// Return size of one vertex in morph data: vertex index followed by deltas of morphed elements.
+unsigned GetMorphVertexStride(VertexMaskFlags elementMask)
 {
-    return {
-        m.m00_ * v.x_ + m.m01_ * v.y_ + m.m02_ * v.z_,
-        m.m10_ * v.x_ + m.m11_ * v.y_ + m.m12_ * v.z_,
-        m.m20_ * v.x_ + m.m21_ * v.y_ + m.m22_ * v.z_
-    };
+    unsigned stride = sizeof(unsigned);
+    if (elementMask & MASK_POSITION)
+        stride += sizeof(Vector3);
+    if (elementMask & MASK_NORMAL)
+        stride += sizeof(Vector3);
+    if (elementMask & MASK_TANGENT)
+        stride += sizeof(Vector3);
+    return stride;
+}
+
+unsigned GetMorphVertexIndex(const VertexBufferMorph& morph, unsigned stride, unsigned morphVertex)
+{
+    return *reinterpret_cast<const unsigned*>(morph.morphData_.get() + morphVertex * stride);
+}
+
+/// Return first morph vertex with index not less than given. Morph vertices should be sorted.
+unsigned FindMorphVertex(const VertexBufferMorph& morph, unsigned stride, unsigned vertexIndex)
+{
+    unsigned first = 0;
+    unsigned count = morph.vertexCount_;
+    while (count > 0)
+    {
+        const unsigned step = count / 2;
+        if (GetMorphVertexIndex(morph, stride, first + step) < vertexIndex)
+        {
+            first += step + 1;
+            count -= step + 1;
+        }
+        else
+            count = step;
+    }
+    return first;
+}
+
+bool AreMorphVerticesSorted(const VertexBufferMorph& morph)
+{
+    const unsigned stride = GetMorphVertexStride(morph.elementMask_);
+    for (unsigned i = 1; i < morph.vertexCount_; ++i)
+    {
+        if (GetMorphVertexIndex(morph, stride, i - 1) > GetMorphVertexIndex(morph, stride, i))
+            return false;
+    }
+    return true;
+}
+
+void AddMorphDelta(unsigned char* destData, const unsigned char* srcData, float weight)
+{
+    auto dest = reinterpret_cast<float*>(destData);
+    auto src = reinterpret_cast<const float*>(srcData);
+    dest[0] += src[0] * weight;
+    dest[1] += src[1] * weight;
+    dest[2] += src[2] * weight;
 }
 
 }
@@ -66,6 +116,13 @@ void SoftwareModelAnimator::Initialize(Model* model, bool skinned, unsigned numB
     numBones_ = numBones;
     CloneModelGeometries();
     InitializeAnimationData();
+
+    morphVerticesSorted_ = true;
+    for (const ModelMorph& morph : originalModel_->GetMorphs())
+    {
+        for (const auto& bufferMorph : morph.buffers_)
+            morphVerticesSorted_ = morphVerticesSorted_ && AreMorphVerticesSorted(bufferMorph.second);
+    }
 }
 
 void SoftwareModelAnimator::ResetAnimation()
@@ -113,72 +170,85 @@ void SoftwareModelAnimator::ApplySkinning(ea::span<const Matrix3x4> worldTransfo
     for (unsigned bufferIndex = 0; bufferIndex < vertexBuffers_.size(); ++bufferIndex)
     {
         VertexBuffer* clonedBuffer = vertexBuffers_[bufferIndex];
-        const VertexBufferAnimationData& animationData = vertexBuffersData_[bufferIndex];
-        if (!clonedBuffer || !animationData.hasSkeletalAnimation_)
+        if (!clonedBuffer || !vertexBuffersData_[bufferIndex].hasSkeletalAnimation_)
             continue;
 
-        if (!animationData.skinNormals_ && !animationData.skinTangents_)
-            ApplyVertexBufferSkinning<false, false>(clonedBuffer, animationData, worldTransforms);
-        else if (animationData.skinNormals_ && !animationData.skinTangents_)
-            ApplyVertexBufferSkinning<true, false>(clonedBuffer, animationData, worldTransforms);
-        else if (animationData.skinNormals_ && animationData.skinTangents_)
-            ApplyVertexBufferSkinning<true, true>(clonedBuffer, animationData, worldTransforms);
-        else
-            ApplyVertexBufferSkinning<false, true>(clonedBuffer, animationData, worldTransforms); // this is really weird case
+        ForEachVertexRange(clonedBuffer, [&](unsigned beginIndex, unsigned endIndex)
+        {
+            ApplyVertexBufferSkinning(bufferIndex, worldTransforms, beginIndex, endIndex);
+        });
     }
 }
 
-template <bool SkinNormals, bool SkinTangents>
-void SoftwareModelAnimator::ApplyVertexBufferSkinning(VertexBuffer* clonedBuffer, const VertexBufferAnimationData& animationData,
-    ea::span<const Matrix3x4> worldTransforms) const
+void SoftwareModelAnimator::Update(ea::span<const ModelMorph> morphs, ea::span<const Matrix3x4> worldTransforms)
 {
-    const unsigned clonedVertexSize = clonedBuffer->GetVertexSize();
-    const unsigned normalOffset = clonedBuffer->GetElementOffset(TYPE_VECTOR3, SEM_NORMAL);
-    const unsigned tangentOffset = clonedBuffer->GetElementOffset(TYPE_VECTOR4, SEM_TANGENT);
-
-    unsigned char* clonedBufferData = clonedBuffer->GetShadowData();
-
-    unsigned char* positionsData = clonedBufferData;
-    unsigned char* normalsData = SkinNormals ? clonedBufferData + normalOffset : nullptr;
-    unsigned char* tangentsData = SkinTangents ? clonedBufferData + tangentOffset : nullptr;
-
-    const unsigned char* indicesData = animationData.blendIndices_.data();
-    const float* weightsData = animationData.blendWeights_.data();
-
-    const unsigned numVertices = clonedBuffer->GetVertexCount();
-    Matrix3x4 matrix;
-    for (unsigned vertexIndex = 0; vertexIndex < numVertices; ++vertexIndex)
+    // Morphs can be applied to vertex ranges only if morph vertices are sorted
+    const bool applySkinning = skinned_ && !worldTransforms.empty();
+    if (!applySkinning || !morphVerticesSorted_)
     {
-        matrix = worldTransforms[indicesData[0]] * weightsData[0];
-        for (unsigned boneIndex = 1; boneIndex < numBones_; ++boneIndex)
-            matrix = matrix + worldTransforms[indicesData[boneIndex]] * weightsData[boneIndex];
+        ResetAnimation();
+        ApplyMorphs(morphs);
+        if (applySkinning)
+            ApplySkinning(worldTransforms);
+        return;
+    }
 
-        Vector3& position = *reinterpret_cast<Vector3*>(positionsData);
-        position = matrix * position;
+    // Skinned buffers are fully reset, so each vertex range is reset, morphed and skinned independently
+    for (unsigned bufferIndex = 0; bufferIndex < vertexBuffers_.size(); ++bufferIndex)
+    {
+        VertexBuffer* clonedBuffer = vertexBuffers_[bufferIndex];
+        if (!clonedBuffer)
+            continue;
 
-        if constexpr (SkinNormals)
+        VertexBuffer* originalBuffer = originalModel_->GetVertexBuffers()[bufferIndex];
+        ForEachVertexRange(clonedBuffer, [&](unsigned beginIndex, unsigned endIndex)
         {
-            Vector3& normal = *reinterpret_cast<Vector3*>(normalsData);
-            normal = TransformNormal(matrix, normal);
-        }
+            const unsigned char* sourceData = originalBuffer->GetShadowData() + beginIndex * originalBuffer->GetVertexSize();
+            unsigned char* destData = clonedBuffer->GetShadowData() + beginIndex * clonedBuffer->GetVertexSize();
+            CopyMorphVertices(destData, sourceData, endIndex - beginIndex, clonedBuffer, originalBuffer);
 
-        if constexpr (SkinTangents)
-        {
-            Vector3& tangent = *reinterpret_cast<Vector3*>(tangentsData);
-            tangent = TransformNormal(matrix, tangent);
-        }
+            for (const ModelMorph& morph : morphs)
+            {
+                if (morph.weight_ == 0.0f)
+                    continue;
 
-        // Advance
-        indicesData += numBones_;
-        weightsData += numBones_;
+                const auto bufferMorph = morph.buffers_.find(bufferIndex);
+                if (bufferMorph != morph.buffers_.end())
+                    ApplyMorph(clonedBuffer, bufferMorph->second, morph.weight_, beginIndex, endIndex);
+            }
 
-        positionsData += clonedVertexSize;
-        if constexpr (SkinNormals)
-            normalsData += clonedVertexSize;
-        if constexpr (SkinTangents)
-            tangentsData += clonedVertexSize;
+            ApplyVertexBufferSkinning(bufferIndex, worldTransforms, beginIndex, endIndex);
+        });
     }
+}
 
+template <class Callback>
+void SoftwareModelAnimator::ForEachVertexRange(VertexBuffer* buffer, const Callback& callback) const
+{
+    const unsigned numVertices = buffer->GetVertexCount();
+    if (auto workQueue = GetSubsystem<WorkQueue>())
+        ForEachParallel(workQueue, VerticesPerTask, numVertices, callback);
+    else if (numVertices > 0)
+        callback(0, numVertices);
+}
+
+void SoftwareModelAnimator::ApplyVertexBufferSkinning(unsigned bufferIndex, ea::span<const Matrix3x4> worldTransforms,
+    unsigned beginIndex, unsigned endIndex) const
+{
+    const VertexBufferAnimationData& animationData = vertexBuffersData_[bufferIndex];
+    if (!animationData.hasSkeletalAnimation_)
+        return;
+
+    // Cloned buffers contain only float elements, so offsets are converted to floats
+    VertexBuffer* clonedBuffer = vertexBuffers_[bufferIndex];
+    const unsigned vertexSize = clonedBuffer->GetVertexSize();
+    const unsigned normalOffset = animationData.skinNormals_ ? clonedBuffer->GetElementOffset(TYPE_VECTOR3, SEM_NORMAL) : 0;
+    const unsigned tangentOffset = animationData.skinTangents_ ? clonedBuffer->GetElementOffset(TYPE_VECTOR4, SEM_TANGENT) : 0;
+
+    auto vertexData = reinterpret_cast<float*>(clonedBuffer->GetShadowData() + beginIndex * vertexSize);
+    SkinVertices(worldTransforms.data(), animationData.blendIndices_.data() + beginIndex * numBones_,
+        animationData.blendWeights_.data() + beginIndex * numBones_, numBones_, vertexData,
+        vertexSize / sizeof(float), normalOffset / sizeof(float), tangentOffset / sizeof(float), endIndex - beginIndex);
 }
 
 void SoftwareModelAnimator::Commit()
@@ -440,48 +510,46 @@ void SoftwareModelAnimator::CopyMorphVertices(void* destVertexData, const void*
     }
 }
 
-void SoftwareModelAnimator::ApplyMorph(VertexBuffer* buffer, const VertexBufferMorph& morph, float weight)
+void SoftwareModelAnimator::ApplyMorph(VertexBuffer* buffer, const VertexBufferMorph& morph, float weight,
+    unsigned beginIndex, unsigned endIndex) const
 {
     const VertexMaskFlags elementMask = morph.elementMask_ & buffer->GetElementMask();
-    unsigned vertexCount = morph.vertexCount_;
-    unsigned normalOffset = buffer->GetElementOffset(SEM_NORMAL);
-    unsigned tangentOffset = buffer->GetElementOffset(SEM_TANGENT);
-    unsigned vertexSize = buffer->GetVertexSize();
+    const unsigned stride = GetMorphVertexStride(morph.elementMask_);
+    const unsigned normalOffset = buffer->GetElementOffset(SEM_NORMAL);
+    const unsigned tangentOffset = buffer->GetElementOffset(SEM_TANGENT);
+    const unsigned vertexSize = buffer->GetVertexSize();
 
-    unsigned char* srcData = morph.morphData_.get();
     unsigned char* destData = buffer->GetShadowData();
 
-    while (vertexCount--)
+    const unsigned firstMorphVertex = beginIndex != 0 ? FindMorphVertex(morph, stride, beginIndex) : 0;
+    for (unsigned morphVertex = firstMorphVertex; morphVertex < morph.vertexCount_; ++morphVertex)
     {
+        const unsigned char* srcData = morph.morphData_.get() + morphVertex * stride;
         const unsigned vertexIndex = *reinterpret_cast<const unsigned*>(srcData);
+        if (vertexIndex >= endIndex)
+            break;
+
+        unsigned char* vertexData = destData + vertexIndex * vertexSize;
         srcData += sizeof(unsigned);
 
-        if (elementMask & MASK_POSITION)
+        // Skip deltas of elements that are not present in the buffer
+        if (morph.elementMask_ & MASK_POSITION)
         {
-            auto dest = reinterpret_cast<float*>(destData + vertexIndex * vertexSize);
-            auto src = reinterpret_cast<const float*>(srcData);
-            dest[0] += src[0] * weight;
-            dest[1] += src[1] * weight;
-            dest[2] += src[2] * weight;
-            srcData += 3 * sizeof(float);
+            if (elementMask & MASK_POSITION)
+                AddMorphDelta(vertexData, srcData, weight);
+            srcData += sizeof(Vector3);
         }
-        if (elementMask & MASK_NORMAL)
+        if (morph.elementMask_ & MASK_NORMAL)
         {
-            auto dest = reinterpret_cast<float*>(destData + vertexIndex * vertexSize + normalOffset);
-            auto src = reinterpret_cast<const float*>(srcData);
-            dest[0] += src[0] * weight;
-            dest[1] += src[1] * weight;
-            dest[2] += src[2] * weight;
-            srcData += 3 * sizeof(float);
+            if (elementMask & MASK_NORMAL)
+                AddMorphDelta(vertexData + normalOffset, srcData, weight);
+            srcData += sizeof(Vector3);
         }
-        if (elementMask & MASK_TANGENT)
+        if (morph.elementMask_ & MASK_TANGENT)
         {
-            auto dest = reinterpret_cast<float*>(destData + vertexIndex * vertexSize + tangentOffset);
-            auto src = reinterpret_cast<const float*>(srcData);
-            dest[0] += src[0] * weight;
-            dest[1] += src[1] * weight;
-            dest[2] += src[2] * weight;
-            srcData += 3 * sizeof(float);
+            if (elementMask & MASK_TANGENT)
+                AddMorphDelta(vertexData + tangentOffset, srcData, weight);
+            srcData += sizeof(Vector3);
         }
     }
 }
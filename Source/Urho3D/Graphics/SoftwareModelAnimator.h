@@ -53,6 +53,8 @@ class URHO3D_API SoftwareModelAnimator : public Object
 public:
     /// Max number of bones.
     static const unsigned MaxBones = 4;
+    /// Number of vertices processed by one task of parallel update.
+    static const unsigned VerticesPerTask = 1024;
 
     /// Construct.
     explicit SoftwareModelAnimator(Context* context);
@@ -70,6 +72,10 @@ public:
     void ApplyMorphs(ea::span<const ModelMorph> morphs);
     /// Apply skinning.
     void ApplySkinning(ea::span<const Matrix3x4> worldTransforms);
+    /// Reset animation, apply morphs and apply skinning if skinned and transforms are not empty.
+    /// Vertices are processed in one pass, vertex ranges of skinned buffers are split between worker threads.
+    /// Shall be called from main thread.
+    void Update(ea::span<const ModelMorph> morphs, ea::span<const Matrix3x4> worldTransforms);
     /// Commit data to GPU.
     void Commit();
 
@@ -89,12 +95,15 @@ private:
     /// Copy morph vertices.
     void CopyMorphVertices(void* destVertexData, const void* srcVertexData, unsigned vertexCount,
         VertexBuffer* destBuffer, VertexBuffer* srcBuffer) const;
-    /// Apply a vertex buffer morph.
-    void ApplyMorph(VertexBuffer* buffer, const VertexBufferMorph& morph, float weight);
-    /// Apply skinning for given vertex buffer.
-    template <bool SkinNormals, bool SkinTangents>
-    void ApplyVertexBufferSkinning(VertexBuffer* clonedBuffer, const VertexBufferAnimationData& animationData,
-        ea::span<const Matrix3x4> worldTransforms) const;
+    /// Apply a vertex buffer morph to vertices in range. Morph vertices should be sorted unless the range is full.
+    void ApplyMorph(VertexBuffer* buffer, const VertexBufferMorph& morph, float weight,
+        unsigned beginIndex = 0, unsigned endIndex = M_MAX_UNSIGNED) const;
+    /// Apply skinning to vertices in range of given vertex buffer.
+    void ApplyVertexBufferSkinning(unsigned bufferIndex, ea::span<const Matrix3x4> worldTransforms,
+        unsigned beginIndex, unsigned endIndex) const;
+    /// Process vertex ranges of the buffer in worker threads.
+    template <class Callback>
+    void ForEachVertexRange(VertexBuffer* buffer, const Callback& callback) const;
 
     /// Original model.
     SharedPtr<Model> originalModel_;
@@ -109,6 +118,8 @@ private:
     unsigned numBones_{};
     /// Animation data for vertex buffers.
     ea::vector<VertexBufferAnimationData> vertexBuffersData_;
+    /// Whether the vertices of all model morphs are sorted by index, so the morphs can be applied to vertex ranges.
+    bool morphVerticesSorted_{};
 };
 
 }
@@ -182,8 +182,12 @@ public:
         return indexAndData.first;
     }
 
+    /// Return writeable data of already allocated vertex. Safe to call from multiple threads.
+    unsigned char* GetVertexData(unsigned index) { return shadowData_.data() + index * vertexSize_; }
+
     VertexBuffer* GetVertexBuffer() const { return vertexBuffer_; }
     unsigned GetVertexCount() const { return numVertices_; }
+    unsigned GetVertexSize() const { return vertexSize_; }
 
     void SetDebugName(const ea::string& debugName) { vertexBuffer_->SetDebugName(debugName); }
 
@@ -0,0 +1,372 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../Precompiled.h"
+
+#include "../Math/BatchMath.h"
+
+#include "../Math/BatchMathKernels.h"
+
+#include <SDL_cpuinfo.h>
+
+#include "../DebugNew.h"
+
+namespace Urho3D
+{
+
+static_assert(sizeof(Vector3) == 3 * sizeof(float), "Unexpected Vector3 layout");
+static_assert(sizeof(Matrix3x4) == 12 * sizeof(float), "Unexpected Matrix3x4 layout");
+static_assert(sizeof(BoundingBox) == 8 * sizeof(float), "Unexpected BoundingBox layout");
+
+namespace
+{
+
+BatchMathInstructionSet DetectInstructionSet()
+{
+#if URHO3D_BATCH_MATH_NEON
+    return BatchMathInstructionSet::NEON;
+#elif URHO3D_BATCH_MATH_AVX2
+    if (SDL_HasAVX2())
+        return BatchMathInstructionSet::AVX2;
+    return BatchMathInstructionSet::Generic;
+#else
+    return BatchMathInstructionSet::Generic;
+#endif
+}
+
+BatchMathInstructionSet& GetCurrentInstructionSet()
+{
+    static BatchMathInstructionSet instructionSet = DetectInstructionSet();
+    return instructionSet;
+}
+
+void PackFrustumPlanes(const Frustum& frustum, float planes[NUM_FRUSTUM_PLANES * 4])
+{
+    for (unsigned i = 0; i < NUM_FRUSTUM_PLANES; ++i)
+    {
+        const Plane& plane = frustum.planes_[i];
+        planes[i * 4 + 0] = plane.normal_.x_;
+        planes[i * 4 + 1] = plane.normal_.y_;
+        planes[i * 4 + 2] = plane.normal_.z_;
+        planes[i * 4 + 3] = plane.d_;
+    }
+}
+
+Vector3 TransformNormal(const Matrix3x4& matrix, const Vector3& normal)
+{
+    return Vector3{
+        matrix.m00_ * normal.x_ + matrix.m01_ * normal.y_ + matrix.m02_ * normal.z_,
+        matrix.m10_ * normal.x_ + matrix.m11_ * normal.y_ + matrix.m12_ * normal.z_,
+        matrix.m20_ * normal.x_ + matrix.m21_ * normal.y_ + matrix.m22_ * normal.z_,
+    };
+}
+
+template <bool SkinNormals, bool SkinTangents>
+void SkinVerticesGeneric(const Matrix3x4* boneTransforms, const unsigned char* boneIndices, const float* boneWeights,
+    unsigned numBonesPerVertex, float* vertices, unsigned vertexStride, unsigned normalOffset, unsigned tangentOffset,
+    unsigned count)
+{
+    for (unsigned i = 0; i < count; ++i)
+    {
+        Matrix3x4 matrix = boneTransforms[boneIndices[0]] * boneWeights[0];
+        for (unsigned j = 1; j < numBonesPerVertex; ++j)
+            matrix = matrix + boneTransforms[boneIndices[j]] * boneWeights[j];
+
+        float* vertex = vertices + i * vertexStride;
+        Vector3& position = *reinterpret_cast<Vector3*>(vertex);
+        position = matrix * position;
+
+        if constexpr (SkinNormals)
+        {
+            Vector3& normal = *reinterpret_cast<Vector3*>(vertex + normalOffset);
+            normal = TransformNormal(matrix, normal);
+        }
+
+        if constexpr (SkinTangents)
+        {
+            Vector3& tangent = *reinterpret_cast<Vector3*>(vertex + tangentOffset);
+            tangent = TransformNormal(matrix, tangent);
+        }
+
+        boneIndices += numBonesPerVertex;
+        boneWeights += numBonesPerVertex;
+    }
+}
+
+void TestBoundingBoxesInFrustumGeneric(const Frustum& frustum, const BoundingBox* boxes, bool* visible, unsigned count)
+{
+    unsigned i = 0;
+#ifdef URHO3D_SSE
+    const __m128 half = _mm_set1_ps(0.5f);
+    const __m128 signMask = _mm_castsi128_ps(_mm_set1_epi32(0x80000000));
+
+    for (; i + 4 <= count; i += 4)
+    {
+        // Boxes are min, padding, max, padding: transpose 4 mins and 4 maxs into XYZ rows
+        const float* data = reinterpret_cast<const float*>(boxes + i);
+        __m128 min0 = _mm_loadu_ps(data + 0);
+        __m128 min1 = _mm_loadu_ps(data + 8);
+        __m128 min2 = _mm_loadu_ps(data + 16);
+        __m128 min3 = _mm_loadu_ps(data + 24);
+        __m128 max0 = _mm_loadu_ps(data + 4);
+        __m128 max1 = _mm_loadu_ps(data + 12);
+        __m128 max2 = _mm_loadu_ps(data + 20);
+        __m128 max3 = _mm_loadu_ps(data + 28);
+        _MM_TRANSPOSE4_PS(min0, min1, min2, min3);
+        _MM_TRANSPOSE4_PS(max0, max1, max2, max3);
+
+        const __m128 centerX = _mm_mul_ps(_mm_add_ps(max0, min0), half);
+        const __m128 centerY = _mm_mul_ps(_mm_add_ps(max1, min1), half);
+        const __m128 centerZ = _mm_mul_ps(_mm_add_ps(max2, min2), half);
+        const __m128 edgeX = _mm_sub_ps(centerX, min0);
+        const __m128 edgeY = _mm_sub_ps(centerY, min1);
+        const __m128 edgeZ = _mm_sub_ps(centerZ, min2);
+
+        __m128 outside = _mm_setzero_ps();
+        for (const Plane& plane : frustum.planes_)
+        {
+            const __m128 dist = _mm_add_ps(_mm_add_ps(_mm_add_ps(
+                _mm_mul_ps(_mm_set1_ps(plane.normal_.x_), centerX), _mm_mul_ps(_mm_set1_ps(plane.normal_.y_), centerY)),
+                _mm_mul_ps(_mm_set1_ps(plane.normal_.z_), centerZ)), _mm_set1_ps(plane.d_));
+            const __m128 absDist = _mm_add_ps(_mm_add_ps(
+                _mm_mul_ps(_mm_set1_ps(plane.absNormal_.x_), edgeX), _mm_mul_ps(_mm_set1_ps(plane.absNormal_.y_), edgeY)),
+                _mm_mul_ps(_mm_set1_ps(plane.absNormal_.z_), edgeZ));
+
+            outside = _mm_or_ps(outside, _mm_cmplt_ps(dist, _mm_xor_ps(absDist, signMask)));
+        }
+
+        const int outsideMask = _mm_movemask_ps(outside);
+        for (unsigned j = 0; j < 4; ++j)
+            visible[i + j] = ((outsideMask >> j) & 1) == 0;
+    }
+#endif
+
+    for (; i < count; ++i)
+        visible[i] = frustum.IsInsideFast(boxes[i]) != OUTSIDE;
+}
+
+}
+
+BatchMathInstructionSet GetBatchMathInstructionSet()
+{
+    return GetCurrentInstructionSet();
+}
+
+bool IsBatchMathInstructionSetSupported(BatchMathInstructionSet instructionSet)
+{
+    switch (instructionSet)
+    {
+    case BatchMathInstructionSet::Generic:
+        return true;
+    case BatchMathInstructionSet::AVX2:
+#if URHO3D_BATCH_MATH_AVX2
+        return SDL_HasAVX2();
+#else
+        return false;
+#endif
+    case BatchMathInstructionSet::NEON:
+#if URHO3D_BATCH_MATH_NEON
+        return true;
+#else
+        return false;
+#endif
+    default:
+        return false;
+    }
+}
+
+void SetBatchMathInstructionSet(BatchMathInstructionSet instructionSet)
+{
+    if (IsBatchMathInstructionSetSupported(instructionSet))
+        GetCurrentInstructionSet() = instructionSet;
+}
+
+void TransformPoints(const Matrix3x4& transform, const Vector3* source, Vector3* dest, unsigned count)
+{
+    switch (GetCurrentInstructionSet())
+    {
+#if URHO3D_BATCH_MATH_AVX2
+    case BatchMathInstructionSet::AVX2:
+        BatchMathKernels::TransformPointsAVX2(
+            transform.Data(), reinterpret_cast<const float*>(source), reinterpret_cast<float*>(dest), count);
+        return;
+#endif
+#if URHO3D_BATCH_MATH_NEON
+    case BatchMathInstructionSet::NEON:
+        BatchMathKernels::TransformPointsNEON(
+            transform.Data(), reinterpret_cast<const float*>(source), reinterpret_cast<float*>(dest), count);
+        return;
+#endif
+    default:
+        for (unsigned i = 0; i < count; ++i)
+            dest[i] = transform * source[i];
+        return;
+    }
+}
+
+void MultiplyMatrices(const Matrix3x4* lhs, const Matrix3x4* rhs, Matrix3x4* dest, unsigned count)
+{
+    switch (GetCurrentInstructionSet())
+    {
+#if URHO3D_BATCH_MATH_AVX2
+    case BatchMathInstructionSet::AVX2:
+        BatchMathKernels::MultiplyMatricesAVX2(
+            reinterpret_cast<const float*>(lhs), reinterpret_cast<const float*>(rhs),
+            reinterpret_cast<float*>(dest), count);
+        return;
+#endif
+#if URHO3D_BATCH_MATH_NEON
+    case BatchMathInstructionSet::NEON:
+        BatchMathKernels::MultiplyMatricesNEON(
+            reinterpret_cast<const float*>(lhs), reinterpret_cast<const float*>(rhs),
+            reinterpret_cast<float*>(dest), count);
+        return;
+#endif
+    default:
+        for (unsigned i = 0; i < count; ++i)
+            dest[i] = lhs[i] * rhs[i];
+        return;
+    }
+}
+
+void TransformBoundingBoxes(const Matrix3x4* transforms, const BoundingBox* source, BoundingBox* dest, unsigned count)
+{
+    switch (GetCurrentInstructionSet())
+    {
+#if URHO3D_BATCH_MATH_AVX2
+    case BatchMathInstructionSet::AVX2:
+        BatchMathKernels::TransformBoundingBoxesAVX2(
+            reinterpret_cast<const float*>(transforms), reinterpret_cast<const float*>(source),
+            reinterpret_cast<float*>(dest), count);
+        return;
+#endif
+#if URHO3D_BATCH_MATH_NEON
+    case BatchMathInstructionSet::NEON:
+        BatchMathKernels::TransformBoundingBoxesNEON(
+            reinterpret_cast<const float*>(transforms), reinterpret_cast<const float*>(source),
+            reinterpret_cast<float*>(dest), count);
+        return;
+#endif
+    default:
+        for (unsigned i = 0; i < count; ++i)
+            dest[i] = source[i].Transformed(transforms[i]);
+        return;
+    }
+}
+
+BoundingBox MergeBoundingBoxes(const BoundingBox* boxes, unsigned count)
+{
+    BoundingBox result;
+    switch (GetCurrentInstructionSet())
+    {
+#if URHO3D_BATCH_MATH_AVX2
+    case BatchMathInstructionSet::AVX2:
+        BatchMathKernels::MergeBoundingBoxesAVX2(
+            reinterpret_cast<const float*>(boxes), count, reinterpret_cast<float*>(&result));
+        break;
+#endif
+#if URHO3D_BATCH_MATH_NEON
+    case BatchMathInstructionSet::NEON:
+        BatchMathKernels::MergeBoundingBoxesNEON(
+            reinterpret_cast<const float*>(boxes), count, reinterpret_cast<float*>(&result));
+        break;
+#endif
+    default:
+        for (unsigned i = 0; i < count; ++i)
+            result.Merge(boxes[i]);
+        break;
+    }
+    return result;
+}
+
+void TestBoundingBoxesInFrustum(const Frustum& frustum, const BoundingBox* boxes, bool* visible, unsigned count)
+{
+    float planes[NUM_FRUSTUM_PLANES * 4];
+    switch (GetCurrentInstructionSet())
+    {
+#if URHO3D_BATCH_MATH_AVX2
+    case BatchMathInstructionSet::AVX2:
+        PackFrustumPlanes(frustum, planes);
+        BatchMathKernels::TestBoundingBoxesInFrustumAVX2(
+            planes, NUM_FRUSTUM_PLANES, reinterpret_cast<const float*>(boxes), visible, count);
+        return;
+#endif
+#if URHO3D_BATCH_MATH_NEON
+    case BatchMathInstructionSet::NEON:
+        PackFrustumPlanes(frustum, planes);
+        BatchMathKernels::TestBoundingBoxesInFrustumNEON(
+            planes, NUM_FRUSTUM_PLANES, reinterpret_cast<const float*>(boxes), visible, count);
+        return;
+#endif
+    default:
+        TestBoundingBoxesInFrustumGeneric(frustum, boxes, visible, count);
+        return;
+    }
+}
+
+void SkinVertices(const Matrix3x4* boneTransforms, const unsigned char* boneIndices, const float* boneWeights,
+    unsigned numBonesPerVertex, float* vertices, unsigned vertexStride, unsigned normalOffset, unsigned tangentOffset,
+    unsigned count)
+{
+    assert(numBonesPerVertex > 0 && numBonesPerVertex <= 4);
+
+    switch (GetCurrentInstructionSet())
+    {
+#if URHO3D_BATCH_MATH_AVX2
+    case BatchMathInstructionSet::AVX2:
+        BatchMathKernels::SkinVerticesAVX2(reinterpret_cast<const float*>(boneTransforms), boneIndices, boneWeights,
+            numBonesPerVertex, vertices, vertexStride, normalOffset, tangentOffset, count);
+        return;
+#endif
+#if URHO3D_BATCH_MATH_NEON
+    case BatchMathInstructionSet::NEON:
+        BatchMathKernels::SkinVerticesNEON(reinterpret_cast<const float*>(boneTransforms), boneIndices, boneWeights,
+            numBonesPerVertex, vertices, vertexStride, normalOffset, tangentOffset, count);
+        return;
+#endif
+    default:
+        if (normalOffset && tangentOffset)
+        {
+            SkinVerticesGeneric<true, true>(boneTransforms, boneIndices, boneWeights, numBonesPerVertex, vertices,
+                vertexStride, normalOffset, tangentOffset, count);
+        }
+        else if (normalOffset)
+        {
+            SkinVerticesGeneric<true, false>(boneTransforms, boneIndices, boneWeights, numBonesPerVertex, vertices,
+                vertexStride, normalOffset, tangentOffset, count);
+        }
+        else if (tangentOffset)
+        {
+            SkinVerticesGeneric<false, true>(boneTransforms, boneIndices, boneWeights, numBonesPerVertex, vertices,
+                vertexStride, normalOffset, tangentOffset, count);
+        }
+        else
+        {
+            SkinVerticesGeneric<false, false>(boneTransforms, boneIndices, boneWeights, numBonesPerVertex, vertices,
+                vertexStride, normalOffset, tangentOffset, count);
+        }
+        return;
+    }
+}
+
+}
@@ -0,0 +1,73 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+/// \file
+
+#pragma once
+
+#include "../Math/BoundingBox.h"
+#include "../Math/Frustum.h"
+#include "../Math/Matrix3x4.h"
+
+namespace Urho3D
+{
+
+/// Instruction set used by batch math functions.
+enum class BatchMathInstructionSet
+{
+    /// Portable implementation on top of math classes. Uses SSE if the engine is built with it.
+    Generic,
+    /// AVX2 kernels. Selected if supported by the CPU.
+    AVX2,
+    /// NEON kernels. Always selected on AArch64, not available on 32-bit ARM.
+    NEON
+};
+
+/// Return instruction set currently used by batch math functions.
+URHO3D_API BatchMathInstructionSet GetBatchMathInstructionSet();
+/// Return whether the instruction set is supported by the build and the CPU.
+URHO3D_API bool IsBatchMathInstructionSetSupported(BatchMathInstructionSet instructionSet);
+/// Override instruction set used by batch math functions. Unsupported instruction sets are ignored.
+/// Should be used for testing only.
+URHO3D_API void SetBatchMathInstructionSet(BatchMathInstructionSet instructionSet);
+
+/// Transform points by the matrix. Source and destination may be the same array.
+URHO3D_API void TransformPoints(const Matrix3x4& transform, const Vector3* source, Vector3* dest, unsigned count);
+/// Multiply pairs of matrices. Destination may be the same array as one of the sources.
+URHO3D_API void MultiplyMatrices(const Matrix3x4* lhs, const Matrix3x4* rhs, Matrix3x4* dest, unsigned count);
+/// Transform each bounding box by the corresponding matrix. Source and destination may be the same array.
+URHO3D_API void TransformBoundingBoxes(
+    const Matrix3x4* transforms, const BoundingBox* source, BoundingBox* dest, unsigned count);
+/// Return bounding box that contains all bounding boxes.
+URHO3D_API BoundingBox MergeBoundingBoxes(const BoundingBox* boxes, unsigned count);
+/// Test bounding boxes against the frustum. Same as Frustum::IsInsideFast, but returns whether the box is not OUTSIDE.
+URHO3D_API void TestBoundingBoxesInFrustum(const Frustum& frustum, const BoundingBox* boxes, bool* visible, unsigned count);
+/// Skin vertices in place by blending bone transforms with weights, up to 4 bones per vertex.
+/// Vertices are interleaved with given stride in floats. Position is at the start of the vertex.
+/// Normal and tangent are at given offsets in floats, zero if the element should not be skinned.
+/// Only XYZ components of vertex elements are transformed.
+URHO3D_API void SkinVertices(const Matrix3x4* boneTransforms, const unsigned char* boneIndices, const float* boneWeights,
+    unsigned numBonesPerVertex, float* vertices, unsigned vertexStride, unsigned normalOffset, unsigned tangentOffset,
+    unsigned count);
+
+}
@@ -0,0 +1,398 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+// This file is compiled with AVX2 enabled. Don't include engine headers here,
+// otherwise inline functions from them may be compiled with AVX2 instructions.
+#include "../Math/BatchMathKernels.h"
+
+#if URHO3D_BATCH_MATH_AVX2
+
+#include <immintrin.h>
+
+namespace Urho3D
+{
+
+namespace BatchMathKernels
+{
+
+namespace
+{
+
+/// Return absolute value of the float.
+inline float AbsFloat(float value)
+{
+    return value < 0.0f ? -value : value;
+}
+
+/// Transform single point. Used for the tail of the array.
+inline void TransformPoint(const float* m, const float* source, float* dest)
+{
+    const float x = source[0];
+    const float y = source[1];
+    const float z = source[2];
+    dest[0] = m[0] * x + m[1] * y + m[2] * z + m[3];
+    dest[1] = m[4] * x + m[5] * y + m[6] * z + m[7];
+    dest[2] = m[8] * x + m[9] * y + m[10] * z + m[11];
+}
+
+/// Return linear part of the transform applied to XYZ of the vector. Matrix is passed in columns.
+inline __m128 TransformDirection(__m128 col0, __m128 col1, __m128 col2, const float* source)
+{
+    return _mm_add_ps(_mm_add_ps(
+        _mm_mul_ps(col0, _mm_set1_ps(source[0])), _mm_mul_ps(col1, _mm_set1_ps(source[1]))),
+        _mm_mul_ps(col2, _mm_set1_ps(source[2])));
+}
+
+/// Store XYZ components of the vector.
+inline void StoreVector3(float* dest, __m128 value)
+{
+    _mm_storel_pi(reinterpret_cast<__m64*>(dest), value);
+    _mm_store_ss(dest + 2, _mm_movehl_ps(value, value));
+}
+
+/// Skin vertices with blended bone transforms. Bone matrix rows 0-1 are blended in one register.
+template <bool SkinNormals, bool SkinTangents>
+void SkinVerticesImpl(const float* boneTransforms, const unsigned char* boneIndices, const float* boneWeights,
+    unsigned numBonesPerVertex, float* vertices, unsigned vertexStride, unsigned normalOffset, unsigned tangentOffset,
+    unsigned count)
+{
+    for (unsigned i = 0; i < count; ++i)
+    {
+        const float* bone = boneTransforms + boneIndices[0] * 12;
+        __m256 weight = _mm256_broadcast_ss(&boneWeights[0]);
+        __m256 rows01 = _mm256_mul_ps(_mm256_loadu_ps(bone), weight);
+        __m128 row2 = _mm_mul_ps(_mm_loadu_ps(bone + 8), _mm256_castps256_ps128(weight));
+        for (unsigned j = 1; j < numBonesPerVertex; ++j)
+        {
+            bone = boneTransforms + boneIndices[j] * 12;
+            weight = _mm256_broadcast_ss(&boneWeights[j]);
+            rows01 = _mm256_add_ps(rows01, _mm256_mul_ps(_mm256_loadu_ps(bone), weight));
+            row2 = _mm_add_ps(row2, _mm_mul_ps(_mm_loadu_ps(bone + 8), _mm256_castps256_ps128(weight)));
+        }
+
+        // Last column after transpose is translation
+        __m128 col0 = _mm256_castps256_ps128(rows01);
+        __m128 col1 = _mm256_extractf128_ps(rows01, 1);
+        __m128 col2 = row2;
+        __m128 col3 = _mm_setzero_ps();
+        _MM_TRANSPOSE4_PS(col0, col1, col2, col3);
+
+        float* vertex = vertices + i * vertexStride;
+        StoreVector3(vertex, _mm_add_ps(TransformDirection(col0, col1, col2, vertex), col3));
+        if constexpr (SkinNormals)
+            StoreVector3(vertex + normalOffset, TransformDirection(col0, col1, col2, vertex + normalOffset));
+        if constexpr (SkinTangents)
+            StoreVector3(vertex + tangentOffset, TransformDirection(col0, col1, col2, vertex + tangentOffset));
+
+        boneIndices += numBonesPerVertex;
+        boneWeights += numBonesPerVertex;
+    }
+}
+
+/// Transpose 8x8 matrix stored in rows.
+inline void Transpose8x8(__m256 rows[8])
+{
+    const __m256 t0 = _mm256_unpacklo_ps(rows[0], rows[1]);
+    const __m256 t1 = _mm256_unpackhi_ps(rows[0], rows[1]);
+    const __m256 t2 = _mm256_unpacklo_ps(rows[2], rows[3]);
+    const __m256 t3 = _mm256_unpackhi_ps(rows[2], rows[3]);
+    const __m256 t4 = _mm256_unpacklo_ps(rows[4], rows[5]);
+    const __m256 t5 = _mm256_unpackhi_ps(rows[4], rows[5]);
+    const __m256 t6 = _mm256_unpacklo_ps(rows[6], rows[7]);
+    const __m256 t7 = _mm256_unpackhi_ps(rows[6], rows[7]);
+
+    const __m256 s0 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0));
+    const __m256 s1 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+    const __m256 s2 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0));
+    const __m256 s3 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2));
+    const __m256 s4 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(1, 0, 1, 0));
+    const __m256 s5 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(3, 2, 3, 2));
+    const __m256 s6 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(1, 0, 1, 0));
+    const __m256 s7 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(3, 2, 3, 2));
+
+    rows[0] = _mm256_permute2f128_ps(s0, s4, 0x20);
+    rows[1] = _mm256_permute2f128_ps(s1, s5, 0x20);
+    rows[2] = _mm256_permute2f128_ps(s2, s6, 0x20);
+    rows[3] = _mm256_permute2f128_ps(s3, s7, 0x20);
+    rows[4] = _mm256_permute2f128_ps(s0, s4, 0x31);
+    rows[5] = _mm256_permute2f128_ps(s1, s5, 0x31);
+    rows[6] = _mm256_permute2f128_ps(s2, s6, 0x31);
+    rows[7] = _mm256_permute2f128_ps(s3, s7, 0x31);
+}
+
+}
+
+void TransformPointsAVX2(const float* transform, const float* source, float* dest, unsigned count)
+{
+    const __m256 m00 = _mm256_set1_ps(transform[0]);
+    const __m256 m01 = _mm256_set1_ps(transform[1]);
+    const __m256 m02 = _mm256_set1_ps(transform[2]);
+    const __m256 m03 = _mm256_set1_ps(transform[3]);
+    const __m256 m10 = _mm256_set1_ps(transform[4]);
+    const __m256 m11 = _mm256_set1_ps(transform[5]);
+    const __m256 m12 = _mm256_set1_ps(transform[6]);
+    const __m256 m13 = _mm256_set1_ps(transform[7]);
+    const __m256 m20 = _mm256_set1_ps(transform[8]);
+    const __m256 m21 = _mm256_set1_ps(transform[9]);
+    const __m256 m22 = _mm256_set1_ps(transform[10]);
+    const __m256 m23 = _mm256_set1_ps(transform[11]);
+
+    unsigned i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        const float* src = source + i * 3;
+        float* dst = dest + i * 3;
+
+        // Deinterleave 8 points into x, y and z vectors
+        __m256 p03 = _mm256_castps128_ps256(_mm_loadu_ps(src + 0));
+        __m256 p14 = _mm256_castps128_ps256(_mm_loadu_ps(src + 4));
+        __m256 p25 = _mm256_castps128_ps256(_mm_loadu_ps(src + 8));
+        p03 = _mm256_insertf128_ps(p03, _mm_loadu_ps(src + 12), 1);
+        p14 = _mm256_insertf128_ps(p14, _mm_loadu_ps(src + 16), 1);
+        p25 = _mm256_insertf128_ps(p25, _mm_loadu_ps(src + 20), 1);
+
+        const __m256 xy = _mm256_shuffle_ps(p14, p25, _MM_SHUFFLE(2, 1, 3, 2));
+        const __m256 yz = _mm256_shuffle_ps(p03, p14, _MM_SHUFFLE(1, 0, 2, 1));
+        const __m256 x = _mm256_shuffle_ps(p03, xy, _MM_SHUFFLE(2, 0, 3, 0));
+        const __m256 y = _mm256_shuffle_ps(yz, xy, _MM_SHUFFLE(3, 1, 2, 0));
+        const __m256 z = _mm256_shuffle_ps(yz, p25, _MM_SHUFFLE(3, 0, 3, 1));
+
+        // Same order of operations as in scalar code, FMA would change the result
+        const __m256 rx = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(
+            _mm256_mul_ps(m00, x), _mm256_mul_ps(m01, y)), _mm256_mul_ps(m02, z)), m03);
+        const __m256 ry = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(
+            _mm256_mul_ps(m10, x), _mm256_mul_ps(m11, y)), _mm256_mul_ps(m12, z)), m13);
+        const __m256 rz = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(
+            _mm256_mul_ps(m20, x), _mm256_mul_ps(m21, y)), _mm256_mul_ps(m22, z)), m23);
+
+        // Interleave x, y and z vectors back into points
+        const __m256 rxy = _mm256_shuffle_ps(rx, ry, _MM_SHUFFLE(2, 0, 2, 0));
+        const __m256 ryz = _mm256_shuffle_ps(ry, rz, _MM_SHUFFLE(3, 1, 3, 1));
+        const __m256 rzx = _mm256_shuffle_ps(rz, rx, _MM_SHUFFLE(3, 1, 2, 0));
+        const __m256 r03 = _mm256_shuffle_ps(rxy, rzx, _MM_SHUFFLE(2, 0, 2, 0));
+        const __m256 r14 = _mm256_shuffle_ps(ryz, rxy, _MM_SHUFFLE(3, 1, 2, 0));
+        const __m256 r25 = _mm256_shuffle_ps(rzx, ryz, _MM_SHUFFLE(3, 1, 3, 1));
+
+        _mm256_storeu_ps(dst + 0, _mm256_permute2f128_ps(r03, r14, 0x20));
+        _mm256_storeu_ps(dst + 8, _mm256_permute2f128_ps(r25, r03, 0x30));
+        _mm256_storeu_ps(dst + 16, _mm256_permute2f128_ps(r14, r25, 0x31));
+    }
+
+    for (; i < count; ++i)
+        TransformPoint(transform, source + i * 3, dest + i * 3);
+}
+
+void MultiplyMatricesAVX2(const float* lhs, const float* rhs, float* dest, unsigned count)
+{
+    const __m256 lastColumnMask = _mm256_castsi256_ps(_mm256_setr_epi32(0, 0, 0, -1, 0, 0, 0, -1));
+
+    for (unsigned i = 0; i < count; ++i)
+    {
+        const float* a = lhs + i * 12;
+        const float* b = rhs + i * 12;
+        float* d = dest + i * 12;
+
+        const __m256 b0 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(b + 0));
+        const __m256 b1 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(b + 4));
+        const __m256 b2 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(b + 8));
+
+        // First and second rows of the result
+        const __m256 a01 = _mm256_loadu_ps(a);
+        const __m256 r01 = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(
+            _mm256_mul_ps(_mm256_permute_ps(a01, _MM_SHUFFLE(0, 0, 0, 0)), b0),
+            _mm256_mul_ps(_mm256_permute_ps(a01, _MM_SHUFFLE(1, 1, 1, 1)), b1)),
+            _mm256_mul_ps(_mm256_permute_ps(a01, _MM_SHUFFLE(2, 2, 2, 2)), b2)),
+            _mm256_and_ps(a01, lastColumnMask));
+
+        // Third row of the result
+        const __m128 a2 = _mm_loadu_ps(a + 8);
+        const __m128 r2 = _mm_add_ps(_mm_add_ps(_mm_add_ps(
+            _mm_mul_ps(_mm_permute_ps(a2, _MM_SHUFFLE(0, 0, 0, 0)), _mm256_castps256_ps128(b0)),
+            _mm_mul_ps(_mm_permute_ps(a2, _MM_SHUFFLE(1, 1, 1, 1)), _mm256_castps256_ps128(b1))),
+            _mm_mul_ps(_mm_permute_ps(a2, _MM_SHUFFLE(2, 2, 2, 2)), _mm256_castps256_ps128(b2))),
+            _mm_and_ps(a2, _mm256_castps256_ps128(lastColumnMask)));
+
+        _mm256_storeu_ps(d, r01);
+        _mm_storeu_ps(d + 8, r2);
+    }
+}
+
+void TransformBoundingBoxesAVX2(const float* transforms, const float* source, float* dest, unsigned count)
+{
+    const __m128 half = _mm_set1_ps(0.5f);
+    const __m128 wOne = _mm_setr_ps(0.0f, 0.0f, 0.0f, 1.0f);
+    const __m128 xyzMask = _mm_castsi128_ps(_mm_setr_epi32(-1, -1, -1, 0));
+    const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+
+    for (unsigned i = 0; i < count; ++i)
+    {
+        const float* m = transforms + i * 12;
+        const float* src = source + i * 8;
+        float* dst = dest + i * 8;
+
+        // Padding is ignored: center has w=1 to apply translation, half size has w=0
+        const __m256 box = _mm256_loadu_ps(src);
+        const __m128 minPt = _mm_and_ps(_mm256_castps256_ps128(box), xyzMask);
+        const __m128 maxPt = _mm_and_ps(_mm256_extractf128_ps(box, 1), xyzMask);
+        const __m128 center = _mm_or_ps(_mm_mul_ps(_mm_add_ps(maxPt, minPt), half), wOne);
+        const __m128 halfSize = _mm_and_ps(_mm_sub_ps(center, minPt), xyzMask);
+
+        const __m128 m0 = _mm_loadu_ps(m + 0);
+        const __m128 m1 = _mm_loadu_ps(m + 4);
+        const __m128 m2 = _mm_loadu_ps(m + 8);
+
+        __m128 c0 = _mm_mul_ps(m0, center);
+        __m128 c1 = _mm_mul_ps(m1, center);
+        __m128 c2 = _mm_mul_ps(m2, center);
+        __m128 c3 = _mm_setzero_ps();
+        _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+        const __m128 newCenter = _mm_add_ps(_mm_add_ps(c0, c1), _mm_add_ps(c2, c3));
+
+        __m128 e0 = _mm_and_ps(_mm_mul_ps(m0, halfSize), absMask);
+        __m128 e1 = _mm_and_ps(_mm_mul_ps(m1, halfSize), absMask);
+        __m128 e2 = _mm_and_ps(_mm_mul_ps(m2, halfSize), absMask);
+        __m128 e3 = _mm_setzero_ps();
+        _MM_TRANSPOSE4_PS(e0, e1, e2, e3);
+        const __m128 newEdge = _mm_add_ps(_mm_add_ps(e0, e1), e2);
+
+        // Both vectors have w=0, so padding is zeroed
+        _mm_storeu_ps(dst + 0, _mm_sub_ps(newCenter, newEdge));
+        _mm_storeu_ps(dst + 4, _mm_add_ps(newCenter, newEdge));
+    }
+}
+
+void MergeBoundingBoxesAVX2(const float* boxes, unsigned count, float* result)
+{
+    if (count == 0)
+        return;
+
+    __m256 minAcc = _mm256_loadu_ps(result);
+    __m256 maxAcc = minAcc;
+    for (unsigned i = 0; i < count; ++i)
+    {
+        const __m256 box = _mm256_loadu_ps(boxes + i * 8);
+        minAcc = _mm256_min_ps(minAcc, box);
+        maxAcc = _mm256_max_ps(maxAcc, box);
+    }
+
+    _mm_storeu_ps(result + 0, _mm256_castps256_ps128(minAcc));
+    _mm_storeu_ps(result + 4, _mm256_extractf128_ps(maxAcc, 1));
+}
+
+void TestBoundingBoxesInFrustumAVX2(
+    const float* planes, unsigned numPlanes, const float* boxes, bool* visible, unsigned count)
+{
+    const __m256 half = _mm256_set1_ps(0.5f);
+    const __m256 absMask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7fffffff));
+    const __m256 signMask = _mm256_castsi256_ps(_mm256_set1_epi32(0x80000000));
+
+    unsigned i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        __m256 rows[8];
+        for (unsigned j = 0; j < 8; ++j)
+            rows[j] = _mm256_loadu_ps(boxes + (i + j) * 8);
+        Transpose8x8(rows);
+
+        const __m256 centerX = _mm256_mul_ps(_mm256_add_ps(rows[4], rows[0]), half);
+        const __m256 centerY = _mm256_mul_ps(_mm256_add_ps(rows[5], rows[1]), half);
+        const __m256 centerZ = _mm256_mul_ps(_mm256_add_ps(rows[6], rows[2]), half);
+        const __m256 edgeX = _mm256_sub_ps(centerX, rows[0]);
+        const __m256 edgeY = _mm256_sub_ps(centerY, rows[1]);
+        const __m256 edgeZ = _mm256_sub_ps(centerZ, rows[2]);
+
+        __m256 outside = _mm256_setzero_ps();
+        for (unsigned j = 0; j < numPlanes; ++j)
+        {
+            const float* plane = planes + j * 4;
+            const __m256 nx = _mm256_set1_ps(plane[0]);
+            const __m256 ny = _mm256_set1_ps(plane[1]);
+            const __m256 nz = _mm256_set1_ps(plane[2]);
+            const __m256 d = _mm256_set1_ps(plane[3]);
+
+            const __m256 dist = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(
+                _mm256_mul_ps(nx, centerX), _mm256_mul_ps(ny, centerY)), _mm256_mul_ps(nz, centerZ)), d);
+            const __m256 absDist = _mm256_add_ps(_mm256_add_ps(
+                _mm256_mul_ps(_mm256_and_ps(nx, absMask), edgeX),
+                _mm256_mul_ps(_mm256_and_ps(ny, absMask), edgeY)),
+                _mm256_mul_ps(_mm256_and_ps(nz, absMask), edgeZ));
+
+            outside = _mm256_or_ps(outside, _mm256_cmp_ps(dist, _mm256_xor_ps(absDist, signMask), _CMP_LT_OQ));
+        }
+
+        const int outsideMask = _mm256_movemask_ps(outside);
+        for (unsigned j = 0; j < 8; ++j)
+            visible[i + j] = ((outsideMask >> j) & 1) == 0;
+    }
+
+    for (; i < count; ++i)
+    {
+        const float* box = boxes + i * 8;
+        const float center[3]{(box[4] + box[0]) * 0.5f, (box[5] + box[1]) * 0.5f, (box[6] + box[2]) * 0.5f};
+        const float edge[3]{center[0] - box[0], center[1] - box[1], center[2] - box[2]};
+
+        bool isVisible = true;
+        for (unsigned j = 0; j < numPlanes && isVisible; ++j)
+        {
+            const float* plane = planes + j * 4;
+            const float dist = plane[0] * center[0] + plane[1] * center[1] + plane[2] * center[2] + plane[3];
+            const float absDist = AbsFloat(plane[0]) * edge[0] + AbsFloat(plane[1]) * edge[1]
+                + AbsFloat(plane[2]) * edge[2];
+            if (dist < -absDist)
+                isVisible = false;
+        }
+        visible[i] = isVisible;
+    }
+}
+
+void SkinVerticesAVX2(const float* boneTransforms, const unsigned char* boneIndices, const float* boneWeights,
+    unsigned numBonesPerVertex, float* vertices, unsigned vertexStride, unsigned normalOffset, unsigned tangentOffset,
+    unsigned count)
+{
+    if (normalOffset && tangentOffset)
+    {
+        SkinVerticesImpl<true, true>(boneTransforms, boneIndices, boneWeights, numBonesPerVertex, vertices,
+            vertexStride, normalOffset, tangentOffset, count);
+    }
+    else if (normalOffset)
+    {
+        SkinVerticesImpl<true, false>(boneTransforms, boneIndices, boneWeights, numBonesPerVertex, vertices,
+            vertexStride, normalOffset, tangentOffset, count);
+    }
+    else if (tangentOffset)
+    {
+        SkinVerticesImpl<false, true>(boneTransforms, boneIndices, boneWeights, numBonesPerVertex, vertices,
+            vertexStride, normalOffset, tangentOffset, count);
+    }
+    else
+    {
+        SkinVerticesImpl<false, false>(boneTransforms, boneIndices, boneWeights, numBonesPerVertex, vertices,
+            vertexStride, normalOffset, tangentOffset, count);
+    }
+}
+
+}
+
+}
+
+#endif
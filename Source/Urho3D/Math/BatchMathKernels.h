@@ -0,0 +1,66 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+/// \file
+/// Internal. Instruction set specific kernels of batch math functions.
+/// This header should not include anything: kernels are compiled with instruction set specific flags,
+/// and inline functions from other headers would be compiled with these flags too.
+
+#pragma once
+
+// Kernels use AArch64-only intrinsics (e.g. pairwise add of quad registers), 32-bit ARM uses generic kernels.
+#if defined(__aarch64__) || defined(_M_ARM64)
+    #define URHO3D_BATCH_MATH_NEON 1
+#endif
+
+namespace Urho3D
+{
+
+namespace BatchMathKernels
+{
+
+/// Matrices are rows of Matrix3x4, 12 floats each.
+/// Points are 3 floats each.
+/// Bounding boxes are min, padding, max, padding, 8 floats each.
+/// Frustum planes are normal and distance, 4 floats each.
+/// Vertices are interleaved with position at the start and optional normal and tangent at non-zero offsets.
+/// @{
+#define URHO3D_DECLARE_BATCH_MATH_KERNELS(suffix) \
+    void TransformPoints##suffix(const float* transform, const float* source, float* dest, unsigned count); \
+    void MultiplyMatrices##suffix(const float* lhs, const float* rhs, float* dest, unsigned count); \
+    void TransformBoundingBoxes##suffix(const float* transforms, const float* source, float* dest, unsigned count); \
+    void MergeBoundingBoxes##suffix(const float* boxes, unsigned count, float* result); \
+    void TestBoundingBoxesInFrustum##suffix(const float* planes, unsigned numPlanes, const float* boxes, bool* visible, unsigned count); \
+    void SkinVertices##suffix(const float* boneTransforms, const unsigned char* boneIndices, const float* boneWeights, \
+        unsigned numBonesPerVertex, float* vertices, unsigned vertexStride, unsigned normalOffset, unsigned tangentOffset, \
+        unsigned count);
+
+URHO3D_DECLARE_BATCH_MATH_KERNELS(AVX2)
+URHO3D_DECLARE_BATCH_MATH_KERNELS(NEON)
+
+#undef URHO3D_DECLARE_BATCH_MATH_KERNELS
+/// @}
+
+}
+
+}
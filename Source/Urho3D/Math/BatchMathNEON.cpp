@@ -0,0 +1,317 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+// Don't include engine headers here, see BatchMathKernels.h.
+#include "../Math/BatchMathKernels.h"
+
+#if URHO3D_BATCH_MATH_NEON
+
+#include <arm_neon.h>
+
+namespace Urho3D
+{
+
+namespace BatchMathKernels
+{
+
+namespace
+{
+
+/// Return absolute value of the float.
+inline float AbsFloat(float value)
+{
+    return value < 0.0f ? -value : value;
+}
+
+/// Transform single point. Used for the tail of the array.
+inline void TransformPoint(const float* m, const float* source, float* dest)
+{
+    const float x = source[0];
+    const float y = source[1];
+    const float z = source[2];
+    dest[0] = m[0] * x + m[1] * y + m[2] * z + m[3];
+    dest[1] = m[4] * x + m[5] * y + m[6] * z + m[7];
+    dest[2] = m[8] * x + m[9] * y + m[10] * z + m[11];
+}
+
+/// Load XYZ components of the vector and set W component. Doesn't read past the vector.
+inline float32x4_t LoadVector3(const float* source, float w)
+{
+    return vcombine_f32(vld1_f32(source), vset_lane_f32(w, vld1_dup_f32(source + 2), 1));
+}
+
+/// Store XYZ components of the vector.
+inline void StoreVector3(float* dest, float32x4_t value)
+{
+    vst1_f32(dest, vget_low_f32(value));
+    vst1q_lane_f32(dest + 2, value, 2);
+}
+
+/// Return dot products of the matrix rows with the vector as XYZ components.
+inline float32x4_t TransformVector(float32x4_t row0, float32x4_t row1, float32x4_t row2, float32x4_t value)
+{
+    const float32x4_t xy = vpaddq_f32(vmulq_f32(row0, value), vmulq_f32(row1, value));
+    const float32x4_t z = vmulq_f32(row2, value);
+    return vpaddq_f32(xy, vpaddq_f32(z, z));
+}
+
+/// Skin vertices with blended bone transforms.
+template <bool SkinNormals, bool SkinTangents>
+void SkinVerticesImpl(const float* boneTransforms, const unsigned char* boneIndices, const float* boneWeights,
+    unsigned numBonesPerVertex, float* vertices, unsigned vertexStride, unsigned normalOffset, unsigned tangentOffset,
+    unsigned count)
+{
+    for (unsigned i = 0; i < count; ++i)
+    {
+        const float* bone = boneTransforms + boneIndices[0] * 12;
+        float32x4_t row0 = vmulq_n_f32(vld1q_f32(bone + 0), boneWeights[0]);
+        float32x4_t row1 = vmulq_n_f32(vld1q_f32(bone + 4), boneWeights[0]);
+        float32x4_t row2 = vmulq_n_f32(vld1q_f32(bone + 8), boneWeights[0]);
+        for (unsigned j = 1; j < numBonesPerVertex; ++j)
+        {
+            bone = boneTransforms + boneIndices[j] * 12;
+            row0 = vaddq_f32(row0, vmulq_n_f32(vld1q_f32(bone + 0), boneWeights[j]));
+            row1 = vaddq_f32(row1, vmulq_n_f32(vld1q_f32(bone + 4), boneWeights[j]));
+            row2 = vaddq_f32(row2, vmulq_n_f32(vld1q_f32(bone + 8), boneWeights[j]));
+        }
+
+        // Zero W component excludes translation from directions
+        float* vertex = vertices + i * vertexStride;
+        StoreVector3(vertex, TransformVector(row0, row1, row2, LoadVector3(vertex, 1.0f)));
+        if constexpr (SkinNormals)
+        {
+            float* normal = vertex + normalOffset;
+            StoreVector3(normal, TransformVector(row0, row1, row2, LoadVector3(normal, 0.0f)));
+        }
+        if constexpr (SkinTangents)
+        {
+            float* tangent = vertex + tangentOffset;
+            StoreVector3(tangent, TransformVector(row0, row1, row2, LoadVector3(tangent, 0.0f)));
+        }
+
+        boneIndices += numBonesPerVertex;
+        boneWeights += numBonesPerVertex;
+    }
+}
+
+/// Return dot product of the row with (x, y, z, 1). Fused operations are not used to match scalar code.
+inline float32x4_t TransformRow(const float* row, float32x4_t x, float32x4_t y, float32x4_t z)
+{
+    return vaddq_f32(vaddq_f32(vaddq_f32(
+        vmulq_n_f32(x, row[0]), vmulq_n_f32(y, row[1])), vmulq_n_f32(z, row[2])), vdupq_n_f32(row[3]));
+}
+
+}
+
+void TransformPointsNEON(const float* transform, const float* source, float* dest, unsigned count)
+{
+    unsigned i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        const float32x4x3_t points = vld3q_f32(source + i * 3);
+        float32x4x3_t result;
+        result.val[0] = TransformRow(transform + 0, points.val[0], points.val[1], points.val[2]);
+        result.val[1] = TransformRow(transform + 4, points.val[0], points.val[1], points.val[2]);
+        result.val[2] = TransformRow(transform + 8, points.val[0], points.val[1], points.val[2]);
+        vst3q_f32(dest + i * 3, result);
+    }
+
+    for (; i < count; ++i)
+        TransformPoint(transform, source + i * 3, dest + i * 3);
+}
+
+void MultiplyMatricesNEON(const float* lhs, const float* rhs, float* dest, unsigned count)
+{
+    for (unsigned i = 0; i < count; ++i)
+    {
+        const float* a = lhs + i * 12;
+        const float* b = rhs + i * 12;
+        float* d = dest + i * 12;
+
+        const float32x4_t b0 = vld1q_f32(b + 0);
+        const float32x4_t b1 = vld1q_f32(b + 4);
+        const float32x4_t b2 = vld1q_f32(b + 8);
+
+        float32x4_t rows[3];
+        for (unsigned j = 0; j < 3; ++j)
+        {
+            const float* row = a + j * 4;
+            const float32x4_t translation = vsetq_lane_f32(row[3], vdupq_n_f32(0.0f), 3);
+            rows[j] = vaddq_f32(vaddq_f32(vaddq_f32(
+                vmulq_n_f32(b0, row[0]), vmulq_n_f32(b1, row[1])), vmulq_n_f32(b2, row[2])), translation);
+        }
+
+        vst1q_f32(d + 0, rows[0]);
+        vst1q_f32(d + 4, rows[1]);
+        vst1q_f32(d + 8, rows[2]);
+    }
+}
+
+void TransformBoundingBoxesNEON(const float* transforms, const float* source, float* dest, unsigned count)
+{
+    for (unsigned i = 0; i < count; ++i)
+    {
+        const float* m = transforms + i * 12;
+        const float* src = source + i * 8;
+        float* dst = dest + i * 8;
+
+        const float32x4_t minPt = vld1q_f32(src + 0);
+        const float32x4_t maxPt = vld1q_f32(src + 4);
+        const float32x4_t center = vmulq_n_f32(vaddq_f32(maxPt, minPt), 0.5f);
+        const float32x4_t halfSize = vsubq_f32(center, minPt);
+
+        // Columns of the matrix, translation is the last column
+        const float columns[16]{
+            m[0], m[4], m[8], 0.0f,
+            m[1], m[5], m[9], 0.0f,
+            m[2], m[6], m[10], 0.0f,
+            m[3], m[7], m[11], 0.0f,
+        };
+        const float32x4_t col0 = vld1q_f32(columns + 0);
+        const float32x4_t col1 = vld1q_f32(columns + 4);
+        const float32x4_t col2 = vld1q_f32(columns + 8);
+        const float32x4_t col3 = vld1q_f32(columns + 12);
+
+        const float32x4_t newCenter = vaddq_f32(vaddq_f32(vaddq_f32(
+            vmulq_lane_f32(col0, vget_low_f32(center), 0), vmulq_lane_f32(col1, vget_low_f32(center), 1)),
+            vmulq_lane_f32(col2, vget_high_f32(center), 0)), col3);
+        const float32x4_t newEdge = vaddq_f32(vaddq_f32(
+            vmulq_lane_f32(vabsq_f32(col0), vget_low_f32(halfSize), 0),
+            vmulq_lane_f32(vabsq_f32(col1), vget_low_f32(halfSize), 1)),
+            vmulq_lane_f32(vabsq_f32(col2), vget_high_f32(halfSize), 0));
+
+        vst1q_f32(dst + 0, vsubq_f32(newCenter, newEdge));
+        vst1q_f32(dst + 4, vaddq_f32(newCenter, newEdge));
+    }
+}
+
+void MergeBoundingBoxesNEON(const float* boxes, unsigned count, float* result)
+{
+    if (count == 0)
+        return;
+
+    float32x4_t minAcc = vld1q_f32(result + 0);
+    float32x4_t maxAcc = vld1q_f32(result + 4);
+    for (unsigned i = 0; i < count; ++i)
+    {
+        minAcc = vminq_f32(minAcc, vld1q_f32(boxes + i * 8 + 0));
+        maxAcc = vmaxq_f32(maxAcc, vld1q_f32(boxes + i * 8 + 4));
+    }
+
+    vst1q_f32(result + 0, minAcc);
+    vst1q_f32(result + 4, maxAcc);
+}
+
+void TestBoundingBoxesInFrustumNEON(
+    const float* planes, unsigned numPlanes, const float* boxes, bool* visible, unsigned count)
+{
+    unsigned i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        // Deinterleave 4 boxes. Each vector of vld4q contains min and max of two boxes: min0, max0, min1, max1
+        const float32x4x4_t lo = vld4q_f32(boxes + i * 8);
+        const float32x4x4_t hi = vld4q_f32(boxes + i * 8 + 16);
+        const float32x4_t minX = vuzp1q_f32(lo.val[0], hi.val[0]);
+        const float32x4_t minY = vuzp1q_f32(lo.val[1], hi.val[1]);
+        const float32x4_t minZ = vuzp1q_f32(lo.val[2], hi.val[2]);
+        const float32x4_t maxX = vuzp2q_f32(lo.val[0], hi.val[0]);
+        const float32x4_t maxY = vuzp2q_f32(lo.val[1], hi.val[1]);
+        const float32x4_t maxZ = vuzp2q_f32(lo.val[2], hi.val[2]);
+
+        const float32x4_t centerX = vmulq_n_f32(vaddq_f32(maxX, minX), 0.5f);
+        const float32x4_t centerY = vmulq_n_f32(vaddq_f32(maxY, minY), 0.5f);
+        const float32x4_t centerZ = vmulq_n_f32(vaddq_f32(maxZ, minZ), 0.5f);
+        const float32x4_t edgeX = vsubq_f32(centerX, minX);
+        const float32x4_t edgeY = vsubq_f32(centerY, minY);
+        const float32x4_t edgeZ = vsubq_f32(centerZ, minZ);
+
+        uint32x4_t outside = vdupq_n_u32(0);
+        for (unsigned j = 0; j < numPlanes; ++j)
+        {
+            const float* plane = planes + j * 4;
+            const float32x4_t dist = vaddq_f32(vaddq_f32(vaddq_f32(
+                vmulq_n_f32(centerX, plane[0]), vmulq_n_f32(centerY, plane[1])), vmulq_n_f32(centerZ, plane[2])),
+                vdupq_n_f32(plane[3]));
+            const float32x4_t absDist = vaddq_f32(vaddq_f32(
+                vmulq_n_f32(edgeX, AbsFloat(plane[0])), vmulq_n_f32(edgeY, AbsFloat(plane[1]))),
+                vmulq_n_f32(edgeZ, AbsFloat(plane[2])));
+            outside = vorrq_u32(outside, vcltq_f32(dist, vnegq_f32(absDist)));
+        }
+
+        visible[i + 0] = vgetq_lane_u32(outside, 0) == 0;
+        visible[i + 1] = vgetq_lane_u32(outside, 1) == 0;
+        visible[i + 2] = vgetq_lane_u32(outside, 2) == 0;
+        visible[i + 3] = vgetq_lane_u32(outside, 3) == 0;
+    }
+
+    for (; i < count; ++i)
+    {
+        const float* box = boxes + i * 8;
+        const float center[3]{(box[4] + box[0]) * 0.5f, (box[5] + box[1]) * 0.5f, (box[6] + box[2]) * 0.5f};
+        const float edge[3]{center[0] - box[0], center[1] - box[1], center[2] - box[2]};
+
+        bool isVisible = true;
+        for (unsigned j = 0; j < numPlanes && isVisible; ++j)
+        {
+            const float* plane = planes + j * 4;
+            const float dist = plane[0] * center[0] + plane[1] * center[1] + plane[2] * center[2] + plane[3];
+            const float absDist = AbsFloat(plane[0]) * edge[0] + AbsFloat(plane[1]) * edge[1]
+                + AbsFloat(plane[2]) * edge[2];
+            if (dist < -absDist)
+                isVisible = false;
+        }
+        visible[i] = isVisible;
+    }
+}
+
+void SkinVerticesNEON(const float* boneTransforms, const unsigned char* boneIndices, const float* boneWeights,
+    unsigned numBonesPerVertex, float* vertices, unsigned vertexStride, unsigned normalOffset, unsigned tangentOffset,
+    unsigned count)
+{
+    if (normalOffset && tangentOffset)
+    {
+        SkinVerticesImpl<true, true>(boneTransforms, boneIndices, boneWeights, numBonesPerVertex, vertices,
+            vertexStride, normalOffset, tangentOffset, count);
+    }
+    else if (normalOffset)
+    {
+        SkinVerticesImpl<true, false>(boneTransforms, boneIndices, boneWeights, numBonesPerVertex, vertices,
+            vertexStride, normalOffset, tangentOffset, count);
+    }
+    else if (tangentOffset)
+    {
+        SkinVerticesImpl<false, true>(boneTransforms, boneIndices, boneWeights, numBonesPerVertex, vertices,
+            vertexStride, normalOffset, tangentOffset, count);
+    }
+    else
+    {
+        SkinVerticesImpl<false, false>(boneTransforms, boneIndices, boneWeights, numBonesPerVertex, vertices,
+            vertexStride, normalOffset, tangentOffset, count);
+    }
+}
+
+}
+
+}
+
+#endif
@@ -51,7 +51,7 @@ static StringHashRegister& GetGlobalStringHashRegister()
 
 #endif
 
-const StringHash StringHash::Empty{""};
+const StringHash StringHash::Empty{EmptyValue};
 
 StringHash::StringHash(const ea::string_view& str) noexcept
     : value_(Calculate(static_cast<const void*>(str.data()), str.length()))
@@ -68,8 +68,7 @@ unsigned StringHash::Calculate(const char* str)
 
 unsigned StringHash::Calculate(const void* data, unsigned length)
 {
-    const ea::string_view view{static_cast<const char*>(data), length};
-    return MakeHash(view);
+    return CalculateConstexpr(static_cast<const char*>(data), length);
 }
 
 StringHashRegister* StringHash::GetGlobalStringHashRegister()
@@ -37,13 +37,13 @@ class URHO3D_API StringHash
 {
 public:
     /// Construct with zero value.
-    StringHash() noexcept
-        : value_(Empty.value_)
+    constexpr StringHash() noexcept
+        : value_(EmptyValue)
     {
     }
 
     /// Construct with an initial value.
-    explicit StringHash(unsigned value) noexcept
+    constexpr explicit StringHash(unsigned value) noexcept
         : value_(value)
     {
     }
@@ -64,26 +64,26 @@ public:
     StringHash(const ea::string_view& str) noexcept; // NOLINT(google-explicit-constructor)
 
     /// Test for equality with another hash.
-    bool operator==(const StringHash& rhs) const { return value_ == rhs.value_; }
+    constexpr bool operator==(const StringHash& rhs) const { return value_ == rhs.value_; }
 
     /// Test for inequality with another hash.
-    bool operator!=(const StringHash& rhs) const { return value_ != rhs.value_; }
+    constexpr bool operator!=(const StringHash& rhs) const { return value_ != rhs.value_; }
 
     /// Test if less than another hash.
-    bool operator<(const StringHash& rhs) const { return value_ < rhs.value_; }
+    constexpr bool operator<(const StringHash& rhs) const { return value_ < rhs.value_; }
 
     /// Test if greater than another hash.
-    bool operator>(const StringHash& rhs) const { return value_ > rhs.value_; }
+    constexpr bool operator>(const StringHash& rhs) const { return value_ > rhs.value_; }
 
     /// Return true if nonempty hash value.
-    bool IsEmpty() const { return value_ == Empty.value_; }
+    constexpr bool IsEmpty() const { return value_ == EmptyValue; }
 
     /// Return true if nonempty hash value.
-    explicit operator bool() const { return !IsEmpty(); }
+    constexpr explicit operator bool() const { return !IsEmpty(); }
 
     /// Return hash value.
     /// @property
-    unsigned Value() const { return value_; }
+    constexpr unsigned Value() const { return value_; }
 
     /// Return mutable hash value. For internal use only.
     unsigned& MutableValue() { return value_; }
@@ -107,6 +107,15 @@ public:
     /// Calculate hash value from binary data.
     static unsigned Calculate(const void* data, unsigned length);
 
+    /// Calculate hash value at compile time. Same as ea::hash<ea::string_view>.
+    static constexpr unsigned CalculateConstexpr(const char* str, unsigned length)
+    {
+        unsigned result = EmptyValue;
+        for (unsigned i = 0; i < length; ++i)
+            result = (result * 16777619u) ^ static_cast<unsigned char>(str[i]);
+        return result;
+    }
+
     /// Get global StringHashRegister. Use for debug purposes only. Return nullptr if URHO3D_HASH_DEBUG is off.
     static StringHashRegister* GetGlobalStringHashRegister();
 
@@ -114,10 +123,25 @@ public:
     static const StringHash Empty;
 
 private:
+    /// Hash value of empty string.
+    static constexpr unsigned EmptyValue = 2166136261u;
+
     /// Hash value.
     unsigned value_;
 };
 
 static_assert(sizeof(StringHash) == sizeof(unsigned), "Unexpected StringHash size.");
 
+inline namespace Literals
+{
+
+/// Calculate StringHash of string literal at compile time, e.g. "Position"_sh.
+/// The string is not registered for reverse lookup.
+constexpr StringHash operator""_sh(const char* str, size_t length)
+{
+    return StringHash{StringHash::CalculateConstexpr(str, static_cast<unsigned>(length))};
+}
+
+}
+
 } // namespace Urho3D
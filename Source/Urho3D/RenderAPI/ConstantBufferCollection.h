@@ -78,6 +78,32 @@ public:
         return {{ currentBufferIndex_, offset, size }, data };
     }
 
+    /// Move all used buffers of other collection into this collection without copying the data.
+    /// Spare buffers of this collection are handed over to other collection, so both keep their storage between frames.
+    /// Other collection should be cleared before reuse. Return index of the first adopted buffer.
+    unsigned AdoptBuffers(ConstantBufferCollection& other)
+    {
+        assert(bufferSize_ == other.bufferSize_ && alignment_ == other.alignment_);
+
+        const unsigned firstIndex = buffers_[currentBufferIndex_].second == 0 ? currentBufferIndex_ : currentBufferIndex_ + 1;
+        const unsigned numBuffers = other.GetNumBuffers();
+        for (unsigned i = 0; i < numBuffers; ++i)
+        {
+            const unsigned index = firstIndex + i;
+            if (buffers_.size() <= index)
+                buffers_.emplace_back();
+
+            ea::swap(buffers_[index], other.buffers_[i]);
+            other.buffers_[i].first.resize(bufferSize_);
+            other.buffers_[i].second = 0;
+        }
+
+        // Keep writing into the last adopted buffer
+        currentBufferIndex_ = firstIndex + numBuffers - 1;
+        other.currentBufferIndex_ = 0;
+        return firstIndex;
+    }
+
     /// Return number of buffers.
     unsigned GetNumBuffers() const { return currentBufferIndex_ + 1; }
 
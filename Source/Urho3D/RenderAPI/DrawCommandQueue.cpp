@@ -55,8 +55,9 @@ void DrawCommandQueue::Reset()
     currentUnorderedAccessViewGroup_ = {};
     currentShaderProgramReflection_ = nullptr;
 
-    // Clear shader parameters
-    constantBuffers_.collection_.ClearAndInitialize(renderDevice_->GetCaps().constantBufferOffsetAlignment_);
+    // Clear shader parameters. Render device is only needed to align constant buffers
+    const unsigned alignment = renderDevice_ ? renderDevice_->GetCaps().constantBufferOffsetAlignment_ : 1;
+    constantBuffers_.collection_.ClearAndInitialize(alignment);
     constantBuffers_.currentData_ = nullptr;
     constantBuffers_.currentHashes_.fill(0);
 
@@ -70,6 +71,85 @@ void DrawCommandQueue::Reset()
     scissorRects_.push_back(IntRect::ZERO);
 }
 
+void DrawCommandQueue::ResetFrom(const DrawCommandQueue& parent)
+{
+    Reset();
+
+    clipPlaneMask_ = parent.clipPlaneMask_;
+    if (parent.currentDrawCommand_.scissorRect_ != 0)
+        SetScissorRect(parent.scissorRects_[parent.currentDrawCommand_.scissorRect_]);
+    currentDrawCommand_.stencilRef_ = parent.currentDrawCommand_.stencilRef_;
+}
+
+void DrawCommandQueue::AppendCommands(DrawCommandQueue& other)
+{
+    // Take over whole constant buffers, block offsets within buffers stay the same
+    const unsigned constantBuffersOffset = constantBuffers_.collection_.AdoptBuffers(other.constantBuffers_.collection_);
+    other.constantBuffers_.currentData_ = nullptr;
+
+    const unsigned shaderResourcesOffset = shaderResources_.size();
+    shaderResources_.insert(shaderResources_.end(), other.shaderResources_.begin(), other.shaderResources_.end());
+
+    const unsigned unorderedAccessViewsOffset = unorderedAccessViews_.size();
+    unorderedAccessViews_.insert(
+        unorderedAccessViews_.end(), other.unorderedAccessViews_.begin(), other.unorderedAccessViews_.end());
+
+    // Scissor rect #0 is always empty and is shared
+    const unsigned scissorRectsOffset = scissorRects_.size() - 1;
+    scissorRects_.insert(scissorRects_.end(), other.scissorRects_.begin() + 1, other.scissorRects_.end());
+
+    const auto remapCommand = [&](DrawCommandDescription& cmd)
+    {
+        for (ConstantBufferCollectionRef& ref : cmd.constantBuffers_)
+        {
+            if (ref.size_ == 0)
+                continue;
+
+            ref.index_ += constantBuffersOffset;
+        }
+
+        cmd.shaderResources_.first += shaderResourcesOffset;
+        cmd.shaderResources_.second += shaderResourcesOffset;
+        cmd.unorderedAccessViews_.first += unorderedAccessViewsOffset;
+        cmd.unorderedAccessViews_.second += unorderedAccessViewsOffset;
+        if (cmd.scissorRect_ != 0)
+            cmd.scissorRect_ += scissorRectsOffset;
+    };
+
+    const unsigned numCommands = drawCommands_.size();
+    drawCommands_.insert(drawCommands_.end(), other.drawCommands_.begin(), other.drawCommands_.end());
+    for (unsigned i = numCommands; i < drawCommands_.size(); ++i)
+        remapCommand(drawCommands_[i]);
+
+    // Continue recording from the state of appended queue
+    DrawCommandDescription currentDrawCommand = other.currentDrawCommand_;
+    remapCommand(currentDrawCommand);
+    for (unsigned i = 0; i < MAX_SHADER_PARAMETER_GROUPS; ++i)
+    {
+        if (other.constantBuffers_.currentHashes_[i] == 0)
+            continue;
+
+        currentDrawCommand_.constantBuffers_[i] = currentDrawCommand.constantBuffers_[i];
+        constantBuffers_.currentHashes_[i] = other.constantBuffers_.currentHashes_[i];
+    }
+
+    if (other.currentShaderProgramReflection_)
+    {
+        currentDrawCommand_.pipelineState_ = currentDrawCommand.pipelineState_;
+        currentShaderProgramReflection_ = other.currentShaderProgramReflection_;
+    }
+
+    currentDrawCommand_.vertexBuffers_ = currentDrawCommand.vertexBuffers_;
+    currentDrawCommand_.indexBuffer_ = currentDrawCommand.indexBuffer_;
+    currentDrawCommand_.shaderResources_ = currentDrawCommand.shaderResources_;
+    currentDrawCommand_.unorderedAccessViews_ = currentDrawCommand.unorderedAccessViews_;
+    currentDrawCommand_.scissorRect_ = currentDrawCommand.scissorRect_;
+    currentDrawCommand_.stencilRef_ = currentDrawCommand.stencilRef_;
+
+    currentShaderResourceGroup_ = {shaderResources_.size(), shaderResources_.size()};
+    currentUnorderedAccessViewGroup_ = {unorderedAccessViews_.size(), unorderedAccessViews_.size()};
+}
+
 void DrawCommandQueue::ExecuteInContext(RenderContext* renderContext)
 {
     if (drawCommands_.empty())
@@ -57,6 +57,12 @@ public:
 
     /// Reset queue.
     void Reset();
+    /// Reset queue and inherit current clip plane mask, scissor rect and stencil reference from another queue.
+    /// Used to record commands in another thread before appending them to the other queue.
+    void ResetFrom(const DrawCommandQueue& parent);
+    /// Append commands recorded in another queue. Recording continues with the current state of appended queue.
+    /// Constant buffers are moved from another queue instead of being copied, so it should be reset before reuse.
+    void AppendCommands(DrawCommandQueue& other);
 
     /// Set clip plane enabled for all draw commands in the queue.
     void SetClipPlaneMask(unsigned mask) { clipPlaneMask_ = mask; }
@@ -311,6 +317,49 @@ public:
     void ExecuteInContext(RenderContext* renderContext);
 
 private:
+    friend class DrawCommandQueueTester;
+
+    /// Testing API, bypasses shader reflection and pipeline state. Accessed via DrawCommandQueueTester in unit tests.
+    /// @{
+    /// Store constant buffer of the group.
+    void AddRawConstantBuffer(ShaderParameterGroup group, ea::span<const unsigned char> data)
+    {
+        const auto& refAndData = constantBuffers_.collection_.AddBlock(data.size());
+        ea::copy(data.begin(), data.end(), refAndData.second);
+
+        currentDrawCommand_.constantBuffers_[group] = refAndData.first;
+        // Layout is unknown, so the buffer is never reused for reflected parameters
+        constantBuffers_.currentHashes_[group] = M_MAX_UNSIGNED;
+    }
+
+    /// Add shader resource.
+    void AddRawShaderResource(RawTexture* texture)
+    {
+        shaderResources_.push_back(ShaderResourceData{nullptr, texture, nullptr, TextureType::Texture2D});
+        ++currentShaderResourceGroup_.second;
+    }
+
+    /// Enqueue draw command.
+    void DrawRaw(unsigned indexStart, unsigned indexCount)
+    {
+        currentDrawCommand_.indexStart_ = indexStart;
+        currentDrawCommand_.indexCount_ = indexCount;
+        drawCommands_.push_back(currentDrawCommand_);
+    }
+
+    /// Return recorded draw commands.
+    ea::span<const DrawCommandDescription> GetDrawCommands() const { return drawCommands_; }
+    /// Return scissor rect by index.
+    const IntRect& GetScissorRect(unsigned index) const { return scissorRects_[index]; }
+    /// Return texture of shader resource by index.
+    RawTexture* GetShaderResourceTexture(unsigned index) const { return shaderResources_[index].texture_; }
+    /// Return data of constant buffer block.
+    const unsigned char* GetConstantBufferData(const ConstantBufferCollectionRef& ref) const
+    {
+        return static_cast<const unsigned char*>(constantBuffers_.collection_.GetBufferData(ref.index_)) + ref.offset_;
+    }
+    /// @}
+
     RenderDevice* renderDevice_{};
 
     /// Shader parameters data when constant buffers are used.
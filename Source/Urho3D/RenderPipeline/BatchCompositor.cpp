@@ -61,12 +61,25 @@ void BatchCompositorPass::SetDeferredOutputDesc(const PipelineStateOutputDesc& d
 void BatchCompositorPass::ComposeBatches()
 {
     // Try to process batches in worker threads
-    ForEachParallel(workQueue_, geometryBatches_,
-        [&](unsigned /*index*/, const GeometryBatch& geometryBatch)
+    TaskGraph taskGraph(workQueue_);
+    ScheduleComposeBatches(taskGraph, {});
+    taskGraph.Execute();
+
+    ResolveBatches();
+}
+
+TaskGraph::TaskId BatchCompositorPass::ScheduleComposeBatches(
+    TaskGraph& taskGraph, std::initializer_list<TaskGraph::TaskId> dependencies)
+{
+    return taskGraph.AddForEachTask(geometryBatches_,
+        [this](unsigned /*index*/, const GeometryBatch& geometryBatch)
     {
         ProcessGeometryBatch(geometryBatch);
-    });
+    }, dependencies);
+}
 
+void BatchCompositorPass::ResolveBatches()
+{
     // Create missing pipeline states from main thread
     ResolveDelayedBatches(BatchCompositorSubpass::Deferred, delayedDeferredBatches_, deferredCache_, deferredBatches_);
     ResolveDelayedBatches(BatchCompositorSubpass::Base, delayedUnlitBaseBatches_, unlitBaseCache_, baseBatches_);
@@ -110,6 +123,7 @@ void BatchCompositorPass::ProcessGeometryBatch(const GeometryBatch& geometryBatc
 
     if (!desc.material_)
         desc.material_ = defaultMaterial_;
+    desc.DisableInstancingIfNoCustomData(instancingCustomData_);
 
     // Always add deferred batch if possible.
     if (desc.pass_)
@@ -252,6 +266,15 @@ BatchCompositor::~BatchCompositor()
 void BatchCompositor::SetPasses(ea::vector<SharedPtr<BatchCompositorPass>> passes)
 {
     allPasses_ = passes;
+    for (BatchCompositorPass* pass : allPasses_)
+        pass->SetInstancingCustomData(instancingCustomData_);
+}
+
+void BatchCompositor::SetInstancingCustomData(bool enabled)
+{
+    instancingCustomData_ = enabled;
+    for (BatchCompositorPass* pass : allPasses_)
+        pass->SetInstancingCustomData(instancingCustomData_);
 }
 
 void BatchCompositor::SetShadowOutputDesc(const PipelineStateOutputDesc& desc)
@@ -269,6 +292,24 @@ void BatchCompositor::ComposeShadowBatches()
     URHO3D_PROFILE("PrepareShadowBatches");
 
     // Collect shadow caster batches in worker threads
+    TaskGraph taskGraph(workQueue_);
+    ScheduleShadowBatches(taskGraph);
+    taskGraph.Execute();
+
+    // Finalize shadow batches
+    FinalizeShadowBatchesComposition();
+}
+
+void BatchCompositor::ComposeSceneBatches()
+{
+    URHO3D_PROFILE("PrepareSceneBatches");
+
+    for (BatchCompositorPass* pass : passes_)
+        pass->ComposeBatches();
+}
+
+void BatchCompositor::ScheduleShadowBatches(TaskGraph& taskGraph)
+{
     const auto& lightProcessors = drawableProcessor_->GetLightProcessors();
     for (unsigned lightIndex = 0; lightIndex < lightProcessors.size(); ++lightIndex)
     {
@@ -276,24 +317,33 @@ void BatchCompositor::ComposeShadowBatches()
         const unsigned numSplits = lightProcessor->GetNumSplits();
         for (unsigned splitIndex = 0; splitIndex < numSplits; ++splitIndex)
         {
-            workQueue_->PostTask([=](unsigned threadIndex)
+            taskGraph.AddTask([=]
             {
                 BeginShadowBatchesComposition(lightIndex, lightProcessor->GetMutableSplit(splitIndex));
-            }, TaskPriority::Immediate);
+            });
         }
     }
-    workQueue_->CompleteImmediateForThisThread();
+}
+
+void BatchCompositor::ScheduleSceneBatches(TaskGraph& taskGraph, std::initializer_list<TaskGraph::TaskId> dependencies)
+{
+    for (BatchCompositorPass* pass : passes_)
+        pass->ScheduleComposeBatches(taskGraph, dependencies);
+}
+
+void BatchCompositor::FinalizeShadowBatches()
+{
+    URHO3D_PROFILE("FinalizeShadowBatches");
 
-    // Finalize shadow batches
     FinalizeShadowBatchesComposition();
 }
 
-void BatchCompositor::ComposeSceneBatches()
+void BatchCompositor::FinalizeSceneBatches()
 {
-    URHO3D_PROFILE("PrepareSceneBatches");
+    URHO3D_PROFILE("FinalizeSceneBatches");
 
     for (BatchCompositorPass* pass : passes_)
-        pass->ComposeBatches();
+        pass->ResolveBatches();
 }
 
 void BatchCompositor::ComposeLightVolumeBatches()
@@ -395,6 +445,7 @@ void BatchCompositor::BeginShadowBatchesComposition(unsigned lightIndex, ShadowS
 
             PipelineBatchDesc desc(drawable, j, pass);
             desc.material_ = material;
+            desc.DisableInstancingIfNoCustomData(instancingCustomData_);
             desc.InitializeShadowBatch(lightProcessor, lightIndex, lightHash);
 
             PipelineState* pipelineState = shadowCache_.GetPipelineState(desc.GetKey());
@@ -432,6 +483,7 @@ void BatchCompositor::FinalizeShadowBatchesComposition()
     }
 
     // Finalize shadow batches
+    TaskGraph taskGraph(workQueue_);
     const auto& lightProcessors = drawableProcessor_->GetLightProcessors();
     for (unsigned lightIndex = 0; lightIndex < lightProcessors.size(); ++lightIndex)
     {
@@ -439,13 +491,13 @@ void BatchCompositor::FinalizeShadowBatchesComposition()
         const unsigned numSplits = lightProcessor->GetNumSplits();
         for (unsigned splitIndex = 0; splitIndex < numSplits; ++splitIndex)
         {
-            workQueue_->PostTask([=](unsigned threadIndex)
+            taskGraph.AddTask([=]
             {
                 lightProcessor->GetMutableSplit(splitIndex)->FinalizeShadowBatches();
-            }, TaskPriority::Immediate);
+            });
         }
     }
-    workQueue_->CompleteImmediateForThisThread();
+    taskGraph.Execute();
 }
 
 }
@@ -104,6 +104,13 @@ struct PipelineBatchDesc : public PipelineBatch
     {
     }
 
+    /// Render batch without instancing if it has custom data that cannot be stored in instancing buffer.
+    void DisableInstancingIfNoCustomData(bool instancingCustomData)
+    {
+        if (!instancingCustomData && geometryType_ == GEOM_STATIC && GetSourceBatch().instancingData_)
+            geometryType_ = GEOM_STATIC_NOINSTANCING;
+    }
+
     void InitializeShadowBatch(LightProcessor* light, unsigned lightIndex, unsigned lightHash)
     {
         pixelLightForPipelineState_ = light;
@@ -151,8 +158,14 @@ public:
 
     void SetForwardOutputDesc(const PipelineStateOutputDesc& desc);
     void SetDeferredOutputDesc(const PipelineStateOutputDesc& desc);
+    /// Set whether instancing buffer has custom data. Batches with custom data are not instanced otherwise.
+    void SetInstancingCustomData(bool enabled) { instancingCustomData_ = enabled; }
 
     void ComposeBatches();
+    /// Schedule processing of geometry batches in the task graph. Forward lighting should be ready.
+    TaskGraph::TaskId ScheduleComposeBatches(TaskGraph& taskGraph, std::initializer_list<TaskGraph::TaskId> dependencies);
+    /// Create missing pipeline states and finalize batches. Should be called from main thread after scheduled tasks.
+    void ResolveBatches();
 
     bool HasBatches() const
     {
@@ -210,6 +223,8 @@ private:
     WorkQueueVector<PipelineBatchDesc> delayedLightBatches_;
     WorkQueueVector<PipelineBatchDesc> delayedNegativeLightBatches_;
     /// @}
+
+    bool instancingCustomData_{};
 };
 
 /// Batch composition manager.
@@ -230,6 +245,8 @@ public:
     ~BatchCompositor() override;
     void SetPasses(ea::vector<SharedPtr<BatchCompositorPass>> passes);
     void SetShadowMaterialQuality(MaterialQuality materialQuality) { shadowMaterialQuality_ = materialQuality; }
+    /// Set whether instancing buffer has custom data, for shadow batches and all passes.
+    void SetInstancingCustomData(bool enabled);
 
     void SetShadowOutputDesc(const PipelineStateOutputDesc& desc);
     void SetLightVolumesOutputDesc(const PipelineStateOutputDesc& desc);
@@ -241,6 +258,15 @@ public:
     void ComposeLightVolumeBatches();
     /// @}
 
+    /// Compose batches using task graph, so scene and shadow batches are processed concurrently.
+    /// Call Schedule* functions, execute the graph and then call Finalize* functions from main thread.
+    /// @{
+    void ScheduleShadowBatches(TaskGraph& taskGraph);
+    void ScheduleSceneBatches(TaskGraph& taskGraph, std::initializer_list<TaskGraph::TaskId> dependencies);
+    void FinalizeShadowBatches();
+    void FinalizeSceneBatches();
+    /// @}
+
     /// Return sorted light volume batches.
     const auto& GetLightVolumeBatches() const { return sortedLightVolumeBatches_; }
 
@@ -295,6 +321,7 @@ private:
     ea::vector<SharedPtr<BatchCompositorPass>> allPasses_;
     ea::vector<BatchCompositorPass*> passes_;
     MaterialQuality shadowMaterialQuality_{};
+    bool instancingCustomData_{};
     SharedPtr<Material> lightVolumeMaterial_;
     SharedPtr<Material> negativeLightVolumeMaterial_;
     SharedPtr<Pass> lightVolumePass_;
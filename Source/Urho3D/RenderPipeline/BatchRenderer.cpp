@@ -23,6 +23,7 @@
 #include "../Precompiled.h"
 
 #include "../Core/Context.h"
+#include "../Core/WorkQueue.h"
 #include "../Graphics/Camera.h"
 #include "../RenderAPI/DrawCommandQueue.h"
 #include "../Graphics/Drawable.h"
@@ -120,11 +121,14 @@ Vector4 GetClipPlane(const Camera& camera)
 class ObjectParameterBuilder : public NonCopyable
 {
 public:
-    ObjectParameterBuilder(const BatchRendererSettings& settings, BatchRenderFlags flags)
+    ObjectParameterBuilder(const BatchRendererSettings& settings,
+        const InstancingBufferSettings& instancingSettings, BatchRenderFlags flags)
         : instancingEnabled_(flags.Test(BatchRenderFlag::EnableInstancingForStaticGeometry))
         , ambientEnabled_(flags.Test(BatchRenderFlag::EnableAmbientLighting))
         , ambientMode_(settings.ambientMode_)
         , linearColorSpace_(flags.Test(BatchRenderFlag::LinearColorSpace))
+        , customDataEnabled_(instancingSettings.enableCustomData_)
+        , customDataElement_(instancingSettings.numInstancingTexCoords_ - 1)
     {
     }
 
@@ -156,18 +160,20 @@ public:
     }
 
     /// Add uniforms to instancing buffer for instanced batches.
-    void AddBatchesToInstancingBuffer(InstancingBuffer& instancingBuffer,
+    void AddBatchesToInstancingBuffer(InstancingBufferCursor& cursor,
         const SourceBatch& sourceBatch, unsigned instanceIndex)
     {
-        instancingBuffer.AddInstance();
-        instancingBuffer.SetElements(&sourceBatch.worldTransform_[instanceIndex], 0, 3);
+        cursor.AddInstance();
+        cursor.SetElements(&sourceBatch.worldTransform_[instanceIndex], 0, 3);
         if (ambientEnabled_)
         {
             if (ambientMode_ == DrawableAmbientMode::Flat)
-                instancingBuffer.SetElements(&ambientValueFlat_, 3, 1);
+                cursor.SetElements(&ambientValueFlat_, 3, 1);
             else if (ambientMode_ == DrawableAmbientMode::Directional)
-                instancingBuffer.SetElements(ambientValueSH_, 3, 7);
+                cursor.SetElements(ambientValueSH_, 3, 7);
         }
+        if (customDataEnabled_)
+            cursor.SetElements(GetCustomData(sourceBatch), customDataElement_, 1);
     }
 
     /// Add uniforms to draw queue for non-instanced batch.
@@ -193,6 +199,9 @@ public:
             }
         }
 
+        if (sourceBatch.instancingData_)
+            drawQueue.AddShaderParameter(ShaderConsts::Object_InstanceData, *GetCustomData(sourceBatch));
+
         switch (sourceBatch.geometryType_)
         {
         case GEOM_SKINNED:
@@ -223,10 +232,18 @@ public:
     }
 
 private:
+    /// Return custom per-instance data of the batch.
+    static const Vector4* GetCustomData(const SourceBatch& sourceBatch)
+    {
+        return sourceBatch.instancingData_ ? static_cast<const Vector4*>(sourceBatch.instancingData_) : &Vector4::ZERO;
+    }
+
     const bool instancingEnabled_;
     const bool ambientEnabled_;
     const DrawableAmbientMode ambientMode_;
     const bool linearColorSpace_;
+    const bool customDataEnabled_;
+    const unsigned customDataElement_;
 
     Vector4 ambientValueFlat_;
     const SphericalHarmonicsDot9* ambientValueSH_{};
@@ -257,7 +274,7 @@ public:
         , depthRange_(camera_.GetFarClip())
         , clipPlane_(GetClipPlane(camera_))
         , enabled_(flags, instancingBuffer)
-        , objectParameterBuilder_(settings_, flags)
+        , objectParameterBuilder_(settings_, instancingBuffer.GetSettings(), flags)
         , instanceIndex_(startInstance)
     {
         thread_local ea::vector<const ea::pair<const StringHash, MaterialShaderParameter>*> customMaterialParameters;
@@ -950,22 +967,50 @@ BatchRenderingContext::BatchRenderingContext(DrawCommandQueue& drawQueue, const
 {
 }
 
+BatchRenderingContext::BatchRenderingContext(DrawCommandQueue& drawQueue, const BatchRenderingContext& other)
+    : drawQueue_(drawQueue)
+    , camera_(other.camera_)
+    , outputShadowSplit_(other.outputShadowSplit_)
+    , instanceMultiplier_(other.instanceMultiplier_)
+    , globalResources_(other.globalResources_)
+    , frameParameters_(other.frameParameters_)
+    , cameraParameters_(other.cameraParameters_)
+{
+}
+
 BatchRenderer::BatchRenderer(RenderPipelineInterface* renderPipeline, const DrawableProcessor* drawableProcessor,
     InstancingBuffer* instancingBuffer)
     : Object(renderPipeline->GetContext())
     , renderer_(context_->GetSubsystem<Renderer>())
+    , renderDevice_(context_->GetSubsystem<RenderDevice>())
+    , workQueue_(context_->GetSubsystem<WorkQueue>())
     , debugger_(renderPipeline->GetDebugger())
     , drawableProcessor_(drawableProcessor)
     , instancingBuffer_(instancingBuffer)
 {
 }
 
+BatchRenderer::~BatchRenderer()
+{
+}
+
 void BatchRenderer::SetSettings(const BatchRendererSettings& settings)
 {
     settings_ = settings;
 }
 
 void BatchRenderer::RenderBatches(const BatchRenderingContext& ctx, PipelineBatchGroup<PipelineBatchByState> batchGroup)
+{
+    RenderBatchesImpl(ctx, batchGroup);
+}
+
+void BatchRenderer::RenderBatches(const BatchRenderingContext& ctx, PipelineBatchGroup<PipelineBatchBackToFront> batchGroup)
+{
+    RenderBatchesImpl(ctx, batchGroup);
+}
+
+template <class T>
+void BatchRenderer::RenderBatchesImpl(const BatchRenderingContext& ctx, PipelineBatchGroup<T> batchGroup)
 {
     batchGroup.flags_ = AdjustRenderFlags(batchGroup.flags_);
 
@@ -977,7 +1022,7 @@ void BatchRenderer::RenderBatches(const BatchRenderingContext& ctx, PipelineBatc
             compositor.ProcessSceneBatch(*sortedBatch.pipelineBatch_);
         compositor.FlushDrawCommands(batchGroup.startInstance_ + batchGroup.numInstances_);
     }
-    else
+    else if (!RenderBatchesInParallel(ctx, batchGroup))
     {
         DrawCommandCompositor<false> compositor(ctx, settings_, nullptr,
             *drawableProcessor_, *instancingBuffer_, batchGroup.flags_, batchGroup.startInstance_);
@@ -987,26 +1032,39 @@ void BatchRenderer::RenderBatches(const BatchRenderingContext& ctx, PipelineBatc
     }
 }
 
-void BatchRenderer::RenderBatches(const BatchRenderingContext& ctx, PipelineBatchGroup<PipelineBatchBackToFront> batchGroup)
+template <class T>
+bool BatchRenderer::RenderBatchesInParallel(const BatchRenderingContext& ctx, const PipelineBatchGroup<T>& batchGroup)
 {
-    batchGroup.flags_ = AdjustRenderFlags(batchGroup.flags_);
+    const unsigned numThreads = workQueue_ ? workQueue_->GetNumProcessingThreads() : 1;
+    if (numThreads <= 1 || !renderDevice_ || batchGroup.batches_.size() < 2 * MinBatchesPerRecordingTask)
+        return false;
 
-    if (RenderPipelineDebugger::IsSnapshotInProgress(debugger_))
-    {
-        DrawCommandCompositor<true> compositor(ctx, settings_, debugger_,
-            *drawableProcessor_, *instancingBuffer_, batchGroup.flags_, batchGroup.startInstance_);
-        for (const auto& sortedBatch : batchGroup.batches_)
-            compositor.ProcessSceneBatch(*sortedBatch.pipelineBatch_);
-        compositor.FlushDrawCommands(batchGroup.startInstance_ + batchGroup.numInstances_);
-    }
-    else
+    SplitIntoRecordingChunks(recordingChunks_, batchGroup, MinBatchesPerRecordingTask, numThreads);
+    const unsigned numChunks = recordingChunks_.size();
+    if (numChunks <= 1)
+        return false;
+
+    while (recordingQueues_.size() < numChunks)
+        recordingQueues_.push_back(MakeShared<DrawCommandQueue>(renderDevice_));
+
+    // Record each chunk into its own queue as if it was separate batch group
+    ForEachParallel(workQueue_, recordingChunks_, [&](unsigned index, const BatchRecordingChunk& chunk)
     {
-        DrawCommandCompositor<false> compositor(ctx, settings_, nullptr,
-            *drawableProcessor_, *instancingBuffer_, batchGroup.flags_, batchGroup.startInstance_);
-        for (const auto& sortedBatch : batchGroup.batches_)
-            compositor.ProcessSceneBatch(*sortedBatch.pipelineBatch_);
-        compositor.FlushDrawCommands(batchGroup.startInstance_ + batchGroup.numInstances_);
-    }
+        DrawCommandQueue& drawQueue = *recordingQueues_[index];
+        drawQueue.ResetFrom(ctx.drawQueue_);
+
+        const BatchRenderingContext chunkCtx{drawQueue, ctx};
+        DrawCommandCompositor<false> compositor(chunkCtx, settings_, nullptr,
+            *drawableProcessor_, *instancingBuffer_, batchGroup.flags_, chunk.startInstance_);
+        for (unsigned i = chunk.beginBatch_; i < chunk.endBatch_; ++i)
+            compositor.ProcessSceneBatch(*batchGroup.batches_[i].pipelineBatch_);
+        compositor.FlushDrawCommands(chunk.startInstance_ + chunk.numInstances_);
+    });
+
+    // Merge commands in order
+    for (unsigned i = 0; i < numChunks; ++i)
+        ctx.drawQueue_.AppendCommands(*recordingQueues_[i]);
+    return true;
 }
 
 void BatchRenderer::RenderLightVolumeBatches(const BatchRenderingContext& ctx,
@@ -1047,28 +1105,106 @@ void BatchRenderer::PrepareInstancingBufferImpl(PipelineBatchGroup<T>& batches)
     batches.startInstance_ = 0;
     batches.numInstances_ = 0;
 
-    ObjectParameterBuilder objectParameterBuilder(settings_, batches.flags_);
+    ObjectParameterBuilder objectParameterBuilder(settings_, instancingBuffer_->GetSettings(), batches.flags_);
     if (!objectParameterBuilder.IsInstancingSupported())
         return;
 
+    // Count instances first so the whole range is reserved before any data is written
+    const unsigned numBatches = batches.batches_.size();
+    instanceOffsets_.resize(numBatches);
+    unsigned numInstances = 0;
+    for (unsigned i = 0; i < numBatches; ++i)
+    {
+        const PipelineBatch& pipelineBatch = *batches.batches_[i].pipelineBatch_;
+        instanceOffsets_[i] = numInstances;
+        if (objectParameterBuilder.IsBatchInstanced(pipelineBatch))
+            numInstances += pipelineBatch.GetSourceBatch().numWorldTransforms_;
+    }
+
     batches.startInstance_ = instancingBuffer_->GetNextInstanceIndex();
-    for (const T& sortedBatch : batches.batches_)
+    batches.numInstances_ = numInstances;
+    if (numInstances == 0)
+        return;
+
+    instancingBuffer_->ReserveInstances(numInstances);
+
+    // Each task writes its own range of instances, no copy pass is needed afterwards
+    ForEachParallel(workQueue_, MinBatchesPerInstancingTask, numBatches,
+        [&](unsigned beginIndex, unsigned endIndex)
     {
-        const PipelineBatch& pipelineBatch = *sortedBatch.pipelineBatch_;
-        if (!objectParameterBuilder.IsBatchInstanced(pipelineBatch))
+        ObjectParameterBuilder taskParameterBuilder(settings_, instancingBuffer_->GetSettings(), batches.flags_);
+        InstancingBufferCursor cursor(*instancingBuffer_, batches.startInstance_ + instanceOffsets_[beginIndex]);
+        for (unsigned index = beginIndex; index < endIndex; ++index)
+        {
+            const PipelineBatch& pipelineBatch = *batches.batches_[index].pipelineBatch_;
+            if (!taskParameterBuilder.IsBatchInstanced(pipelineBatch))
+                continue;
+
+            const SourceBatch& sourceBatch = pipelineBatch.GetSourceBatch();
+            if (taskParameterBuilder.IsAmbientEnabled())
+            {
+                const LightAccumulator& lightAccumulator = drawableProcessor_->GetGeometryLighting(pipelineBatch.drawableIndex_);
+                taskParameterBuilder.SetBatchAmbient(lightAccumulator);
+            }
+
+            for (unsigned i = 0; i < sourceBatch.numWorldTransforms_; ++i)
+                taskParameterBuilder.AddBatchesToInstancingBuffer(cursor, sourceBatch, i);
+        }
+    });
+}
+
+void BatchRenderer::SplitIntoRecordingChunks(ea::vector<BatchRecordingChunk>& chunks,
+    const PipelineBatchGroup<PipelineBatchByState>& batchGroup, unsigned minBatchesPerChunk, unsigned maxChunks)
+{
+    SplitIntoRecordingChunksImpl(chunks, batchGroup, minBatchesPerChunk, maxChunks);
+}
+
+void BatchRenderer::SplitIntoRecordingChunks(ea::vector<BatchRecordingChunk>& chunks,
+    const PipelineBatchGroup<PipelineBatchBackToFront>& batchGroup, unsigned minBatchesPerChunk, unsigned maxChunks)
+{
+    SplitIntoRecordingChunksImpl(chunks, batchGroup, minBatchesPerChunk, maxChunks);
+}
+
+template <class T>
+void BatchRenderer::SplitIntoRecordingChunksImpl(ea::vector<BatchRecordingChunk>& chunks,
+    const PipelineBatchGroup<T>& batchGroup, unsigned minBatchesPerChunk, unsigned maxChunks)
+{
+    const unsigned numBatches = batchGroup.batches_.size();
+    const unsigned targetChunkSize = ea::max(minBatchesPerChunk, (numBatches + maxChunks - 1) / ea::max(maxChunks, 1u));
+    const bool instancingEnabled = batchGroup.flags_.Test(BatchRenderFlag::EnableInstancingForStaticGeometry);
+
+    chunks.clear();
+    BatchRecordingChunk chunk;
+    chunk.startInstance_ = batchGroup.startInstance_;
+
+    // Batches are processed in the same way as DrawCommandCompositor::ProcessBatch does
+    PipelineState* lastPipelineState = nullptr;
+    for (unsigned i = 0; i < numBatches; ++i)
+    {
+        const PipelineBatch& pipelineBatch = *batchGroup.batches_[i].pipelineBatch_;
+        if (pipelineBatch.geometry_->GetEffectiveIndexCount() == 0)
             continue;
 
-        const SourceBatch& sourceBatch = pipelineBatch.GetSourceBatch();
-        if (objectParameterBuilder.IsAmbientEnabled())
+        if (pipelineBatch.pipelineState_ != lastPipelineState && i - chunk.beginBatch_ >= targetChunkSize)
         {
-            const LightAccumulator& lightAccumulator = drawableProcessor_->GetGeometryLighting(pipelineBatch.drawableIndex_);
-            objectParameterBuilder.SetBatchAmbient(lightAccumulator);
+            chunk.endBatch_ = i;
+            chunks.push_back(chunk);
+
+            chunk.beginBatch_ = i;
+            chunk.startInstance_ += chunk.numInstances_;
+            chunk.numInstances_ = 0;
         }
+        lastPipelineState = pipelineBatch.pipelineState_;
 
-        for (unsigned i = 0; i < sourceBatch.numWorldTransforms_; ++i)
-            objectParameterBuilder.AddBatchesToInstancingBuffer(*instancingBuffer_, sourceBatch, i);
-        batches.numInstances_ += sourceBatch.numWorldTransforms_;
+        if (instancingEnabled && pipelineBatch.geometry_->IsInstanced(pipelineBatch.geometryType_))
+        {
+            chunk.numInstances_ += pipelineBatch.geometryType_ == GEOM_STATIC
+                ? pipelineBatch.GetSourceBatch().numWorldTransforms_ : 1u;
+        }
     }
+
+    chunk.endBatch_ = numBatches;
+    chunks.push_back(chunk);
 }
 
 BatchRenderFlags BatchRenderer::AdjustRenderFlags(BatchRenderFlags flags) const
@@ -36,7 +36,9 @@ class Camera;
 class DrawableProcessor;
 class DrawCommandQueue;
 class InstancingBuffer;
+class RenderDevice;
 class ShadowSplitProcessor;
+class WorkQueue;
 
 /// Common parameters of batch rendering
 struct BatchRenderingContext
@@ -52,6 +54,17 @@ struct BatchRenderingContext
 
     BatchRenderingContext(DrawCommandQueue& drawQueue, const Camera& camera);
     BatchRenderingContext(DrawCommandQueue& drawQueue, const ShadowSplitProcessor& outputShadowSplit);
+    BatchRenderingContext(DrawCommandQueue& drawQueue, const BatchRenderingContext& other);
+};
+
+/// Range of sorted batches that is recorded into separate DrawCommandQueue.
+struct BatchRecordingChunk
+{
+    unsigned beginBatch_{};
+    unsigned endBatch_{};
+    /// Index of the first instance in instancing buffer used by the chunk.
+    unsigned startInstance_{};
+    unsigned numInstances_{};
 };
 
 /// Utility class to convert pipeline batches into sequence of draw commands.
@@ -62,6 +75,7 @@ class URHO3D_API BatchRenderer : public Object
 public:
     BatchRenderer(RenderPipelineInterface* renderPipeline, const DrawableProcessor* drawableProcessor,
         InstancingBuffer* instancingBuffer);
+    ~BatchRenderer() override;
     void SetSettings(const BatchRendererSettings& settings);
 
     /// Render batches
@@ -73,25 +87,59 @@ public:
     /// @}
 
     /// Store instancing data for batches.
+    /// Instances are reserved up front and then written directly by worker threads.
     /// @{
     void PrepareInstancingBuffer(PipelineBatchGroup<PipelineBatchByState>& batches);
     void PrepareInstancingBuffer(PipelineBatchGroup<PipelineBatchBackToFront>& batches);
     /// @}
 
+    /// Split sorted batches into chunks that can be recorded independently.
+    /// Chunks are split only where pipeline state changes and instancing group is restarted anyway,
+    /// so recorded chunks produce the same draw calls as the whole batch group recorded at once.
+    /// @{
+    static void SplitIntoRecordingChunks(ea::vector<BatchRecordingChunk>& chunks,
+        const PipelineBatchGroup<PipelineBatchByState>& batchGroup, unsigned minBatchesPerChunk, unsigned maxChunks);
+    static void SplitIntoRecordingChunks(ea::vector<BatchRecordingChunk>& chunks,
+        const PipelineBatchGroup<PipelineBatchBackToFront>& batchGroup, unsigned minBatchesPerChunk, unsigned maxChunks);
+    /// @}
+
+    /// Minimum number of batches recorded by one worker thread.
+    static constexpr unsigned MinBatchesPerRecordingTask = 256;
+    /// Minimum number of batches whose instancing data is written by one worker thread.
+    static constexpr unsigned MinBatchesPerInstancingTask = 512;
+
 private:
     template <class T>
+    void RenderBatchesImpl(const BatchRenderingContext& ctx, PipelineBatchGroup<T> batchGroup);
+    template <class T>
+    bool RenderBatchesInParallel(const BatchRenderingContext& ctx, const PipelineBatchGroup<T>& batchGroup);
+    template <class T>
+    static void SplitIntoRecordingChunksImpl(ea::vector<BatchRecordingChunk>& chunks,
+        const PipelineBatchGroup<T>& batchGroup, unsigned minBatchesPerChunk, unsigned maxChunks);
+    template <class T>
     void PrepareInstancingBufferImpl(PipelineBatchGroup<T>& batches);
     BatchRenderFlags AdjustRenderFlags(BatchRenderFlags flags) const;
 
     /// External dependencies
     /// @{
     Renderer* renderer_{};
+    RenderDevice* renderDevice_{};
+    WorkQueue* workQueue_{};
     RenderPipelineDebugger* debugger_{};
     const DrawableProcessor* drawableProcessor_{};
     InstancingBuffer* instancingBuffer_{};
     /// @}
 
     BatchRendererSettings settings_;
+
+    /// Parallel recording state
+    /// @{
+    ea::vector<BatchRecordingChunk> recordingChunks_;
+    ea::vector<SharedPtr<DrawCommandQueue>> recordingQueues_;
+    /// @}
+
+    /// Offsets of batch instances within batch group, used as start of per-thread write cursors.
+    ea::vector<unsigned> instanceOffsets_;
 };
 
 }
@@ -38,6 +38,7 @@
 #include "../RenderPipeline/RenderPipelineDefs.h"
 #include "../Scene/Scene.h"
 
+#include <EASTL/optional.h>
 #include <EASTL/sort.h>
 
 #include "../DebugNew.h"
@@ -627,11 +628,19 @@ void DrawableProcessor::ProcessLights(LightProcessorCallback* callback)
 
 void DrawableProcessor::ProcessForwardLightingForLight(
     unsigned lightIndex, const ea::vector<Drawable*>& litGeometries)
+{
+    TaskGraph taskGraph(workQueue_);
+    ScheduleForwardLightingForLight(taskGraph, lightIndex, litGeometries, {});
+    taskGraph.Execute();
+}
+
+TaskGraph::TaskId DrawableProcessor::ScheduleForwardLightingForLight(TaskGraph& taskGraph, unsigned lightIndex,
+    const ea::vector<Drawable*>& litGeometries, std::initializer_list<TaskGraph::TaskId> dependencies)
 {
     if (lightIndex >= lights_.size())
     {
         URHO3D_LOGERROR("Invalid light index {}", lightIndex);
-        return;
+        return taskGraph.AddTask([] {}, dependencies);
     }
 
     Light* light = lights_[lightIndex];
@@ -646,8 +655,8 @@ void DrawableProcessor::ProcessForwardLightingForLight(
     ctx.maxPixelLights_ = settings_.maxPixelLights_;
     ctx.lights_ = &lightDataForAccumulator_;
 
-    ForEachParallel(workQueue_, litGeometries,
-        [&](unsigned /*index*/, Drawable* geometry)
+    return taskGraph.AddForEachTask(litGeometries,
+        [=](unsigned /*index*/, Drawable* geometry)
     {
         const unsigned drawableIndex = geometry->GetDrawableIndex();
 
@@ -663,13 +672,21 @@ void DrawableProcessor::ProcessForwardLightingForLight(
         const float penalty = GetDrawableLightPenalty(distance * lightIntensityPenalty,
             isNegative, lightImportance, lightType);
         geometryLighting_[drawableIndex].AccumulateLight(ctx, geometry, lightImportance, lightIndex, penalty);
-    });
+    }, dependencies);
 }
 
 void DrawableProcessor::FinalizeForwardLighting()
 {
-    ForEachParallel(workQueue_, geometries_,
-        [&](unsigned /*index*/, Drawable* drawable)
+    TaskGraph taskGraph(workQueue_);
+    ScheduleFinalizeForwardLighting(taskGraph, {});
+    taskGraph.Execute();
+}
+
+TaskGraph::TaskId DrawableProcessor::ScheduleFinalizeForwardLighting(
+    TaskGraph& taskGraph, std::initializer_list<TaskGraph::TaskId> dependencies)
+{
+    return taskGraph.AddForEachTask(geometries_,
+        [this](unsigned /*index*/, Drawable* drawable)
     {
         const unsigned drawableIndex = drawable->GetDrawableIndex();
         const unsigned char flags = geometryFlags_[drawableIndex];
@@ -678,25 +695,37 @@ void DrawableProcessor::FinalizeForwardLighting()
             LightAccumulator& lightAccumulator = geometryLighting_[drawableIndex];
             lightAccumulator.Cook();
         }
-    });
+    }, dependencies);
 }
 
 void DrawableProcessor::ProcessForwardLighting()
 {
     URHO3D_PROFILE("ProcessForwardLighting");
 
-    bool hasForwardLights = false;
+    TaskGraph taskGraph(workQueue_);
+    ScheduleForwardLighting(taskGraph);
+    taskGraph.Execute();
+}
+
+TaskGraph::TaskId DrawableProcessor::ScheduleForwardLighting(TaskGraph& taskGraph)
+{
+    // Lights are processed one by one because they share light accumulators
+    ea::optional<TaskGraph::TaskId> previousTask;
     for (unsigned i = 0; i < lightProcessors_.size(); ++i)
     {
         const LightProcessor* lightProcessor = lightProcessors_[i];
         if (lightProcessor->HasForwardLitGeometries())
         {
-            ProcessForwardLightingForLight(i, lightProcessor->GetLitGeometries());
-            hasForwardLights = true;
+            const auto& litGeometries = lightProcessor->GetLitGeometries();
+            previousTask = previousTask
+                ? ScheduleForwardLightingForLight(taskGraph, i, litGeometries, {*previousTask})
+                : ScheduleForwardLightingForLight(taskGraph, i, litGeometries, {});
         }
     }
-    if (hasForwardLights)
-        FinalizeForwardLighting();
+
+    if (!previousTask)
+        return taskGraph.AddTask([] {});
+    return ScheduleFinalizeForwardLighting(taskGraph, {*previousTask});
 }
 
 void DrawableProcessor::PreprocessShadowCasters(ea::vector<Drawable*>& shadowCasters,
@@ -23,6 +23,7 @@
 #pragma once
 
 #include "../Core/Object.h"
+#include "../Core/TaskGraph.h"
 #include "../Core/WorkQueue.h"
 #include "../Graphics/GraphicsDefs.h"
 #include "../Math/NumericRange.h"
@@ -231,12 +232,19 @@ public:
     void FinalizeForwardLighting();
     /// Process forward lighting for all lights.
     void ProcessForwardLighting();
+    /// Schedule forward lighting for all lights in the task graph.
+    /// Returns the task that completes when forward lighting is finalized.
+    TaskGraph::TaskId ScheduleForwardLighting(TaskGraph& taskGraph);
 
     /// Update drawable geometries if needed.
     void UpdateGeometries();
 
 protected:
     void ProcessVisibleDrawable(Drawable* drawable);
+    TaskGraph::TaskId ScheduleForwardLightingForLight(TaskGraph& taskGraph, unsigned lightIndex,
+        const ea::vector<Drawable*>& litGeometries, std::initializer_list<TaskGraph::TaskId> dependencies);
+    TaskGraph::TaskId ScheduleFinalizeForwardLighting(
+        TaskGraph& taskGraph, std::initializer_list<TaskGraph::TaskId> dependencies);
     void ProcessQueuedDrawable(Drawable* drawable);
     void UpdateDrawableZone(const BoundingBox& boundingBox, Drawable* drawable) const;
     void UpdateDrawableReflection(const BoundingBox& boundingBox, Drawable* drawable) const;
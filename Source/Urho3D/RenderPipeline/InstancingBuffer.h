@@ -64,6 +64,14 @@ public:
         memcpy(currentInstanceData_ + index * ElementStride, data, count * ElementStride);
     }
 
+    /// Reserve range of instances to be filled later via InstancingBufferCursor.
+    /// Should be called from main thread. Returns index of first reserved instance.
+    unsigned ReserveInstances(unsigned count) { return vertexBuffer_->AddVertices(count).first; }
+    /// Return writeable data of reserved instance.
+    unsigned char* GetInstanceData(unsigned index) { return vertexBuffer_->GetVertexData(index); }
+    /// Return size of one instance in bytes.
+    unsigned GetInstanceStride() const { return vertexBuffer_->GetVertexSize(); }
+
     /// Getters
     /// @{
     const InstancingBufferSettings& GetSettings() const { return settings_; }
@@ -80,4 +88,37 @@ private:
     unsigned char* currentInstanceData_{};
 };
 
+/// Write cursor over the range of instances reserved in InstancingBuffer.
+/// Cursors over non-overlapping ranges can be used from different threads simultaneously.
+class InstancingBufferCursor
+{
+public:
+    InstancingBufferCursor(InstancingBuffer& instancingBuffer, unsigned firstInstance)
+        : nextInstanceIndex_(firstInstance)
+        , nextInstanceData_(instancingBuffer.GetInstanceData(firstInstance))
+        , stride_(instancingBuffer.GetInstanceStride())
+    {
+    }
+
+    /// Advance to next reserved instance. Use SetElements to fill it after.
+    unsigned AddInstance()
+    {
+        currentInstanceData_ = nextInstanceData_;
+        nextInstanceData_ += stride_;
+        return nextInstanceIndex_++;
+    }
+
+    /// Set one or more 4-float elements in current instance.
+    void SetElements(const void* data, unsigned index, unsigned count)
+    {
+        memcpy(currentInstanceData_ + index * InstancingBuffer::ElementStride, data, count * InstancingBuffer::ElementStride);
+    }
+
+private:
+    unsigned nextInstanceIndex_{};
+    unsigned char* nextInstanceData_{};
+    unsigned char* currentInstanceData_{};
+    unsigned stride_{};
+};
+
 }
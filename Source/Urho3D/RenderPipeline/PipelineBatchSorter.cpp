@@ -0,0 +1,278 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../Precompiled.h"
+
+#include "../Core/FrameAllocator.h"
+#include "../Core/WorkQueue.h"
+#include "../RenderPipeline/PipelineBatchSorter.h"
+
+#include <EASTL/sort.h>
+
+#include "../DebugNew.h"
+
+namespace Urho3D
+{
+
+namespace
+{
+
+static constexpr unsigned RadixSize = 256;
+static constexpr unsigned MaxRadixDigits = 16;
+
+/// 128-bit key with the least significant word first.
+struct RadixKey
+{
+    unsigned long long low_{};
+    unsigned long long high_{};
+};
+
+RadixKey GetRadixKey(const PipelineBatchByState& batch)
+{
+    return {batch.secondaryKey_, batch.primaryKey_};
+}
+
+RadixKey GetRadixKey(const PipelineBatchBackToFront& batch)
+{
+    // Map float to unsigned integer with the same order, then invert it to sort back to front
+    unsigned distanceBits{};
+    memcpy(&distanceBits, &batch.distance_, sizeof(distanceBits));
+    distanceBits = (distanceBits & 0x80000000u) ? ~distanceBits : (distanceBits | 0x80000000u);
+    return {(static_cast<unsigned long long>(batch.renderOrder_) << 32) | ~distanceBits, 0};
+}
+
+unsigned GetRadixDigit(const RadixKey& key, unsigned digit)
+{
+    const unsigned long long word = digit < 8 ? key.low_ : key.high_;
+    return static_cast<unsigned>(word >> ((digit % 8) * 8)) & (RadixSize - 1);
+}
+
+}
+
+void PipelineBatchRadixSort::Sort(ea::span<PipelineBatchByState> batches, WorkQueue* workQueue)
+{
+    if (batches.size() >= MinBatches)
+        RadixSort(batches, workQueue);
+    else
+        ea::sort(batches.begin(), batches.end());
+}
+
+void PipelineBatchRadixSort::Sort(ea::span<PipelineBatchBackToFront> batches, WorkQueue* workQueue)
+{
+    if (batches.size() >= MinBatches)
+        RadixSort(batches, workQueue);
+    else
+        ea::sort(batches.begin(), batches.end());
+}
+
+void PipelineBatchRadixSort::RadixSort(ea::span<PipelineBatchByState> batches, WorkQueue* workQueue)
+{
+    RadixSortImpl(batches, byStateBuffer_, workQueue);
+}
+
+void PipelineBatchRadixSort::RadixSort(ea::span<PipelineBatchBackToFront> batches, WorkQueue* workQueue)
+{
+    RadixSortImpl(batches, backToFrontBuffer_, workQueue);
+}
+
+template <class T>
+void PipelineBatchRadixSort::RadixSortImpl(ea::span<T> batches, ea::vector<T>& buffer, WorkQueue* workQueue)
+{
+    const unsigned numBatches = batches.size();
+    if (numBatches < 2)
+        return;
+
+    // Split batches into chunks, each chunk has its own histogram
+    const unsigned numThreads = workQueue ? workQueue->GetNumProcessingThreads() : 1;
+    const unsigned chunkSize = numThreads > 1
+        ? ea::max(MinBatchesPerTask, (numBatches + numThreads - 1) / numThreads)
+        : numBatches;
+    const unsigned numChunks = (numBatches + chunkSize - 1) / chunkSize;
+    histograms_.resize(numChunks * RadixSize);
+
+    // Find bits that differ between batches
+    FrameVector<RadixKey> chunkDifferences(numChunks);
+    const RadixKey firstKey = GetRadixKey(batches[0]);
+    ForEachParallel(workQueue, chunkSize, numBatches, [&](unsigned beginIndex, unsigned endIndex)
+    {
+        RadixKey difference;
+        for (unsigned i = beginIndex; i < endIndex; ++i)
+        {
+            const RadixKey key = GetRadixKey(batches[i]);
+            difference.low_ |= key.low_ ^ firstKey.low_;
+            difference.high_ |= key.high_ ^ firstKey.high_;
+        }
+        chunkDifferences[beginIndex / chunkSize] = difference;
+    });
+
+    RadixKey difference;
+    for (const RadixKey& chunkDifference : chunkDifferences)
+    {
+        difference.low_ |= chunkDifference.low_;
+        difference.high_ |= chunkDifference.high_;
+    }
+
+    buffer.resize(numBatches);
+    T* source = batches.data();
+    T* destination = buffer.data();
+    for (unsigned digit = 0; digit < MaxRadixDigits; ++digit)
+    {
+        if (GetRadixDigit(difference, digit) == 0)
+            continue;
+
+        // Count digits in each chunk
+        ForEachParallel(workQueue, chunkSize, numBatches, [&](unsigned beginIndex, unsigned endIndex)
+        {
+            unsigned* histogram = &histograms_[beginIndex / chunkSize * RadixSize];
+            ea::fill_n(histogram, RadixSize, 0u);
+            for (unsigned i = beginIndex; i < endIndex; ++i)
+                ++histogram[GetRadixDigit(GetRadixKey(source[i]), digit)];
+        });
+
+        // Convert counts to output offsets, chunks are ordered within each digit value
+        unsigned offset = 0;
+        for (unsigned value = 0; value < RadixSize; ++value)
+        {
+            for (unsigned chunk = 0; chunk < numChunks; ++chunk)
+            {
+                unsigned& count = histograms_[chunk * RadixSize + value];
+                const unsigned chunkOffset = offset;
+                offset += count;
+                count = chunkOffset;
+            }
+        }
+
+        // Scatter batches
+        ForEachParallel(workQueue, chunkSize, numBatches, [&](unsigned beginIndex, unsigned endIndex)
+        {
+            unsigned* offsets = &histograms_[beginIndex / chunkSize * RadixSize];
+            for (unsigned i = beginIndex; i < endIndex; ++i)
+                destination[offsets[GetRadixDigit(GetRadixKey(source[i]), digit)]++] = source[i];
+        });
+
+        ea::swap(source, destination);
+    }
+
+    if (source != batches.data())
+        ea::copy(source, source + numBatches, batches.data());
+}
+
+void PipelineBatchSorter::Sort(ea::span<PipelineBatchByState> batches, WorkQueue* workQueue)
+{
+    const unsigned numBatches = batches.size();
+    numReusedBatches_ = 0;
+
+    // Split batches into ones with retained order and new ones
+    retainedToCurrent_.assign(retainedBatches_.size(), M_MAX_UNSIGNED);
+    newBatches_.clear();
+    if (!retainedBatches_.empty())
+    {
+        for (unsigned i = 0; i < numBatches; ++i)
+        {
+            const unsigned retainedIndex = FindRetainedBatch(batches[i]);
+            if (retainedIndex != M_MAX_UNSIGNED)
+            {
+                retainedToCurrent_[retainedIndex] = i;
+                ++numReusedBatches_;
+            }
+            else
+                newBatches_.push_back(batches[i]);
+        }
+    }
+
+    // Sort from scratch if there's not much to reuse
+    if (numReusedBatches_ == 0 || numReusedBatches_ < numBatches / 2)
+    {
+        numReusedBatches_ = 0;
+        radixSort_.Sort(batches, workQueue);
+        RetainBatches(batches);
+        return;
+    }
+
+    reusedBatches_.clear();
+    for (unsigned currentIndex : retainedToCurrent_)
+    {
+        if (currentIndex != M_MAX_UNSIGNED)
+            reusedBatches_.push_back(batches[currentIndex]);
+    }
+
+    radixSort_.Sort(newBatches_, workQueue);
+    ea::merge(reusedBatches_.begin(), reusedBatches_.end(), newBatches_.begin(), newBatches_.end(), batches.begin());
+    RetainBatches(batches);
+}
+
+void PipelineBatchSorter::Reset()
+{
+    retainedBatches_.clear();
+    firstRetainedBatch_.clear();
+    numReusedBatches_ = 0;
+}
+
+unsigned PipelineBatchSorter::FindRetainedBatch(const PipelineBatchByState& batch) const
+{
+    const PipelineBatch& pipelineBatch = *batch.pipelineBatch_;
+    const unsigned drawableIndex = pipelineBatch.drawableIndex_;
+    if (drawableIndex >= firstRetainedBatch_.size())
+        return M_MAX_UNSIGNED;
+
+    for (unsigned index = firstRetainedBatch_[drawableIndex]; index != M_MAX_UNSIGNED;
+         index = retainedBatches_[index].nextBatch_)
+    {
+        const RetainedBatch& retainedBatch = retainedBatches_[index];
+        if (retainedToCurrent_[index] == M_MAX_UNSIGNED
+            && retainedBatch.drawable_ == pipelineBatch.drawable_
+            && retainedBatch.sourceBatchIndex_ == pipelineBatch.sourceBatchIndex_
+            && retainedBatch.primaryKey_ == batch.primaryKey_
+            && retainedBatch.secondaryKey_ == batch.secondaryKey_)
+            return index;
+    }
+    return M_MAX_UNSIGNED;
+}
+
+void PipelineBatchSorter::RetainBatches(ea::span<const PipelineBatchByState> batches)
+{
+    // Unlink previous batches without touching the whole array
+    for (const RetainedBatch& retainedBatch : retainedBatches_)
+        firstRetainedBatch_[retainedBatch.drawableIndex_] = M_MAX_UNSIGNED;
+
+    const unsigned numBatches = batches.size();
+    retainedBatches_.resize(numBatches);
+    for (unsigned i = 0; i < numBatches; ++i)
+    {
+        const PipelineBatch& pipelineBatch = *batches[i].pipelineBatch_;
+        const unsigned drawableIndex = pipelineBatch.drawableIndex_;
+        if (drawableIndex >= firstRetainedBatch_.size())
+            firstRetainedBatch_.resize(drawableIndex + 1, M_MAX_UNSIGNED);
+
+        RetainedBatch& retainedBatch = retainedBatches_[i];
+        retainedBatch.drawable_ = pipelineBatch.drawable_;
+        retainedBatch.drawableIndex_ = drawableIndex;
+        retainedBatch.sourceBatchIndex_ = pipelineBatch.sourceBatchIndex_;
+        retainedBatch.primaryKey_ = batches[i].primaryKey_;
+        retainedBatch.secondaryKey_ = batches[i].secondaryKey_;
+        retainedBatch.nextBatch_ = firstRetainedBatch_[drawableIndex];
+        firstRetainedBatch_[drawableIndex] = i;
+    }
+}
+
+}
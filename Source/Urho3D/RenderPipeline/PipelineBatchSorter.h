@@ -0,0 +1,119 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#pragma once
+
+#include "../RenderPipeline/PipelineBatchSortKey.h"
+
+#include <EASTL/span.h>
+#include <EASTL/vector.h>
+
+namespace Urho3D
+{
+
+class WorkQueue;
+
+/// Sorts batches by sort keys with parallel LSD radix sort.
+/// Bytes of the key that are the same for all batches are skipped.
+/// Keeps temporary buffers between calls.
+class URHO3D_API PipelineBatchRadixSort
+{
+public:
+    /// Minimum number of batches for which Sort uses radix sort instead of comparison sort.
+    static constexpr unsigned MinBatches = 4096;
+    /// Minimum number of batches processed by one task.
+    static constexpr unsigned MinBatchesPerTask = 4096;
+
+    /// Sort batches. Radix sort is used for large arrays and comparison sort for small ones.
+    /// @{
+    void Sort(ea::span<PipelineBatchByState> batches, WorkQueue* workQueue = nullptr);
+    void Sort(ea::span<PipelineBatchBackToFront> batches, WorkQueue* workQueue = nullptr);
+    /// @}
+
+    /// Sort batches with radix sort regardless of array size.
+    /// @{
+    void RadixSort(ea::span<PipelineBatchByState> batches, WorkQueue* workQueue = nullptr);
+    void RadixSort(ea::span<PipelineBatchBackToFront> batches, WorkQueue* workQueue = nullptr);
+    /// @}
+
+private:
+    template <class T> void RadixSortImpl(ea::span<T> batches, ea::vector<T>& buffer, WorkQueue* workQueue);
+
+    ea::vector<PipelineBatchByState> byStateBuffer_;
+    ea::vector<PipelineBatchBackToFront> backToFrontBuffer_;
+    ea::vector<unsigned> histograms_;
+};
+
+/// Sorts PipelineBatchByState using the order retained from the previous sort as a hint.
+///
+/// Batches of the same Drawable and SourceBatch whose sort keys are unchanged since the previous sort
+/// keep their relative order and are only merged with sorted new and changed batches.
+/// Pipeline states and materials contribute to sort keys,
+/// so batches with states recreated due to PipelineStateTracker changes are sorted from scratch.
+class URHO3D_API PipelineBatchSorter
+{
+public:
+    /// Sort batches and retain order for the next sort.
+    void Sort(ea::span<PipelineBatchByState> batches, WorkQueue* workQueue = nullptr);
+    /// Forget retained order.
+    void Reset();
+
+    /// Return number of batches that reused retained order during the last sort.
+    unsigned GetNumReusedBatches() const { return numReusedBatches_; }
+
+private:
+    /// Batch from the previous sort.
+    struct RetainedBatch
+    {
+        const Drawable* drawable_{};
+        unsigned drawableIndex_{};
+        unsigned sourceBatchIndex_{};
+        unsigned long long primaryKey_{};
+        unsigned long long secondaryKey_{};
+        /// Next retained batch of the same drawable index.
+        unsigned nextBatch_{};
+    };
+
+    /// Find unused retained batch matching the batch. Return M_MAX_UNSIGNED if not found.
+    unsigned FindRetainedBatch(const PipelineBatchByState& batch) const;
+    /// Retain order of sorted batches.
+    void RetainBatches(ea::span<const PipelineBatchByState> batches);
+
+    /// Retained batches in sorted order.
+    ea::vector<RetainedBatch> retainedBatches_;
+    /// Index of the first retained batch for each drawable index.
+    ea::vector<unsigned> firstRetainedBatch_;
+
+    PipelineBatchRadixSort radixSort_;
+
+    /// Temporary buffers
+    /// @{
+    ea::vector<unsigned> retainedToCurrent_;
+    ea::vector<PipelineBatchByState> reusedBatches_;
+    ea::vector<PipelineBatchByState> newBatches_;
+    /// @}
+
+    unsigned numReusedBatches_{};
+};
+
+}
@@ -155,6 +155,8 @@ void RenderPipelineSettings::PropagateImpliedSettings()
             instancingBuffer_.numInstancingTexCoords_ = 3 + 7;
             break;
         }
+        if (instancingBuffer_.enableCustomData_)
+            ++instancingBuffer_.numInstancingTexCoords_;
     }
 
     // TODO: Revisit this place, it may be incorrect for Optimized color space used in VR
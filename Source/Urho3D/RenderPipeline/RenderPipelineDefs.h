@@ -385,6 +385,9 @@ struct DrawableProcessorSettings
 struct InstancingBufferSettings
 {
     bool enableInstancing_{};
+    /// Whether to reserve one vec4 per instance for custom data provided by SourceBatch::instancingData_.
+    /// If disabled, batches with custom data are rendered without instancing.
+    bool enableCustomData_{};
     unsigned firstInstancingTexCoord_{};
     unsigned numInstancingTexCoords_{};
     unsigned stepRate_{ 1 };
@@ -395,6 +398,7 @@ struct InstancingBufferSettings
     {
         unsigned hash = 0;
         CombineHash(hash, enableInstancing_);
+        CombineHash(hash, enableCustomData_);
         CombineHash(hash, firstInstancingTexCoord_);
         CombineHash(hash, numInstancingTexCoords_);
         CombineHash(hash, stepRate_);
@@ -408,6 +412,7 @@ struct InstancingBufferSettings
     bool operator==(const InstancingBufferSettings& rhs) const
     {
         return enableInstancing_ == rhs.enableInstancing_
+            && enableCustomData_ == rhs.enableCustomData_
             && firstInstancingTexCoord_ == rhs.firstInstancingTexCoord_
             && numInstancingTexCoords_ == rhs.numInstancingTexCoords_
             && stepRate_ == rhs.stepRate_;
@@ -504,6 +509,8 @@ struct OcclusionBufferSettings
     unsigned maxOccluderTriangles_{ 5000 };
     unsigned occlusionBufferSize_{ 256 };
     float occluderSizeThreshold_{ 0.025f };
+    /// Whether to seed occlusion buffer with previous frame depth and rasterize only new and moved occluders.
+    bool temporalOcclusion_{};
 
     /// Utility operators
     /// @{
@@ -522,7 +529,8 @@ struct OcclusionBufferSettings
         return threadedOcclusion_ == rhs.threadedOcclusion_
             && maxOccluderTriangles_ == rhs.maxOccluderTriangles_
             && occlusionBufferSize_ == rhs.occlusionBufferSize_
-            && occluderSizeThreshold_ == rhs.occluderSizeThreshold_;
+            && occluderSizeThreshold_ == rhs.occluderSizeThreshold_
+            && temporalOcclusion_ == rhs.temporalOcclusion_;
     }
 
     bool operator!=(const OcclusionBufferSettings& rhs) const { return !(*this == rhs); }
@@ -57,12 +57,14 @@ void UnorderedScenePass::OnBatchesReady()
     BatchCompositor::FillSortKeys(sortedBaseBatches_, baseBatches_);
     BatchCompositor::FillSortKeys(sortedLightBatches_, lightBatches_, negativeLightBatches_);
 
-    ea::sort(sortedDeferredBatches_.begin(), sortedDeferredBatches_.end());
-    ea::sort(sortedBaseBatches_.begin(), sortedBaseBatches_.end());
+    deferredBatchSorter_.Sort(sortedDeferredBatches_, workQueue_);
+    baseBatchSorter_.Sort(sortedBaseBatches_, workQueue_);
 
     const unsigned numNegativeLightBatches = negativeLightBatches_.Size();
-    ea::sort(sortedLightBatches_.begin(), sortedLightBatches_.end() - numNegativeLightBatches);
-    ea::sort(sortedLightBatches_.end() - numNegativeLightBatches, sortedLightBatches_.end());
+    const unsigned numLightBatches = sortedLightBatches_.size() - numNegativeLightBatches;
+    lightBatchSorter_.Sort({sortedLightBatches_.data(), numLightBatches}, workQueue_);
+    negativeLightBatchSorter_.Sort(
+        {sortedLightBatches_.data() + numLightBatches, numNegativeLightBatches}, workQueue_);
 
     deferredBatchGroup_ = { sortedDeferredBatches_ };
     baseBatchGroup_ = { sortedBaseBatches_ };
@@ -149,7 +151,7 @@ void BackToFrontScenePass::OnBatchesReady()
     for (unsigned i = subtractiveLightBatchesBegin; i < subtractiveLightBatchesEnd; ++i)
         sortedBatches_[i].distance_ *= subtractiveDistanceFactor;
 
-    ea::sort(sortedBatches_.begin(), sortedBatches_.end());
+    radixSort_.Sort(sortedBatches_, workQueue_);
 
     if (GetFlags().Test(DrawableProcessorPassFlag::RefractionPass))
     {
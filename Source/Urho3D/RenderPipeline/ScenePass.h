@@ -24,6 +24,7 @@
 
 #include "../Core/Object.h"
 #include "../RenderPipeline/PipelineBatchSortKey.h"
+#include "../RenderPipeline/PipelineBatchSorter.h"
 #include "../RenderPipeline/BatchCompositor.h"
 #include "../RenderPipeline/DrawableProcessor.h"
 
@@ -76,6 +77,14 @@ protected:
     ea::vector<PipelineBatchByState> sortedBaseBatches_;
     ea::vector<PipelineBatchByState> sortedLightBatches_;
 
+    /// Sorters that reuse order of unchanged batches between frames.
+    /// @{
+    PipelineBatchSorter deferredBatchSorter_;
+    PipelineBatchSorter baseBatchSorter_;
+    PipelineBatchSorter lightBatchSorter_;
+    PipelineBatchSorter negativeLightBatchSorter_;
+    /// @}
+
     PipelineBatchGroup<PipelineBatchByState> deferredBatchGroup_;
     PipelineBatchGroup<PipelineBatchByState> baseBatchGroup_;
     PipelineBatchGroup<PipelineBatchByState> lightBatchGroup_;
@@ -99,6 +108,7 @@ protected:
     void OnBatchesReady() override;
 
     ea::vector<PipelineBatchBackToFront> sortedBatches_;
+    PipelineBatchRadixSort radixSort_;
     bool hasRefractionBatches_{};
 
     PipelineBatchGroup<PipelineBatchBackToFront> batchGroup_;
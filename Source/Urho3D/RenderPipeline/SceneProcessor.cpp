@@ -23,7 +23,9 @@
 #include "../Precompiled.h"
 
 #include "../Core/Context.h"
+#include "../Core/FrameAllocator.h"
 #include "../Core/IteratorRange.h"
+#include "../Core/TaskGraph.h"
 #include "../Graphics/Drawable.h"
 #include "../RenderAPI/DrawCommandQueue.h"
 #include "../Graphics/OcclusionBuffer.h"
@@ -267,6 +269,7 @@ void SceneProcessor::SetPasses(ea::vector<SharedPtr<ScenePass>> passes)
 void SceneProcessor::SetSettings(const ShaderProgramCompositorSettings& settings)
 {
     pipelineStateBuilder_->SetSettings(settings);
+    batchCompositor_->SetInstancingCustomData(settings.instancingBuffer_.enableCustomData_);
 
     if (settings_ != settings.sceneProcessor_)
     {
@@ -315,23 +318,35 @@ void SceneProcessor::Update()
     else
     {
         URHO3D_PROFILE("QueryVisibleDrawables");
-        FrustumOctreeQuery drawableQuery(drawables_, frustum,
+        frameInfo_.octree_->GetDrawablesInFrustum(drawables_, frustum,
             DRAWABLE_GEOMETRY | DRAWABLE_LIGHT, frameInfo_.camera_->GetViewMask());
-        frameInfo_.octree_->GetDrawables(drawableQuery);
     }
 
     // Process drawables
     drawableProcessor_->ProcessVisibleDrawables(drawables_, currentOcclusionBuffer_ ? ea::span(&currentOcclusionBuffer_, 1u) : ea::span<OcclusionBuffer*>() );
     drawableProcessor_->ProcessLights(this);
-    drawableProcessor_->ProcessForwardLighting();
-
-    batchCompositor_->ComposeSceneBatches();
-    if (settings_.enableShadows_)
-        batchCompositor_->ComposeShadowBatches();
+    ProcessLightingAndComposeBatches();
     if (settings_.IsDeferredLighting())
         batchCompositor_->ComposeLightVolumeBatches();
 }
 
+void SceneProcessor::ProcessLightingAndComposeBatches()
+{
+    URHO3D_PROFILE("ProcessLightingAndComposeBatches");
+
+    // Shadow batches don't depend on forward lighting, so they are composed while forward lighting is processed
+    TaskGraph taskGraph(GetSubsystem<WorkQueue>());
+    const TaskGraph::TaskId forwardLightingTask = drawableProcessor_->ScheduleForwardLighting(taskGraph);
+    batchCompositor_->ScheduleSceneBatches(taskGraph, {forwardLightingTask});
+    if (settings_.enableShadows_)
+        batchCompositor_->ScheduleShadowBatches(taskGraph);
+    taskGraph.Execute();
+
+    batchCompositor_->FinalizeSceneBatches();
+    if (settings_.enableShadows_)
+        batchCompositor_->FinalizeShadowBatches();
+}
+
 void SceneProcessor::PrepareInstancingBuffer()
 {
     if (!instancingBuffer_->IsEnabled())
@@ -543,7 +558,15 @@ void SceneProcessor::DrawOccluders()
     occlusionBuffer_->SetMaxTriangles(settings_.maxOccluderTriangles_);
     occlusionBuffer_->Clear();
 
-    if (!occlusionBuffer_->IsThreaded())
+    if (!settings_.temporalOcclusion_ && occlusionBuffer_->HasDepthHistory())
+    {
+        temporalOcclusion_.Reset();
+        occlusionBuffer_->ResetDepthHistory();
+    }
+
+    if (settings_.temporalOcclusion_)
+        temporalOcclusion_.DrawOccluders(occlusionBuffer_, activeOccluders);
+    else if (!occlusionBuffer_->IsThreaded())
     {
         // If not threaded, draw occluders one by one and test the next occluder against already rasterized depth
         for (unsigned i = 0; i < activeOccluders.size(); ++i)
@@ -24,6 +24,7 @@
 
 #include "../RenderPipeline/RenderPipelineDefs.h"
 #include "../RenderPipeline/PipelineBatchSortKey.h"
+#include "../RenderPipeline/TemporalOcclusion.h"
 
 namespace Urho3D
 {
@@ -107,6 +108,9 @@ public:
 
 protected:
     virtual void DrawOccluders();
+    /// Process forward lighting and compose scene and shadow batches.
+    /// Independent stages are executed concurrently.
+    void ProcessLightingAndComposeBatches();
 
 private:
     /// Callbacks from RenderPipeline
@@ -160,6 +164,8 @@ protected:
 
     OcclusionBuffer* currentOcclusionBuffer_{};
     ea::vector<Drawable*> occluders_;
+
+    TemporalOcclusion temporalOcclusion_;
     ea::vector<Drawable*> drawables_;
 };
 
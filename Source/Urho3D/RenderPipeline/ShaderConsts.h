@@ -107,6 +107,7 @@ namespace ShaderConsts
     URHO3D_SHADER_CONST(Object, Ambient);
     URHO3D_SHADER_CONST(Object, BillboardRot);
     URHO3D_SHADER_CONST(Object, SkinMatrices);
+    URHO3D_SHADER_CONST(Object, InstanceData);
 };
 
 /// Built-in shader resources.
@@ -123,6 +124,7 @@ namespace ShaderResources
     URHO3D_SHADER_RESOURCE(LightShape);
     URHO3D_SHADER_RESOURCE(ShadowMap);
     URHO3D_SHADER_RESOURCE(DepthBuffer);
+    URHO3D_SHADER_RESOURCE(AnimationPalette);
 }
 
 }
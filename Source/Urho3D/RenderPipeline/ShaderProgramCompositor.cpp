@@ -186,7 +186,11 @@ void ShaderProgramCompositor::ApplyGeometryVertexDefines(ShaderProgramDesc& resu
 {
     result.isInstancingUsed_ = IsInstancingUsed(flags, geometry, geometryType);
     if (result.isInstancingUsed_)
+    {
         result.AddShaderDefines(VS, "URHO3D_INSTANCING");
+        if (settings_.instancingBuffer_.enableCustomData_)
+            result.AddShaderDefines(VS, "URHO3D_INSTANCING_CUSTOM_DATA");
+    }
 
     static const ea::string geometryDefines[] = {
         "URHO3D_GEOMETRY_STATIC ",
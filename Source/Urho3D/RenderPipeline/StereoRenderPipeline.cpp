@@ -231,11 +231,7 @@ public:
         drawableProcessor_->ProcessVisibleDrawables(drawables_,
             currentOcclusionBuffer_ ? ea::span(&currentOcclusionBuffer_, 1u) : ea::span<OcclusionBuffer*>());
         drawableProcessor_->ProcessLights(this);
-        drawableProcessor_->ProcessForwardLighting();
-
-        batchCompositor_->ComposeSceneBatches();
-        if (settings_.enableShadows_)
-            batchCompositor_->ComposeShadowBatches();
+        ProcessLightingAndComposeBatches();
     }
 
 protected:
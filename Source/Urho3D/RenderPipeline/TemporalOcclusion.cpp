@@ -0,0 +1,128 @@
+//
+// Copyright (c) 2017-2020 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "../Precompiled.h"
+
+#include "../Core/FrameAllocator.h"
+#include "../Graphics/Drawable.h"
+#include "../Graphics/OcclusionBuffer.h"
+#include "../RenderPipeline/TemporalOcclusion.h"
+
+#include "../DebugNew.h"
+
+namespace Urho3D
+{
+
+namespace
+{
+
+/// Reprojection error accumulates over time, so history is reset periodically.
+const unsigned maxFramesWithoutReset = 16;
+
+}
+
+void TemporalOcclusion::DrawOccluders(OcclusionBuffer* buffer, ea::span<const SortedOccluder> occluders)
+{
+    // History is only valid if all occluders rendered into it are still live occluders that didn't move.
+    bool historyValid = ++numFramesSinceReset_ < maxFramesWithoutReset;
+    for (auto& [drawable, history] : occluderHistory_)
+    {
+        history.active_ = false;
+        if (!historyValid || !history.inDepthHistory_)
+            continue;
+
+        if (!IsUnchanged(history))
+            historyValid = false;
+    }
+
+    if (historyValid)
+        historyValid = buffer->ReprojectDepthHistory();
+
+    if (!historyValid)
+    {
+        numFramesSinceReset_ = 0;
+        for (auto& [drawable, history] : occluderHistory_)
+            history.inDepthHistory_ = false;
+    }
+
+    // Draw occluders that didn't move since the last frame and are not in history yet, then store depth
+    // as history for the next frame. Moved occluders are drawn after that.
+    FrameVector<Drawable*> movedOccluders;
+    bool budgetExceeded = false;
+    for (const SortedOccluder& occluder : occluders)
+    {
+        Drawable* drawable = occluder.drawable_;
+
+        const auto iter = occluderHistory_.find(drawable);
+        const bool isStatic = iter != occluderHistory_.end() && IsUnchanged(iter->second);
+
+        OccluderHistory& history = occluderHistory_[drawable];
+        history.active_ = true;
+        if (isStatic && history.inDepthHistory_)
+            continue;
+
+        history.drawable_ = drawable;
+        history.boundingBox_ = drawable->GetWorldBoundingBox();
+        if (!isStatic)
+            movedOccluders.push_back(drawable);
+        else if (!budgetExceeded)
+        {
+            budgetExceeded = !drawable->DrawOcclusion(buffer);
+            history.inDepthHistory_ = true;
+        }
+    }
+
+    buffer->DrawTriangles();
+    buffer->StoreDepthHistory();
+
+    for (Drawable* drawable : movedOccluders)
+    {
+        if (budgetExceeded)
+            break;
+        budgetExceeded = !drawable->DrawOcclusion(buffer);
+    }
+    buffer->DrawTriangles();
+
+    // Forget occluders that are neither active nor contribute to history
+    ea::erase_if(occluderHistory_, [](const auto& item) { return !item.second.active_ && !item.second.inDepthHistory_; });
+}
+
+void TemporalOcclusion::Reset()
+{
+    occluderHistory_.clear();
+    numFramesSinceReset_ = 0;
+}
+
+bool TemporalOcclusion::IsInDepthHistory(Drawable* drawable) const
+{
+    const auto iter = occluderHistory_.find(drawable);
+    return iter != occluderHistory_.end() && iter->second.inDepthHistory_;
+}
+
+bool TemporalOcclusion::IsUnchanged(const OccluderHistory& history)
+{
+    Drawable* drawable = history.drawable_;
+    return drawable && drawable->IsEnabledEffective() && drawable->GetOctant() && drawable->IsOccluder()
+        && drawable->GetWorldBoundingBox() == history.boundingBox_;
+}
+
+}
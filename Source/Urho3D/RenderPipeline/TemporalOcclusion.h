@@ -0,0 +1,70 @@
+//
+// Copyright (c) 2017-2020 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#pragma once
+
+#include "../Container/Ptr.h"
+#include "../Math/BoundingBox.h"
+#include "../RenderPipeline/DrawableProcessor.h"
+
+#include <EASTL/span.h>
+#include <EASTL/unordered_map.h>
+
+namespace Urho3D
+{
+
+class Drawable;
+class OcclusionBuffer;
+
+/// Draws occluders on top of occlusion depth reprojected from the previous frame.
+/// Occluders that are already stored in depth history are not rasterized again.
+class URHO3D_API TemporalOcclusion
+{
+public:
+    /// Draw occluders into cleared occlusion buffer. Depth hierarchy is not built.
+    void DrawOccluders(OcclusionBuffer* buffer, ea::span<const SortedOccluder> occluders);
+    /// Forget all occluders. Depth history of occlusion buffer should be reset too.
+    void Reset();
+
+    /// Return whether the occluder is stored in depth history.
+    bool IsInDepthHistory(Drawable* drawable) const;
+
+private:
+    /// Occluder state of the previous frame.
+    struct OccluderHistory
+    {
+        WeakPtr<Drawable> drawable_;
+        BoundingBox boundingBox_;
+        /// Whether occluder is rendered into occlusion depth history.
+        bool inDepthHistory_{};
+        /// Whether occluder was active in the last frame.
+        bool active_{};
+    };
+
+    /// Return whether the occluder still exists, is still an enabled occluder in the octree and didn't move.
+    static bool IsUnchanged(const OccluderHistory& history);
+
+    ea::unordered_map<Drawable*, OccluderHistory> occluderHistory_;
+    unsigned numFramesSinceReset_{};
+};
+
+}
@@ -23,10 +23,8 @@
 #include "../Precompiled.h"
 
 #include "../IO/Log.h"
-#if defined(URHO3D_PHYSICS) || defined(URHO3D_PHYSICS2D)
-#include "../Physics/PhysicsEvents.h"
-#endif
 #include "../Scene/LogicComponent.h"
+#include "../Scene/LogicComponentScheduler.h"
 #include "../Scene/Scene.h"
 #include "../Scene/SceneEvents.h"
 
@@ -39,6 +37,7 @@ LogicComponent::LogicComponent(Context* context) :
     currentEventMask_(0),
     delayedStartCalled_(false)
 {
+    schedulerIndices_.fill(M_MAX_UNSIGNED);
 }
 
 LogicComponent::~LogicComponent() = default;
@@ -73,6 +72,10 @@ void LogicComponent::SetUpdateEventMask(UpdateEventFlags mask)
 {
     if (updateEventMask_ != mask)
     {
+        // Component should be moved to another group of the scheduler
+        if ((updateEventMask_ ^ mask) & USE_PARALLEL_UPDATE)
+            UnsubscribeFromUpdateEvents();
+
         updateEventMask_ = mask;
         UpdateEventSubscription();
     }
@@ -98,13 +101,8 @@ void LogicComponent::OnSceneSet(Scene* scene)
         UpdateEventSubscription();
     else
     {
-        UnsubscribeFromEvent(E_SCENEUPDATE);
-        UnsubscribeFromEvent(GetPostUpdateEvent());
-#if defined(URHO3D_PHYSICS) || defined(URHO3D_PHYSICS2D)
-        UnsubscribeFromEvent(E_PHYSICSPRESTEP);
-        UnsubscribeFromEvent(E_PHYSICSPOSTSTEP);
-#endif
-        currentEventMask_ = USE_NO_EVENT;
+        UnsubscribeFromUpdateEvents();
+        scheduler_ = nullptr;
     }
 }
 
@@ -114,29 +112,24 @@ void LogicComponent::UpdateEventSubscription()
     if (!scene)
         return;
 
-    bool enabled = IsEnabledEffective();
+    scheduler_ = scene->GetLogicComponentScheduler();
+    const bool enabled = IsEnabledEffective();
 
-    bool needUpdate = enabled && ((updateEventMask_ & USE_UPDATE) || !delayedStartCalled_);
-    if (needUpdate && !(currentEventMask_ & USE_UPDATE))
-    {
-        SubscribeToEvent(scene, E_SCENEUPDATE, URHO3D_HANDLER(LogicComponent, HandleSceneUpdate));
-        currentEventMask_ |= USE_UPDATE;
-    }
-    else if (!needUpdate && (currentEventMask_ & USE_UPDATE))
-    {
-        UnsubscribeFromEvent(scene, E_SCENEUPDATE);
-        currentEventMask_ &= ~USE_UPDATE;
-    }
+    const bool needUpdate = enabled && ((updateEventMask_ & USE_UPDATE) || !delayedStartCalled_);
+    SetUpdatePhaseScheduled(LogicUpdatePhase::Update, USE_UPDATE, needUpdate);
 
-    bool needPostUpdate = enabled && (updateEventMask_ & USE_POSTUPDATE);
-    if (needPostUpdate && !(currentEventMask_ & USE_POSTUPDATE))
+    const bool needPostUpdate = enabled && (updateEventMask_ & USE_POSTUPDATE);
+    const StringHash postUpdateEvent = GetPostUpdateEvent();
+    if (postUpdateEvent == E_SCENEPOSTUPDATE)
+        SetUpdatePhaseScheduled(LogicUpdatePhase::PostUpdate, USE_POSTUPDATE, needPostUpdate);
+    else if (needPostUpdate && !(currentEventMask_ & USE_POSTUPDATE))
     {
-        SubscribeToEvent(scene, GetPostUpdateEvent(), URHO3D_HANDLER(LogicComponent, HandleScenePostUpdate));
+        SubscribeToEvent(scene, postUpdateEvent, &LogicComponent::HandleCustomPostUpdate);
         currentEventMask_ |= USE_POSTUPDATE;
     }
     else if (!needPostUpdate && (currentEventMask_ & USE_POSTUPDATE))
     {
-        UnsubscribeFromEvent(scene, GetPostUpdateEvent());
+        UnsubscribeFromEvent(scene, postUpdateEvent);
         currentEventMask_ &= ~USE_POSTUPDATE;
     }
 
@@ -145,88 +138,78 @@ void LogicComponent::UpdateEventSubscription()
     if (!world)
         return;
 
-    bool needFixedUpdate = enabled && (updateEventMask_ & USE_FIXEDUPDATE);
-    if (needFixedUpdate && !(currentEventMask_ & USE_FIXEDUPDATE))
-    {
-        SubscribeToEvent(world, E_PHYSICSPRESTEP, URHO3D_HANDLER(LogicComponent, HandlePhysicsPreStep));
-        currentEventMask_ |= USE_FIXEDUPDATE;
-    }
-    else if (!needFixedUpdate && (currentEventMask_ & USE_FIXEDUPDATE))
-    {
-        UnsubscribeFromEvent(world, E_PHYSICSPRESTEP);
-        currentEventMask_ &= ~USE_FIXEDUPDATE;
-    }
+    scheduler_->SetFixedUpdateSource(world);
 
-    bool needFixedPostUpdate = enabled && (updateEventMask_ & USE_FIXEDPOSTUPDATE);
-    if (needFixedPostUpdate && !(currentEventMask_ & USE_FIXEDPOSTUPDATE))
-    {
-        SubscribeToEvent(world, E_PHYSICSPOSTSTEP, URHO3D_HANDLER(LogicComponent, HandlePhysicsPostStep));
-        currentEventMask_ |= USE_FIXEDPOSTUPDATE;
-    }
-    else if (!needFixedPostUpdate && (currentEventMask_ & USE_FIXEDPOSTUPDATE))
-    {
-        UnsubscribeFromEvent(world, E_PHYSICSPOSTSTEP);
-        currentEventMask_ &= ~USE_FIXEDPOSTUPDATE;
-    }
+    const bool needFixedUpdate = enabled && (updateEventMask_ & USE_FIXEDUPDATE);
+    SetUpdatePhaseScheduled(LogicUpdatePhase::FixedUpdate, USE_FIXEDUPDATE, needFixedUpdate);
+
+    const bool needFixedPostUpdate = enabled && (updateEventMask_ & USE_FIXEDPOSTUPDATE);
+    SetUpdatePhaseScheduled(LogicUpdatePhase::FixedPostUpdate, USE_FIXEDPOSTUPDATE, needFixedPostUpdate);
 #endif
 }
 
-void LogicComponent::HandleSceneUpdate(StringHash eventType, VariantMap& eventData)
+void LogicComponent::UnsubscribeFromUpdateEvents()
 {
-    using namespace SceneUpdate;
+    SetUpdatePhaseScheduled(LogicUpdatePhase::Update, USE_UPDATE, false);
+    SetUpdatePhaseScheduled(LogicUpdatePhase::FixedUpdate, USE_FIXEDUPDATE, false);
+    SetUpdatePhaseScheduled(LogicUpdatePhase::FixedPostUpdate, USE_FIXEDPOSTUPDATE, false);
 
-    // Execute user-defined delayed start function before first update
-    if (!delayedStartCalled_)
+    const StringHash postUpdateEvent = GetPostUpdateEvent();
+    if (postUpdateEvent == E_SCENEPOSTUPDATE)
+        SetUpdatePhaseScheduled(LogicUpdatePhase::PostUpdate, USE_POSTUPDATE, false);
+    else
     {
-        DelayedStart();
-        delayedStartCalled_ = true;
-
-        // If did not need actual update events, unsubscribe now
-        if (!(updateEventMask_ & USE_UPDATE))
-        {
-            UnsubscribeFromEvent(GetScene(), E_SCENEUPDATE);
-            currentEventMask_ &= ~USE_UPDATE;
-            return;
-        }
+        UnsubscribeFromEvent(postUpdateEvent);
+        currentEventMask_ &= ~USE_POSTUPDATE;
     }
-
-    // Then execute user-defined update function
-    Update(eventData[P_TIMESTEP].GetFloat());
 }
 
-void LogicComponent::HandleScenePostUpdate(StringHash eventType, VariantMap& eventData)
+void LogicComponent::SetUpdatePhaseScheduled(LogicUpdatePhase phase, UpdateEvent flag, bool scheduled)
 {
-    using namespace ScenePostUpdate;
+    if (scheduled == currentEventMask_.Test(flag))
+        return;
 
-    // Execute user-defined post-update function
-    PostUpdate(eventData[P_TIMESTEP].GetFloat());
+    if (scheduled)
+    {
+        scheduler_->AddComponent(this, phase);
+        currentEventMask_ |= flag;
+    }
+    else
+    {
+        if (scheduler_)
+            scheduler_->RemoveComponent(this, phase);
+        currentEventMask_ &= ~flag;
+    }
 }
 
-#if defined(URHO3D_PHYSICS) || defined(URHO3D_PHYSICS2D)
-
-void LogicComponent::HandlePhysicsPreStep(StringHash eventType, VariantMap& eventData)
+void LogicComponent::ResetSchedulerState()
 {
-    using namespace PhysicsPreStep;
-
-    // Execute user-defined delayed start function before first fixed update if not called yet
-    if (!delayedStartCalled_)
+    static const UpdateEvent phaseFlags[] = {USE_UPDATE, USE_POSTUPDATE, USE_FIXEDUPDATE, USE_FIXEDPOSTUPDATE};
+    for (unsigned i = 0; i < schedulerIndices_.size(); ++i)
     {
-        DelayedStart();
-        delayedStartCalled_ = true;
+        if (schedulerIndices_[i] != M_MAX_UNSIGNED)
+            currentEventMask_ &= ~phaseFlags[i];
     }
 
-    // Execute user-defined fixed update function
-    FixedUpdate(eventData[P_TIMESTEP].GetFloat());
+    schedulerIndices_.fill(M_MAX_UNSIGNED);
+    schedulerGroup_ = M_MAX_UNSIGNED;
 }
 
-void LogicComponent::HandlePhysicsPostStep(StringHash eventType, VariantMap& eventData)
+void LogicComponent::ExecuteDelayedStart()
 {
-    using namespace PhysicsPostStep;
+    DelayedStart();
+    delayedStartCalled_ = true;
 
-    // Execute user-defined fixed post-update function
-    FixedPostUpdate(eventData[P_TIMESTEP].GetFloat());
+    // If did not need actual update events, unsubscribe now
+    UpdateEventSubscription();
 }
 
-#endif
+void LogicComponent::HandleCustomPostUpdate(StringHash eventType, VariantMap& eventData)
+{
+    using namespace ScenePostUpdate;
+
+    // Execute user-defined post-update function
+    PostUpdate(eventData[P_TIMESTEP].GetFloat());
+}
 
 }
@@ -26,10 +26,15 @@
 
 #include "../Container/FlagSet.h"
 #include "../Scene/Component.h"
+#include "../Scene/SceneEvents.h"
+
+#include <EASTL/array.h>
 
 namespace Urho3D
 {
 
+class LogicComponentScheduler;
+
 enum UpdateEvent : unsigned
 {
     /// Bitmask for not using any events.
@@ -42,9 +47,22 @@ enum UpdateEvent : unsigned
     USE_FIXEDUPDATE = 0x4,
     /// Bitmask for using the physics post-update event.
     USE_FIXEDPOSTUPDATE = 0x8,
+    /// Bitmask for updating components in parallel from worker threads.
+    /// Update functions should not modify shared state or create and remove components.
+    USE_PARALLEL_UPDATE = 0x10,
 };
 URHO3D_FLAGSET(UpdateEvent, UpdateEventFlags);
 
+/// Update phase of LogicComponent.
+enum class LogicUpdatePhase
+{
+    Update,
+    PostUpdate,
+    FixedUpdate,
+    FixedPostUpdate,
+    Count
+};
+
 /// Helper base class for user-defined game logic components that hooks up to update events and forwards them to virtual functions similar to ScriptInstance class.
 class URHO3D_API LogicComponent : public Component
 {
@@ -95,24 +113,33 @@ protected:
     void OnSceneSet(Scene* scene) override;
 
 private:
+    friend class LogicComponentScheduler;
+
     /// Subscribe/unsubscribe to update events based on current enabled state and update event mask.
     void UpdateEventSubscription();
-    /// Handle scene update event.
-    void HandleSceneUpdate(StringHash eventType, VariantMap& eventData);
-    /// Handle scene post-update event.
-    void HandleScenePostUpdate(StringHash eventType, VariantMap& eventData);
-#if defined(URHO3D_PHYSICS) || defined(URHO3D_PHYSICS2D)
-    /// Handle physics pre-step event.
-    void HandlePhysicsPreStep(StringHash eventType, VariantMap& eventData);
-    /// Handle physics post-step event.
-    void HandlePhysicsPostStep(StringHash eventType, VariantMap& eventData);
-#endif
+    /// Unsubscribe from all update events.
+    void UnsubscribeFromUpdateEvents();
+    /// Add to or remove from update phase of the scheduler.
+    void SetUpdatePhaseScheduled(LogicUpdatePhase phase, UpdateEvent flag, bool scheduled);
+    /// Reset state related to the scheduler when the scheduler is destroyed.
+    void ResetSchedulerState();
+    /// Execute delayed start. Called by the scheduler before the first update.
+    void ExecuteDelayedStart();
+    /// Handle custom post-update event.
+    void HandleCustomPostUpdate(StringHash eventType, VariantMap& eventData);
+
     /// Requested event subscription mask.
     UpdateEventFlags updateEventMask_;
     /// Current event subscription mask.
     UpdateEventFlags currentEventMask_;
     /// Flag for delayed start.
     bool delayedStartCalled_;
+    /// Scheduler that updates this component.
+    WeakPtr<LogicComponentScheduler> scheduler_;
+    /// Index of component group in the scheduler.
+    unsigned schedulerGroup_{M_MAX_UNSIGNED};
+    /// Indices of the component in the scheduler arrays for each update phase.
+    ea::array<unsigned, static_cast<unsigned>(LogicUpdatePhase::Count)> schedulerIndices_;
 };
 
 }
@@ -0,0 +1,308 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../Precompiled.h"
+
+#include "../Scene/LogicComponentScheduler.h"
+
+#include "../Core/Profiler.h"
+#include "../Core/WorkQueue.h"
+#if defined(URHO3D_PHYSICS) || defined(URHO3D_PHYSICS2D)
+#include "../Physics/PhysicsEvents.h"
+#endif
+#include "../Scene/Scene.h"
+
+#include "../DebugNew.h"
+
+namespace Urho3D
+{
+
+namespace
+{
+
+/// Minimum number of components processed by one worker thread at once.
+static const unsigned MinParallelBucketSize = 16;
+
+using LogicComponentMethod = void (LogicComponent::*)(float timeStep);
+
+LogicComponentMethod GetPhaseMethod(LogicUpdatePhase phase)
+{
+    switch (phase)
+    {
+    case LogicUpdatePhase::Update: return &LogicComponent::Update;
+    case LogicUpdatePhase::PostUpdate: return &LogicComponent::PostUpdate;
+    case LogicUpdatePhase::FixedUpdate: return &LogicComponent::FixedUpdate;
+    case LogicUpdatePhase::FixedPostUpdate: return &LogicComponent::FixedPostUpdate;
+    default: return nullptr;
+    }
+}
+
+bool NeedsDelayedStart(LogicUpdatePhase phase)
+{
+    return phase == LogicUpdatePhase::Update || phase == LogicUpdatePhase::FixedUpdate;
+}
+
+}
+
+LogicComponentScheduler::LogicComponentScheduler(Context* context, Scene* scene)
+    : Object(context)
+    , scene_(scene)
+    , workQueue_(GetSubsystem<WorkQueue>())
+{
+}
+
+LogicComponentScheduler::~LogicComponentScheduler()
+{
+    // Components may outlive the scheduler, reset their state
+    for (ComponentGroup& group : groups_)
+    {
+        for (PhaseComponents& phaseComponents : group.phases_)
+        {
+            for (LogicComponent* component : phaseComponents.components_)
+            {
+                if (component)
+                    component->ResetSchedulerState();
+            }
+        }
+    }
+}
+
+void LogicComponentScheduler::AddComponent(LogicComponent* component, LogicUpdatePhase phase)
+{
+    const unsigned phaseIndex = static_cast<unsigned>(phase);
+    URHO3D_ASSERT(component->schedulerIndices_[phaseIndex] == M_MAX_UNSIGNED);
+
+    if (component->schedulerGroup_ == M_MAX_UNSIGNED)
+    {
+        const bool isParallel = component->GetUpdateEventMask().Test(USE_PARALLEL_UPDATE);
+        component->schedulerGroup_ = GetOrCreateGroup(component->GetType(), isParallel);
+    }
+
+    PhaseComponents& phaseComponents = groups_[component->schedulerGroup_].phases_[phaseIndex];
+    component->schedulerIndices_[phaseIndex] = phaseComponents.components_.size();
+    phaseComponents.components_.push_back(component);
+}
+
+void LogicComponentScheduler::RemoveComponent(LogicComponent* component, LogicUpdatePhase phase)
+{
+    const unsigned phaseIndex = static_cast<unsigned>(phase);
+    const unsigned index = component->schedulerIndices_[phaseIndex];
+    if (index == M_MAX_UNSIGNED)
+        return;
+
+    // Don't change the order of components, just leave a hole
+    PhaseComponents& phaseComponents = groups_[component->schedulerGroup_].phases_[phaseIndex];
+    URHO3D_ASSERT(phaseComponents.components_[index] == component);
+    phaseComponents.components_[index] = nullptr;
+    ++phaseComponents.numRemoved_;
+
+    component->schedulerIndices_[phaseIndex] = M_MAX_UNSIGNED;
+    if (ea::all_of(component->schedulerIndices_.begin(), component->schedulerIndices_.end(),
+        [](unsigned index) { return index == M_MAX_UNSIGNED; }))
+    {
+        component->schedulerGroup_ = M_MAX_UNSIGNED;
+    }
+
+    // Don't let holes accumulate if there are no updates for a while
+    if (updateDepth_ == 0 && phaseComponents.numRemoved_ > phaseComponents.components_.size() / 2)
+        Compact(phaseComponents, phase);
+}
+
+void LogicComponentScheduler::SetFixedUpdateSource(Component* source)
+{
+    if (fixedUpdateSource_.Get() == source)
+        return;
+
+#if defined(URHO3D_PHYSICS) || defined(URHO3D_PHYSICS2D)
+    if (fixedUpdateSource_)
+    {
+        UnsubscribeFromEvent(fixedUpdateSource_, E_PHYSICSPRESTEP);
+        UnsubscribeFromEvent(fixedUpdateSource_, E_PHYSICSPOSTSTEP);
+    }
+
+    if (source)
+    {
+        SubscribeToEvent(source, E_PHYSICSPRESTEP, &LogicComponentScheduler::HandlePhysicsPreStep);
+        SubscribeToEvent(source, E_PHYSICSPOSTSTEP, &LogicComponentScheduler::HandlePhysicsPostStep);
+    }
+#endif
+
+    fixedUpdateSource_ = source;
+}
+
+void LogicComponentScheduler::Update(LogicUpdatePhase phase, float timeStep)
+{
+    URHO3D_PROFILE("UpdateLogicComponents");
+
+    const unsigned phaseIndex = static_cast<unsigned>(phase);
+    if (updateDepth_ == 0)
+    {
+        for (ComponentGroup& group : groups_)
+        {
+            PhaseComponents& phaseComponents = group.phases_[phaseIndex];
+            if (phaseComponents.numRemoved_ > 0)
+                Compact(phaseComponents, phase);
+        }
+    }
+
+    const bool isMultithreaded = workQueue_ && workQueue_->IsMultithreaded();
+
+    ++updateDepth_;
+
+    // Groups may be added during update, don't keep references
+    const unsigned numGroups = groups_.size();
+    for (unsigned groupIndex = 0; groupIndex < numGroups; ++groupIndex)
+    {
+        if (groups_[groupIndex].phases_[phaseIndex].components_.empty())
+            continue;
+
+        if (isMultithreaded && groups_[groupIndex].isParallel_)
+            UpdateGroupParallel(groupIndex, phase, timeStep);
+        else
+            UpdateGroup(groupIndex, phase, timeStep);
+    }
+
+    --updateDepth_;
+}
+
+unsigned LogicComponentScheduler::GetNumComponents(LogicUpdatePhase phase) const
+{
+    const unsigned phaseIndex = static_cast<unsigned>(phase);
+
+    unsigned numComponents = 0;
+    for (const ComponentGroup& group : groups_)
+    {
+        const PhaseComponents& phaseComponents = group.phases_[phaseIndex];
+        numComponents += phaseComponents.components_.size() - phaseComponents.numRemoved_;
+    }
+    return numComponents;
+}
+
+unsigned LogicComponentScheduler::GetOrCreateGroup(StringHash componentType, bool isParallel)
+{
+    const auto key = ea::make_pair(componentType, isParallel);
+    const auto iter = groupIndices_.find(key);
+    if (iter != groupIndices_.end())
+        return iter->second;
+
+    const unsigned groupIndex = groups_.size();
+    ComponentGroup& group = groups_.emplace_back();
+    group.componentType_ = componentType;
+    group.isParallel_ = isParallel;
+    groupIndices_.emplace(key, groupIndex);
+    return groupIndex;
+}
+
+void LogicComponentScheduler::UpdateGroup(unsigned groupIndex, LogicUpdatePhase phase, float timeStep)
+{
+    const unsigned phaseIndex = static_cast<unsigned>(phase);
+    const LogicComponentMethod method = GetPhaseMethod(phase);
+    const bool needsDelayedStart = NeedsDelayedStart(phase);
+
+    // Components may be added or removed during update, don't keep references.
+    // Components added during update will be updated next time.
+    const unsigned numComponents = groups_[groupIndex].phases_[phaseIndex].components_.size();
+    for (unsigned i = 0; i < numComponents; ++i)
+    {
+        const auto& components = groups_[groupIndex].phases_[phaseIndex].components_;
+        LogicComponent* component = components[i];
+        if (!component)
+            continue;
+
+        if (needsDelayedStart && !component->IsDelayedStartCalled())
+        {
+            component->ExecuteDelayedStart();
+
+            // Component may have been removed from this phase or destroyed
+            if (groups_[groupIndex].phases_[phaseIndex].components_[i] != component)
+                continue;
+        }
+
+        (component->*method)(timeStep);
+    }
+}
+
+void LogicComponentScheduler::UpdateGroupParallel(unsigned groupIndex, LogicUpdatePhase phase, float timeStep)
+{
+    const unsigned phaseIndex = static_cast<unsigned>(phase);
+    const LogicComponentMethod method = GetPhaseMethod(phase);
+
+    // Delayed start is not guaranteed to be thread-safe, execute it in the main thread
+    if (NeedsDelayedStart(phase))
+    {
+        const unsigned numComponents = groups_[groupIndex].phases_[phaseIndex].components_.size();
+        for (unsigned i = 0; i < numComponents; ++i)
+        {
+            LogicComponent* component = groups_[groupIndex].phases_[phaseIndex].components_[i];
+            if (component && !component->IsDelayedStartCalled())
+                component->ExecuteDelayedStart();
+        }
+    }
+
+    // Components are not allowed to add or remove components during parallel update
+    const ea::vector<LogicComponent*>& components = groups_[groupIndex].phases_[phaseIndex].components_;
+    const unsigned numComponents = components.size();
+    const unsigned numTasks = workQueue_->GetNumProcessingThreads() * 4;
+    const unsigned bucketSize = ea::max(MinParallelBucketSize, (numComponents + numTasks - 1) / numTasks);
+
+    scene_->BeginThreadedUpdate();
+    ForEachParallel(workQueue_, bucketSize, numComponents,
+        [&](unsigned beginIndex, unsigned endIndex)
+    {
+        for (unsigned i = beginIndex; i < endIndex; ++i)
+        {
+            if (LogicComponent* component = components[i])
+                (component->*method)(timeStep);
+        }
+    });
+    scene_->EndThreadedUpdate();
+}
+
+void LogicComponentScheduler::Compact(PhaseComponents& phaseComponents, LogicUpdatePhase phase)
+{
+    URHO3D_ASSERT(updateDepth_ == 0);
+
+    const unsigned phaseIndex = static_cast<unsigned>(phase);
+    ea::erase(phaseComponents.components_, nullptr);
+    for (unsigned i = 0; i < phaseComponents.components_.size(); ++i)
+        phaseComponents.components_[i]->schedulerIndices_[phaseIndex] = i;
+    phaseComponents.numRemoved_ = 0;
+}
+
+#if defined(URHO3D_PHYSICS) || defined(URHO3D_PHYSICS2D)
+
+void LogicComponentScheduler::HandlePhysicsPreStep(StringHash eventType, VariantMap& eventData)
+{
+    using namespace PhysicsPreStep;
+    Update(LogicUpdatePhase::FixedUpdate, eventData[P_TIMESTEP].GetFloat());
+}
+
+void LogicComponentScheduler::HandlePhysicsPostStep(StringHash eventType, VariantMap& eventData)
+{
+    using namespace PhysicsPostStep;
+    Update(LogicUpdatePhase::FixedPostUpdate, eventData[P_TIMESTEP].GetFloat());
+}
+
+#endif
+
+}
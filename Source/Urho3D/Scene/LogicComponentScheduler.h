@@ -0,0 +1,117 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+/// \file
+
+#pragma once
+
+#include "../Core/Object.h"
+#include "../Scene/LogicComponent.h"
+
+#include <EASTL/array.h>
+#include <EASTL/unordered_map.h>
+
+namespace Urho3D
+{
+
+class Scene;
+class WorkQueue;
+
+/// Scene-level scheduler of LogicComponent updates.
+/// Components are grouped by type and updated in tight per-type loops in order of type registration.
+/// Components of types with USE_PARALLEL_UPDATE flag are updated from worker threads.
+class URHO3D_API LogicComponentScheduler : public Object
+{
+    URHO3D_OBJECT(LogicComponentScheduler, Object);
+
+public:
+    LogicComponentScheduler(Context* context, Scene* scene);
+    ~LogicComponentScheduler() override;
+
+    /// Add component to the update phase. Component should not be already added.
+    void AddComponent(LogicComponent* component, LogicUpdatePhase phase);
+    /// Remove component from the update phase. Safe to call during update.
+    void RemoveComponent(LogicComponent* component, LogicUpdatePhase phase);
+    /// Set source of fixed update events. Should be PhysicsWorld or PhysicsWorld2D.
+    void SetFixedUpdateSource(Component* source);
+
+    /// Execute update phase for all components.
+    void Update(LogicUpdatePhase phase, float timeStep);
+
+    /// Return number of components in the update phase.
+    unsigned GetNumComponents(LogicUpdatePhase phase) const;
+    /// Return number of component groups.
+    unsigned GetNumGroups() const { return groups_.size(); }
+
+private:
+    static constexpr unsigned NumPhases = static_cast<unsigned>(LogicUpdatePhase::Count);
+
+    /// Components of one group in one update phase.
+    struct PhaseComponents
+    {
+        /// Components. Removed components are replaced with null until compaction.
+        ea::vector<LogicComponent*> components_;
+        /// Number of null elements in the array.
+        unsigned numRemoved_{};
+    };
+
+    /// Components of the same type and update mode.
+    struct ComponentGroup
+    {
+        StringHash componentType_;
+        bool isParallel_{};
+        ea::array<PhaseComponents, NumPhases> phases_;
+    };
+
+    /// Return index of component group, create if missing.
+    unsigned GetOrCreateGroup(StringHash componentType, bool isParallel);
+    /// Execute update phase for the group in the main thread.
+    void UpdateGroup(unsigned groupIndex, LogicUpdatePhase phase, float timeStep);
+    /// Execute update phase for the group in worker threads.
+    void UpdateGroupParallel(unsigned groupIndex, LogicUpdatePhase phase, float timeStep);
+    /// Remove null elements from the phase array.
+    void Compact(PhaseComponents& phaseComponents, LogicUpdatePhase phase);
+
+#if defined(URHO3D_PHYSICS) || defined(URHO3D_PHYSICS2D)
+    /// Handle physics pre-step event.
+    void HandlePhysicsPreStep(StringHash eventType, VariantMap& eventData);
+    /// Handle physics post-step event.
+    void HandlePhysicsPostStep(StringHash eventType, VariantMap& eventData);
+#endif
+
+    /// Scene that owns the scheduler.
+    Scene* scene_{};
+    /// Work queue used for parallel updates.
+    WeakPtr<WorkQueue> workQueue_;
+    /// Source of fixed update events.
+    WeakPtr<Component> fixedUpdateSource_;
+
+    /// Component groups in order of creation.
+    ea::vector<ComponentGroup> groups_;
+    /// Component group lookup by component type and update mode.
+    ea::unordered_map<ea::pair<StringHash, bool>, unsigned> groupIndices_;
+    /// Depth of nested updates. Arrays are not compacted during update.
+    unsigned updateDepth_{};
+};
+
+}
@@ -36,6 +36,7 @@
 #include "../Scene/PrefabWriter.h"
 #include "../Scene/Scene.h"
 #include "../Scene/SceneEvents.h"
+#include "../Scene/SceneTransformStore.h"
 #include "../Scene/UnknownComponent.h"
 
 #include "../DebugNew.h"
@@ -930,6 +931,8 @@ void Node::MarkDirty()
         if (cur->dirty_)
             return;
         cur->dirty_ = true;
+        if (cur->transformIndex_ != M_MAX_UNSIGNED)
+            cur->scene_->GetTransformStore()->MarkDirty(cur->transformIndex_);
 
         // Notify listener components first, then mark child nodes
         for (auto i = cur->listeners_.begin(); i !=
@@ -1021,6 +1024,12 @@ void Node::AddChild(Node* node, unsigned index)
     node->parent_ = this;
     node->MarkDirty();
 
+    if (scene_)
+    {
+        if (SceneTransformStore* transformStore = scene_->GetTransformStore())
+            transformStore->MarkHierarchyDirty();
+    }
+
     // Send change event
     if (scene_)
     {
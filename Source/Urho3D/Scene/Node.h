@@ -90,6 +90,7 @@ class URHO3D_API Node : public Serializable
     URHO3D_OBJECT(Node, Serializable);
 
     friend class Connection;
+    friend class SceneTransformStore;
 
 public:
     /// Construct.
@@ -798,6 +799,8 @@ private:
     Scene* scene_;
     /// Unique ID within the scene.
     unsigned id_;
+    /// Index in the transform store of the scene, if enabled.
+    unsigned transformIndex_{M_MAX_UNSIGNED};
     /// Position.
     Vector3 position_;
     /// Rotation.
@@ -38,11 +38,13 @@
 #include "Urho3D/Resource/XMLArchive.h"
 #include "Urho3D/Resource/XMLFile.h"
 #include "Urho3D/Scene/Component.h"
+#include "Urho3D/Scene/LogicComponentScheduler.h"
 #include "Urho3D/Scene/ObjectAnimation.h"
 #include "Urho3D/Scene/PrefabReference.h"
 #include "Urho3D/Scene/PrefabResource.h"
 #include "Urho3D/Scene/SceneEvents.h"
 #include "Urho3D/Scene/SceneResource.h"
+#include "Urho3D/Scene/SceneTransformStore.h"
 #include "Urho3D/Scene/ShakeComponent.h"
 #include "Urho3D/Scene/SplinePath.h"
 #include "Urho3D/Scene/UnknownComponent.h"
@@ -70,6 +72,14 @@ Scene::Scene(Context* context) :
     SetID(GetFreeNodeID());
     NodeAdded(this);
 
+    logicComponentScheduler_ = MakeShared<LogicComponentScheduler>(context, this);
+
+    // Logic components are updated as the first specific receiver of the scene, as if each of them was subscribed
+    SubscribeToTypedEvent<SceneUpdateEventData>(this, E_SCENEUPDATE, [this](const SceneUpdateEventData& eventData)
+    { logicComponentScheduler_->Update(LogicUpdatePhase::Update, eventData.timeStep_); });
+    SubscribeToTypedEvent<SceneUpdateEventData>(this, E_SCENEPOSTUPDATE, [this](const SceneUpdateEventData& eventData)
+    { logicComponentScheduler_->Update(LogicUpdatePhase::PostUpdate, eventData.timeStep_); });
+
     SubscribeToEvent(E_UPDATE, URHO3D_HANDLER(Scene, HandleUpdate));
     SubscribeToEvent(E_RESOURCEBACKGROUNDLOADED, URHO3D_HANDLER(Scene, HandleResourceBackgroundLoaded));
 }
@@ -783,14 +793,13 @@ void Scene::Update(float timeStep)
 
     timeStep *= timeScale_;
 
-    using namespace SceneUpdate;
-
-    VariantMap& eventData = GetEventDataMap();
-    eventData[P_SCENE] = this;
-    eventData[P_TIMESTEP] = timeStep;
+    const SceneUpdateEventData typedEventData{this, timeStep};
 
     // Update variable timestep logic
-    SendEvent(E_SCENEUPDATE, eventData);
+    SendTypedEvent(E_SCENEUPDATE, typedEventData);
+
+    VariantMap& eventData = GetEventDataMap();
+    typedEventData.ToVariantMap(eventData);
 
     // Update scene attribute animation.
     SendEvent(E_ATTRIBUTEANIMATIONUPDATE, eventData);
@@ -799,7 +808,9 @@ void Scene::Update(float timeStep)
     SendEvent(E_SCENESUBSYSTEMUPDATE, eventData);
 
     // Post-update variable timestep logic
-    SendEvent(E_SCENEPOSTUPDATE, eventData);
+    SendTypedEvent(E_SCENEPOSTUPDATE, typedEventData);
+
+    UpdateTransforms();
 
     // Note: using a float for elapsed time accumulation is inherently inaccurate. The purpose of this value is
     // primarily to update material animation effects, as it is available to shaders. It can be reset by calling
@@ -807,6 +818,41 @@ void Scene::Update(float timeStep)
     elapsedTime_ += timeStep;
 }
 
+void SceneUpdateEventData::ToVariantMap(VariantMap& eventData) const
+{
+    using namespace SceneUpdate;
+    eventData[P_SCENE] = scene_;
+    eventData[P_TIMESTEP] = timeStep_;
+}
+
+SceneUpdateEventData SceneUpdateEventData::FromVariantMap(const VariantMap& eventData)
+{
+    using namespace SceneUpdate;
+    const auto getValue = [&](StringHash key) -> const Variant&
+    {
+        const auto iter = eventData.find(key);
+        return iter != eventData.end() ? iter->second : Variant::EMPTY;
+    };
+    return {static_cast<Scene*>(getValue(P_SCENE).GetPtr()), getValue(P_TIMESTEP).GetFloat()};
+}
+
+void Scene::SetTransformStoreEnabled(bool enable)
+{
+    if (enable == IsTransformStoreEnabled())
+        return;
+
+    if (enable)
+        transformStore_ = ea::make_unique<SceneTransformStore>(this, GetSubsystem<WorkQueue>());
+    else
+        transformStore_ = nullptr;
+}
+
+void Scene::UpdateTransforms()
+{
+    if (transformStore_)
+        transformStore_->Update();
+}
+
 void Scene::BeginThreadedUpdate()
 {
     // Check the work queue subsystem whether it actually has created worker threads. If not, do not enter threaded mode.
@@ -879,6 +925,8 @@ void Scene::NodeAdded(Node* node)
         oldScene->NodeRemoved(node);
 
     node->SetScene(this);
+    if (transformStore_)
+        transformStore_->MarkHierarchyDirty();
 
     // If the new node has an ID of zero (default), assign a replicated ID now
     unsigned id = node->GetID();
@@ -933,6 +981,8 @@ void Scene::NodeRemoved(Node* node)
     unsigned id = node->GetID();
     replicatedNodes_.erase(id);
 
+    if (transformStore_)
+        transformStore_->RemoveNode(node);
     node->ResetScene();
 
     // Remove node from tag cache
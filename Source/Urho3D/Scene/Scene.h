@@ -38,7 +38,9 @@ namespace Urho3D
 {
 
 class File;
+class LogicComponentScheduler;
 class PackageFile;
+class SceneTransformStore;
 class Texture2D;
 
 /// TODO: Get rid of "replicated" word in the code. It is not used in the networking code anymore.
@@ -260,6 +262,19 @@ public:
 
     /// Return threaded update flag.
     bool IsThreadedUpdate() const { return threadedUpdate_; }
+    /// Return scheduler of LogicComponent updates.
+    LogicComponentScheduler* GetLogicComponentScheduler() const { return logicComponentScheduler_; }
+
+    /// Enable or disable structure-of-arrays storage of world transforms.
+    /// When enabled, world transforms of all dirty nodes are updated in parallel at the end of Update.
+    /// Use it for scenes with many moving nodes.
+    void SetTransformStoreEnabled(bool enable);
+    /// Return whether the transform store is enabled.
+    bool IsTransformStoreEnabled() const { return transformStore_ != nullptr; }
+    /// Return transform store, if enabled.
+    SceneTransformStore* GetTransformStore() const { return transformStore_.get(); }
+    /// Update world transforms of all dirty nodes. Does nothing if the transform store is disabled.
+    void UpdateTransforms();
 
     /// Get free node ID.
     unsigned GetFreeNodeID();
@@ -333,6 +348,10 @@ private:
     ea::vector<Component*> delayedDirtyComponents_;
     /// Mutex for the delayed dirty notification queue.
     Mutex sceneMutex_;
+    /// Scheduler of LogicComponent updates.
+    SharedPtr<LogicComponentScheduler> logicComponentScheduler_;
+    /// Structure-of-arrays storage of world transforms.
+    ea::unique_ptr<SceneTransformStore> transformStore_;
     /// Next free non-local node ID.
     unsigned replicatedNodeID_;
     /// Next free non-local component ID.
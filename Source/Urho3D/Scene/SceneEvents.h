@@ -34,6 +34,22 @@ URHO3D_EVENT(E_SCENEUPDATE, SceneUpdate)
     URHO3D_PARAM(P_TIMESTEP, TimeStep);            // float
 }
 
+class Scene;
+
+/// Typed data of E_SCENEUPDATE and E_SCENEPOSTUPDATE, see Object::SendTypedEvent.
+struct URHO3D_API SceneUpdateEventData
+{
+    /// Scene being updated.
+    Scene* scene_{};
+    /// Time step, scaled by scene time scale.
+    float timeStep_{};
+
+    /// Fill event data for legacy subscribers.
+    void ToVariantMap(VariantMap& eventData) const;
+    /// Read event data sent by legacy senders.
+    static SceneUpdateEventData FromVariantMap(const VariantMap& eventData);
+};
+
 /// Network-aware scene update.
 /// In standalone mode, SceneNetworkUpdate is equivalent to SceneUpdate.
 /// In server mode, SceneNetworkUpdate is called once per network frame with fixed timestep.
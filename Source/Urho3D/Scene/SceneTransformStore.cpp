@@ -0,0 +1,184 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../Precompiled.h"
+
+#include "../Scene/SceneTransformStore.h"
+
+#include "../Core/Profiler.h"
+#include "../Core/WorkQueue.h"
+#include "../Scene/Scene.h"
+
+#include "../DebugNew.h"
+
+namespace Urho3D
+{
+
+namespace
+{
+
+/// Minimum number of nodes processed by one worker thread at once.
+static const unsigned MinParallelBucketSize = 256;
+
+}
+
+SceneTransformStore::SceneTransformStore(Scene* scene, WorkQueue* workQueue)
+    : scene_(scene)
+    , workQueue_(workQueue)
+{
+}
+
+SceneTransformStore::~SceneTransformStore()
+{
+    ResetNodeIndices();
+}
+
+void SceneTransformStore::RemoveNode(Node* node)
+{
+    const unsigned index = node->transformIndex_;
+    if (index == M_MAX_UNSIGNED)
+        return;
+
+    nodes_[index] = nullptr;
+    node->transformIndex_ = M_MAX_UNSIGNED;
+    hierarchyDirty_ = true;
+}
+
+void SceneTransformStore::Update()
+{
+    URHO3D_PROFILE("UpdateSceneTransforms");
+
+    if (hierarchyDirty_)
+        Rebuild();
+
+    const bool isMultithreaded = workQueue_ && workQueue_->IsMultithreaded();
+    const unsigned numTasks = workQueue_ ? workQueue_->GetNumProcessingThreads() * 4 : 1;
+
+    // Parents are always updated before children because levels are processed in order
+    const unsigned numLevels = GetNumLevels();
+    for (unsigned level = 0; level < numLevels; ++level)
+    {
+        const unsigned levelBegin = levelOffsets_[level];
+        const unsigned levelSize = levelOffsets_[level + 1] - levelBegin;
+
+        if (!isMultithreaded)
+        {
+            UpdateRange(levelBegin, levelBegin + levelSize);
+            continue;
+        }
+
+        const unsigned bucketSize = ea::max(MinParallelBucketSize, (levelSize + numTasks - 1) / numTasks);
+        ForEachParallel(workQueue_, bucketSize, levelSize,
+            [this, levelBegin](unsigned beginIndex, unsigned endIndex)
+        {
+            UpdateRange(levelBegin + beginIndex, levelBegin + endIndex);
+        });
+    }
+}
+
+void SceneTransformStore::Rebuild()
+{
+    URHO3D_PROFILE("RebuildSceneTransforms");
+
+    ResetNodeIndices();
+
+    nodes_.clear();
+    parentIndices_.clear();
+    levelOffsets_.clear();
+
+    const auto addNode = [this](Node* node, unsigned parentIndex)
+    {
+        node->transformIndex_ = nodes_.size();
+        nodes_.push_back(node);
+        parentIndices_.push_back(parentIndex);
+    };
+
+    // Children of the scene ignore the transform of the scene itself
+    for (Node* child : scene_->GetChildren())
+        addNode(child, M_MAX_UNSIGNED);
+
+    // Breadth-first traversal, one level per iteration
+    unsigned levelBegin = 0;
+    levelOffsets_.push_back(0);
+    while (levelBegin < nodes_.size())
+    {
+        const unsigned levelEnd = nodes_.size();
+        levelOffsets_.push_back(levelEnd);
+
+        for (unsigned parentIndex = levelBegin; parentIndex < levelEnd; ++parentIndex)
+        {
+            for (Node* child : nodes_[parentIndex]->GetChildren())
+                addNode(child, parentIndex);
+        }
+
+        levelBegin = levelEnd;
+    }
+
+    // Don't trust anything after the rebuild
+    const unsigned numNodes = nodes_.size();
+    dirtyFlags_.assign(numNodes, 1);
+    worldTransforms_.resize(numNodes);
+    worldRotations_.resize(numNodes);
+
+    hierarchyDirty_ = false;
+}
+
+void SceneTransformStore::ResetNodeIndices()
+{
+    for (Node* node : nodes_)
+    {
+        if (node)
+            node->transformIndex_ = M_MAX_UNSIGNED;
+    }
+}
+
+void SceneTransformStore::UpdateRange(unsigned beginIndex, unsigned endIndex)
+{
+    for (unsigned index = beginIndex; index < endIndex; ++index)
+    {
+        if (!dirtyFlags_[index])
+            continue;
+
+        Node* node = nodes_[index];
+        const Matrix3x4 localTransform{node->position_, node->rotation_, node->scale_};
+
+        const unsigned parentIndex = parentIndices_[index];
+        if (parentIndex == M_MAX_UNSIGNED)
+        {
+            worldTransforms_[index] = localTransform;
+            worldRotations_[index] = node->rotation_;
+        }
+        else
+        {
+            worldTransforms_[index] = worldTransforms_[parentIndex] * localTransform;
+            worldRotations_[index] = worldRotations_[parentIndex] * node->rotation_;
+        }
+
+        node->worldTransform_ = worldTransforms_[index];
+        node->worldRotation_ = worldRotations_[index];
+        node->dirty_ = false;
+        dirtyFlags_[index] = 0;
+    }
+}
+
+}
@@ -0,0 +1,91 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+/// \file
+
+#pragma once
+
+#include "../Math/Matrix3x4.h"
+#include "../Math/Quaternion.h"
+
+#include <EASTL/vector.h>
+
+namespace Urho3D
+{
+
+class Node;
+class Scene;
+class WorkQueue;
+
+/// Structure-of-arrays storage of world transforms of all nodes in the scene.
+/// Nodes are stored in breadth-first order, so parents always precede children
+/// and each level of the hierarchy is a contiguous range of indices.
+/// Local transforms are still owned by Node.
+class URHO3D_API SceneTransformStore
+{
+public:
+    SceneTransformStore(Scene* scene, WorkQueue* workQueue);
+    ~SceneTransformStore();
+
+    /// Mark node as dirty. Called by Node::MarkDirty.
+    void MarkDirty(unsigned index) { dirtyFlags_[index] = 1; }
+    /// Mark hierarchy as changed. Storage will be rebuilt on next update.
+    void MarkHierarchyDirty() { hierarchyDirty_ = true; }
+    /// Remove node from the storage. Storage will be rebuilt on next update.
+    void RemoveNode(Node* node);
+
+    /// Update world transforms of all dirty nodes and write them back to the nodes.
+    void Update();
+
+    /// Return number of nodes in the storage.
+    unsigned GetNumNodes() const { return nodes_.size(); }
+    /// Return number of hierarchy levels in the storage.
+    unsigned GetNumLevels() const { return levelOffsets_.empty() ? 0 : levelOffsets_.size() - 1; }
+
+private:
+    /// Rebuild storage from the scene hierarchy.
+    void Rebuild();
+    /// Reset indices stored in the nodes.
+    void ResetNodeIndices();
+    /// Update world transforms of the range of nodes within one level.
+    void UpdateRange(unsigned beginIndex, unsigned endIndex);
+
+    Scene* scene_{};
+    WorkQueue* workQueue_{};
+    bool hierarchyDirty_{true};
+
+    /// Nodes. Removed nodes are null until next rebuild.
+    ea::vector<Node*> nodes_;
+    /// Parent indices. M_MAX_UNSIGNED for the children of the scene.
+    ea::vector<unsigned> parentIndices_;
+    /// Whether the world transform needs update.
+    ea::vector<unsigned char> dirtyFlags_;
+    /// World transforms.
+    ea::vector<Matrix3x4> worldTransforms_;
+    /// World rotations.
+    ea::vector<Quaternion> worldRotations_;
+    /// Index of the first node of each level, followed by total number of nodes.
+    ea::vector<unsigned> levelOffsets_;
+};
+
+}
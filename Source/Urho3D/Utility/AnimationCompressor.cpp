@@ -0,0 +1,61 @@
+// Copyright (c) 2023-2023 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#include "Urho3D/Precompiled.h"
+
+#include "Urho3D/Utility/AnimationCompressor.h"
+
+#include "Urho3D/Core/Context.h"
+#include "Urho3D/IO/Log.h"
+#include "Urho3D/Resource/ResourceCache.h"
+
+#include "Urho3D/DebugNew.h"
+
+namespace Urho3D
+{
+
+AnimationCompressor::AnimationCompressor(Context* context)
+    : AssetTransformer(context)
+{
+}
+
+AnimationCompressor::~AnimationCompressor()
+{
+}
+
+void AnimationCompressor::RegisterObject(Context* context)
+{
+    context->RegisterFactory<AnimationCompressor>(Category_Transformer);
+
+    static const AnimationCompressionSettings defaultSettings;
+    URHO3D_ATTRIBUTE("Position Error", float, settings_.positionError_, defaultSettings.positionError_, AM_DEFAULT);
+    URHO3D_ATTRIBUTE("Rotation Error", float, settings_.rotationError_, defaultSettings.rotationError_, AM_DEFAULT);
+    URHO3D_ATTRIBUTE("Scale Error", float, settings_.scaleError_, defaultSettings.scaleError_, AM_DEFAULT);
+    URHO3D_ATTRIBUTE("Reduce KeyFrames", bool, settings_.reduceKeyFrames_, defaultSettings.reduceKeyFrames_, AM_DEFAULT);
+}
+
+bool AnimationCompressor::IsApplicable(const AssetTransformerInput& input)
+{
+    return input.inputFileName_.ends_with(".ani", false);
+}
+
+bool AnimationCompressor::Execute(
+    const AssetTransformerInput& input, AssetTransformerOutput& output, const AssetTransformerVector& transformers)
+{
+    auto cache = GetSubsystem<ResourceCache>();
+    auto animation = cache->GetResource<Animation>(input.resourceName_);
+    if (!animation)
+        return false;
+
+    const AnimationCompressionReport report = animation->Compress(settings_);
+    if (report.numTracks_ == 0)
+        return true;
+
+    URHO3D_LOGINFO("Animation '{}' is compressed: {}", input.resourceName_, report.ToString());
+
+    animation->SaveFile(animation->GetAbsoluteFileName());
+    return true;
+}
+
+}
@@ -0,0 +1,32 @@
+// Copyright (c) 2023-2023 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#pragma once
+
+#include "Urho3D/Graphics/Animation.h"
+#include "Urho3D/Utility/AssetTransformer.h"
+
+namespace Urho3D
+{
+
+/// Asset transformer that compresses keyframes of skeletal animations.
+class URHO3D_API AnimationCompressor : public AssetTransformer
+{
+    URHO3D_OBJECT(AnimationCompressor, AssetTransformer);
+
+public:
+    explicit AnimationCompressor(Context* context);
+    ~AnimationCompressor() override;
+    static void RegisterObject(Context* context);
+
+    bool IsApplicable(const AssetTransformerInput& input) override;
+    bool Execute(const AssetTransformerInput& input, AssetTransformerOutput& output,
+        const AssetTransformerVector& transformers) override;
+    bool IsExecutedOnOutput() override { return true; }
+
+private:
+    AnimationCompressionSettings settings_;
+};
+
+}
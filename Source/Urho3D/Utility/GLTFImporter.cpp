@@ -3385,6 +3385,14 @@ private:
         return track.keyFrames_.back().time_;
     }
 
+    static ea::optional<float> GetTrackLength(const AnimationTrack& track)
+    {
+        const unsigned numKeyFrames = track.GetNumKeyFrames();
+        if (numKeyFrames == 0)
+            return ea::nullopt;
+        return track.GetKeyFrameValue(numKeyFrames - 1).time_;
+    }
+
     static float GetAnimationLength(const Animation& animation)
     {
         float length = 0.0f;
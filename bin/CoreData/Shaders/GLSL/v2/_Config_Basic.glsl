@@ -202,7 +202,7 @@ half RoughnessToSpecularPower(half roughness) { return (1.0 - roughness) * 255.0
 
 #ifdef URHO3D_VERTEX_SHADER
     /// Some geometries require certain vertex attributes.
-    #if defined(URHO3D_GEOMETRY_SKINNED)
+    #if defined(URHO3D_GEOMETRY_SKINNED) || defined(URHO3D_ANIMATION_PALETTE)
         #ifndef URHO3D_VERTEX_HAS_BONE_WEIGHTS_AND_INDICES
             #define URHO3D_VERTEX_HAS_BONE_WEIGHTS_AND_INDICES
         #endif
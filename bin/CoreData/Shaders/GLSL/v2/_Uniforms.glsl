@@ -232,6 +232,7 @@ UNIFORM_BUFFER_END(4, Material)
 /// cSH*: Per-object ambient lighting in linear color space.
 /// cBillboardRot: Rotation of billboard plane in world space.
 /// cSkinMatrices: Object to world space matrices for each bone.
+/// cInstanceData: Custom per-instance data. Frames and blend factor for animation palette.
 #ifdef URHO3D_VERTEX_SHADER
     #ifdef URHO3D_INSTANCING
         VERTEX_INPUT(vec4 iTexCoord4)
@@ -258,6 +259,21 @@ UNIFORM_BUFFER_END(4, Material)
         VERTEX_INPUT(half4 iTexCoord7)
         #define cAmbient iTexCoord7
     #endif
+
+    #if defined(URHO3D_INSTANCING_CUSTOM_DATA)
+        #if defined(URHO3D_AMBIENT_DIRECTIONAL)
+            VERTEX_INPUT(vec4 iTexCoord14)
+            #define cInstanceData iTexCoord14
+        #elif defined(URHO3D_AMBIENT_FLAT)
+            VERTEX_INPUT(vec4 iTexCoord8)
+            #define cInstanceData iTexCoord8
+        #else
+            VERTEX_INPUT(vec4 iTexCoord7)
+            #define cInstanceData iTexCoord7
+        #endif
+    #elif defined(URHO3D_ANIMATION_PALETTE)
+        #define cInstanceData vec4(0.0, 0.0, 0.0, 0.0)
+    #endif
     #else
         UNIFORM_BUFFER_BEGIN(5, Object)
             UNIFORM_HIGHP(mat4 cModel)
@@ -281,8 +297,16 @@ UNIFORM_BUFFER_END(4, Material)
             /// Object to world space matrices for each bone.
             UNIFORM_HIGHP(vec4 cSkinMatrices[URHO3D_MAXBONES * 3])
         #endif
+        #ifdef URHO3D_ANIMATION_PALETTE
+            UNIFORM_HIGHP(vec4 cInstanceData)
+        #endif
         UNIFORM_BUFFER_END(5, Object)
     #endif
+
+    #ifdef URHO3D_ANIMATION_PALETTE
+        /// Skinning matrices baked for all frames, one frame per row and three texels per bone.
+        SAMPLER_HIGHP(11, sampler2D sAnimationPalette)
+    #endif
 #endif // URHO3D_VERTEX_SHADER
 
 #endif // _UNIFORMS_GLSL_
@@ -90,6 +90,28 @@ mat4 GetModelMatrix()
 
     const vec4 col4 = vec4(0.0, 0.0, 0.0, 1.0);
     return mat4(col1, col2, col3, col4);
+#elif defined(URHO3D_ANIMATION_PALETTE)
+    // cInstanceData.xy are rows of two nearest frames and cInstanceData.z is blend factor between them
+    ivec4 idx = ivec4(iBlendIndices) * 3;
+    ivec2 frames = ivec2(cInstanceData.xy);
+    vec4 weights0 = iBlendWeights * (1.0 - cInstanceData.z);
+    vec4 weights1 = iBlendWeights * cInstanceData.z;
+
+    #define GetPaletteTexel(i, frame) texelFetch(sAnimationPalette, ivec2(i, frame), 0)
+    #define GetPaletteColumn(i1, i2, i3, i4, frame, k) \
+        (GetPaletteTexel(i1, frame) * k.x + GetPaletteTexel(i2, frame) * k.y + GetPaletteTexel(i3, frame) * k.z + GetPaletteTexel(i4, frame) * k.w)
+    #define GetSkinMatrixColumn(i1, i2, i3, i4) \
+        (GetPaletteColumn(i1, i2, i3, i4, frames.x, weights0) + GetPaletteColumn(i1, i2, i3, i4, frames.y, weights1))
+    vec4 col1 = GetSkinMatrixColumn(idx.x, idx.y, idx.z, idx.w);
+    vec4 col2 = GetSkinMatrixColumn(idx.x + 1, idx.y + 1, idx.z + 1, idx.w + 1);
+    vec4 col3 = GetSkinMatrixColumn(idx.x + 2, idx.y + 2, idx.z + 2, idx.w + 2);
+    #undef GetSkinMatrixColumn
+    #undef GetPaletteColumn
+    #undef GetPaletteTexel
+
+    // Palette matrices are in model space, so instance transform is applied on top of them
+    const vec4 col4 = vec4(0.0, 0.0, 0.0, 1.0);
+    return mat4(col1, col2, col3, col4) * cModel;
 #else
     return cModel;
 #endif